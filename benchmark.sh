@@ -0,0 +1,69 @@
+#!/bin/sh
+
+# NOTE(vlad): Benchmarks are built with optimizations and without sanitizers,
+#             so they are not a part of 'build.sh'.
+
+set -e
+
+mkdir -p build/benchmarks
+
+USE_GCC=0
+
+compiler_warnings="
+  -pedantic
+  -Wall
+  -Wextra
+  -Werror
+  -Wconversion
+  -Wshadow
+  -Wunreachable-code
+
+  -Wno-error=unused-function
+  -Wno-error=unused-variable
+  -Wno-error=unused-parameter
+"
+compiler_common_flags="
+  -std=gnu11
+  -O2
+  -DNDEBUG=1
+  -ggdb
+  -I.
+  -fno-omit-frame-pointer
+  -pthread
+"
+
+if [ $USE_GCC -eq 1 ];
+then
+    compiler=gcc
+    compiler_warnings="$compiler_warnings -Wno-type-limits"
+else
+    compiler=clang
+    compiler_warnings="$compiler_warnings -Wno-variadic-macro-arguments-omitted"
+fi
+
+compile_and_run_benchmark()
+{
+    benchmark_filename="$1"
+    benchmark_name=$(basename -s .c "$benchmark_filename")
+
+    shift
+
+    echo
+    echo "Compiling '$benchmark_name'"
+    $compiler "$benchmark_filename" -o "build/benchmarks/$benchmark_name" \
+              $compiler_common_flags \
+              $compiler_warnings
+
+    echo "Running '$benchmark_name'"
+    "./build/benchmarks/$benchmark_name" "$@"
+}
+
+if [ $# -eq 0 ];
+then
+    for benchmark in benchmarks/*.c;
+    do
+        compile_and_run_benchmark "$benchmark"
+    done
+else
+    compile_and_run_benchmark "$@"
+fi
@@ -0,0 +1,305 @@
+#include <eon/arena_provider.h>
+#include <eon/common.h>
+#include <eon/io.h>
+#include <eon/memory.h>
+#include <eon/string.h>
+
+#include <eon/platform/memory.h>
+#include <eon/platform/time.h>
+
+#include <eon_cfg.h>
+#include <eon_compilation_context.h>
+#include <eon_lexer.h>
+#include <eon_lexical_scopes.h>
+#include <eon_parser.h>
+#include <eon_ssa.h>
+#include <eon_tac.h>
+#include <eon_types.h>
+
+#define DEFAULT_NUMBER_OF_LINES 1000000
+
+// NOTE(vlad): Functions are pretty long to keep the number of functions (and therefore
+//             the number of lexical scopes and arenas) reasonable for 1M lines.
+#define STATEMENTS_PER_FUNCTION 90
+
+// NOTE(vlad): Must match the number of lines in 'append_synthetic_function'.
+#define LINES_PER_FUNCTION (STATEMENTS_PER_FUNCTION + 12)
+
+// NOTE(vlad): Must be enough for any function from 'append_synthetic_function'.
+#define MAX_BYTES_PER_FUNCTION (256 + 32 * STATEMENTS_PER_FUNCTION)
+
+internal void
+append_source_code(String* code, const String_View code_to_append)
+{
+    copy_memory(as_bytes(code->data + code->length), as_bytes(code_to_append.data), code_to_append.length);
+    code->length += code_to_append.length;
+}
+
+internal void
+append_synthetic_function(String* code, Arena* scratch_arena, const Index function_index, const Bool is_edited)
+{
+    const Index position = arena_get_position(scratch_arena);
+
+    append_source_code(code,
+                       string_view(format_string(scratch_arena,
+                                                 "function_{}: (parameter: s32) -> s32 =\n",
+                                                 function_index)));
+    append_source_code(code,
+                       string_view("{\n"
+                                   "    a: mutable _ = parameter;\n"
+                                   "    b: mutable _ = 0;\n"));
+
+    for (Index i = 0;
+         i < STATEMENTS_PER_FUNCTION;
+         ++i)
+    {
+        append_source_code(code,
+                           string_view(format_string(scratch_arena,
+                                                     "    b = b + a * {};\n",
+                                                     i + 1)));
+    }
+
+    append_source_code(code,
+                       string_view("    while a > 0\n"
+                                   "    {\n"));
+    append_source_code(code,
+                       string_view(format_string(scratch_arena,
+                                                 "        a = a - {};\n",
+                                                 function_index % 100 + (is_edited ? 2 : 1))));
+    append_source_code(code,
+                       string_view("    }\n"
+                                   "\n"
+                                   "    return a + b;\n"
+                                   "}\n"
+                                   "\n"));
+
+    arena_pop_to_position(scratch_arena, position);
+}
+
+// NOTE(vlad): Pass -1 as 'edited_function_index' to edit nothing.
+internal Source_File
+generate_synthetic_source_file(Arena* source_code_arena,
+                               Arena* scratch_arena,
+                               const Size number_of_lines,
+                               const Index edited_function_index)
+{
+    const Size number_of_functions = MAX(number_of_lines / LINES_PER_FUNCTION, 1);
+
+    String code = {0};
+    code.data = allocate_uninitialized_array(source_code_arena, number_of_functions * MAX_BYTES_PER_FUNCTION, char);
+
+    for (Index function_index = 0;
+         function_index < number_of_functions;
+         ++function_index)
+    {
+        append_synthetic_function(&code, scratch_arena, function_index, function_index == edited_function_index);
+    }
+
+    ASSERT(code.length <= number_of_functions * MAX_BYTES_PER_FUNCTION);
+
+    Source_File source_file = {0};
+    source_file.filename = string_view("synthetic.eon");
+    source_file.code = string_view(code);
+    return source_file;
+}
+
+#define BENCHMARK_PHASE(phase_name, ...)                                \
+    do                                                                  \
+    {                                                                   \
+        const Timestamp phase_start = platform_get_current_monotonic_timestamp(); \
+        __VA_ARGS__;                                                    \
+        const Timestamp phase_end = platform_get_current_monotonic_timestamp(); \
+        println("    {}: {} mcs", string_view(phase_name), phase_end - phase_start); \
+    }                                                                   \
+    while (0)
+
+internal void
+run_compiler_phases(Compilation_Context* context, Lexer* lexer, Parser* parser)
+{
+    create_lexer(lexer, context);
+    create_parser(parser, lexer, context);
+
+    Bool parsed = false;
+    BENCHMARK_PHASE("parsing", parsed = parse_ast(parser));
+
+    if (!parsed || has_diagnostic_messages(context))
+    {
+        println("Error: failed to parse the synthetic input");
+    }
+    else
+    {
+        BENCHMARK_PHASE("AST validation", validate_ast(context));
+        BENCHMARK_PHASE("lexical scopes", create_lexical_scopes(context));
+        BENCHMARK_PHASE("types", resolve_and_validate_types(context));
+        BENCHMARK_PHASE("TAC", lower_ast_to_tac(context));
+        BENCHMARK_PHASE("CFG", construct_cfg_from_tac(context));
+        BENCHMARK_PHASE("SSA", construct_ssa_from_cfg(context));
+
+        if (has_diagnostic_messages(context))
+        {
+            println("Error: the synthetic input has diagnostic messages");
+        }
+    }
+}
+
+internal void
+run_compiler_pipeline(const Source_File* source_file, const Arena_Flags arena_flags)
+{
+    Arena_Provider arena_provider = {0};
+    create_arena_provider(&arena_provider);
+    arena_provider.arena_flags = arena_flags;
+
+    const Timestamp start = platform_get_current_monotonic_timestamp();
+
+    Compilation_Context context = {0};
+    Lexer lexer = {0};
+    Parser parser = {0};
+
+    create_compilation_context(&context, &arena_provider, source_file);
+    run_compiler_phases(&context, &lexer, &parser);
+
+    if (arena_flags & ARENA_FLAG_COLLECT_STATISTICS)
+    {
+        println("Arena statistics (in bytes):\n{}", dump_arena_statistics(context.scratch_arena, &context));
+    }
+
+    destroy_compilation_context(&context);
+    destroy_parser(&parser);
+    destroy_lexer(&lexer);
+
+    const Timestamp end = platform_get_current_monotonic_timestamp();
+    println("    total: {} mcs", end - start);
+
+    destroy_arena_provider(&arena_provider);
+}
+
+// NOTE(vlad): Measures the time from an edit of one function to diagnostics, the previous
+//             compilation is not timed.
+internal void
+run_incremental_compiler_pipeline(const Source_File* source_file, const Source_File* edited_source_file)
+{
+    Arena_Provider arena_provider = {0};
+    create_arena_provider(&arena_provider);
+
+    Compilation_Context previous_context = {0};
+    Lexer previous_lexer = {0};
+    Parser previous_parser = {0};
+
+    create_compilation_context(&previous_context, &arena_provider, source_file);
+    run_compiler_phases(&previous_context, &previous_lexer, &previous_parser);
+
+    println("After editing one function:");
+
+    const Timestamp start = platform_get_current_monotonic_timestamp();
+
+    Compilation_Context context = {0};
+    Lexer lexer = {0};
+    Parser parser = {0};
+
+    create_compilation_context(&context, &arena_provider, edited_source_file);
+    reuse_unchanged_functions_of_previous_compilation(&context, &previous_context);
+    run_compiler_phases(&context, &lexer, &parser);
+
+    const Timestamp end = platform_get_current_monotonic_timestamp();
+    println("    total: {} mcs", end - start);
+
+    destroy_compilation_context(&context);
+    destroy_parser(&parser);
+    destroy_lexer(&lexer);
+
+    destroy_compilation_context(&previous_context);
+    destroy_parser(&previous_parser);
+    destroy_lexer(&previous_lexer);
+
+    destroy_arena_provider(&arena_provider);
+}
+
+internal inline void
+print_usage(void)
+{
+    println("Usage: compiler_benchmark [number-of-lines] [arena-statistics]");
+}
+
+int
+main(const int argc, const char* argv[])
+{
+    init_io_state(MiB(64));
+
+    Size number_of_lines = DEFAULT_NUMBER_OF_LINES;
+    if (argc >= 2 && (!parse_integer(string_view(argv[1]), &number_of_lines) || number_of_lines <= 0))
+    {
+        print_usage();
+        return EXIT_FAILURE;
+    }
+
+    // NOTE(vlad): Collecting statistics slows every push down, so it's a separate run.
+    Bool collect_arena_statistics = false;
+    if (argc >= 3)
+    {
+        if (!strings_are_equal(string_view(argv[2]), string_view("arena-statistics")))
+        {
+            print_usage();
+            return EXIT_FAILURE;
+        }
+
+        collect_arena_statistics = true;
+    }
+
+    Arena* source_code_arena = create_arena("source-code", GiB(4), MiB(1));
+    Arena* scratch_arena = create_arena("scratch", MiB(1), KiB(64));
+
+    const Source_File source_file = generate_synthetic_source_file(source_code_arena, scratch_arena, number_of_lines, -1);
+
+    println("Synthetic input: {} lines, {} bytes", number_of_lines, source_file.code.length);
+
+    if (collect_arena_statistics)
+    {
+        println("Regular pages with arena statistics:");
+        run_compiler_pipeline(&source_file, ARENA_FLAG_COLLECT_STATISTICS);
+    }
+
+    // NOTE(vlad): Alternating runs to even out warmup effects.
+    for (Index run = 0;
+         run < 2 && !collect_arena_statistics;
+         ++run)
+    {
+        println("Regular pages:");
+        run_compiler_pipeline(&source_file, ARENA_FLAG_NONE);
+
+        println("Huge pages (huge page size is {} bytes):", platform_get_huge_page_size());
+        run_compiler_pipeline(&source_file, ARENA_FLAG_HUGE_PAGES);
+    }
+
+    if (!collect_arena_statistics)
+    {
+        const Size number_of_functions = MAX(number_of_lines / LINES_PER_FUNCTION, 1);
+        const Source_File edited_source_file = generate_synthetic_source_file(source_code_arena,
+                                                                              scratch_arena,
+                                                                              number_of_lines,
+                                                                              number_of_functions / 2);
+
+        println("Incremental recompilation, before the edit:");
+        run_incremental_compiler_pipeline(&source_file, &edited_source_file);
+    }
+
+    destroy_arena(scratch_arena);
+    destroy_arena(source_code_arena);
+
+    return EXIT_SUCCESS;
+}
+
+#include <eon/arena_provider.c>
+#include <eon/io.c>
+#include <eon/memory.c>
+#include <eon/string.c>
+
+#include <eon_ast.c>
+#include <eon_cfg.c>
+#include <eon_compilation_context.c>
+#include <eon_diagnostics.c>
+#include <eon_lexer.c>
+#include <eon_lexical_scopes.c>
+#include <eon_parser.c>
+#include <eon_ssa.c>
+#include <eon_tac.c>
+#include <eon_types.c>
@@ -0,0 +1,140 @@
+#include <eon/common.h>
+#include <eon/containers.h>
+#include <eon/io.h>
+#include <eon/memory.h>
+#include <eon/string.h>
+
+#include <eon/platform/time.h>
+
+#define MIN_NUMBER_OF_NAMES 4
+#define MAX_NUMBER_OF_NAMES 32768
+
+// NOTE(vlad): Every measurement does roughly this many string comparisons for the linear
+//             scan, which is plenty for small tables and keeps the big ones reasonable.
+#define COMPARISONS_PER_MEASUREMENT 200000000
+
+// NOTE(vlad): The same lookups 'find_symbol_id' does: a name that is in the table
+//             and one that isn't, every other time.
+struct Names
+{
+    array(String_View, names);
+    array(String_View, missing_names);
+};
+typedef struct Names Names;
+
+struct Names_Map
+{
+    hash_map(String_View, Index, indices);
+};
+typedef struct Names_Map Names_Map;
+
+internal void
+generate_names(Arena* arena, Names* names, const Size number_of_names)
+{
+    for (Index i = 0;
+         i < number_of_names;
+         ++i)
+    {
+        append_array(arena, names->names, String_View, string_view(format_string(arena, "identifier_{}", i)));
+        append_array(arena, names->missing_names, String_View, string_view(format_string(arena, "missing_{}", i)));
+    }
+}
+
+internal Index
+find_name_linearly(const Names* names, const String_View name)
+{
+    for (Index i = 0;
+         i < names->names_count;
+         ++i)
+    {
+        if (strings_are_equal(names->names[i], name))
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+internal Index
+find_name_in_map(const Names_Map* map, const String_View name)
+{
+    Index slot_index = 0;
+    hash_map_find(map->indices, String_View, name, hash_string, strings_are_equal, slot_index);
+    return (slot_index != -1) ? map->indices[slot_index] : -1;
+}
+
+// NOTE(vlad): Returns the number of lookups per second.
+internal s64
+measure_lookups(const Names* names, const Names_Map* map, const Size lookups_count)
+{
+    Index found_names_count = 0;
+
+    const Timestamp start = platform_get_current_monotonic_timestamp();
+
+    for (Index i = 0;
+         i < lookups_count;
+         ++i)
+    {
+        const Index name_index = i % names->names_count;
+        const String_View name = (i & 1) ? names->missing_names[name_index] : names->names[name_index];
+
+        const Index found_index = (map != NULL) ? find_name_in_map(map, name) : find_name_linearly(names, name);
+        found_names_count += (found_index != -1);
+    }
+
+    const Timestamp end = platform_get_current_monotonic_timestamp();
+    const Timestamp elapsed_microseconds = MAX(end - start, 1);
+
+    if (found_names_count != (lookups_count + 1) / 2)
+    {
+        println("Error: found {} names instead of {}", found_names_count, (lookups_count + 1) / 2);
+    }
+
+    return lookups_count * 1000000 / elapsed_microseconds;
+}
+
+int
+main(void)
+{
+    init_io_state(MiB(1));
+
+    Arena* arena = create_arena("hash-map-benchmark", GiB(1), 0);
+
+    println("Lookups per second, half of the looked up names are missing.");
+
+    for (Size number_of_names = MIN_NUMBER_OF_NAMES;
+         number_of_names <= MAX_NUMBER_OF_NAMES;
+         number_of_names *= 2)
+    {
+        const Index position = arena_get_position(arena);
+
+        Names names = {0};
+        generate_names(arena, &names, number_of_names);
+
+        Names_Map map = {0};
+        for (Index i = 0;
+             i < names.names_count;
+             ++i)
+        {
+            hash_map_insert(arena, map.indices, String_View, Index, names.names[i], i, hash_string, strings_are_equal);
+        }
+
+        const Size lookups_count = MAX(COMPARISONS_PER_MEASUREMENT / number_of_names, 1000);
+
+        const s64 linear_scan = measure_lookups(&names, NULL, lookups_count);
+        const s64 hash_map = measure_lookups(&names, &map, lookups_count);
+
+        println("{} names: linear scan {}, hash map {}", number_of_names, linear_scan, hash_map);
+
+        arena_pop_to_position(arena, position);
+    }
+
+    destroy_arena(arena);
+
+    return EXIT_SUCCESS;
+}
+
+#include <eon/io.c>
+#include <eon/memory.c>
+#include <eon/string.c>
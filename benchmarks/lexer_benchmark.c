@@ -0,0 +1,384 @@
+#include <eon/arena_provider.h>
+#include <eon/common.h>
+#include <eon/containers.h>
+#include <eon/io.h>
+#include <eon/memory.h>
+#include <eon/string.h>
+
+#include <eon/platform/threads.h>
+#include <eon/platform/time.h>
+
+#include <eon_compilation_context.h>
+#include <eon_lexer.h>
+
+#define DEFAULT_NUMBER_OF_LINES 1000000
+
+// NOTE(vlad): Must match the number of lines in 'append_synthetic_function'.
+#define LINES_PER_FUNCTION 16
+
+// NOTE(vlad): Must be enough for any function from 'append_synthetic_function'.
+#define MAX_BYTES_PER_FUNCTION 512
+
+#define NUMBER_OF_RUNS 3
+
+// NOTE(vlad): Keywords and identifiers that look like keywords are mixed on purpose,
+//             so that the classification of words is a noticeable part of the work.
+internal void
+append_synthetic_function(String* code, Arena* scratch_arena, const Index function_index)
+{
+    const Index position = arena_get_position(scratch_arena);
+
+    const String_View function = string_view(format_string(scratch_arena,
+                                                           "function_{}: (parameter: s32, format: bool) -> s32 =\n"
+                                                           "{}\n"
+                                                           "    counter: mutable _ = parameter;\n"
+                                                           "    forward: mutable s32 = {};\n"
+                                                           "    while counter > 0 and true\n"
+                                                           "    {}\n"
+                                                           "        if format == false {} breaker = counter; break; {}\n"
+                                                           "        else {} forward = forward + counter * 2; {}\n"
+                                                           "        counter = counter - 1;\n"
+                                                           "        // NOTE: comments are skipped by the lexer.\n"
+                                                           "        continue;\n"
+                                                           "    {}\n"
+                                                           "\n"
+                                                           "    return forward + returned;\n"
+                                                           "{}\n"
+                                                           "\n",
+                                                           function_index, "{", function_index % 100,
+                                                           "{", "{", "}", "{", "}", "}", "}"));
+
+    copy_memory(as_bytes(code->data + code->length), as_bytes(function.data), function.length);
+    code->length += function.length;
+
+    arena_pop_to_position(scratch_arena, position);
+}
+
+internal Source_File
+generate_synthetic_source_file(Arena* source_code_arena, Arena* scratch_arena, const Size number_of_lines)
+{
+    const Size number_of_functions = MAX(number_of_lines / LINES_PER_FUNCTION, 1);
+
+    String code = {0};
+    code.data = allocate_uninitialized_array(source_code_arena, number_of_functions * MAX_BYTES_PER_FUNCTION, char);
+
+    for (Index function_index = 0;
+         function_index < number_of_functions;
+         ++function_index)
+    {
+        append_synthetic_function(&code, scratch_arena, function_index);
+    }
+
+    ASSERT(code.length <= number_of_functions * MAX_BYTES_PER_FUNCTION);
+
+    Source_File source_file = {0};
+    source_file.filename = string_view("synthetic.eon");
+    source_file.code = string_view(code);
+    return source_file;
+}
+
+// NOTE(vlad): Returns the number of tokens, including the EOF token.
+internal Size
+lex_source_file(const Source_File* source_file, const Bool into_token_buffer)
+{
+    Arena_Provider arena_provider = {0};
+    create_arena_provider(&arena_provider);
+
+    Compilation_Context context = {0};
+    create_compilation_context(&context, &arena_provider, source_file);
+
+    Lexer lexer = {0};
+    create_lexer(&lexer, &context);
+
+    Size tokens_count = 0;
+
+    if (into_token_buffer)
+    {
+        Token_Buffer buffer = {0};
+        lex_all_tokens(&lexer, context.tokens_arena, &buffer);
+        tokens_count = buffer.types_count;
+    }
+    else
+    {
+        Token token = {0};
+        while (get_next_token(&lexer, &token))
+        {
+            tokens_count += 1;
+
+            if (token.type == TOKEN_EOF)
+            {
+                break;
+            }
+        }
+    }
+
+    if (has_diagnostic_messages(&context))
+    {
+        println("Error: the synthetic input has diagnostic messages");
+    }
+
+    destroy_lexer(&lexer);
+    destroy_compilation_context(&context);
+    destroy_arena_provider(&arena_provider);
+
+    return tokens_count;
+}
+
+// NOTE(vlad): Returns the number of tokens, including the EOF token.
+internal Size
+lex_source_file_in_parallel(const Source_File* source_file, const Size threads_count)
+{
+    Arena_Provider arena_provider = {0};
+    create_arena_provider(&arena_provider);
+
+    Compilation_Context context = {0};
+    create_compilation_context(&context, &arena_provider, source_file);
+
+    Lexer lexer = {0};
+    create_lexer(&lexer, &context);
+
+    Token_Buffer buffer = {0};
+    lex_all_tokens_in_parallel(&lexer, context.tokens_arena, &buffer, threads_count);
+
+    if (has_diagnostic_messages(&context))
+    {
+        println("Error: the synthetic input has diagnostic messages");
+    }
+
+    const Size tokens_count = buffer.types_count;
+
+    destroy_lexer(&lexer);
+    destroy_compilation_context(&context);
+    destroy_arena_provider(&arena_provider);
+
+    return tokens_count;
+}
+
+internal void
+measure_chunk_boundaries_search(const Source_File* source_file, const Size chunks_count)
+{
+    Lexer lexer = {0};
+    lexer.code = source_file->code;
+    lexer.uses_vector_scans = true;
+
+    Index boundaries[MAX_LEXER_CHUNKS_COUNT + 1] = {0};
+
+    const Timestamp start = platform_get_current_monotonic_timestamp();
+    const Size found_chunks_count = find_lexer_chunk_boundaries(&lexer, chunks_count, boundaries);
+    const Timestamp end = platform_get_current_monotonic_timestamp();
+    const Timestamp elapsed_microseconds = MAX(end - start, 1);
+
+    println("Splitting into {} chunks took {} mcs: {} bytes/s",
+            found_chunks_count,
+            elapsed_microseconds,
+            source_file->code.length * 1000000 / elapsed_microseconds);
+}
+
+// NOTE(vlad): Thread counts double up to 'max_threads_count', which is always measured too.
+internal void
+measure_parallel_lexing(const Source_File* source_file, const Size max_threads_count)
+{
+    println("Parallel lexing on up to {} threads ({} processors):",
+            max_threads_count,
+            platform_get_number_of_processors());
+
+    measure_chunk_boundaries_search(source_file, max_threads_count);
+
+    Timestamp single_thread_microseconds = 0;
+
+    for (Size threads_count = 1;
+         threads_count <= max_threads_count;
+         threads_count = (threads_count * 2 > max_threads_count && threads_count != max_threads_count)
+             ? max_threads_count
+             : threads_count * 2)
+    {
+        Timestamp best_elapsed_microseconds = MAX_VALUE(Timestamp);
+        Size tokens_count = 0;
+
+        for (Index run = 0;
+             run < NUMBER_OF_RUNS;
+             ++run)
+        {
+            const Timestamp start = platform_get_current_monotonic_timestamp();
+            tokens_count = lex_source_file_in_parallel(source_file, threads_count);
+            const Timestamp end = platform_get_current_monotonic_timestamp();
+
+            best_elapsed_microseconds = MIN(best_elapsed_microseconds, MAX(end - start, 1));
+        }
+
+        if (threads_count == 1)
+        {
+            single_thread_microseconds = best_elapsed_microseconds;
+        }
+
+        println("    {} threads: {} tokens in {} mcs: {} bytes/s, {}% of the single thread speed",
+                threads_count,
+                tokens_count,
+                best_elapsed_microseconds,
+                source_file->code.length * 1000000 / best_elapsed_microseconds,
+                single_thread_microseconds * 100 / best_elapsed_microseconds);
+    }
+}
+
+struct Words
+{
+    array(String_View, words);
+};
+typedef struct Words Words;
+
+// NOTE(vlad): The classification 'get_next_token' used before the perfect hash, kept
+//             here to compare against 'classify_word'.
+internal Token_Type
+classify_word_linearly(const String_View word)
+{
+    for (Index i = 0;
+         i < KEYWORDS_TABLE_SIZE;
+         ++i)
+    {
+        const Keyword* keyword = &global_keywords[i];
+        if (keyword->lexeme.length > 0 && strings_are_equal(word, keyword->lexeme))
+        {
+            return keyword->type;
+        }
+    }
+
+    return TOKEN_IDENTIFIER;
+}
+
+internal void
+measure_word_classification(const Words* words, const Bool use_perfect_hash)
+{
+    Size keywords_count = 0;
+
+    const Timestamp start = platform_get_current_monotonic_timestamp();
+
+    for (Index i = 0;
+         i < words->words_count;
+         ++i)
+    {
+        const String_View word = words->words[i];
+        const Token_Type type = use_perfect_hash ? classify_word(word) : classify_word_linearly(word);
+        keywords_count += (type != TOKEN_IDENTIFIER);
+    }
+
+    const Timestamp end = platform_get_current_monotonic_timestamp();
+    const Timestamp elapsed_microseconds = MAX(end - start, 1);
+
+    println("    {} words ({} keywords) in {} mcs: {} words/s",
+            words->words_count,
+            keywords_count,
+            elapsed_microseconds,
+            words->words_count * 1000000 / elapsed_microseconds);
+}
+
+internal void
+collect_words(Arena* arena, const Source_File* source_file, Words* words)
+{
+    Arena_Provider arena_provider = {0};
+    create_arena_provider(&arena_provider);
+
+    Compilation_Context context = {0};
+    create_compilation_context(&context, &arena_provider, source_file);
+
+    Lexer lexer = {0};
+    create_lexer(&lexer, &context);
+
+    Token token = {0};
+    while (get_next_token(&lexer, &token) && token.type != TOKEN_EOF)
+    {
+        // NOTE(vlad): Only identifiers and keywords have names.
+        if (token.name_id != INVALID_NAME_ID)
+        {
+            append_array(arena, words->words, String_View, token.lexeme);
+        }
+    }
+
+    destroy_lexer(&lexer);
+    destroy_compilation_context(&context);
+    destroy_arena_provider(&arena_provider);
+}
+
+int
+main(const int argc, const char* argv[])
+{
+    init_io_state(MiB(1));
+
+    Size number_of_lines = DEFAULT_NUMBER_OF_LINES;
+    Size max_threads_count = platform_get_number_of_processors();
+
+    if ((argc >= 2 && (!parse_integer(string_view(argv[1]), &number_of_lines) || number_of_lines <= 0))
+        || (argc >= 3 && (!parse_integer(string_view(argv[2]), &max_threads_count) || max_threads_count <= 0)))
+    {
+        println("Usage: lexer_benchmark [number-of-lines] [max-threads-count]");
+        return EXIT_FAILURE;
+    }
+
+    max_threads_count = MIN(max_threads_count, MAX_LEXER_CHUNKS_COUNT);
+
+    Arena* source_code_arena = create_arena("source-code", GiB(4), MiB(1));
+    Arena* scratch_arena = create_arena("scratch", MiB(1), KiB(64));
+
+    const Source_File source_file = generate_synthetic_source_file(source_code_arena, scratch_arena, number_of_lines);
+
+    println("Synthetic input: {} lines, {} bytes", number_of_lines, source_file.code.length);
+
+    // NOTE(vlad): Streamed tokens are dropped right away, buffered ones are kept in
+    //             the structure-of-arrays form for the parser.
+    println("Bytes per token: {} streamed, {} buffered",
+            size_of(Token),
+            size_of(u8) + size_of(u32) + size_of(u32) + size_of(Name_Id));
+
+    for (Index run = 0;
+         run < 2 * NUMBER_OF_RUNS;
+         ++run)
+    {
+        const Bool into_token_buffer = (run % 2 == 1);
+        println(into_token_buffer ? "Lexing into a token buffer:" : "Lexing:");
+
+        const Timestamp start = platform_get_current_monotonic_timestamp();
+        const Size tokens_count = lex_source_file(&source_file, into_token_buffer);
+        const Timestamp end = platform_get_current_monotonic_timestamp();
+        const Timestamp elapsed_microseconds = MAX(end - start, 1);
+
+        println("    {} tokens in {} mcs: {} tokens/s, {} bytes/s",
+                tokens_count,
+                elapsed_microseconds,
+                tokens_count * 1000000 / elapsed_microseconds,
+                source_file.code.length * 1000000 / elapsed_microseconds);
+    }
+
+    measure_parallel_lexing(&source_file, max_threads_count);
+
+    Words words = {0};
+    collect_words(source_code_arena, &source_file, &words);
+
+    for (Index run = 0;
+         run < NUMBER_OF_RUNS;
+         ++run)
+    {
+        println("Linear scan over keywords:");
+        measure_word_classification(&words, false);
+
+        println("Perfect hash:");
+        measure_word_classification(&words, true);
+    }
+
+    destroy_arena(scratch_arena);
+    destroy_arena(source_code_arena);
+
+    return EXIT_SUCCESS;
+}
+
+#include <eon/arena_provider.c>
+#include <eon/io.c>
+#include <eon/memory.c>
+#include <eon/string.c>
+
+#include <eon_ast.c>
+#include <eon_cfg.c>
+#include <eon_compilation_context.c>
+#include <eon_diagnostics.c>
+#include <eon_lexer.c>
+#include <eon_lexical_scopes.c>
+#include <eon_tac.c>
+#include <eon_types.c>
@@ -0,0 +1,133 @@
+#include <eon/common.h>
+#include <eon/io.h>
+#include <eon/memory.h>
+
+#include <eon/platform/time.h>
+
+#include <string.h> // NOTE(vlad): For 'memcpy' and 'memset' we're comparing against.
+
+#define MIN_NUMBER_OF_BYTES 8
+#define MAX_NUMBER_OF_BYTES MiB(64)
+
+// NOTE(vlad): Every measurement touches roughly this much memory.
+#define BYTES_PER_MEASUREMENT MiB(512)
+
+typedef enum
+{
+    MEMORY_OPERATION_COPY_MEMORY,
+    MEMORY_OPERATION_FILL_MEMORY_WITH_ZEROS,
+    MEMORY_OPERATION_MEMCPY,
+    MEMORY_OPERATION_MEMSET,
+} Memory_Operation;
+
+// NOTE(vlad): Returns throughput in MiB per second.
+internal s64
+measure_memory_operation(const Memory_Operation operation,
+                         Byte* restrict destination,
+                         const Byte* restrict source,
+                         const Size number_of_bytes)
+{
+    const Size iterations_count = MAX(BYTES_PER_MEASUREMENT / number_of_bytes, 4);
+
+    const Timestamp start = platform_get_current_monotonic_timestamp();
+
+    for (Index i = 0;
+         i < iterations_count;
+         ++i)
+    {
+        switch (operation)
+        {
+            case MEMORY_OPERATION_COPY_MEMORY:
+            {
+                copy_memory(destination, source, number_of_bytes);
+            } break;
+
+            case MEMORY_OPERATION_FILL_MEMORY_WITH_ZEROS:
+            {
+                fill_memory_with_zeros(destination, number_of_bytes);
+            } break;
+
+            case MEMORY_OPERATION_MEMCPY:
+            {
+                memcpy(destination, source, (USize)number_of_bytes);
+            } break;
+
+            case MEMORY_OPERATION_MEMSET:
+            {
+                memset(destination, 0, (USize)number_of_bytes);
+            } break;
+        }
+
+        // NOTE(vlad): Prevent the compiler from hoisting the operation out of the loop.
+        __asm__ volatile("" : : "r"(destination) : "memory");
+    }
+
+    const Timestamp end = platform_get_current_monotonic_timestamp();
+    const Timestamp elapsed_microseconds = MAX(end - start, 1);
+
+    return (s64)((iterations_count * number_of_bytes) / MiB(1)) * 1000000 / elapsed_microseconds;
+}
+
+int
+main(void)
+{
+    init_io_state(MiB(1));
+
+    Arena* arena = create_arena("memory-benchmark", 2 * MAX_NUMBER_OF_BYTES + KiB(64), 0);
+
+    // NOTE(vlad): Offsetting buffers to exercise unaligned heads and tails. Also buffers
+    //             are half a page apart, otherwise loads would falsely depend on stores
+    //             to the same offset within a page (4K aliasing).
+    Byte* source = arena_push(arena, MAX_NUMBER_OF_BYTES + KiB(4)) + 3;
+    Byte* destination = arena_push(arena, MAX_NUMBER_OF_BYTES + KiB(4)) + KiB(2) + 1;
+
+    for (Index i = 0;
+         i < MAX_NUMBER_OF_BYTES;
+         ++i)
+    {
+        source[i] = (Byte)i;
+    }
+
+    Memory_Primitives primitives[MAX_NUMBER_OF_MEMORY_PRIMITIVES];
+    const Size primitives_count = get_supported_memory_primitives(primitives);
+
+    println("Throughput in MiB/s, non-temporal stores are used starting from {} bytes.",
+            MEMORY_NON_TEMPORAL_STORES_THRESHOLD);
+
+    for (Size number_of_bytes = MIN_NUMBER_OF_BYTES;
+         number_of_bytes <= MAX_NUMBER_OF_BYTES;
+         number_of_bytes *= 2)
+    {
+        println("");
+        println("{} bytes:", number_of_bytes);
+
+        for (Index i = 0;
+             i < primitives_count;
+             ++i)
+        {
+            use_memory_primitives(&primitives[i]);
+
+            const s64 copy = measure_memory_operation(MEMORY_OPERATION_COPY_MEMORY,
+                                                      destination, source, number_of_bytes);
+            const s64 fill = measure_memory_operation(MEMORY_OPERATION_FILL_MEMORY_WITH_ZEROS,
+                                                      destination, source, number_of_bytes);
+
+            println("    {}: copy_memory {}, fill_memory_with_zeros {}", primitives[i].name, copy, fill);
+        }
+
+        const s64 copy = measure_memory_operation(MEMORY_OPERATION_MEMCPY,
+                                                  destination, source, number_of_bytes);
+        const s64 fill = measure_memory_operation(MEMORY_OPERATION_MEMSET,
+                                                  destination, source, number_of_bytes);
+
+        println("    libc: memcpy {}, memset {}", copy, fill);
+    }
+
+    destroy_arena(arena);
+
+    return EXIT_SUCCESS;
+}
+
+#include <eon/io.c>
+#include <eon/memory.c>
+#include <eon/string.c>
@@ -0,0 +1,267 @@
+#include <eon/arena_provider.h>
+#include <eon/common.h>
+#include <eon/io.h>
+#include <eon/memory.h>
+#include <eon/string.h>
+
+#include <eon/platform/threads.h>
+#include <eon/platform/time.h>
+
+#include <eon_compilation_context.h>
+#include <eon_lexer.h>
+#include <eon_lexical_scopes.h>
+#include <eon_parser.h>
+#include <eon_types.h>
+
+#define DEFAULT_NUMBER_OF_TYPE_VARIABLES 1000000
+
+#define CALLS_PER_FUNCTION 4
+
+#define MAX_TYPE_CHECKER_BATCHES_COUNT_TO_MEASURE 8
+
+// NOTE(vlad): Returns the time spent in 'resolve_and_validate_types_in_batches' or -1 on failure.
+internal Timestamp
+resolve_types_in_code(Compilation_Context* context,
+                      Arena_Provider* arena_provider,
+                      Lexer* lexer,
+                      Parser* parser,
+                      const String_View code,
+                      const Size batches_count)
+{
+    Source_File source_file = {0};
+    source_file.filename = string_view("<type-solver-benchmark>");
+    source_file.code = code;
+
+    create_compilation_context(context, arena_provider, &source_file);
+    create_lexer(lexer, context);
+    create_parser(parser, lexer, context);
+
+    if (!parse_ast(parser))
+    {
+        return -1;
+    }
+
+    create_lexical_scopes(context);
+
+    const Timestamp start = platform_get_current_monotonic_timestamp();
+    const Bool types_are_valid = resolve_and_validate_types_in_batches(context, batches_count);
+    const Timestamp end = platform_get_current_monotonic_timestamp();
+
+    return types_are_valid ? end - start : -1;
+}
+
+// NOTE(vlad): Every function has pointer parameters and calls the previous one several times,
+//             passing both parameters and addresses of locals.
+internal String_View
+generate_call_heavy_code(Arena* code_arena, Arena* scratch_arena, const Size number_of_functions)
+{
+    String_Builder builder = {0};
+    create_string_builder(&builder, code_arena);
+
+    append_string(&builder, string_view("function_0: (pointer: * s32, value: s32) -> * s32 =\n"
+                                        "{\n"
+                                        "    return pointer;\n"
+                                        "}\n"));
+
+    for (Index i = 1;
+         i < number_of_functions;
+         ++i)
+    {
+        const Index position = arena_get_position(scratch_arena);
+
+        append_string(&builder, string_view(format_string(scratch_arena, "function_{}: (pointer: * s32, value: s32) -> * s32 =\n", i)));
+        append_string(&builder, string_view("{\n"
+                                            "    local: mutable s32 = value;\n"));
+
+        for (Index j = 0;
+             j < CALLS_PER_FUNCTION;
+             ++j)
+        {
+            append_string(&builder, string_view(format_string(scratch_arena, "    result_{}: * s32 = function_{}(local&, value);\n", j, i - 1)));
+        }
+
+        append_string(&builder, string_view(format_string(scratch_arena, "    return function_{}(pointer, value);\n", i - 1)));
+        append_string(&builder, string_view("}\n"));
+
+        arena_pop_to_position(scratch_arena, position);
+    }
+
+    return string_builder_to_string(&builder);
+}
+
+internal Index
+find_all_root_type_ids(Compilation_Context* context, const Type_Id first_type_id, const Size number_of_types)
+{
+    Index roots_sum = 0;
+
+    for (Index i = 0;
+         i < number_of_types;
+         ++i)
+    {
+        const Type_Id type_id = (Type_Id) { first_type_id.index + i };
+        roots_sum += find_root_type_id(context, type_id).index;
+    }
+
+    return roots_sum;
+}
+
+// NOTE(vlad): Inferred '_' bindings initialised from each other, one after another.
+internal void
+measure_unification_of_a_chain(Compilation_Context* context, const Size number_of_type_variables)
+{
+    const Timestamp start = platform_get_current_monotonic_timestamp();
+
+    const Type_Id first_type_id = create_new_type_variable(context);
+    Type_Id previous_type_id = first_type_id;
+
+    for (Index i = 1;
+         i < number_of_type_variables;
+         ++i)
+    {
+        const Type_Id type_id = create_new_type_variable(context);
+        try_to_unify_types(context, previous_type_id, type_id);
+        previous_type_id = type_id;
+    }
+
+    try_to_unify_types(context, previous_type_id, get_boolean_type_id(context));
+
+    const Timestamp unified = platform_get_current_monotonic_timestamp();
+
+    const Index roots_sum = find_all_root_type_ids(context, first_type_id, number_of_type_variables);
+
+    const Timestamp end = platform_get_current_monotonic_timestamp();
+
+    const Type_Id root_type_id = find_root_type_id(context, first_type_id);
+    println("    unification: {} mcs, finding all roots: {} mcs, rank of the root: {} (checksum {})",
+            unified - start,
+            end - unified,
+            get_exact_type_by_id(context, root_type_id)->rank,
+            roots_sum);
+}
+
+// NOTE(vlad): The worst case for 'find_root_type_id': a single chain where every variable
+//             is linked under the next one. This is what unification used to build without ranks.
+internal void
+measure_finding_roots_in_a_degenerate_chain(Compilation_Context* context, const Size number_of_type_variables)
+{
+    const Type_Id first_type_id = create_new_type_variable(context);
+
+    for (Index i = 1;
+         i < number_of_type_variables;
+         ++i)
+    {
+        const Type_Id type_id = create_new_type_variable(context);
+        get_exact_type_by_id(context, (Type_Id) { type_id.index - 1 })->parent_type_id = type_id;
+    }
+
+    const Timestamp start = platform_get_current_monotonic_timestamp();
+
+    find_root_type_id(context, first_type_id);
+
+    const Timestamp first_find = platform_get_current_monotonic_timestamp();
+
+    const Index roots_sum = find_all_root_type_ids(context, first_type_id, number_of_type_variables);
+
+    const Timestamp end = platform_get_current_monotonic_timestamp();
+
+    println("    first find from the deepest variable: {} mcs, finding all roots: {} mcs (checksum {})",
+            first_find - start,
+            end - first_find,
+            roots_sum);
+}
+
+int
+main(const int argc, const char* argv[])
+{
+    init_io_state(MiB(1));
+
+    Size number_of_type_variables = DEFAULT_NUMBER_OF_TYPE_VARIABLES;
+    if (argc >= 2 && (!parse_integer(string_view(argv[1]), &number_of_type_variables) || number_of_type_variables <= 0))
+    {
+        println("Usage: type_solver_benchmark [number-of-type-variables]");
+        return EXIT_FAILURE;
+    }
+
+    Arena_Provider arena_provider = {0};
+    create_arena_provider(&arena_provider);
+
+    {
+        Compilation_Context context = {0};
+        Lexer lexer = {0};
+        Parser parser = {0};
+
+        // NOTE(vlad): Builtin types are created by the type checker, so it runs once on an empty function.
+        if (resolve_types_in_code(&context, &arena_provider, &lexer, &parser, string_view("foo: () -> void = {\n}\n"), 1) < 0)
+        {
+            println("Error: failed to compile the empty function");
+            return EXIT_FAILURE;
+        }
+
+        println("{} chained type variables:", number_of_type_variables);
+        measure_unification_of_a_chain(&context, number_of_type_variables);
+
+        println("{} type variables in a degenerate chain:", number_of_type_variables);
+        measure_finding_roots_in_a_degenerate_chain(&context, number_of_type_variables);
+
+        destroy_compilation_context(&context);
+        destroy_parser(&parser);
+        destroy_lexer(&lexer);
+    }
+
+    {
+        Arena* code_arena = create_arena("call-heavy-code", GiB(1), MiB(1));
+        Arena* scratch_arena = create_arena("scratch", MiB(1), KiB(64));
+
+        const Size number_of_functions = MAX(number_of_type_variables / 100, 2);
+        const String_View code = generate_call_heavy_code(code_arena, scratch_arena, number_of_functions);
+
+        println("{} functions with {} calls each, {} processors:",
+                number_of_functions,
+                CALLS_PER_FUNCTION + 1,
+                platform_get_number_of_processors());
+
+        for (Size batches_count = 1;
+             batches_count <= MAX_TYPE_CHECKER_BATCHES_COUNT_TO_MEASURE;
+             batches_count *= 2)
+        {
+            Compilation_Context context = {0};
+            Lexer lexer = {0};
+            Parser parser = {0};
+
+            const Timestamp elapsed_microseconds = resolve_types_in_code(&context, &arena_provider, &lexer, &parser, code, batches_count);
+            if (elapsed_microseconds < 0)
+            {
+                println("Error: failed to compile the call-heavy code");
+                return EXIT_FAILURE;
+            }
+
+            println("    {} batches: {} mcs, {} types created", batches_count, elapsed_microseconds, context.types_count);
+
+            destroy_compilation_context(&context);
+            destroy_parser(&parser);
+            destroy_lexer(&lexer);
+        }
+
+        destroy_arena(scratch_arena);
+        destroy_arena(code_arena);
+    }
+
+    destroy_arena_provider(&arena_provider);
+
+    return EXIT_SUCCESS;
+}
+
+#include <eon/arena_provider.c>
+#include <eon/io.c>
+#include <eon/memory.c>
+#include <eon/string.c>
+
+#include <eon_ast.c>
+#include <eon_cfg.c>
+#include <eon_compilation_context.c>
+#include <eon_diagnostics.c>
+#include <eon_lexer.c>
+#include <eon_lexical_scopes.c>
+#include <eon_parser.c>
+#include <eon_tac.c>
+#include <eon_types.c>
@@ -54,6 +54,7 @@ compiler_common_flags="
   -ggdb
   -I.
   -fno-omit-frame-pointer
+  -pthread
 "
 
 if [ $ENABLE_ASAN -eq 1 ];
@@ -122,6 +123,7 @@ compile_and_run_unit_test eon/memory_ut.c
 compile_and_run_unit_test eon/containers_ut.c
 compile_and_run_unit_test eon/string_ut.c
 compile_and_run_unit_test eon/diff_ut.c
+compile_and_run_unit_test eon/arena_provider_ut.c
 
 if [ $asan_is_broken -eq 0 ];
 then
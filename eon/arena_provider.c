@@ -0,0 +1,164 @@
+#include "arena_provider.h"
+
+maybe_unused internal void
+create_arena_provider(Arena_Provider* provider)
+{
+    *provider = (Arena_Provider){0};
+    provider->arena = create_arena("arena-provider", MiB(1), KiB(4));
+}
+
+maybe_unused internal void
+destroy_arena_provider(Arena_Provider* provider)
+{
+    for (Index bucket_index = 0;
+         bucket_index < ARENA_PROVIDER_SIZE_CLASSES_COUNT;
+         ++bucket_index)
+    {
+        Arena_Provider_Bucket* bucket = &provider->buckets[bucket_index];
+
+        for (Index arena_index = 0;
+             arena_index < bucket->free_arenas_count;
+             ++arena_index)
+        {
+            destroy_arena(bucket->free_arenas[arena_index]);
+        }
+    }
+
+    destroy_arena(provider->arena);
+}
+
+// NOTE(vlad): Returns the index of the smallest size class that can hold
+//             'number_of_bytes' or -1 if the size is too big to be pooled.
+internal Index
+get_size_class_index_for_acquiring(const Size number_of_bytes)
+{
+    Size size_class = ARENA_PROVIDER_MIN_SIZE_CLASS;
+
+    for (Index size_class_index = 0;
+         size_class_index < ARENA_PROVIDER_SIZE_CLASSES_COUNT;
+         ++size_class_index)
+    {
+        if (number_of_bytes <= size_class)
+        {
+            return size_class_index;
+        }
+
+        size_class *= 2;
+    }
+
+    return -1;
+}
+
+// NOTE(vlad): Returns the index of the biggest size class that fits into
+//             'number_of_bytes' or -1 if the size is too big to be pooled.
+internal Index
+get_size_class_index_for_releasing(const Size number_of_bytes)
+{
+    Size size_class = ARENA_PROVIDER_MIN_SIZE_CLASS;
+    Index result = 0;
+
+    for (Index size_class_index = 0;
+         size_class_index < ARENA_PROVIDER_SIZE_CLASSES_COUNT;
+         ++size_class_index)
+    {
+        if (number_of_bytes < size_class)
+        {
+            return result;
+        }
+
+        result = size_class_index;
+        size_class *= 2;
+    }
+
+    // NOTE(vlad): 'size_class' is twice as big as the biggest size class here.
+    return (number_of_bytes < size_class) ? result : -1;
+}
+
+maybe_unused internal Arena*
+acquire_arena_from_provider(Arena_Provider* provider,
+                            const String_View arena_name,
+                            const Size number_of_bytes_to_reserve,
+                            const Size number_of_bytes_to_commit)
+{
+    return acquire_arena_with_flags_from_provider(provider,
+                                                  arena_name,
+                                                  number_of_bytes_to_reserve,
+                                                  number_of_bytes_to_commit,
+                                                  ARENA_FLAG_NONE);
+}
+
+maybe_unused internal Arena*
+acquire_arena_with_flags_from_provider(Arena_Provider* provider,
+                                       const String_View arena_name,
+                                       const Size number_of_bytes_to_reserve,
+                                       const Size number_of_bytes_to_commit,
+                                       const Arena_Flags arena_flags)
+{
+    const Arena_Flags flags = provider->arena_flags | arena_flags;
+    const Index size_class_index = get_size_class_index_for_acquiring(number_of_bytes_to_reserve);
+
+    if (size_class_index == -1)
+    {
+        provider->misses_count += 1;
+        return INTERNAL_create_arena(arena_name, number_of_bytes_to_reserve, number_of_bytes_to_commit, flags);
+    }
+
+    Arena_Provider_Bucket* bucket = &provider->buckets[size_class_index];
+
+    if (bucket->free_arenas_count != 0)
+    {
+        provider->hits_count += 1;
+
+        Arena* arena = bucket->free_arenas[bucket->free_arenas_count - 1];
+        bucket->free_arenas_count -= 1;
+
+        arena->name = arena_name;
+        arena->flags = flags;
+        arena->high_water_mark = 0;
+        arena->page_counters = (Arena_Page_Counters){0};
+        arena->statistics = (Arena_Statistics){0};
+        return arena;
+    }
+
+    provider->misses_count += 1;
+
+    const Size size_class = ARENA_PROVIDER_MIN_SIZE_CLASS << size_class_index;
+    return INTERNAL_create_arena(arena_name, size_class, MIN(number_of_bytes_to_commit, size_class), flags);
+}
+
+// NOTE(vlad): Arenas that are used on other threads. This provider never hands out the same
+//             arena twice, so they are no different from the rest.
+maybe_unused internal Arena*
+acquire_worker_arena_from_provider(Arena_Provider* provider,
+                                   const String_View arena_name,
+                                   const Size number_of_bytes_to_reserve,
+                                   const Size number_of_bytes_to_commit)
+{
+    return acquire_arena_from_provider(provider, arena_name, number_of_bytes_to_reserve, number_of_bytes_to_commit);
+}
+
+maybe_unused internal void
+request_arena_reset(Arena_Provider* provider, Arena* arena)
+{
+    UNUSED(provider);
+    arena_clear(arena);
+}
+
+maybe_unused internal void
+release_arena_to_provider(Arena_Provider* provider, Arena* arena)
+{
+    const Index size_class_index = get_size_class_index_for_releasing(arena->reserved_bytes_count);
+
+    if (size_class_index == -1)
+    {
+        destroy_arena(arena);
+        return;
+    }
+
+    // NOTE(vlad): Pooled arenas should not hold on to their pages.
+    arena->flags &= ~(Arena_Flags)ARENA_FLAG_RETAIN_COMMITTED_PAGES;
+    arena_clear(arena);
+
+    Arena_Provider_Bucket* bucket = &provider->buckets[size_class_index];
+    append_array(provider->arena, bucket->free_arenas, Arena*, arena);
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <eon/common.h>
+#include <eon/containers.h>
+#include <eon/memory.h>
+#include <eon/string.h>
+
+// NOTE(vlad): Size classes are powers of two starting from 'ARENA_PROVIDER_MIN_SIZE_CLASS'.
+//             Arenas that reserve more than the biggest size class are not pooled.
+#define ARENA_PROVIDER_MIN_SIZE_CLASS KiB(64)
+#define ARENA_PROVIDER_SIZE_CLASSES_COUNT 12
+
+struct Arena_Provider_Bucket
+{
+    array(Arena*, free_arenas);
+};
+typedef struct Arena_Provider_Bucket Arena_Provider_Bucket;
+
+// NOTE(vlad): Arena provider keeps released arenas in free lists bucketed by their
+//             reservation size and gives them back instead of reserving new memory.
+struct Arena_Provider
+{
+    Arena* arena;
+
+    // NOTE(vlad): Flags of every arena created by this provider, e.g. 'ARENA_FLAG_HUGE_PAGES'
+    //             for big inputs. Should be set right after creating the provider.
+    Arena_Flags arena_flags;
+
+    Arena_Provider_Bucket buckets[ARENA_PROVIDER_SIZE_CLASSES_COUNT];
+
+    Size hits_count;
+    Size misses_count;
+};
+typedef struct Arena_Provider Arena_Provider;
+
+internal void create_arena_provider(Arena_Provider* provider);
+internal void destroy_arena_provider(Arena_Provider* provider);
+
+internal Arena* acquire_arena_from_provider(Arena_Provider* provider,
+                                            const String_View arena_name,
+                                            const Size number_of_bytes_to_reserve,
+                                            const Size number_of_bytes_to_commit);
+// NOTE(vlad): 'arena_flags' are added to the provider's ones.
+internal Arena* acquire_arena_with_flags_from_provider(Arena_Provider* provider,
+                                                       const String_View arena_name,
+                                                       const Size number_of_bytes_to_reserve,
+                                                       const Size number_of_bytes_to_commit,
+                                                       const Arena_Flags arena_flags);
+internal Arena* acquire_worker_arena_from_provider(Arena_Provider* provider,
+                                                   const String_View arena_name,
+                                                   const Size number_of_bytes_to_reserve,
+                                                   const Size number_of_bytes_to_commit);
+internal void request_arena_reset(Arena_Provider* provider, Arena* arena);
+internal void release_arena_to_provider(Arena_Provider* provider, Arena* arena);
@@ -0,0 +1,118 @@
+#include <eon/unit_test.h>
+
+#include "arena_provider.h"
+
+internal void
+test_arenas_recycling(Test_Context* test_context)
+{
+    Arena_Provider provider = {0};
+    create_arena_provider(&provider);
+
+    // NOTE(vlad): The first arena is always created.
+    Arena* first_arena = acquire_arena_from_provider(&provider, string_view("first"), KiB(64), KiB(4));
+    ASSERT_EQUAL(provider.hits_count, 0);
+    ASSERT_EQUAL(provider.misses_count, 1);
+
+    s32* value = allocate(first_arena, s32);
+    *value = 10;
+
+    release_arena_to_provider(&provider, first_arena);
+
+    // NOTE(vlad): Released arena is recycled.
+    Arena* second_arena = acquire_arena_from_provider(&provider, string_view("second"), KiB(64), KiB(4));
+    ASSERT_EQUAL(provider.hits_count, 1);
+    ASSERT_EQUAL(provider.misses_count, 1);
+    ASSERT_POINTERS_ARE_EQUAL(second_arena, first_arena);
+    ASSERT_STRINGS_ARE_EQUAL(second_arena->name, "second");
+
+#if ASAN_ENABLED == 0
+    ASSERT_EQUAL(arena_get_position(second_arena), ARENA_HEADER_SIZE);
+#endif
+
+    // NOTE(vlad): There are no free arenas left.
+    Arena* third_arena = acquire_arena_from_provider(&provider, string_view("third"), KiB(64), KiB(4));
+    ASSERT_EQUAL(provider.hits_count, 1);
+    ASSERT_EQUAL(provider.misses_count, 2);
+    ASSERT_TRUE(third_arena != second_arena);
+
+    release_arena_to_provider(&provider, second_arena);
+    release_arena_to_provider(&provider, third_arena);
+
+    destroy_arena_provider(&provider);
+}
+
+internal void
+test_size_classes(Test_Context* test_context)
+{
+    Arena_Provider provider = {0};
+    create_arena_provider(&provider);
+
+    Arena* small_arena = acquire_arena_from_provider(&provider, string_view("small"), KiB(16), KiB(4));
+    Arena* big_arena = acquire_arena_from_provider(&provider, string_view("big"), MiB(16), KiB(4));
+
+    release_arena_to_provider(&provider, small_arena);
+    release_arena_to_provider(&provider, big_arena);
+
+    // NOTE(vlad): Small requests are served from the smallest size class.
+    {
+        Arena* arena = acquire_arena_from_provider(&provider, string_view("small"), KiB(32), KiB(4));
+        ASSERT_POINTERS_ARE_EQUAL(arena, small_arena);
+        release_arena_to_provider(&provider, arena);
+    }
+
+    // NOTE(vlad): Big requests are not served by small arenas.
+    {
+        Arena* arena = acquire_arena_from_provider(&provider, string_view("big"), MiB(12), KiB(4));
+        ASSERT_POINTERS_ARE_EQUAL(arena, big_arena);
+        release_arena_to_provider(&provider, arena);
+    }
+
+    ASSERT_EQUAL(provider.hits_count, 2);
+    ASSERT_EQUAL(provider.misses_count, 2);
+
+    // NOTE(vlad): Huge arenas are not pooled.
+    {
+        Arena* huge_arena = acquire_arena_from_provider(&provider, string_view("huge"), MiB(256), KiB(4));
+        ASSERT_EQUAL(provider.misses_count, 3);
+        release_arena_to_provider(&provider, huge_arena);
+
+        Arena* another_huge_arena = acquire_arena_from_provider(&provider, string_view("huge"), MiB(256), KiB(4));
+        ASSERT_EQUAL(provider.misses_count, 4);
+        release_arena_to_provider(&provider, another_huge_arena);
+    }
+
+    destroy_arena_provider(&provider);
+}
+
+internal void
+test_acquiring_arenas_with_flags(Test_Context* test_context)
+{
+    Arena_Provider provider = {0};
+    create_arena_provider(&provider);
+    provider.arena_flags = ARENA_FLAG_COLLECT_STATISTICS;
+
+    Arena* arena = acquire_arena_with_flags_from_provider(&provider,
+                                                          string_view("retaining"),
+                                                          KiB(64),
+                                                          KiB(4),
+                                                          ARENA_FLAG_RETAIN_COMMITTED_PAGES);
+    ASSERT_EQUAL(arena->flags, ARENA_FLAG_COLLECT_STATISTICS | ARENA_FLAG_RETAIN_COMMITTED_PAGES);
+    release_arena_to_provider(&provider, arena);
+
+    // NOTE(vlad): Flags of a recycled arena don't leak into the next acquisition.
+    Arena* recycled_arena = acquire_arena_from_provider(&provider, string_view("plain"), KiB(64), KiB(4));
+    ASSERT_POINTERS_ARE_EQUAL(recycled_arena, arena);
+    ASSERT_EQUAL(recycled_arena->flags, ARENA_FLAG_COLLECT_STATISTICS);
+
+    release_arena_to_provider(&provider, recycled_arena);
+
+    destroy_arena_provider(&provider);
+}
+
+REGISTER_TESTS(
+    test_arenas_recycling,
+    test_size_classes,
+    test_acquiring_arenas_with_flags
+)
+
+#include "arena_provider.c"
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <eon/build_info.h>
+#include <eon/common.h>
+
+// NOTE(vlad): Blocks of characters for scanning source code. SSE2 and NEON are a part of
+//             the x86-64 and AArch64 baselines. Most scanned runs (identifiers, indentation)
+//             are shorter than a single SSE2 block, so wider AVX2 blocks wouldn't pay for
+//             the runtime dispatch.
+#if ARCH_X86_64
+#    include <emmintrin.h>
+
+#    define HAS_CHARACTERS_BLOCKS 1
+
+typedef __m128i Characters_Block;
+
+#    define CHARACTERS_BLOCK_SIZE 16
+#    define CHARACTERS_BLOCK_FULL_MASK 0xFFFFu
+
+#    define LOAD_CHARACTERS_BLOCK(pointer) _mm_loadu_si128((const __m128i*)(pointer))
+#    define BROADCAST_CHARACTER(c) _mm_set1_epi8((char)(c))
+#    define CHARACTERS_ARE_EQUAL(block, c) _mm_cmpeq_epi8((block), BROADCAST_CHARACTER(c))
+// NOTE(vlad): SSE2 only has signed comparisons, which is fine for ASCII ranges: non-ASCII
+//             characters are negative and are never in the range.
+#    define CHARACTERS_ARE_IN_RANGE(block, first, last)                       \
+    _mm_and_si128(_mm_cmpgt_epi8((block), BROADCAST_CHARACTER((first) - 1)),  \
+                  _mm_cmplt_epi8((block), BROADCAST_CHARACTER((last) + 1)))
+#    define CHARACTERS_OR(lhs, rhs) _mm_or_si128((lhs), (rhs))
+#    define CHARACTERS_BLOCK_MASK(block) ((u32)_mm_movemask_epi8(block))
+#elif ARCH_ARM64
+#    include <arm_neon.h>
+
+#    define HAS_CHARACTERS_BLOCKS 1
+
+typedef uint8x16_t Characters_Block;
+
+#    define CHARACTERS_BLOCK_SIZE 16
+#    define CHARACTERS_BLOCK_FULL_MASK 0xFFFFu
+
+#    define LOAD_CHARACTERS_BLOCK(pointer) vld1q_u8((const u8*)(pointer))
+#    define BROADCAST_CHARACTER(c) vdupq_n_u8((u8)(c))
+#    define CHARACTERS_ARE_EQUAL(block, c) vceqq_u8((block), BROADCAST_CHARACTER(c))
+#    define CHARACTERS_ARE_IN_RANGE(block, first, last)                       \
+    vandq_u8(vcgeq_u8((block), BROADCAST_CHARACTER(first)),                   \
+             vcleq_u8((block), BROADCAST_CHARACTER(last)))
+#    define CHARACTERS_OR(lhs, rhs) vorrq_u8((lhs), (rhs))
+#    define CHARACTERS_BLOCK_MASK(block) neon_characters_block_mask(block)
+
+// NOTE(vlad): NEON has no 'movemask', so every byte keeps its own bit and the halves are summed up.
+internal inline u32
+neon_characters_block_mask(const uint8x16_t block)
+{
+    const uint8x16_t bits = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+    const uint8x16_t masked_bits = vandq_u8(block, bits);
+    return (u32)vaddv_u8(vget_low_u8(masked_bits)) | ((u32)vaddv_u8(vget_high_u8(masked_bits)) << 8);
+}
+#else
+#    define HAS_CHARACTERS_BLOCKS 0
+#endif
+
+#if HAS_CHARACTERS_BLOCKS
+#    if COMPILER_MSVC
+#        include <intrin.h> // NOTE(vlad): For '_BitScanForward'.
+#    endif
+
+internal inline u32
+count_trailing_zeros(const u32 number)
+{
+    ASSERT(number != 0);
+
+#    if COMPILER_GCC || COMPILER_CLANG
+    return (u32)__builtin_ctz(number);
+#    elif COMPILER_MSVC
+    unsigned long index = 0;
+    _BitScanForward(&index, number);
+    return (u32)index;
+#    endif
+}
+#endif
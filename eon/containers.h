@@ -6,38 +6,34 @@
 
 #include <eon/sanitizers/asan.h>
 
-#if ASAN_ENABLED
-#    define ensure_array_has_enough_capacity(arena, array, Type, requested_size) \
-    do                                                                  \
-    {                                                                   \
-        /* NOTE(vlad): Always reallocate so we could find all use-after-move bugs. */ \
-        const Size new_capacity = CONCATENATE(array, _count) + requested_size; \
-        array = reallocate(arena,                                       \
-                           array,                                       \
-                           Type,                                        \
-                           CONCATENATE(array, _capacity),               \
-                           new_capacity);                               \
-        CONCATENATE(array, _capacity) = new_capacity;                   \
-    }                                                                   \
-    while (0)
-#else
-#    define ensure_array_has_enough_capacity(arena, array, Type, requested_size) \
+// NOTE(vlad): Arrays grow geometrically with and without ASAN. If ASAN is enabled,
+//             'arena_reallocate' always moves the array and poisons the old buffer,
+//             and the capacity past the requested elements is poisoned too, so we still
+//             find use-after-move bugs on every growth and reads past the end of arrays.
+#define ensure_array_has_enough_capacity(arena, array, Type, requested_size) \
     do                                                                  \
     {                                                                   \
         if (CONCATENATE(array, _count) + requested_size > CONCATENATE(array, _capacity)) \
         {                                                               \
             const Size new_capacity = MAX(CONCATENATE(array, _count) + requested_size, \
                                           2 * CONCATENATE(array, _capacity)); \
+            /* NOTE(vlad): The whole capacity is copied on reallocation. */ \
+            ASAN_UNPOISON_MEMORY_REGION(as_bytes((array) + CONCATENATE(array, _count)), \
+                                        size_of(Type) * (CONCATENATE(array, _capacity) - CONCATENATE(array, _count))); \
             array = reallocate(arena,                                   \
                                array,                                   \
                                Type,                                    \
                                CONCATENATE(array, _capacity),           \
                                new_capacity);                           \
+            ASAN_POISON_MEMORY_REGION(as_bytes((array) + CONCATENATE(array, _count)), \
+                                      size_of(Type) * (new_capacity - CONCATENATE(array, _count))); \
             CONCATENATE(array, _capacity) = new_capacity;               \
         }                                                               \
+                                                                        \
+        ASAN_UNPOISON_MEMORY_REGION(as_bytes((array) + CONCATENATE(array, _count)), \
+                                    size_of(Type) * (requested_size));  \
     }                                                                   \
     while (0)
-#endif
 
 #define grow_array_if_needed(arena, array, Type) ensure_array_has_enough_capacity(arena, array, Type, 1)
 
@@ -55,6 +51,17 @@
     }                                                                   \
     while (0)                                                           \
 
+#define append_array_elements(arena, array, Type, elements, elements_count) \
+    do                                                                  \
+    {                                                                   \
+        ensure_array_has_enough_capacity(arena, array, Type, (elements_count)); \
+        copy_memory(as_bytes((array) + CONCATENATE(array, _count)),     \
+                    as_bytes(elements),                                 \
+                    size_of(Type) * (elements_count));                  \
+        CONCATENATE(array, _count) += (elements_count);                 \
+    }                                                                   \
+    while (0)
+
 #define remove_last_array_element(array, Type)                          \
     do                                                                  \
     {                                                                   \
@@ -76,3 +83,195 @@
         CONCATENATE(stack, _count) -= 1;        \
     }                                           \
     while (0)
+
+// NOTE(vlad): Open-addressing hash map with linear probing. Every slot has a control byte:
+//             zero for an empty slot, otherwise the top 7 bits of the key's hash with the
+//             highest bit set, so most of mismatching keys are skipped without comparing
+//             them. The capacity is a power of 2 and the load factor is at most 3/4, thus
+//             probing always stops at an empty slot. Keys can't be removed.
+//
+//             Hash and equality functions are passed to every operation that needs them:
+//
+//                 u64 hash_function(Key_Type key);
+//                 Bool keys_are_equal_function(Key_Type lhs, Key_Type rhs);
+//
+//             Iterating over 'hash_map(String_View, s32, values)':
+//
+//                 for (Index slot_index = 0;
+//                      slot_index < map.values_capacity;
+//                      ++slot_index)
+//                 {
+//                     if (hash_map_slot_is_occupied(map.values, slot_index))
+//                     {
+//                         ... map.values_keys[slot_index], map.values[slot_index] ...
+//                     }
+//                 }
+
+#define HASH_MAP_EMPTY_SLOT_CONTROL 0
+#define HASH_MAP_MIN_CAPACITY 16
+
+#define hash_map(Key_Type, Value_Type, name)    \
+    Value_Type* name;                           \
+    Key_Type* CONCATENATE(name, _keys);         \
+    u8* CONCATENATE(name, _controls);           \
+    Size CONCATENATE(name, _count);             \
+    Size CONCATENATE(name, _capacity)
+
+internal inline u8
+hash_map_get_control(const u64 hash)
+{
+    return (u8)(0x80 | (hash >> 57));
+}
+
+internal inline Index
+hash_map_get_first_slot_index(const u64 hash, const Size capacity)
+{
+    return (Index)(hash & (u64)(capacity - 1));
+}
+
+internal inline Bool
+hash_map_needs_to_grow(const Size count, const Size capacity)
+{
+    return 4 * count > 3 * capacity;
+}
+
+#define hash_map_slot_is_occupied(map, slot_index)                      \
+    (CONCATENATE(map, _controls)[slot_index] != HASH_MAP_EMPTY_SLOT_CONTROL)
+
+// NOTE(vlad): Makes sure that 'requested_count' keys fit without rehashing.
+#define hash_map_reserve(arena, map, Key_Type, Value_Type, requested_count, hash_function) \
+    do                                                                  \
+    {                                                                   \
+        const Size INTERNAL_reserve_requested_count = (requested_count); \
+        if (hash_map_needs_to_grow(INTERNAL_reserve_requested_count, CONCATENATE(map, _capacity))) \
+        {                                                               \
+            Size INTERNAL_reserve_capacity = MAX(HASH_MAP_MIN_CAPACITY, 2 * CONCATENATE(map, _capacity)); \
+            while (hash_map_needs_to_grow(INTERNAL_reserve_requested_count, INTERNAL_reserve_capacity)) \
+            {                                                           \
+                INTERNAL_reserve_capacity *= 2;                         \
+            }                                                           \
+                                                                        \
+            u8* INTERNAL_reserve_controls = allocate_array(arena, INTERNAL_reserve_capacity, u8); \
+            Key_Type* INTERNAL_reserve_keys = allocate_uninitialized_array(arena, INTERNAL_reserve_capacity, Key_Type); \
+            Value_Type* INTERNAL_reserve_values = allocate_uninitialized_array(arena, INTERNAL_reserve_capacity, Value_Type); \
+                                                                        \
+            for (Index INTERNAL_reserve_old_slot_index = 0;             \
+                 INTERNAL_reserve_old_slot_index < CONCATENATE(map, _capacity); \
+                 ++INTERNAL_reserve_old_slot_index)                     \
+            {                                                           \
+                if (!hash_map_slot_is_occupied(map, INTERNAL_reserve_old_slot_index)) \
+                {                                                       \
+                    continue;                                           \
+                }                                                       \
+                                                                        \
+                /* NOTE(vlad): Keys are unique, so only looking for an empty slot. */ \
+                const u64 INTERNAL_reserve_hash = hash_function(CONCATENATE(map, _keys)[INTERNAL_reserve_old_slot_index]); \
+                Index INTERNAL_reserve_slot_index = hash_map_get_first_slot_index(INTERNAL_reserve_hash, INTERNAL_reserve_capacity); \
+                while (INTERNAL_reserve_controls[INTERNAL_reserve_slot_index] != HASH_MAP_EMPTY_SLOT_CONTROL) \
+                {                                                       \
+                    INTERNAL_reserve_slot_index = (INTERNAL_reserve_slot_index + 1) & (INTERNAL_reserve_capacity - 1); \
+                }                                                       \
+                                                                        \
+                INTERNAL_reserve_controls[INTERNAL_reserve_slot_index] = CONCATENATE(map, _controls)[INTERNAL_reserve_old_slot_index]; \
+                INTERNAL_reserve_keys[INTERNAL_reserve_slot_index] = CONCATENATE(map, _keys)[INTERNAL_reserve_old_slot_index]; \
+                INTERNAL_reserve_values[INTERNAL_reserve_slot_index] = (map)[INTERNAL_reserve_old_slot_index]; \
+            }                                                           \
+                                                                        \
+            CONCATENATE(map, _controls) = INTERNAL_reserve_controls;    \
+            CONCATENATE(map, _keys) = INTERNAL_reserve_keys;            \
+            (map) = INTERNAL_reserve_values;                            \
+            CONCATENATE(map, _capacity) = INTERNAL_reserve_capacity;    \
+        }                                                               \
+    }                                                                   \
+    while (0)
+
+// NOTE(vlad): Sets 'out_slot_index' to the slot of the key or to -1 if there is no such key.
+#define hash_map_find(map, Key_Type, key, hash_function, keys_are_equal_function, out_slot_index) \
+    do                                                                  \
+    {                                                                   \
+        (out_slot_index) = -1;                                          \
+                                                                        \
+        if (CONCATENATE(map, _count) != 0)                              \
+        {                                                               \
+            const Key_Type INTERNAL_find_key = (key);                   \
+            const u64 INTERNAL_find_hash = hash_function(INTERNAL_find_key); \
+            const u8 INTERNAL_find_control = hash_map_get_control(INTERNAL_find_hash); \
+                                                                        \
+            for (Index INTERNAL_find_slot_index = hash_map_get_first_slot_index(INTERNAL_find_hash, CONCATENATE(map, _capacity)); \
+                 CONCATENATE(map, _controls)[INTERNAL_find_slot_index] != HASH_MAP_EMPTY_SLOT_CONTROL; \
+                 INTERNAL_find_slot_index = (INTERNAL_find_slot_index + 1) & (CONCATENATE(map, _capacity) - 1)) \
+            {                                                           \
+                if (CONCATENATE(map, _controls)[INTERNAL_find_slot_index] == INTERNAL_find_control \
+                    && keys_are_equal_function(CONCATENATE(map, _keys)[INTERNAL_find_slot_index], INTERNAL_find_key)) \
+                {                                                       \
+                    (out_slot_index) = INTERNAL_find_slot_index;        \
+                    break;                                              \
+                }                                                       \
+            }                                                           \
+        }                                                               \
+    }                                                                   \
+    while (0)
+
+// NOTE(vlad): Inserts the key or replaces the value if the key is already in the map.
+#define hash_map_insert(arena, map, Key_Type, Value_Type, key, value, hash_function, keys_are_equal_function) \
+    do                                                                  \
+    {                                                                   \
+        hash_map_reserve(arena, map, Key_Type, Value_Type, CONCATENATE(map, _count) + 1, hash_function); \
+                                                                        \
+        const Key_Type INTERNAL_insert_key = (key);                     \
+        const u64 INTERNAL_insert_hash = hash_function(INTERNAL_insert_key); \
+        const u8 INTERNAL_insert_control = hash_map_get_control(INTERNAL_insert_hash); \
+                                                                        \
+        Index INTERNAL_insert_slot_index = hash_map_get_first_slot_index(INTERNAL_insert_hash, CONCATENATE(map, _capacity)); \
+        while (CONCATENATE(map, _controls)[INTERNAL_insert_slot_index] != HASH_MAP_EMPTY_SLOT_CONTROL) \
+        {                                                               \
+            if (CONCATENATE(map, _controls)[INTERNAL_insert_slot_index] == INTERNAL_insert_control \
+                && keys_are_equal_function(CONCATENATE(map, _keys)[INTERNAL_insert_slot_index], INTERNAL_insert_key)) \
+            {                                                           \
+                break;                                                  \
+            }                                                           \
+                                                                        \
+            INTERNAL_insert_slot_index = (INTERNAL_insert_slot_index + 1) & (CONCATENATE(map, _capacity) - 1); \
+        }                                                               \
+                                                                        \
+        if (CONCATENATE(map, _controls)[INTERNAL_insert_slot_index] == HASH_MAP_EMPTY_SLOT_CONTROL) \
+        {                                                               \
+            CONCATENATE(map, _controls)[INTERNAL_insert_slot_index] = INTERNAL_insert_control; \
+            CONCATENATE(map, _keys)[INTERNAL_insert_slot_index] = INTERNAL_insert_key; \
+            CONCATENATE(map, _count) += 1;                              \
+        }                                                               \
+                                                                        \
+        (map)[INTERNAL_insert_slot_index] = (value);                    \
+    }                                                                   \
+    while (0)
+
+// NOTE(vlad): Hash functions for common key types.
+
+internal inline u64
+hash_u64(const u64 value)
+{
+    // NOTE(vlad): Finalizer of MurmurHash3, the top bits are used as the control byte,
+    //             so every bit of the key must affect them.
+    u64 hash = value;
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+internal inline u64
+hash_string(const String_View string)
+{
+    // NOTE(vlad): FNV-1a followed by a finalizer, identifiers are short.
+    u64 hash = 0xCBF29CE484222325ull;
+    for (Index i = 0;
+         i < string.length;
+         ++i)
+    {
+        hash ^= (u8)string.data[i];
+        hash *= 0x100000001B3ull;
+    }
+    return hash_u64(hash);
+}
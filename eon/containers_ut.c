@@ -31,6 +31,272 @@ test_stack(Test_Context* test_context)
     }
 }
 
+internal void
+test_array_grows_geometrically(Test_Context* test_context)
+{
+    struct Array
+    {
+        array(s32, values);
+    };
+    typedef struct Array Array;
+
+    enum { VALUES_COUNT = 1 << 14 };
+
+    Array array = {0};
+    Size moves_count = 0;
+
+    for (s32 value = 0;
+         value < VALUES_COUNT;
+         ++value)
+    {
+        const s32* values_before_append = array.values;
+        append_array(test_context->arena, array.values, s32, value);
+
+        if (array.values != values_before_append)
+        {
+            moves_count += 1;
+        }
+    }
+
+    ASSERT_EQUAL(array.values_count, VALUES_COUNT);
+    ASSERT_TRUE(array.values_capacity < 2 * VALUES_COUNT);
+
+    // NOTE(vlad): The array is moved at most once per doubling, with or without ASAN.
+    ASSERT_TRUE(moves_count <= 15);
+
+    for (s32 value = 0;
+         value < VALUES_COUNT;
+         ++value)
+    {
+        ASSERT_EQUAL(array.values[value], value);
+    }
+}
+
+internal void
+test_array_elements_are_appended_at_once(Test_Context* test_context)
+{
+    struct Array
+    {
+        array(s32, values);
+    };
+    typedef struct Array Array;
+
+    const s32 values[] = {1, 2, 3, 4, 5};
+
+    Array array = {0};
+    append_array(test_context->arena, array.values, s32, 0);
+    append_array_elements(test_context->arena, array.values, s32, values, 0);
+    append_array_elements(test_context->arena, array.values, s32, values, NUMBER_OF_STATIC_ARRAY_ELEMENTS(values));
+    append_array_elements(test_context->arena, array.values, s32, values + 3, 2);
+
+    const s32 expected_values[] = {0, 1, 2, 3, 4, 5, 4, 5};
+    ASSERT_EQUAL(array.values_count, NUMBER_OF_STATIC_ARRAY_ELEMENTS(expected_values));
+
+    for (Index i = 0;
+         i < array.values_count;
+         ++i)
+    {
+        ASSERT_EQUAL(array.values[i], expected_values[i]);
+    }
+}
+
+internal inline Bool
+s32_are_equal(const s32 lhs, const s32 rhs)
+{
+    return lhs == rhs;
+}
+
+internal inline u64
+hash_s32(const s32 value)
+{
+    return hash_u64((u64)value);
+}
+
+internal inline u64
+hash_s32_badly(const s32 value)
+{
+    // NOTE(vlad): Every key collides with every other key.
+    UNUSED(value);
+    return 42;
+}
+
+internal void
+test_hash_map(Test_Context* test_context)
+{
+    struct Map
+    {
+        hash_map(s32, s32, values);
+    };
+    typedef struct Map Map;
+
+    enum { VALUES_COUNT = 1000 };
+
+    // NOTE(vlad): Inserting and looking up.
+    {
+        Map map = {0};
+
+        Index slot_index = 0;
+        hash_map_find(map.values, s32, 10, hash_s32, s32_are_equal, slot_index);
+        ASSERT_EQUAL(slot_index, -1);
+
+        for (s32 key = 0;
+             key < VALUES_COUNT;
+             ++key)
+        {
+            hash_map_insert(test_context->arena, map.values, s32, s32, key, key * 10, hash_s32, s32_are_equal);
+        }
+
+        ASSERT_EQUAL(map.values_count, VALUES_COUNT);
+
+        for (s32 key = 0;
+             key < VALUES_COUNT;
+             ++key)
+        {
+            hash_map_find(map.values, s32, key, hash_s32, s32_are_equal, slot_index);
+            ASSERT_TRUE(slot_index != -1);
+            ASSERT_EQUAL(map.values_keys[slot_index], key);
+            ASSERT_EQUAL(map.values[slot_index], key * 10);
+        }
+
+        hash_map_find(map.values, s32, VALUES_COUNT, hash_s32, s32_are_equal, slot_index);
+        ASSERT_EQUAL(slot_index, -1);
+
+        hash_map_find(map.values, s32, -1, hash_s32, s32_are_equal, slot_index);
+        ASSERT_EQUAL(slot_index, -1);
+    }
+
+    // NOTE(vlad): Replacing values.
+    {
+        Map map = {0};
+
+        hash_map_insert(test_context->arena, map.values, s32, s32, 1, 10, hash_s32, s32_are_equal);
+        hash_map_insert(test_context->arena, map.values, s32, s32, 1, 20, hash_s32, s32_are_equal);
+
+        ASSERT_EQUAL(map.values_count, 1);
+
+        Index slot_index = 0;
+        hash_map_find(map.values, s32, 1, hash_s32, s32_are_equal, slot_index);
+        ASSERT_TRUE(slot_index != -1);
+        ASSERT_EQUAL(map.values[slot_index], 20);
+    }
+
+    // NOTE(vlad): Reserving and iterating.
+    {
+        Map map = {0};
+
+        hash_map_reserve(test_context->arena, map.values, s32, s32, VALUES_COUNT, hash_s32);
+        const s32* values = map.values;
+        const Size capacity = map.values_capacity;
+        ASSERT_TRUE(capacity >= VALUES_COUNT);
+
+        s64 expected_keys_sum = 0;
+        for (s32 key = 0;
+             key < VALUES_COUNT;
+             ++key)
+        {
+            hash_map_insert(test_context->arena, map.values, s32, s32, key, -key, hash_s32, s32_are_equal);
+            expected_keys_sum += key;
+        }
+
+        ASSERT_TRUE(map.values == values);
+        ASSERT_EQUAL(map.values_capacity, capacity);
+
+        Size occupied_slots_count = 0;
+        s64 keys_sum = 0;
+        for (Index slot_index = 0;
+             slot_index < map.values_capacity;
+             ++slot_index)
+        {
+            if (hash_map_slot_is_occupied(map.values, slot_index))
+            {
+                occupied_slots_count += 1;
+                keys_sum += map.values_keys[slot_index];
+                ASSERT_EQUAL(map.values[slot_index], -map.values_keys[slot_index]);
+            }
+        }
+
+        ASSERT_EQUAL(occupied_slots_count, VALUES_COUNT);
+        ASSERT_EQUAL(keys_sum, expected_keys_sum);
+    }
+
+    // NOTE(vlad): Colliding keys.
+    {
+        Map map = {0};
+
+        for (s32 key = 0;
+             key < 100;
+             ++key)
+        {
+            hash_map_insert(test_context->arena, map.values, s32, s32, key, key + 1, hash_s32_badly, s32_are_equal);
+        }
+
+        for (s32 key = 0;
+             key < 100;
+             ++key)
+        {
+            Index slot_index = 0;
+            hash_map_find(map.values, s32, key, hash_s32_badly, s32_are_equal, slot_index);
+            ASSERT_TRUE(slot_index != -1);
+            ASSERT_EQUAL(map.values[slot_index], key + 1);
+        }
+
+        Index slot_index = 0;
+        hash_map_find(map.values, s32, 100, hash_s32_badly, s32_are_equal, slot_index);
+        ASSERT_EQUAL(slot_index, -1);
+    }
+}
+
+internal void
+test_hash_map_with_string_keys(Test_Context* test_context)
+{
+    struct Map
+    {
+        hash_map(String_View, Index, indices);
+    };
+    typedef struct Map Map;
+
+    const String_View names[] = {
+        string_view("foo"),
+        string_view("bar"),
+        string_view("baz"),
+        string_view(""),
+        string_view("a_very_long_identifier_that_does_not_fit_in_a_couple_of_words"),
+    };
+    const Size names_count = size_of(names) / size_of(names[0]);
+
+    Map map = {0};
+
+    for (Index name_index = 0;
+         name_index < names_count;
+         ++name_index)
+    {
+        hash_map_insert(test_context->arena, map.indices, String_View, Index, names[name_index], name_index, hash_string, strings_are_equal);
+    }
+
+    ASSERT_EQUAL(map.indices_count, names_count);
+
+    for (Index name_index = 0;
+         name_index < names_count;
+         ++name_index)
+    {
+        // NOTE(vlad): Keys are compared by value, not by pointer.
+        const String copy = copy_string(test_context->arena, names[name_index]);
+
+        Index slot_index = 0;
+        hash_map_find(map.indices, String_View, string_view(copy), hash_string, strings_are_equal, slot_index);
+        ASSERT_TRUE(slot_index != -1);
+        ASSERT_EQUAL(map.indices[slot_index], name_index);
+    }
+
+    Index slot_index = 0;
+    hash_map_find(map.indices, String_View, string_view("fo"), hash_string, strings_are_equal, slot_index);
+    ASSERT_EQUAL(slot_index, -1);
+}
+
 REGISTER_TESTS(
-    test_stack
+    test_stack,
+    test_array_grows_geometrically,
+    test_array_elements_are_appended_at_once,
+    test_hash_map,
+    test_hash_map_with_string_keys
 )
@@ -29,6 +29,10 @@ deinit_io_state(void)
 internal void
 init_io_state(const Size initial_arena_size)
 {
+    // NOTE(vlad): Selected and cached while there is only one thread.
+    select_best_memory_primitives();
+    platform_get_huge_page_size();
+
     global_io_state.arena = create_arena("IO", initial_arena_size, KiB(0));
     global_io_state.stdout_buffer = as_bytes(platform_reserve_memory(STDOUT_BUFFER_SIZE));
     global_io_state.stdout_buffer_index = 0;
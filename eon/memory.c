@@ -7,16 +7,471 @@
 #define ARENA_HEADER_SIZE (size_of(Arena))
 #define ARENA_ALIGNMENT (size_of(Byte*))
 
+// NOTE(vlad): Memory primitives.
+//
+//             Sizes up to MEMORY_SMALL_SIZE_THRESHOLD are handled inline with a couple of
+//             possibly overlapping loads and stores. Everything else goes through
+//             'global_memory_primitives', the vector loops there store everything but
+//             the first and the last vector to aligned addresses, and those two are
+//             stored unaligned. All loads happen before the stores they could be clobbered
+//             by, so the same loops are used to move overlapping memory.
+
+#define MEMORY_SMALL_SIZE_THRESHOLD 16
+
+#if COMPILER_GCC || COMPILER_CLANG
+typedef u64 __attribute__((aligned(1), may_alias)) Unaligned_u64;
+typedef u32 __attribute__((aligned(1), may_alias)) Unaligned_u32;
+#elif COMPILER_MSVC
+// NOTE(vlad): MSVC doesn't do type-based alias analysis and every architecture
+//             we support is fine with unaligned loads and stores.
+typedef u64 Unaligned_u64;
+typedef u32 Unaligned_u32;
+#else
+#    error Failed to define unaligned integer types.
+#endif
+
+internal inline void
+copy_small_memory(Byte* to,
+                  const Byte* from,
+                  const Size number_of_bytes)
+{
+    ASSERT(number_of_bytes <= 16);
+
+    if (number_of_bytes >= 8)
+    {
+        const u64 head = *(const Unaligned_u64*)from;
+        const u64 tail = *(const Unaligned_u64*)(from + number_of_bytes - 8);
+        *(Unaligned_u64*)to = head;
+        *(Unaligned_u64*)(to + number_of_bytes - 8) = tail;
+    }
+    else if (number_of_bytes >= 4)
+    {
+        const u32 head = *(const Unaligned_u32*)from;
+        const u32 tail = *(const Unaligned_u32*)(from + number_of_bytes - 4);
+        *(Unaligned_u32*)to = head;
+        *(Unaligned_u32*)(to + number_of_bytes - 4) = tail;
+    }
+    else if (number_of_bytes > 0)
+    {
+        const Byte first = from[0];
+        const Byte middle = from[number_of_bytes / 2];
+        const Byte last = from[number_of_bytes - 1];
+        to[0] = first;
+        to[number_of_bytes / 2] = middle;
+        to[number_of_bytes - 1] = last;
+    }
+}
+
+internal inline void
+fill_small_memory_with_zeros(Byte* memory, const Size number_of_bytes)
+{
+    ASSERT(number_of_bytes <= 16);
+
+    if (number_of_bytes >= 8)
+    {
+        *(Unaligned_u64*)memory = 0;
+        *(Unaligned_u64*)(memory + number_of_bytes - 8) = 0;
+    }
+    else if (number_of_bytes >= 4)
+    {
+        *(Unaligned_u32*)memory = 0;
+        *(Unaligned_u32*)(memory + number_of_bytes - 4) = 0;
+    }
+    else if (number_of_bytes > 0)
+    {
+        memory[0] = 0;
+        memory[number_of_bytes / 2] = 0;
+        memory[number_of_bytes - 1] = 0;
+    }
+}
+
+// NOTE(vlad): Defines 'copy_memory_<suffix>', 'copy_memory_forward_<suffix>',
+//             'copy_memory_backward_<suffix>' and 'fill_memory_with_zeros_<suffix>'
+//             for 'Vector' of 'WIDTH' bytes. All of them expect at least 'WIDTH' bytes.
+#define DEFINE_MEMORY_PRIMITIVES(suffix, ATTRIBUTES, Vector, WIDTH,                 \
+                                 LOAD, STORE, STORE_ALIGNED, STREAM, FENCE, ZERO)   \
+    ATTRIBUTES internal inline void                                                 \
+    INTERNAL_copy_memory_forward_##suffix(Byte* to,                                 \
+                                          const Byte* from,                         \
+                                          const Size number_of_bytes,               \
+                                          const Bool use_non_temporal_stores)       \
+    {                                                                               \
+        ASSERT(number_of_bytes >= (WIDTH));                                         \
+                                                                                    \
+        const Vector head = LOAD(from);                                             \
+        const Vector tail = LOAD(from + number_of_bytes - (WIDTH));                 \
+                                                                                    \
+        Index i = (WIDTH) - (Index)((USize)to & ((WIDTH) - 1));                     \
+                                                                                    \
+        if (use_non_temporal_stores)                                                \
+        {                                                                           \
+            for (; number_of_bytes - i > 4 * (WIDTH); i += 4 * (WIDTH))             \
+            {                                                                       \
+                const Vector v0 = LOAD(from + i);                                   \
+                const Vector v1 = LOAD(from + i + (WIDTH));                         \
+                const Vector v2 = LOAD(from + i + 2 * (WIDTH));                     \
+                const Vector v3 = LOAD(from + i + 3 * (WIDTH));                     \
+                STREAM(to + i, v0);                                                 \
+                STREAM(to + i + (WIDTH), v1);                                       \
+                STREAM(to + i + 2 * (WIDTH), v2);                                   \
+                STREAM(to + i + 3 * (WIDTH), v3);                                   \
+            }                                                                       \
+            FENCE();                                                                \
+        }                                                                           \
+                                                                                    \
+        for (; number_of_bytes - i > 4 * (WIDTH); i += 4 * (WIDTH))                 \
+        {                                                                           \
+            const Vector v0 = LOAD(from + i);                                       \
+            const Vector v1 = LOAD(from + i + (WIDTH));                             \
+            const Vector v2 = LOAD(from + i + 2 * (WIDTH));                         \
+            const Vector v3 = LOAD(from + i + 3 * (WIDTH));                         \
+            STORE_ALIGNED(to + i, v0);                                              \
+            STORE_ALIGNED(to + i + (WIDTH), v1);                                    \
+            STORE_ALIGNED(to + i + 2 * (WIDTH), v2);                                \
+            STORE_ALIGNED(to + i + 3 * (WIDTH), v3);                                \
+        }                                                                           \
+                                                                                    \
+        for (; number_of_bytes - i > (WIDTH); i += (WIDTH))                         \
+        {                                                                           \
+            const Vector v = LOAD(from + i);                                        \
+            STORE_ALIGNED(to + i, v);                                               \
+        }                                                                           \
+                                                                                    \
+        STORE(to, head);                                                            \
+        STORE(to + number_of_bytes - (WIDTH), tail);                                \
+    }                                                                               \
+                                                                                    \
+    ATTRIBUTES internal void                                                        \
+    copy_memory_##suffix(Byte* to, const Byte* from, const Size number_of_bytes)    \
+    {                                                                               \
+        const Bool use_non_temporal_stores =                                        \
+            number_of_bytes >= MEMORY_NON_TEMPORAL_STORES_THRESHOLD;                \
+        INTERNAL_copy_memory_forward_##suffix(to, from, number_of_bytes,            \
+                                              use_non_temporal_stores);             \
+    }                                                                               \
+                                                                                    \
+    ATTRIBUTES internal void                                                        \
+    copy_memory_forward_##suffix(Byte* to,                                          \
+                                 const Byte* from,                                  \
+                                 const Size number_of_bytes)                        \
+    {                                                                               \
+        INTERNAL_copy_memory_forward_##suffix(to, from, number_of_bytes, false);    \
+    }                                                                               \
+                                                                                    \
+    ATTRIBUTES internal void                                                        \
+    copy_memory_backward_##suffix(Byte* to,                                         \
+                                  const Byte* from,                                 \
+                                  const Size number_of_bytes)                       \
+    {                                                                               \
+        ASSERT(number_of_bytes >= (WIDTH));                                         \
+                                                                                    \
+        const Vector head = LOAD(from);                                             \
+        const Vector tail = LOAD(from + number_of_bytes - (WIDTH));                 \
+                                                                                    \
+        Index i = number_of_bytes - (Index)((USize)(to + number_of_bytes) & ((WIDTH) - 1)); \
+                                                                                    \
+        while (i > 4 * (WIDTH))                                                     \
+        {                                                                           \
+            i -= 4 * (WIDTH);                                                       \
+            const Vector v0 = LOAD(from + i);                                       \
+            const Vector v1 = LOAD(from + i + (WIDTH));                             \
+            const Vector v2 = LOAD(from + i + 2 * (WIDTH));                         \
+            const Vector v3 = LOAD(from + i + 3 * (WIDTH));                         \
+            STORE_ALIGNED(to + i + 3 * (WIDTH), v3);                                \
+            STORE_ALIGNED(to + i + 2 * (WIDTH), v2);                                \
+            STORE_ALIGNED(to + i + (WIDTH), v1);                                    \
+            STORE_ALIGNED(to + i, v0);                                              \
+        }                                                                           \
+                                                                                    \
+        while (i > (WIDTH))                                                         \
+        {                                                                           \
+            i -= (WIDTH);                                                           \
+            const Vector v = LOAD(from + i);                                        \
+            STORE_ALIGNED(to + i, v);                                               \
+        }                                                                           \
+                                                                                    \
+        STORE(to + number_of_bytes - (WIDTH), tail);                                \
+        STORE(to, head);                                                            \
+    }                                                                               \
+                                                                                    \
+    ATTRIBUTES internal void                                                        \
+    fill_memory_with_zeros_##suffix(Byte* memory, const Size number_of_bytes)       \
+    {                                                                               \
+        ASSERT(number_of_bytes >= (WIDTH));                                         \
+                                                                                    \
+        const Vector zero = ZERO();                                                 \
+                                                                                    \
+        STORE(memory, zero);                                                        \
+        STORE(memory + number_of_bytes - (WIDTH), zero);                            \
+                                                                                    \
+        Index i = (WIDTH) - (Index)((USize)memory & ((WIDTH) - 1));                 \
+                                                                                    \
+        if (number_of_bytes >= MEMORY_NON_TEMPORAL_STORES_THRESHOLD)                \
+        {                                                                           \
+            for (; number_of_bytes - i > 4 * (WIDTH); i += 4 * (WIDTH))             \
+            {                                                                       \
+                STREAM(memory + i, zero);                                           \
+                STREAM(memory + i + (WIDTH), zero);                                 \
+                STREAM(memory + i + 2 * (WIDTH), zero);                             \
+                STREAM(memory + i + 3 * (WIDTH), zero);                             \
+            }                                                                       \
+            FENCE();                                                                \
+        }                                                                           \
+                                                                                    \
+        for (; number_of_bytes - i > 4 * (WIDTH); i += 4 * (WIDTH))                 \
+        {                                                                           \
+            STORE_ALIGNED(memory + i, zero);                                        \
+            STORE_ALIGNED(memory + i + (WIDTH), zero);                              \
+            STORE_ALIGNED(memory + i + 2 * (WIDTH), zero);                          \
+            STORE_ALIGNED(memory + i + 3 * (WIDTH), zero);                          \
+        }                                                                           \
+                                                                                    \
+        for (; number_of_bytes - i > (WIDTH); i += (WIDTH))                         \
+        {                                                                           \
+            STORE_ALIGNED(memory + i, zero);                                        \
+        }                                                                           \
+    }
+
+// NOTE(vlad): Word-wide implementation, used on architectures without vector primitives.
+#define WORDS_LOAD(pointer) (*(const Unaligned_u64*)(pointer))
+#define WORDS_STORE(pointer, value) (*(Unaligned_u64*)(pointer) = (value))
+#define WORDS_FENCE()
+#define WORDS_ZERO() ((u64)0)
+
+DEFINE_MEMORY_PRIMITIVES(words, maybe_unused, u64, 8,
+                         WORDS_LOAD, WORDS_STORE, WORDS_STORE, WORDS_STORE, WORDS_FENCE, WORDS_ZERO)
+
+#if ARCH_X86_64
+#    include <immintrin.h>
+
+#    if COMPILER_GCC || COMPILER_CLANG
+#        define AVX2_TARGET __attribute__((target("avx2")))
+#    elif COMPILER_MSVC
+#        include <intrin.h> // NOTE(vlad): For '__cpuidex' and '_xgetbv'.
+#        define AVX2_TARGET
+#    endif
+
+// NOTE(vlad): SSE2 is a part of the x86-64 baseline, so it's always available.
+#    define SSE2_LOAD(pointer) _mm_loadu_si128((const __m128i*)(pointer))
+#    define SSE2_STORE(pointer, value) _mm_storeu_si128((__m128i*)(pointer), (value))
+#    define SSE2_STORE_ALIGNED(pointer, value) _mm_store_si128((__m128i*)(pointer), (value))
+#    define SSE2_STREAM(pointer, value) _mm_stream_si128((__m128i*)(pointer), (value))
+#    define SSE2_FENCE() _mm_sfence()
+#    define SSE2_ZERO() _mm_setzero_si128()
+
+DEFINE_MEMORY_PRIMITIVES(sse2, , __m128i, 16,
+                         SSE2_LOAD, SSE2_STORE, SSE2_STORE_ALIGNED, SSE2_STREAM, SSE2_FENCE, SSE2_ZERO)
+
+#    define AVX2_LOAD(pointer) _mm256_loadu_si256((const __m256i*)(pointer))
+#    define AVX2_STORE(pointer, value) _mm256_storeu_si256((__m256i*)(pointer), (value))
+#    define AVX2_STORE_ALIGNED(pointer, value) _mm256_store_si256((__m256i*)(pointer), (value))
+#    define AVX2_STREAM(pointer, value) _mm256_stream_si256((__m256i*)(pointer), (value))
+#    define AVX2_FENCE() _mm_sfence()
+#    define AVX2_ZERO() _mm256_setzero_si256()
+
+DEFINE_MEMORY_PRIMITIVES(avx2_wide, AVX2_TARGET, __m256i, 32,
+                         AVX2_LOAD, AVX2_STORE, AVX2_STORE_ALIGNED, AVX2_STREAM, AVX2_FENCE, AVX2_ZERO)
+
+// NOTE(vlad): The small path covers everything up to 16 bytes, which is less than
+//             a single AVX2 vector, so anything between 16 and 32 bytes goes to SSE2.
+//             Also we don't want the 'vzeroupper' penalty for these copies anyway.
+AVX2_TARGET internal void
+copy_memory_avx2(Byte* to, const Byte* from, const Size number_of_bytes)
+{
+    if (number_of_bytes < 32)
+    {
+        copy_memory_forward_sse2(to, from, number_of_bytes);
+    }
+    else
+    {
+        copy_memory_avx2_wide(to, from, number_of_bytes);
+    }
+}
+
+AVX2_TARGET internal void
+copy_memory_forward_avx2(Byte* to, const Byte* from, const Size number_of_bytes)
+{
+    if (number_of_bytes < 32)
+    {
+        copy_memory_forward_sse2(to, from, number_of_bytes);
+    }
+    else
+    {
+        copy_memory_forward_avx2_wide(to, from, number_of_bytes);
+    }
+}
+
+AVX2_TARGET internal void
+copy_memory_backward_avx2(Byte* to, const Byte* from, const Size number_of_bytes)
+{
+    if (number_of_bytes < 32)
+    {
+        copy_memory_backward_sse2(to, from, number_of_bytes);
+    }
+    else
+    {
+        copy_memory_backward_avx2_wide(to, from, number_of_bytes);
+    }
+}
+
+AVX2_TARGET internal void
+fill_memory_with_zeros_avx2(Byte* memory, const Size number_of_bytes)
+{
+    if (number_of_bytes < 32)
+    {
+        fill_memory_with_zeros_sse2(memory, number_of_bytes);
+    }
+    else
+    {
+        fill_memory_with_zeros_avx2_wide(memory, number_of_bytes);
+    }
+}
+
+internal Bool
+cpu_supports_avx2(void)
+{
+#    if COMPILER_GCC || COMPILER_CLANG
+    // NOTE(vlad): This also checks that the OS saves YMM registers on context switches.
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#    elif COMPILER_MSVC
+    int registers[4] = {0};
+
+    __cpuid(registers, 0);
+    if (registers[0] < 7)
+    {
+        return false;
+    }
+
+    __cpuid(registers, 1);
+    const Bool os_saves_ymm_registers = (registers[2] & (1 << 27)) != 0 // NOTE(vlad): OSXSAVE.
+        && (_xgetbv(0) & 0x6) == 0x6;
+    if (!os_saves_ymm_registers)
+    {
+        return false;
+    }
+
+    __cpuidex(registers, 7, 0);
+    return (registers[1] & (1 << 5)) != 0;
+#    endif
+}
+#elif ARCH_ARM64
+#    include <arm_neon.h>
+
+// NOTE(vlad): NEON is a part of the AArch64 baseline. There is no intrinsic for non-temporal
+//             stores ('stnp'), so large copies use regular stores.
+#    define NEON_LOAD(pointer) vld1q_u8((const u8*)(pointer))
+#    define NEON_STORE(pointer, value) vst1q_u8((u8*)(pointer), (value))
+#    define NEON_FENCE()
+#    define NEON_ZERO() vdupq_n_u8(0)
+
+DEFINE_MEMORY_PRIMITIVES(neon, , uint8x16_t, 16,
+                         NEON_LOAD, NEON_STORE, NEON_STORE, NEON_STORE, NEON_FENCE, NEON_ZERO)
+#endif
+
+#define MEMORY_PRIMITIVES(name, suffix)                 \
+    (Memory_Primitives)                                 \
+    {                                                   \
+        string_view(name),                              \
+        copy_memory_##suffix,                           \
+        copy_memory_forward_##suffix,                   \
+        copy_memory_backward_##suffix,                  \
+        fill_memory_with_zeros_##suffix,                \
+    }
+
+internal Size
+get_supported_memory_primitives(Memory_Primitives primitives[MAX_NUMBER_OF_MEMORY_PRIMITIVES])
+{
+    Size count = 0;
+
+#if ARCH_X86_64
+    if (cpu_supports_avx2())
+    {
+        primitives[count++] = MEMORY_PRIMITIVES("avx2", avx2);
+    }
+    primitives[count++] = MEMORY_PRIMITIVES("sse2", sse2);
+#elif ARCH_ARM64
+    primitives[count++] = MEMORY_PRIMITIVES("neon", neon);
+#endif
+
+    primitives[count++] = MEMORY_PRIMITIVES("words", words);
+
+    ASSERT(count <= MAX_NUMBER_OF_MEMORY_PRIMITIVES);
+    return count;
+}
+
+internal void copy_memory_and_select_primitives(Byte* to, const Byte* from, Size number_of_bytes);
+internal void copy_memory_forward_and_select_primitives(Byte* to, const Byte* from, Size number_of_bytes);
+internal void copy_memory_backward_and_select_primitives(Byte* to, const Byte* from, Size number_of_bytes);
+internal void fill_memory_with_zeros_and_select_primitives(Byte* memory, Size number_of_bytes);
+
+// NOTE(vlad): Starts with functions that select the best primitives on the first call
+//             and forward it to them. They are only there for the code that runs before
+//             'init_io_state', which selects the primitives while there is only one thread,
+//             so the assignment never races with worker threads.
+global_variable Memory_Primitives global_memory_primitives = {
+    .name = {0},
+    .copy = copy_memory_and_select_primitives,
+    .copy_forward = copy_memory_forward_and_select_primitives,
+    .copy_backward = copy_memory_backward_and_select_primitives,
+    .fill_memory_with_zeros = fill_memory_with_zeros_and_select_primitives,
+};
+
+internal void
+use_memory_primitives(const Memory_Primitives* primitives)
+{
+    global_memory_primitives = *primitives;
+}
+
+internal void
+select_best_memory_primitives(void)
+{
+    Memory_Primitives primitives[MAX_NUMBER_OF_MEMORY_PRIMITIVES];
+    const Size count = get_supported_memory_primitives(primitives);
+    ASSERT(count > 0);
+    use_memory_primitives(&primitives[0]);
+}
+
+internal void
+copy_memory_and_select_primitives(Byte* to, const Byte* from, Size number_of_bytes)
+{
+    select_best_memory_primitives();
+    global_memory_primitives.copy(to, from, number_of_bytes);
+}
+
+internal void
+copy_memory_forward_and_select_primitives(Byte* to, const Byte* from, Size number_of_bytes)
+{
+    select_best_memory_primitives();
+    global_memory_primitives.copy_forward(to, from, number_of_bytes);
+}
+
+internal void
+copy_memory_backward_and_select_primitives(Byte* to, const Byte* from, Size number_of_bytes)
+{
+    select_best_memory_primitives();
+    global_memory_primitives.copy_backward(to, from, number_of_bytes);
+}
+
+internal void
+fill_memory_with_zeros_and_select_primitives(Byte* memory, Size number_of_bytes)
+{
+    select_best_memory_primitives();
+    global_memory_primitives.fill_memory_with_zeros(memory, number_of_bytes);
+}
+
 internal inline void
 copy_memory(Byte* restrict to,
             const Byte* restrict from,
             const Size number_of_bytes)
 {
-    for (Index i = 0;
-         i < number_of_bytes;
-         ++i)
+    if (number_of_bytes <= MEMORY_SMALL_SIZE_THRESHOLD)
+    {
+        copy_small_memory(to, from, number_of_bytes);
+    }
+    else
     {
-        to[i] = from[i];
+        global_memory_primitives.copy(to, from, number_of_bytes);
     }
 }
 
@@ -25,31 +480,37 @@ move_memory(Byte* to,
             const Byte* from,
             const Size number_of_bytes)
 {
-    if (to > from && to - from < number_of_bytes)
+    if (number_of_bytes <= MEMORY_SMALL_SIZE_THRESHOLD)
+    {
+        // NOTE(vlad): Loads everything before storing, so it's fine if regions overlap.
+        copy_small_memory(to, from, number_of_bytes);
+    }
+    else if (to > from && to - from < number_of_bytes)
     {
         // NOTE(vlad): 'to's suffix overlaps with 'from's prefix,
         //             moving memory in reverse order.
-        for (Index i = number_of_bytes - 1;
-             i >= 0;
-             --i)
-        {
-            to[i] = from[i];
-        }
+        global_memory_primitives.copy_backward(to, from, number_of_bytes);
+    }
+    else if (to < from && from - to < number_of_bytes)
+    {
+        global_memory_primitives.copy_forward(to, from, number_of_bytes);
     }
     else
     {
-        copy_memory(to, from, number_of_bytes);
+        global_memory_primitives.copy(to, from, number_of_bytes);
     }
 }
 
 internal inline void
 fill_memory_with_zeros(Byte* memory, const Size number_of_bytes)
 {
-    for (Size i = 0;
-         i < number_of_bytes;
-         ++i)
+    if (number_of_bytes <= MEMORY_SMALL_SIZE_THRESHOLD)
+    {
+        fill_small_memory_with_zeros(memory, number_of_bytes);
+    }
+    else
     {
-        memory[i] = (Byte)0;
+        global_memory_primitives.fill_memory_with_zeros(memory, number_of_bytes);
     }
 }
 
@@ -69,48 +530,106 @@ arena_print_error_message_impl(const Arena* arena,
     arena_print_error_message_impl(arena, string_view(message))
 
 #if ASAN_ENABLED
-#    define ARENA_REDZONE_SIZE_IN_PAGES 1
+// NOTE(vlad): Redzones are shared between neighbouring allocations: every allocation is
+//             followed by a redzone, which also guards the next allocation from underruns.
+//             The first allocation in a block is guarded by an additional leading redzone.
+//             Redzones are multiples of ASAN's shadow granularity (8 bytes), the bytes
+//             between the end of an allocation and the next granule are poisoned too.
+#    define ARENA_REDZONE_SIZE 32
+#    define ARENA_PAGE_SIZED_REDZONE_SIZE_IN_PAGES 1
 
-internal void
-ARENA_ADD_REDZONE(Arena* arena)
+STATIC_ASSERT(ARENA_REDZONE_SIZE % 8 == 0);
+
+internal inline Size
+arena_get_redzone_size(const Arena* arena)
 {
-    const Size aligned_memory_offset = ALIGN_UP_TO_POW2(arena->free_memory_offset,
+    if (arena->flags & ARENA_FLAG_PAGE_SIZED_REDZONES)
+    {
+        return ARENA_PAGE_SIZED_REDZONE_SIZE_IN_PAGES * platform_get_page_size();
+    }
+
+    return ARENA_REDZONE_SIZE;
+}
+
+// NOTE(vlad): Returns the size of the added redzone.
+internal Size
+ARENA_ADD_REDZONE(const Arena* arena, Arena* block)
+{
+    const Size aligned_memory_offset = ALIGN_UP_TO_POW2(block->free_memory_offset,
                                                         ARENA_ALIGNMENT);
-    const Size redzone_size = ARENA_REDZONE_SIZE_IN_PAGES * platform_get_page_size();
+    const Size redzone_size = arena_get_redzone_size(arena);
     const Size free_memory_offset_after_allocation = aligned_memory_offset + redzone_size;
 
-    if (free_memory_offset_after_allocation > arena->reserved_bytes_count)
+    if (free_memory_offset_after_allocation > block->reserved_bytes_count)
     {
-        arena_print_error_message(arena, "Failed to add redzone for ASAN: out of memory.");
+        arena_print_error_message(block, "Failed to add redzone for ASAN: out of memory.");
         FAIL("Failed to add redzone for ASAN: out of memory");
     }
 
-    // XXX(vlad): Do we need to commit the redzone's memory here?
+    // NOTE(vlad): Poisoning memory doesn't touch it, so the redzone's memory doesn't
+    //             have to be committed.
+    Byte* redzone = as_bytes(block) + block->free_memory_offset;
+    ASAN_POISON_MEMORY_REGION(redzone, free_memory_offset_after_allocation - block->free_memory_offset);
 
-    Byte* redzone = as_bytes(arena) + aligned_memory_offset;
-    arena->free_memory_offset = free_memory_offset_after_allocation;
+    block->free_memory_offset = free_memory_offset_after_allocation;
 
-    ASAN_POISON_MEMORY_REGION(redzone, redzone_size);
+    return redzone_size;
 }
 
 #else
-#    define ARENA_ADD_REDZONE(arena)
+internal inline Size
+arena_get_redzone_size(const Arena* arena)
+{
+    UNUSED(arena);
+    return 0;
+}
+
+#    define ARENA_ADD_REDZONE(arena, block) 0
 #endif
 
 maybe_unused internal Arena*
 INTERNAL_create_arena(const String_View name,
                       Size number_of_bytes_to_reserve,
-                      Size number_of_bytes_to_commit)
+                      Size number_of_bytes_to_commit,
+                      const Arena_Flags flags)
 {
     // XXX(vlad): Reserve 'number_of_bytes_to_commit' instead?
     ASSERT(number_of_bytes_to_reserve >= number_of_bytes_to_commit);
 
-    const Size page_size = platform_get_page_size();
+    Arena* arena = NULL;
+    Size commit_granularity = platform_get_page_size();
+
+    // NOTE(vlad): Huge pages are at least 2 MiB everywhere, so not asking the OS about
+    //             their size for smaller arenas.
+    if ((flags & ARENA_FLAG_HUGE_PAGES) && number_of_bytes_to_reserve >= MiB(2))
+    {
+        const Size huge_page_size = platform_get_huge_page_size();
+
+        if (huge_page_size != 0 && number_of_bytes_to_reserve >= huge_page_size)
+        {
+            // NOTE(vlad): The header takes a bit of the first huge page, otherwise a request of
+            //             exactly N huge pages would reserve N + 1 of them.
+            const Size number_of_bytes_to_reserve_with_huge_pages =
+                ALIGN_UP_TO_POW2(number_of_bytes_to_reserve, huge_page_size);
+
+            arena = (Arena*) platform_reserve_memory_with_huge_pages(number_of_bytes_to_reserve_with_huge_pages,
+                                                                     huge_page_size);
+            if (arena != NULL)
+            {
+                number_of_bytes_to_reserve = number_of_bytes_to_reserve_with_huge_pages;
+                commit_granularity = huge_page_size;
+            }
+        }
+    }
+
+    if (arena == NULL)
+    {
+        number_of_bytes_to_reserve = ALIGN_UP_TO_POW2(number_of_bytes_to_reserve + ARENA_HEADER_SIZE, commit_granularity);
+        arena = (Arena*) platform_reserve_memory(number_of_bytes_to_reserve);
+    }
 
-    number_of_bytes_to_reserve = ALIGN_UP_TO_POW2(number_of_bytes_to_reserve + ARENA_HEADER_SIZE, page_size);
-    number_of_bytes_to_commit = ALIGN_UP_TO_POW2(number_of_bytes_to_commit + ARENA_HEADER_SIZE, page_size);
+    number_of_bytes_to_commit = ALIGN_UP_TO_POW2(number_of_bytes_to_commit + ARENA_HEADER_SIZE, commit_granularity);
 
-    Arena* arena = (Arena*) platform_reserve_memory(number_of_bytes_to_reserve);
     if (arena == NULL)
     {
         print_message_directly_to_stdout("Cannot create arena '");
@@ -119,6 +638,9 @@ INTERNAL_create_arena(const String_View name,
         return NULL;
     }
 
+    // NOTE(vlad): The OS may give us back the memory of a previously released block
+    //             and its shadow memory is still poisoned, so unpoisoning the header.
+    ASAN_UNPOISON_MEMORY_REGION(as_bytes(arena), ARENA_HEADER_SIZE);
     ASAN_POISON_MEMORY_REGION(as_bytes(arena) + ARENA_HEADER_SIZE,
                               number_of_bytes_to_reserve - ARENA_HEADER_SIZE);
 
@@ -130,22 +652,138 @@ INTERNAL_create_arena(const String_View name,
 
     arena->name = name;
 
+    arena->current_block = arena;
+    arena->previous_block = NULL;
+
+    arena->base_position = 0;
     arena->reserved_bytes_count = number_of_bytes_to_reserve;
 
     arena->free_memory_offset = ARENA_HEADER_SIZE;
     arena->committed_memory_offset = number_of_bytes_to_commit;
+    arena->commit_granularity = commit_granularity;
+
+    arena->flags = flags;
+    arena->peak_position = ARENA_HEADER_SIZE;
+    arena->high_water_mark = 0;
+
+    arena->page_counters = (Arena_Page_Counters){0};
+    arena->page_counters.commits_count = 1;
+    arena->page_counters.committed_bytes_count = number_of_bytes_to_commit;
+
+    arena->statistics = (Arena_Statistics){0};
 
     return arena;
 }
 
-maybe_unused internal void
-destroy_arena(Arena* arena)
+internal inline void
+arena_release_block(Arena* block)
 {
     // TODO(vlad): Move this memory to a quarantine in asan is enabled?
     //             This would prevent EOF in situations when the OS will
     //             give us back released memory.
     //             @tag(asan)
-    platform_release_memory(as_bytes(arena), arena->reserved_bytes_count);
+    platform_release_memory(as_bytes(block), block->reserved_bytes_count);
+}
+
+internal inline void
+arena_release_chained_block(Arena* arena, Arena* block)
+{
+    ASSERT(block != arena);
+
+    arena->page_counters.decommits_count += 1;
+    arena->page_counters.decommitted_bytes_count += block->committed_memory_offset;
+
+    arena_release_block(block);
+}
+
+maybe_unused internal void
+destroy_arena(Arena* arena)
+{
+    Arena* block = arena->current_block;
+    while (block != NULL)
+    {
+        Arena* previous_block = block->previous_block;
+        arena_release_block(block);
+        block = previous_block;
+    }
+}
+
+internal inline Bool
+arena_block_can_fit(const Arena* arena, const Arena* block, const Size number_of_bytes)
+{
+    // NOTE(vlad): Being conservative here: the leading redzone is only needed for the first
+    //             allocation in a block and the trailing one may need up to 'ARENA_ALIGNMENT'
+    //             bytes of padding after the allocation.
+    const Size required_number_of_bytes = 2 * arena_get_redzone_size(arena) + number_of_bytes + ARENA_ALIGNMENT;
+    const Size aligned_memory_offset = ALIGN_UP_TO_POW2(block->free_memory_offset, ARENA_ALIGNMENT);
+    return aligned_memory_offset + required_number_of_bytes <= block->reserved_bytes_count;
+}
+
+internal Arena*
+arena_chain_new_block(Arena* arena, const Size number_of_bytes)
+{
+    Arena* current_block = arena->current_block;
+
+    // NOTE(vlad): New blocks are as big as the first one unless the requested
+    //             allocation does not fit in it. Huge page blocks keep their header
+    //             within the requested size, so it's counted in.
+    const Size default_block_size = arena->reserved_bytes_count - ARENA_HEADER_SIZE;
+    const Size minimal_block_size = ARENA_HEADER_SIZE + 2 * arena_get_redzone_size(arena) + number_of_bytes + ARENA_ALIGNMENT;
+    const Size block_size = MAX(default_block_size, minimal_block_size);
+
+    Arena* new_block = INTERNAL_create_arena(arena->name, block_size, 0, arena->flags & ARENA_FLAG_HUGE_PAGES);
+    if (new_block == NULL)
+    {
+        arena_print_error_message(arena, "Failed to chain a new block: out of memory.");
+        return NULL;
+    }
+
+    new_block->current_block = NULL;
+    new_block->previous_block = current_block;
+    new_block->base_position = current_block->base_position + current_block->reserved_bytes_count;
+
+    arena->current_block = new_block;
+
+    return new_block;
+}
+
+internal Bool
+arena_block_commit_memory_up_to_offset(Arena* arena, Arena* block, const Index offset)
+{
+    if (offset <= block->committed_memory_offset)
+    {
+        return true;
+    }
+
+    // NOTE(vlad): We assume that the page size is a power of 2.
+    const Index new_committed_memory_offset = ALIGN_UP_TO_POW2(offset, block->commit_granularity);
+
+    // NOTE(vlad): This assert should never fire, but just in case I will leave it here.
+    ASSERT(new_committed_memory_offset <= block->reserved_bytes_count);
+
+    // NOTE(vlad): Assert that we don't overcommit here.
+    ASSERT(new_committed_memory_offset <= offset + block->commit_granularity);
+
+    Byte* memory_to_commit = as_bytes(block) + block->committed_memory_offset;
+    const Size number_of_bytes_to_commit = new_committed_memory_offset - block->committed_memory_offset;
+
+    if (!platform_commit_memory(memory_to_commit, number_of_bytes_to_commit))
+    {
+        return false;
+    }
+
+    block->committed_memory_offset = new_committed_memory_offset;
+
+    arena->page_counters.commits_count += 1;
+    arena->page_counters.committed_bytes_count += number_of_bytes_to_commit;
+
+    return true;
+}
+
+internal inline void
+arena_update_peak_position(Arena* arena, const Arena* block)
+{
+    arena->peak_position = MAX(arena->peak_position, block->base_position + block->free_memory_offset);
 }
 
 maybe_unused internal Byte*
@@ -164,75 +802,155 @@ arena_push_uninitialized(Arena* arena, const Size number_of_bytes)
         FAIL("Arena is uninitialised");
     }
 
-    ARENA_ADD_REDZONE(arena);
+    Arena* block = arena->current_block;
+    if (!arena_block_can_fit(arena, block, number_of_bytes))
+    {
+        block = arena_chain_new_block(arena, number_of_bytes);
+        if (block == NULL)
+        {
+            ASSERT(0 && "Failed to allocate memory");
+            return NULL;
+        }
+    }
 
-    const Size aligned_memory_offset = ALIGN_UP_TO_POW2(arena->free_memory_offset, ARENA_ALIGNMENT);
+    const Index free_memory_offset_before_allocation = block->free_memory_offset;
 
-    const Size free_memory_offset_after_allocation = aligned_memory_offset + number_of_bytes;
-    if (free_memory_offset_after_allocation > arena->reserved_bytes_count)
+    Size redzone_bytes_count = 0;
+    if (block->free_memory_offset == ARENA_HEADER_SIZE)
     {
-        // TODO(vlad): Implement growable arenas.
-        //             @tag(growable-arena)
-        ASSERT(0 && "Failed to allocate memory");
-        return NULL;
+        redzone_bytes_count += ARENA_ADD_REDZONE(arena, block);
     }
 
-    if (free_memory_offset_after_allocation > arena->committed_memory_offset)
+    const Size aligned_memory_offset = ALIGN_UP_TO_POW2(block->free_memory_offset, ARENA_ALIGNMENT);
+    const Size free_memory_offset_after_allocation = aligned_memory_offset + number_of_bytes;
+
+    // NOTE(vlad): 'arena_block_can_fit' guarantees that.
+    ASSERT(free_memory_offset_after_allocation <= block->reserved_bytes_count);
+
+    if (!arena_block_commit_memory_up_to_offset(arena, block, free_memory_offset_after_allocation))
     {
-        const Size page_size = platform_get_page_size();
-        // NOTE(vlad): We assume that the page size is a power of 2.
-        const Index new_committed_memory_offset = ALIGN_UP_TO_POW2(free_memory_offset_after_allocation,
-                                                                   page_size);
+        ASSERT(0 && "Failed to commit memory");
+        return NULL;
+    }
 
-        // NOTE(vlad): This assert should never fire, but just in case I will leave it here.
-        ASSERT(new_committed_memory_offset <= arena->reserved_bytes_count);
+    Byte* memory = as_bytes(block) + aligned_memory_offset;
+    block->free_memory_offset = free_memory_offset_after_allocation;
+    arena_update_peak_position(arena, block);
 
-        // NOTE(vlad): Assert that we don't overcommit here.
-        ASSERT(new_committed_memory_offset <= free_memory_offset_after_allocation + page_size);
+    ASAN_UNPOISON_MEMORY_REGION(memory, number_of_bytes);
 
-        Byte* memory_to_commit = as_bytes(arena) + arena->committed_memory_offset;
-        const Size number_of_bytes_to_commit = new_committed_memory_offset - arena->committed_memory_offset;
+    redzone_bytes_count += ARENA_ADD_REDZONE(arena, block);
 
-        if (!platform_commit_memory(memory_to_commit, number_of_bytes_to_commit))
-        {
-            ASSERT(0 && "Failed to commit memory");
-            return NULL;
-        }
+    if (arena->flags & ARENA_FLAG_COLLECT_STATISTICS)
+    {
+        const Size wasted_bytes_count =
+            block->free_memory_offset - free_memory_offset_before_allocation - number_of_bytes;
 
-        arena->committed_memory_offset = new_committed_memory_offset;
+        arena->statistics.pushes_count += 1;
+        arena->statistics.pushed_bytes_count += number_of_bytes;
+        arena->statistics.redzone_bytes_count += redzone_bytes_count;
+        arena->statistics.alignment_waste_bytes_count += wasted_bytes_count - redzone_bytes_count;
     }
 
-    Byte* memory = as_bytes(arena) + aligned_memory_offset;
-    arena->free_memory_offset = free_memory_offset_after_allocation;
-
-    ASAN_UNPOISON_MEMORY_REGION(memory, number_of_bytes);
+    return memory;
+}
 
-    ARENA_ADD_REDZONE(arena);
+maybe_unused internal Index
+arena_get_position(const Arena* arena)
+{
+    const Arena* block = arena->current_block;
+    return block->base_position + block->free_memory_offset;
+}
 
-    return memory;
+maybe_unused internal Size
+arena_get_committed_bytes_count(const Arena* arena)
+{
+    Size committed_bytes_count = 0;
+    for (const Arena* block = arena->current_block;
+         block != NULL;
+         block = block->previous_block)
+    {
+        committed_bytes_count += block->committed_memory_offset;
+    }
+    return committed_bytes_count;
 }
 
 maybe_unused internal void
 arena_pop_to_position(Arena* arena, const Index position)
 {
-    if (position < arena->free_memory_offset)
+#if ASAN_ENABLED
+    // NOTE(vlad): We do not actually reset 'free_memory_offset' to a 'position' here
+    //             if asan is enabled. See NOTE in 'arena_clear'.
+    for (Arena* block = arena->current_block;
+         block != NULL && block->base_position + block->free_memory_offset > position;
+         block = block->previous_block)
     {
-        const Index new_free_memory_offset = MAX(position, ARENA_HEADER_SIZE);
+        const Index new_free_memory_offset = MAX(position - block->base_position, ARENA_HEADER_SIZE);
 
-#if ASAN_ENABLED
-        // NOTE(vlad): We do not actually reset 'free_memory_offset' to a 'new_free_memory_offset' here
-        //             if asan is enabled. See NOTE in 'arena_clear'.
-        ASAN_POISON_MEMORY_REGION(as_bytes(arena) + new_free_memory_offset,
-                                  arena->free_memory_offset - new_free_memory_offset);
+        ASAN_POISON_MEMORY_REGION(as_bytes(block) + new_free_memory_offset,
+                                  block->free_memory_offset - new_free_memory_offset);
+    }
 #else
-        arena->free_memory_offset = new_free_memory_offset;
-#endif
+    Arena* block = arena->current_block;
+
+    // NOTE(vlad): Releasing blocks that start after the position.
+    while (block->previous_block != NULL && block->base_position + ARENA_HEADER_SIZE >= position)
+    {
+        Arena* previous_block = block->previous_block;
+        arena_release_chained_block(arena, block);
+        block = previous_block;
     }
 
+    arena->current_block = block;
+
+    const Index new_free_memory_offset = MAX(position - block->base_position, ARENA_HEADER_SIZE);
+    if (new_free_memory_offset < block->free_memory_offset)
+    {
+        block->free_memory_offset = new_free_memory_offset;
+    }
+#endif
+
     // TODO(vlad): Decommit memory? Probably not, but maybe we should add
     //             something like 'arena_pop_and_decommit()' for some rare use cases.
 }
 
+// NOTE(vlad): Every clear the high-water mark decays by 1/ARENA_HIGH_WATER_MARK_DECAY_DIVISOR
+//             of itself, so a single spike in usage does not pin its pages forever.
+#define ARENA_HIGH_WATER_MARK_DECAY_DIVISOR 4
+
+maybe_unused internal void
+arena_retain_committed_pages(Arena* arena, const Size commit_granularity)
+{
+    // NOTE(vlad): Chained blocks are released anyway, so we only care about the first one.
+    const Index used_memory_offset = MIN(arena->peak_position, arena->reserved_bytes_count);
+
+    const Index previous_retained_memory_offset = ALIGN_UP_TO_POW2(arena->high_water_mark, commit_granularity);
+
+    arena->high_water_mark = MAX(used_memory_offset,
+                                 arena->high_water_mark - arena->high_water_mark / ARENA_HIGH_WATER_MARK_DECAY_DIVISOR);
+
+    const Index retained_memory_offset = MIN(ALIGN_UP_TO_POW2(arena->high_water_mark, commit_granularity),
+                                             arena->committed_memory_offset);
+
+    // NOTE(vlad): Pages past both of these offsets were not touched since they were
+    //             lazily decommitted during one of the previous clears.
+    const Index dirty_memory_offset = MIN(MAX(ALIGN_UP_TO_POW2(used_memory_offset, commit_granularity),
+                                              previous_retained_memory_offset),
+                                          arena->committed_memory_offset);
+
+    if (dirty_memory_offset > retained_memory_offset)
+    {
+        const Size number_of_bytes_to_decommit = dirty_memory_offset - retained_memory_offset;
+
+        // NOTE(vlad): Pages stay accessible, so there is no need to commit them again.
+        //             The OS takes them back only if it's low on memory.
+        platform_decommit_memory_lazily(as_bytes(arena) + retained_memory_offset, number_of_bytes_to_decommit);
+
+        arena->page_counters.lazy_decommits_count += 1;
+        arena->page_counters.lazily_decommitted_bytes_count += number_of_bytes_to_decommit;
+    }
+}
+
 maybe_unused internal void
 arena_clear(Arena* arena)
 {
@@ -246,36 +964,86 @@ arena_clear(Arena* arena)
     //                 *first_int = 10; // Use after free.
     //                 *second_int = 10; // OK
     //
-    ASAN_POISON_MEMORY_REGION(as_bytes(arena) + ARENA_HEADER_SIZE,
-                              arena->free_memory_offset - ARENA_HEADER_SIZE);
-
-    // TODO(vlad): We will quickly run out of memory if we don't clear
-    //             long standing frequently reusable arenas (e.g. frame arenas).
-    //             We need to track how many memory was used since the last clear
-    //             and if there are less memory available in the arena than the max previous
-    //             usage then we need to actually clear it. Yes, we will not find use-after-free
-    //             bugs after clearing the arena, but we will get OOMs otherwise.
+    for (Arena* block = arena->current_block;
+         block != NULL;
+         block = block->previous_block)
+    {
+        ASAN_POISON_MEMORY_REGION(as_bytes(block) + ARENA_HEADER_SIZE,
+                                  block->free_memory_offset - ARENA_HEADER_SIZE);
+    }
+
+    // TODO(vlad): Long standing frequently reusable arenas (e.g. frame arenas) will
+    //             keep chaining new blocks if we don't clear them. We need to track
+    //             how many memory was used since the last clear and if there are less
+    //             memory available in the current block than the max previous usage
+    //             then we need to actually clear the arena. Yes, we will not find
+    //             use-after-free bugs after clearing the arena, but we will waste
+    //             memory otherwise.
     //
     //             Another approach: track how many times we postponed clearing the arena
     //             and clear it if it exceeds some threshold (say, 10). But I like the
     //             max used memory approach more.
-    //
-    //             Also we need to think about this situation when we will implement growable arenas.
-    //             @tag(asan) @tag(growable-arena)
+    //             @tag(asan)
 #else
-    const Size page_size = platform_get_page_size();
+    const Size commit_granularity = arena->commit_granularity;
+
+    Arena* block = arena->current_block;
+    while (block->previous_block != NULL)
+    {
+        Arena* previous_block = block->previous_block;
+        arena_release_chained_block(arena, block);
+        block = previous_block;
+    }
 
-    ASSERT(arena->committed_memory_offset % page_size == 0);
-    ASSERT(ARENA_HEADER_SIZE < page_size);
+    ASSERT(block == arena);
 
-    Byte* memory_to_decommit = as_bytes(arena) + page_size;
-    const Size number_of_bytes_to_decommit = arena->committed_memory_offset - page_size;
+    arena->current_block = arena;
 
-    platform_decommit_memory(memory_to_decommit, number_of_bytes_to_decommit);
+    ASSERT(arena->committed_memory_offset % commit_granularity == 0);
+    ASSERT(ARENA_HEADER_SIZE < commit_granularity);
+
+    if (arena->flags & ARENA_FLAG_RETAIN_COMMITTED_PAGES)
+    {
+        arena_retain_committed_pages(arena, commit_granularity);
+    }
+    else
+    {
+        Byte* memory_to_decommit = as_bytes(arena) + commit_granularity;
+        const Size number_of_bytes_to_decommit = arena->committed_memory_offset - commit_granularity;
+
+        if (number_of_bytes_to_decommit > 0)
+        {
+            platform_decommit_memory(memory_to_decommit, number_of_bytes_to_decommit);
+
+            arena->page_counters.decommits_count += 1;
+            arena->page_counters.decommitted_bytes_count += number_of_bytes_to_decommit;
+        }
+
+        arena->committed_memory_offset = commit_granularity;
+    }
 
-    arena->committed_memory_offset = page_size;
     arena->free_memory_offset = ARENA_HEADER_SIZE;
 #endif
+
+    arena->statistics.peak_position = MAX(arena->statistics.peak_position, arena->peak_position);
+    arena->peak_position = arena_get_position(arena);
+}
+
+internal inline void
+arena_count_reallocation(Arena* arena, const Bool in_place, const Size copied_bytes_count)
+{
+    if (arena->flags & ARENA_FLAG_COLLECT_STATISTICS)
+    {
+        if (in_place)
+        {
+            arena->statistics.in_place_reallocations_count += 1;
+        }
+        else
+        {
+            arena->statistics.copying_reallocations_count += 1;
+            arena->statistics.copied_bytes_count += copied_bytes_count;
+        }
+    }
 }
 
 maybe_unused internal Byte*
@@ -297,31 +1065,51 @@ arena_reallocate(Arena* restrict arena,
     //             This would be able to find stale pointers to the memory that could
     //             be potentially moved here.
 #else
-    if (memory + memory_size_in_bytes == as_bytes(arena) + arena->free_memory_offset)
+    Arena* block = arena->current_block;
+
+    if (memory + memory_size_in_bytes == as_bytes(block) + block->free_memory_offset)
     {
-        // NOTE(vlad): This memory is at the end of the arena, so we can just
-        //             change its capacity without copying anything.
+        // NOTE(vlad): This memory is at the end of the current block, so we can just
+        //             change its capacity without copying anything if it fits.
 
         if (requested_size_in_bytes < memory_size_in_bytes)
         {
             const Size difference = memory_size_in_bytes - requested_size_in_bytes;
-            arena->free_memory_offset = MAX(arena->free_memory_offset - difference,
+            block->free_memory_offset = MAX(block->free_memory_offset - difference,
                                             ARENA_HEADER_SIZE);
+            arena_count_reallocation(arena, true, 0);
+            return memory;
         }
-        else
+
+        const Size difference = requested_size_in_bytes - memory_size_in_bytes;
+        const Index free_memory_offset_after_allocation = block->free_memory_offset + difference;
+
+        if (free_memory_offset_after_allocation <= block->reserved_bytes_count)
         {
-            const Size difference = requested_size_in_bytes - memory_size_in_bytes;
-            arena_push(arena, difference);
+            if (!arena_block_commit_memory_up_to_offset(arena, block, free_memory_offset_after_allocation))
+            {
+                ASSERT(0 && "Failed to commit memory");
+                return NULL;
+            }
+
+            fill_memory_with_zeros(memory + memory_size_in_bytes, difference);
+            block->free_memory_offset = free_memory_offset_after_allocation;
+            arena_update_peak_position(arena, block);
+            arena_count_reallocation(arena, true, 0);
+
+            return memory;
         }
 
-        return memory;
+        // NOTE(vlad): The block is full, falling back to the copying.
     }
 #endif
 
     // NOTE(vlad): Something else was allocated thus we must reallocate and copy memory.
+    const Size number_of_bytes_to_copy = MIN(requested_size_in_bytes, memory_size_in_bytes);
+
     Byte* new_memory = arena_push(arena, requested_size_in_bytes);
-    copy_memory(as_bytes(new_memory), memory,
-                MIN(requested_size_in_bytes, memory_size_in_bytes));
+    copy_memory(as_bytes(new_memory), memory, number_of_bytes_to_copy);
+    arena_count_reallocation(arena, false, number_of_bytes_to_copy);
 
     ASAN_POISON_MEMORY_REGION(memory, memory_size_in_bytes);
 
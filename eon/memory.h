@@ -18,28 +18,142 @@ internal inline void fill_memory_with_zeros(Byte* memory, const Size number_of_b
 #define fill_with_zeros(pointer, number_of_elements, Type)              \
     fill_memory_with_zeros(as_bytes(pointer), size_of(Type) * number_of_elements)
 
+// NOTE(vlad): Implementations of the memory primitives above. Everything that doesn't fit
+//             into a couple of machine words is dispatched to the widest implementation
+//             supported by the CPU we're running on, which is selected on the first call.
+typedef void Copy_Memory_Function(Byte* to, const Byte* from, Size number_of_bytes);
+typedef void Fill_Memory_Function(Byte* memory, Size number_of_bytes);
+
+struct Memory_Primitives
+{
+    String_View name;
+
+    Copy_Memory_Function* copy;          // NOTE(vlad): Regions must not overlap.
+    Copy_Memory_Function* copy_forward;  // NOTE(vlad): Regions may overlap if 'to' < 'from'.
+    Copy_Memory_Function* copy_backward; // NOTE(vlad): Regions may overlap if 'to' > 'from'.
+    Fill_Memory_Function* fill_memory_with_zeros;
+};
+typedef struct Memory_Primitives Memory_Primitives;
+
+#define MAX_NUMBER_OF_MEMORY_PRIMITIVES 3
+
+// NOTE(vlad): Copies and fills bigger than this bypass the cache with non-temporal stores,
+//             otherwise they'd evict everything else from it and we're unlikely to read
+//             the whole thing back soon anyway.
+#define MEMORY_NON_TEMPORAL_STORES_THRESHOLD MiB(4)
+
+// NOTE(vlad): Returns the number of implementations written to 'primitives', the widest goes first.
+internal Size get_supported_memory_primitives(Memory_Primitives primitives[MAX_NUMBER_OF_MEMORY_PRIMITIVES]);
+internal void use_memory_primitives(const Memory_Primitives* primitives);
+
+// NOTE(vlad): Must be called before any threads are started, 'init_io_state' does it.
+internal void select_best_memory_primitives(void);
+
+typedef enum
+{
+    ARENA_FLAG_NONE = 0,
+
+    // NOTE(vlad): 'arena_clear' keeps pages committed up to a decaying high-water mark
+    //             instead of decommitting everything past the first page, and lets
+    //             the OS lazily take back the rest. Useful for arenas that are cleared
+    //             over and over again, e.g. scratch arenas.
+    ARENA_FLAG_RETAIN_COMMITTED_PAGES = 1 << 0,
+
+    // NOTE(vlad): Reservations of at least one huge page are aligned to the huge page size
+    //             and backed by transparent huge pages, memory is committed by huge pages too.
+    //             Falls back to regular pages if the OS doesn't support them or they're disabled.
+    //             Useful for big arenas that are filled sequentially to reduce TLB pressure.
+    ARENA_FLAG_HUGE_PAGES = 1 << 1,
+
+    // NOTE(vlad): Arena counts its allocations, reallocations and wasted bytes into
+    //             'statistics'. Off by default, since it touches the first block
+    //             on every push.
+    ARENA_FLAG_COLLECT_STATISTICS = 1 << 2,
+
+    // NOTE(vlad): Only used if ASAN is enabled. Allocations are separated by page-sized
+    //             redzones instead of small ones, which finds overruns that skip over
+    //             a couple dozens of bytes at the cost of a page of reservation per push.
+    ARENA_FLAG_PAGE_SIZED_REDZONES = 1 << 3,
+} Arena_Flag;
+typedef u32 Arena_Flags;
+
+struct Arena_Page_Counters
+{
+    Size commits_count;
+    Size committed_bytes_count;
+
+    // NOTE(vlad): Releasing chained blocks counts as decommitting their committed pages.
+    Size decommits_count;
+    Size decommitted_bytes_count;
+
+    Size lazy_decommits_count;
+    Size lazily_decommitted_bytes_count;
+};
+typedef struct Arena_Page_Counters Arena_Page_Counters;
+
+// NOTE(vlad): Only collected if the arena has 'ARENA_FLAG_COLLECT_STATISTICS'.
+struct Arena_Statistics
+{
+    // NOTE(vlad): Reallocations that have to copy memory count as pushes too.
+    Size pushes_count;
+    Size pushed_bytes_count;
+
+    Size in_place_reallocations_count;
+    Size copying_reallocations_count;
+    Size copied_bytes_count;
+
+    // NOTE(vlad): Bytes skipped to align allocations and bytes spent on ASAN redzones.
+    Size alignment_waste_bytes_count;
+    Size redzone_bytes_count;
+
+    // NOTE(vlad): Unlike 'peak_position' survives 'arena_clear'.
+    Index peak_position;
+};
+typedef struct Arena_Statistics Arena_Statistics;
+
+// NOTE(vlad): Arena is a chain of reserved blocks. Every block starts with this header,
+//             the first block is the arena itself. When the current block runs out of
+//             reserved memory a new one is reserved and linked to it, so pointers to
+//             previously allocated memory always stay valid.
 struct Arena
 {
     String_View name;
 
+    struct Arena* current_block; // NOTE(vlad): Only valid in the first block.
+    struct Arena* previous_block;
+
+    Index base_position;
     Size reserved_bytes_count;
 
     Index free_memory_offset;
     Index committed_memory_offset;
+    Size commit_granularity; // NOTE(vlad): Either the page size or the huge page size.
+
+    // NOTE(vlad): These are only valid in the first block.
+    Arena_Flags flags;
+    Index peak_position; // NOTE(vlad): Since the last 'arena_clear'.
+    Index high_water_mark;
+    Arena_Page_Counters page_counters;
+    Arena_Statistics statistics;
 };
 typedef struct Arena Arena;
 
 internal Arena* INTERNAL_create_arena(const String_View name,
                                       Size number_of_bytes_to_reserve,
-                                      Size number_of_bytes_to_commit);
+                                      Size number_of_bytes_to_commit,
+                                      Arena_Flags flags);
 
 #define create_arena(name, number_of_bytes_to_reserve, number_of_bytes_to_commit) \
-    INTERNAL_create_arena(string_view(name), number_of_bytes_to_reserve, number_of_bytes_to_commit)
+    INTERNAL_create_arena(string_view(name), number_of_bytes_to_reserve, number_of_bytes_to_commit, ARENA_FLAG_NONE)
+#define create_arena_with_flags(name, number_of_bytes_to_reserve, number_of_bytes_to_commit, flags) \
+    INTERNAL_create_arena(string_view(name), number_of_bytes_to_reserve, number_of_bytes_to_commit, flags)
 internal void destroy_arena(Arena* arena);
 
 internal Byte* arena_push(Arena* arena, Size number_of_bytes);
 internal Byte* arena_push_uninitialized(Arena* arena, Size number_of_bytes);
 // TODO(vlad): Change to 'arena_save_position' and 'arena_restore_position'.
+internal Index arena_get_position(const Arena* arena);
+internal Size arena_get_committed_bytes_count(const Arena* arena);
 internal void arena_pop_to_position(Arena* arena, Index position);
 internal void arena_clear(Arena* arena);
 
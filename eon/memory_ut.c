@@ -201,8 +201,528 @@ test_fill_memory_with_zeros(Test_Context* test_context)
     }
 }
 
+// NOTE(vlad): Memory primitives are checked byte by byte against this pattern.
+internal inline Byte
+get_pattern_byte(const Index i)
+{
+    return (Byte)(i * 7 + 1);
+}
+
+internal void
+fill_with_pattern(Byte* memory, const Size number_of_bytes)
+{
+    for (Index i = 0;
+         i < number_of_bytes;
+         ++i)
+    {
+        memory[i] = get_pattern_byte(i);
+    }
+}
+
+internal Bool
+all_bytes_are_equal_to(const Byte* memory, const Size number_of_bytes, const Byte value)
+{
+    for (Index i = 0;
+         i < number_of_bytes;
+         ++i)
+    {
+        if (memory[i] != value)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+internal Bool
+all_bytes_are_equal(const Byte* lhs, const Byte* rhs, const Size number_of_bytes)
+{
+    for (Index i = 0;
+         i < number_of_bytes;
+         ++i)
+    {
+        if (lhs[i] != rhs[i])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+internal void
+test_memory_primitives_with_different_sizes_and_alignments(Test_Context* test_context)
+{
+    enum { MAX_NUMBER_OF_BYTES = 300, MAX_OFFSET = 64, GUARD_BYTE = 0xAA };
+
+    local_persist const Index offsets[] = { 0, 1, 3, 7, 8, 15, 16, 31, 33 };
+    const Size buffer_size = MAX_NUMBER_OF_BYTES + 2 * MAX_OFFSET;
+
+    Byte* source = allocate_uninitialized_array(test_context->arena, buffer_size, Byte);
+    Byte* destination = allocate_uninitialized_array(test_context->arena, buffer_size, Byte);
+    fill_with_pattern(source, buffer_size);
+
+    Memory_Primitives primitives[MAX_NUMBER_OF_MEMORY_PRIMITIVES];
+    const Size primitives_count = get_supported_memory_primitives(primitives);
+
+    for (Index primitives_index = 0;
+         primitives_index < primitives_count;
+         ++primitives_index)
+    {
+        use_memory_primitives(&primitives[primitives_index]);
+
+        for (Index number_of_bytes = 0;
+             number_of_bytes <= MAX_NUMBER_OF_BYTES;
+             ++number_of_bytes)
+        {
+            for (Index i = 0;
+                 i < NUMBER_OF_STATIC_ARRAY_ELEMENTS(offsets);
+                 ++i)
+            {
+                for (Index j = 0;
+                     j < NUMBER_OF_STATIC_ARRAY_ELEMENTS(offsets);
+                     ++j)
+                {
+                    const Index source_offset = offsets[i];
+                    const Index destination_offset = offsets[j];
+
+                    for (Index k = 0;
+                         k < buffer_size;
+                         ++k)
+                    {
+                        destination[k] = GUARD_BYTE;
+                    }
+
+                    copy_memory(destination + destination_offset,
+                                source + source_offset,
+                                number_of_bytes);
+
+                    ASSERT_TRUE(all_bytes_are_equal_to(destination, destination_offset, GUARD_BYTE));
+                    ASSERT_TRUE(all_bytes_are_equal(destination + destination_offset,
+                                                    source + source_offset,
+                                                    number_of_bytes));
+                    ASSERT_TRUE(all_bytes_are_equal_to(destination + destination_offset + number_of_bytes,
+                                                       buffer_size - destination_offset - number_of_bytes,
+                                                       GUARD_BYTE));
+
+                    fill_memory_with_zeros(destination + destination_offset, number_of_bytes);
+
+                    ASSERT_TRUE(all_bytes_are_equal_to(destination, destination_offset, GUARD_BYTE));
+                    ASSERT_TRUE(all_bytes_are_equal_to(destination + destination_offset, number_of_bytes, 0));
+                    ASSERT_TRUE(all_bytes_are_equal_to(destination + destination_offset + number_of_bytes,
+                                                       buffer_size - destination_offset - number_of_bytes,
+                                                       GUARD_BYTE));
+                }
+            }
+        }
+    }
+
+    use_memory_primitives(&primitives[0]);
+}
+
+internal void
+test_move_memory_with_different_overlaps(Test_Context* test_context)
+{
+    enum { MAX_NUMBER_OF_BYTES = 200, MAX_DISTANCE = 70 };
+
+    const Size buffer_size = MAX_NUMBER_OF_BYTES + 2 * MAX_DISTANCE;
+
+    Byte* buffer = allocate_uninitialized_array(test_context->arena, buffer_size, Byte);
+    Byte* expected = allocate_uninitialized_array(test_context->arena, buffer_size, Byte);
+
+    Memory_Primitives primitives[MAX_NUMBER_OF_MEMORY_PRIMITIVES];
+    const Size primitives_count = get_supported_memory_primitives(primitives);
+
+    for (Index primitives_index = 0;
+         primitives_index < primitives_count;
+         ++primitives_index)
+    {
+        use_memory_primitives(&primitives[primitives_index]);
+
+        for (Index number_of_bytes = 0;
+             number_of_bytes <= MAX_NUMBER_OF_BYTES;
+             number_of_bytes += 3)
+        {
+            for (Index distance = -MAX_DISTANCE;
+                 distance <= MAX_DISTANCE;
+                 ++distance)
+            {
+                const Index from = MAX_DISTANCE;
+                const Index to = MAX_DISTANCE + distance;
+
+                fill_with_pattern(buffer, buffer_size);
+                fill_with_pattern(expected, buffer_size);
+                for (Index i = 0;
+                     i < number_of_bytes;
+                     ++i)
+                {
+                    expected[to + i] = get_pattern_byte(from + i);
+                }
+
+                move_memory(buffer + to, buffer + from, number_of_bytes);
+
+                ASSERT_TRUE(all_bytes_are_equal(buffer, expected, buffer_size));
+            }
+        }
+    }
+
+    use_memory_primitives(&primitives[0]);
+}
+
+internal void
+test_memory_primitives_with_non_temporal_stores(Test_Context* test_context)
+{
+    // NOTE(vlad): Big enough to use non-temporal stores, but not a multiple of any vector width.
+    const Size number_of_bytes = MiB(4) + 77;
+    const Size buffer_size = number_of_bytes + 64;
+
+    Byte* source = allocate_uninitialized_array(test_context->arena, buffer_size, Byte);
+    Byte* destination = allocate_array(test_context->arena, buffer_size, Byte);
+    fill_with_pattern(source, buffer_size);
+
+    Memory_Primitives primitives[MAX_NUMBER_OF_MEMORY_PRIMITIVES];
+    const Size primitives_count = get_supported_memory_primitives(primitives);
+
+    for (Index primitives_index = 0;
+         primitives_index < primitives_count;
+         ++primitives_index)
+    {
+        use_memory_primitives(&primitives[primitives_index]);
+
+        copy_memory(destination + 5, source + 3, number_of_bytes);
+        ASSERT_TRUE(all_bytes_are_equal(destination + 5, source + 3, number_of_bytes));
+
+        fill_memory_with_zeros(destination + 1, number_of_bytes);
+        ASSERT_TRUE(all_bytes_are_equal_to(destination + 1, number_of_bytes, 0));
+        ASSERT_TRUE(all_bytes_are_equal(destination + 1 + number_of_bytes,
+                                        source + 3 + number_of_bytes - 4,
+                                        4));
+    }
+
+    use_memory_primitives(&primitives[0]);
+}
+
+internal void
+test_arena_chains_new_blocks(Test_Context* test_context)
+{
+    enum { VALUES_COUNT = 4096 };
+
+    Arena* arena = create_arena("chained-arena", KiB(4), KiB(4));
+
+    s32* values[VALUES_COUNT] = {0};
+
+    for (Index i = 0;
+         i < VALUES_COUNT;
+         ++i)
+    {
+        values[i] = allocate(arena, s32);
+        *values[i] = (s32)i;
+    }
+
+    ASSERT_TRUE(arena->current_block != arena);
+
+    for (Index i = 0;
+         i < VALUES_COUNT;
+         ++i)
+    {
+        ASSERT_EQUAL(*values[i], (s32)i);
+    }
+
+    // NOTE(vlad): Allocations that are bigger than the block size are also supported.
+    {
+        const Size big_array_size = KiB(64);
+        Byte* big_array = allocate_array(arena, big_array_size, Byte);
+
+        ASSERT_TRUE(big_array != NULL);
+        ASSERT_EQUAL(big_array[0], 0);
+        ASSERT_EQUAL(big_array[big_array_size - 1], 0);
+    }
+
+    destroy_arena(arena);
+}
+
+internal void
+test_arena_pop_to_position_across_blocks(Test_Context* test_context)
+{
+    Arena* arena = create_arena("chained-arena", KiB(4), KiB(4));
+
+    s32* first_value = allocate(arena, s32);
+    *first_value = 10;
+
+    const Index position = arena_get_position(arena);
+
+    for (Index i = 0;
+         i < 1024;
+         ++i)
+    {
+        allocate(arena, s64);
+    }
+
+    ASSERT_TRUE(arena->current_block != arena);
+
+    arena_pop_to_position(arena, position);
+
+#if ASAN_ENABLED == 0
+    ASSERT_POINTERS_ARE_EQUAL(arena->current_block, arena);
+    ASSERT_EQUAL(arena_get_position(arena), position);
+#endif
+
+    ASSERT_EQUAL(*first_value, 10);
+
+    s32* second_value = allocate(arena, s32);
+    *second_value = 20;
+
+    ASSERT_EQUAL(*first_value, 10);
+    ASSERT_EQUAL(*second_value, 20);
+
+    arena_clear(arena);
+
+#if ASAN_ENABLED == 0
+    ASSERT_POINTERS_ARE_EQUAL(arena->current_block, arena);
+#endif
+
+    destroy_arena(arena);
+}
+
+internal void
+test_arena_reallocate_across_blocks(Test_Context* test_context)
+{
+    Arena* arena = create_arena("chained-arena", KiB(4), KiB(4));
+
+    Size values_count = 16;
+    s32* values = allocate_array(arena, values_count, s32);
+
+    for (Index i = 0;
+         i < values_count;
+         ++i)
+    {
+        values[i] = (s32)i;
+    }
+
+    while (values_count < KiB(16))
+    {
+        const Size new_values_count = 2 * values_count;
+        values = reallocate(arena, values, s32, values_count, new_values_count);
+
+        for (Index i = values_count;
+             i < new_values_count;
+             ++i)
+        {
+            ASSERT_EQUAL(values[i], 0);
+            values[i] = (s32)i;
+        }
+
+        values_count = new_values_count;
+    }
+
+    ASSERT_TRUE(arena->current_block != arena);
+
+    for (Index i = 0;
+         i < values_count;
+         ++i)
+    {
+        ASSERT_EQUAL(values[i], (s32)i);
+    }
+
+    destroy_arena(arena);
+}
+
+internal void
+test_arena_clear_decommits_pages(Test_Context* test_context)
+{
+    UNUSED(test_context);
+
+    Arena* arena = create_arena("decommitting-arena", MiB(1), 0);
+
+    allocate_array(arena, KiB(256), Byte);
+    const Size commits_count = arena->page_counters.commits_count;
+
+    arena_clear(arena);
+
+#if ASAN_ENABLED == 0
+    ASSERT_EQUAL(arena->page_counters.decommits_count, 1);
+    ASSERT_TRUE(arena->page_counters.decommitted_bytes_count >= KiB(256) - KiB(4));
+    ASSERT_EQUAL(arena->page_counters.lazy_decommits_count, 0);
+    ASSERT_TRUE(arena->committed_memory_offset < KiB(256));
+
+    // NOTE(vlad): Pages have to be committed again.
+    allocate_array(arena, KiB(256), Byte);
+    ASSERT_TRUE(arena->page_counters.commits_count > commits_count);
+#else
+    UNUSED(commits_count);
+#endif
+
+    destroy_arena(arena);
+}
+
+internal void
+test_arena_clear_retains_pages_up_to_high_water_mark(Test_Context* test_context)
+{
+    UNUSED(test_context);
+
+    Arena* arena = create_arena_with_flags("retaining-arena", MiB(1), 0, ARENA_FLAG_RETAIN_COMMITTED_PAGES);
+
+    Byte* memory = allocate_array(arena, KiB(256), Byte);
+    memory[KiB(256) - 1] = 1;
+
+    const Size commits_count = arena->page_counters.commits_count;
+    const Index committed_memory_offset = arena->committed_memory_offset;
+
+    arena_clear(arena);
+
+#if ASAN_ENABLED == 0
+    ASSERT_EQUAL(arena->page_counters.decommits_count, 0);
+    ASSERT_EQUAL(arena->page_counters.lazy_decommits_count, 0);
+    ASSERT_EQUAL(arena->committed_memory_offset, committed_memory_offset);
+    ASSERT_EQUAL(arena_get_position(arena), (Index)size_of(Arena));
+
+    // NOTE(vlad): Pages are still committed and zeroed by 'arena_push'.
+    memory = allocate_array(arena, KiB(256), Byte);
+    ASSERT_EQUAL(arena->page_counters.commits_count, commits_count);
+    ASSERT_EQUAL(memory[KiB(256) - 1], 0);
+
+    // NOTE(vlad): The high-water mark decays when the arena is not used that much anymore,
+    //             and pages past it are lazily decommitted once.
+    arena_clear(arena);
+    for (Index i = 0;
+         i < 32;
+         ++i)
+    {
+        allocate_array(arena, KiB(16), Byte);
+        arena_clear(arena);
+    }
+
+    ASSERT_EQUAL(arena->page_counters.decommits_count, 0);
+    ASSERT_TRUE(arena->page_counters.lazy_decommits_count > 0);
+    ASSERT_TRUE(arena->page_counters.lazy_decommits_count < 32);
+    ASSERT_TRUE(arena->page_counters.lazily_decommitted_bytes_count >= KiB(256) - KiB(16) - KiB(4));
+    ASSERT_TRUE(arena->page_counters.lazily_decommitted_bytes_count <= KiB(256));
+    ASSERT_TRUE(arena->high_water_mark < KiB(32));
+    ASSERT_EQUAL(arena->committed_memory_offset, committed_memory_offset);
+
+    // NOTE(vlad): Lazily decommitted pages are still accessible.
+    memory = allocate_array(arena, KiB(256), Byte);
+    ASSERT_EQUAL(arena->page_counters.commits_count, commits_count);
+    ASSERT_EQUAL(memory[KiB(256) - 1], 0);
+#else
+    UNUSED(commits_count, committed_memory_offset);
+#endif
+
+    destroy_arena(arena);
+}
+
+internal void
+test_arena_with_huge_pages(Test_Context* test_context)
+{
+    UNUSED(test_context);
+
+    const Size huge_page_size = platform_get_huge_page_size();
+
+    Arena* arena = create_arena_with_flags("huge-pages-arena", MiB(8), 0, ARENA_FLAG_HUGE_PAGES);
+
+    if (huge_page_size == 0)
+    {
+        // NOTE(vlad): Falling back to regular pages.
+        ASSERT_EQUAL(arena->commit_granularity, platform_get_page_size());
+        destroy_arena(arena);
+        return;
+    }
+
+    ASSERT_EQUAL(arena->commit_granularity, huge_page_size);
+    ASSERT_EQUAL((Size)arena % huge_page_size, 0);
+    ASSERT_EQUAL(arena->reserved_bytes_count, ALIGN_UP_TO_POW2(MiB(8), huge_page_size));
+    ASSERT_EQUAL(arena->committed_memory_offset, huge_page_size);
+
+    allocate_array(arena, KiB(4), Byte);
+    ASSERT_EQUAL(arena->page_counters.commits_count, 1);
+
+    allocate_array(arena, huge_page_size + KiB(4), Byte);
+    ASSERT_EQUAL(arena->committed_memory_offset, 2 * huge_page_size);
+    ASSERT_EQUAL(arena->page_counters.commits_count, 2);
+
+    arena_clear(arena);
+
+#if ASAN_ENABLED == 0
+    ASSERT_EQUAL(arena->committed_memory_offset, huge_page_size);
+#endif
+
+    // NOTE(vlad): A chained block fits an allocation as big as the whole arena.
+    Byte* big_allocation = allocate_array(arena, arena->reserved_bytes_count, Byte);
+    ASSERT_TRUE(big_allocation != NULL);
+    ASSERT_TRUE(arena->current_block != arena);
+
+    // NOTE(vlad): Small arenas don't use huge pages.
+    Arena* small_arena = create_arena_with_flags("small-huge-pages-arena", KiB(64), 0, ARENA_FLAG_HUGE_PAGES);
+    ASSERT_EQUAL(small_arena->commit_granularity, platform_get_page_size());
+
+    destroy_arena(small_arena);
+    destroy_arena(arena);
+}
+
+internal void
+test_arena_statistics(Test_Context* test_context)
+{
+    UNUSED(test_context);
+
+    Arena* arena = create_arena_with_flags("statistics-arena", MiB(1), 0, ARENA_FLAG_COLLECT_STATISTICS);
+
+    Byte* first = allocate_array(arena, 3, Byte);
+    Byte* second = allocate_array(arena, 8, Byte);
+
+    ASSERT_EQUAL(arena->statistics.pushes_count, 2);
+    ASSERT_EQUAL(arena->statistics.pushed_bytes_count, 11);
+    ASSERT_EQUAL(arena->statistics.alignment_waste_bytes_count, 5);
+    // NOTE(vlad): Redzones are shared, the first allocation also gets a leading one.
+    ASSERT_EQUAL(arena->statistics.redzone_bytes_count, 3 * arena_get_redzone_size(arena));
+
+    second = reallocate(arena, second, Byte, 8, 16);
+#if ASAN_ENABLED
+    ASSERT_EQUAL(arena->statistics.in_place_reallocations_count, 0);
+    ASSERT_EQUAL(arena->statistics.copying_reallocations_count, 1);
+    ASSERT_EQUAL(arena->statistics.copied_bytes_count, 8);
+#else
+    ASSERT_EQUAL(arena->statistics.in_place_reallocations_count, 1);
+    ASSERT_EQUAL(arena->statistics.copying_reallocations_count, 0);
+    ASSERT_EQUAL(arena->statistics.copied_bytes_count, 0);
+#endif
+
+    const Size copying_reallocations_count = arena->statistics.copying_reallocations_count;
+    const Size copied_bytes_count = arena->statistics.copied_bytes_count;
+
+    first = reallocate(arena, first, Byte, 3, 32);
+    ASSERT_EQUAL(arena->statistics.copying_reallocations_count, copying_reallocations_count + 1);
+    ASSERT_EQUAL(arena->statistics.copied_bytes_count, copied_bytes_count + 3);
+
+    // NOTE(vlad): Unlike the peak position, the peak in statistics survives clearing.
+    allocate_array(arena, KiB(64), Byte);
+    const Index peak_position = arena->peak_position;
+    arena_clear(arena);
+    ASSERT_EQUAL(arena->statistics.peak_position, peak_position);
+    ASSERT_TRUE(arena->statistics.peak_position >= (Index)size_of(Arena) + KiB(64));
+
+    UNUSED(first, second);
+    destroy_arena(arena);
+
+    Arena* arena_without_statistics = create_arena("arena-without-statistics", MiB(1), 0);
+    allocate_array(arena_without_statistics, 3, Byte);
+    ASSERT_EQUAL(arena_without_statistics->statistics.pushes_count, 0);
+    ASSERT_EQUAL(arena_without_statistics->statistics.pushed_bytes_count, 0);
+    destroy_arena(arena_without_statistics);
+}
+
 REGISTER_TESTS(
     test_copy_memory,
     test_move_memory,
-    test_fill_memory_with_zeros
+    test_fill_memory_with_zeros,
+    test_memory_primitives_with_different_sizes_and_alignments,
+    test_move_memory_with_different_overlaps,
+    test_memory_primitives_with_non_temporal_stores,
+    test_arena_chains_new_blocks,
+    test_arena_pop_to_position_across_blocks,
+    test_arena_reallocate_across_blocks,
+    test_arena_clear_decommits_pages,
+    test_arena_clear_retains_pages_up_to_high_water_mark,
+    test_arena_with_huge_pages,
+    test_arena_statistics
 )
@@ -4,6 +4,7 @@
 
 #include <eon/io.h>
 
+#include <fcntl.h>
 #include <unistd.h>
 #include <sys/mman.h>
 
@@ -22,6 +23,85 @@ platform_get_page_size(void)
     return page_size;
 }
 
+// NOTE(vlad): Returns the number of bytes read, -1 on errors.
+internal Size
+linux_read_small_file(const char* filename, char* buffer, const Size buffer_size)
+{
+    const int fd = open(filename, O_RDONLY);
+    if (fd == -1)
+    {
+        return -1;
+    }
+
+    const ssize_t number_of_bytes_read = read(fd, buffer, (USize)buffer_size);
+    close(fd);
+
+    return number_of_bytes_read;
+}
+
+internal Size
+linux_read_huge_page_size(void)
+{
+    char buffer[128];
+
+    // NOTE(vlad): This file looks like "always [madvise] never", the current mode is in brackets.
+    //             It doesn't exist if the kernel was built without THP.
+    const Size enabled_length = linux_read_small_file("/sys/kernel/mm/transparent_hugepage/enabled",
+                                                      buffer, size_of(buffer));
+    if (enabled_length <= 0)
+    {
+        return 0;
+    }
+
+    const String_View disabled_mode = string_view("[never]");
+    for (Index i = 0;
+         i + disabled_mode.length <= enabled_length;
+         ++i)
+    {
+        const String_View mode = { .data = buffer + i, .length = disabled_mode.length };
+        if (strings_are_equal(mode, disabled_mode))
+        {
+            return 0;
+        }
+    }
+
+    const Size size_length = linux_read_small_file("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size",
+                                                   buffer, size_of(buffer));
+
+    Size huge_page_size = 0;
+    for (Index i = 0;
+         i < size_length && buffer[i] >= '0' && buffer[i] <= '9';
+         ++i)
+    {
+        huge_page_size = huge_page_size * 10 + (buffer[i] - '0');
+    }
+
+    if (huge_page_size <= platform_get_page_size() || !is_power_of_two((USize)huge_page_size))
+    {
+        // NOTE(vlad): Older kernels don't have 'hpage_pmd_size', but they only support
+        //             PMD-sized huge pages on x86-64 anyway.
+        return ARCH_X86_64 ? MiB(2) : 0;
+    }
+
+    return huge_page_size;
+}
+
+// NOTE(vlad): Huge page arenas are created often enough for reading two files every time to
+//             show up. The size is cached by the first call, 'init_io_state' makes it while
+//             there is only one thread.
+internal Size
+platform_get_huge_page_size(void)
+{
+    local_persist Size huge_page_size = -1;
+
+    if (huge_page_size == -1)
+    {
+        huge_page_size = linux_read_huge_page_size();
+    }
+
+    return huge_page_size;
+}
+
 internal Byte*
 platform_reserve_memory(const Size number_of_bytes)
 {
@@ -34,6 +114,47 @@ platform_reserve_memory(const Size number_of_bytes)
     return result;
 }
 
+internal Byte*
+platform_reserve_memory_with_huge_pages(const Size number_of_bytes, const Size huge_page_size)
+{
+    ASSERT(number_of_bytes % huge_page_size == 0);
+
+    // NOTE(vlad): 'mmap' only guarantees page alignment, so reserving one more huge page
+    //             and unmapping everything around the aligned part.
+    const Size number_of_bytes_to_reserve = number_of_bytes + huge_page_size;
+
+    Byte* memory = mmap(NULL, (USize)number_of_bytes_to_reserve, PROT_NONE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED)
+    {
+        return NULL;
+    }
+
+    Byte* aligned_memory = (Byte*)ALIGN_UP_TO_POW2(memory, huge_page_size);
+
+    const Size head_size = aligned_memory - memory;
+    const Size tail_size = number_of_bytes_to_reserve - head_size - number_of_bytes;
+
+    if (head_size > 0)
+    {
+        munmap(memory, (USize)head_size);
+    }
+
+    if (tail_size > 0)
+    {
+        munmap(aligned_memory + number_of_bytes, (USize)tail_size);
+    }
+
+    // NOTE(vlad): The flag sticks to the mapping, pages are backed by huge pages once
+    //             whole aligned huge pages are committed and touched.
+    if (madvise(aligned_memory, (USize)number_of_bytes, MADV_HUGEPAGE) != 0)
+    {
+        munmap(aligned_memory, (USize)number_of_bytes);
+        return NULL;
+    }
+
+    return aligned_memory;
+}
+
 internal Bool
 platform_commit_memory(Byte* pointer, Size number_of_bytes)
 {
@@ -64,6 +185,24 @@ platform_decommit_memory(Byte* pointer, Size number_of_bytes)
     return true;
 }
 
+internal Bool
+platform_decommit_memory_lazily(Byte* pointer, Size number_of_bytes)
+{
+    ASSERT((Size)pointer % platform_get_page_size() == 0);
+
+#if defined(MADV_FREE)
+    const int result = madvise(pointer, (USize)number_of_bytes, MADV_FREE);
+    if (result == 0)
+    {
+        return true;
+    }
+#endif
+
+    // NOTE(vlad): Falling back to 'MADV_DONTNEED' if 'MADV_FREE' is not supported (e.g. Linux
+    //             before 4.5). It drops the pages right away, but they stay accessible anyway.
+    return madvise(pointer, (USize)number_of_bytes, MADV_DONTNEED) == 0;
+}
+
 internal Bool
 platform_release_memory(Byte* pointer, Size number_of_bytes)
 {
@@ -0,0 +1,43 @@
+#if !EON_PLATFORM_THREADS_INCLUDED
+#    error Do not use this file directly. Include "<eon/platform/threads.h>" instead.
+#endif
+
+#include <pthread.h>
+#include <unistd.h> // NOTE(vlad): For 'sysconf'.
+
+struct Thread
+{
+    pthread_t handle;
+
+    Thread_Procedure* procedure;
+    void* argument;
+};
+
+internal Size
+platform_get_number_of_processors(void)
+{
+    const long number_of_processors = sysconf(_SC_NPROCESSORS_ONLN);
+    return (number_of_processors > 0) ? (Size)number_of_processors : 1;
+}
+
+internal void*
+run_thread_procedure(void* thread_pointer)
+{
+    Thread* thread = thread_pointer;
+    thread->procedure(thread->argument);
+    return NULL;
+}
+
+internal Bool
+platform_start_thread(Thread* thread, Thread_Procedure* procedure, void* argument)
+{
+    thread->procedure = procedure;
+    thread->argument = argument;
+    return pthread_create(&thread->handle, NULL, run_thread_procedure, thread) == 0;
+}
+
+internal void
+platform_join_thread(Thread* thread)
+{
+    ASSERT(pthread_join(thread->handle, NULL) == 0);
+}
@@ -22,6 +22,14 @@ platform_get_page_size(void)
     return page_size;
 }
 
+internal Size
+platform_get_huge_page_size(void)
+{
+    // NOTE(vlad): macOS only has superpages for 'mach_vm_allocate' and they are not
+    //             transparent, so not supporting huge pages here.
+    return 0;
+}
+
 internal Byte*
 platform_reserve_memory(const Size number_of_bytes)
 {
@@ -34,6 +42,13 @@ platform_reserve_memory(const Size number_of_bytes)
     return result;
 }
 
+internal Byte*
+platform_reserve_memory_with_huge_pages(const Size number_of_bytes, const Size huge_page_size)
+{
+    UNUSED(number_of_bytes, huge_page_size);
+    return NULL;
+}
+
 internal Bool
 platform_commit_memory(Byte* pointer, Size number_of_bytes)
 {
@@ -64,6 +79,26 @@ platform_decommit_memory(Byte* pointer, Size number_of_bytes)
     return true;
 }
 
+internal Bool
+platform_decommit_memory_lazily(Byte* pointer, Size number_of_bytes)
+{
+    ASSERT((Size)pointer % platform_get_page_size() == 0);
+
+    // NOTE(vlad): With 'MADV_FREE' the pages keep their contents until the system runs short of
+    //             memory and are reused without any further calls. 'MADV_FREE_REUSABLE' would
+    //             also take them out of the process footprint right away, but every reuse
+    //             would then need 'MADV_FREE_REUSE' first, and arenas don't track which pages
+    //             were given back.
+    const int result = madvise(pointer, (USize)number_of_bytes, MADV_FREE);
+    if (result == 0)
+    {
+        return true;
+    }
+
+    // NOTE(vlad): 'MADV_DONTNEED' is only a hint on macOS, the pages stay accessible.
+    return madvise(pointer, (USize)number_of_bytes, MADV_DONTNEED) == 0;
+}
+
 internal Bool
 platform_release_memory(Byte* pointer, Size number_of_bytes)
 {
@@ -5,10 +5,19 @@
 #include <eon/types.h>
 
 internal Size platform_get_page_size(void);
+// NOTE(vlad): Returns 0 if the OS can't back regular allocations with huge pages
+//             or they are disabled.
+internal Size platform_get_huge_page_size(void);
 
 internal Byte* platform_reserve_memory(Size number_of_bytes);
+// NOTE(vlad): Returns NULL if huge pages can't be used for this memory, 'number_of_bytes'
+//             must be a multiple of 'huge_page_size'. The result is aligned to 'huge_page_size'.
+maybe_unused internal Byte* platform_reserve_memory_with_huge_pages(Size number_of_bytes, Size huge_page_size);
 internal Bool platform_commit_memory(Byte* pointer, Size number_of_bytes);
 maybe_unused internal Bool platform_decommit_memory(Byte* pointer, Size number_of_bytes);
+// NOTE(vlad): Pages stay accessible, but the OS may take them back when it's low on memory.
+//             Their contents are undefined after this call.
+maybe_unused internal Bool platform_decommit_memory_lazily(Byte* pointer, Size number_of_bytes);
 internal Bool platform_release_memory(Byte* pointer, Size number_of_bytes);
 
 #if OS_WINDOWS
@@ -0,0 +1,27 @@
+#pragma once
+#define EON_PLATFORM_THREADS_INCLUDED 1
+
+#include <eon/common.h>
+#include <eon/keywords.h>
+
+typedef void Thread_Procedure(void* argument);
+
+// NOTE(vlad): Defined by every platform, must stay alive until the thread is joined.
+struct Thread;
+typedef struct Thread Thread;
+
+// NOTE(vlad): Returns at least 1, even if the OS can't tell.
+maybe_unused internal Size platform_get_number_of_processors(void);
+
+maybe_unused internal Bool platform_start_thread(Thread* thread, Thread_Procedure* procedure, void* argument);
+maybe_unused internal void platform_join_thread(Thread* thread);
+
+#if OS_LINUX
+#    include "linux_threads.c"
+#elif OS_MAC
+#    include "macos_threads.c"
+#elif OS_WINDOWS
+#    include "win32_threads.c"
+#else
+#    error This OS is not supported yet.
+#endif
@@ -14,12 +14,27 @@ platform_get_page_size(void)
     return info.dwPageSize;
 }
 
+internal Size
+platform_get_huge_page_size(void)
+{
+    // NOTE(vlad): Large pages require 'SeLockMemoryPrivilege' and have to be committed
+    //             all at once, so not supporting them here.
+    return 0;
+}
+
 internal Byte*
 platform_reserve_memory(const Size number_of_bytes)
 {
     return VirtualAlloc(NULL, (USize)number_of_bytes, MEM_RESERVE, PAGE_READWRITE);
 }
 
+internal Byte*
+platform_reserve_memory_with_huge_pages(const Size number_of_bytes, const Size huge_page_size)
+{
+    UNUSED(number_of_bytes, huge_page_size);
+    return NULL;
+}
+
 internal Bool
 platform_commit_memory(Byte* pointer, Size number_of_bytes)
 {
@@ -33,6 +48,13 @@ platform_decommit_memory(Byte* pointer, Size number_of_bytes)
     return VirtualFree(pointer, (USize)number_of_bytes, MEM_DECOMMIT);
 }
 
+internal Bool
+platform_decommit_memory_lazily(Byte* pointer, Size number_of_bytes)
+{
+    const Byte* result = VirtualAlloc(pointer, (USize)number_of_bytes, MEM_RESET, PAGE_READWRITE);
+    return result != NULL;
+}
+
 internal Bool
 platform_release_memory(Byte* pointer, Size number_of_bytes)
 {
@@ -0,0 +1,50 @@
+#if !EON_PLATFORM_THREADS_INCLUDED
+#    error Do not use this file directly. Include "<eon/platform/threads.h>" instead.
+#endif
+
+// FIXME(vlad): Test this on Windows.
+
+#include "win32_hacks.h"
+#include <windows.h>
+
+struct Thread
+{
+    HANDLE handle;
+
+    Thread_Procedure* procedure;
+    void* argument;
+};
+
+internal Size
+platform_get_number_of_processors(void)
+{
+    SYSTEM_INFO info = {0};
+    GetSystemInfo(&info);
+    return (info.dwNumberOfProcessors > 0) ? (Size)info.dwNumberOfProcessors : 1;
+}
+
+internal DWORD WINAPI
+run_thread_procedure(LPVOID thread_pointer)
+{
+    Thread* thread = thread_pointer;
+    thread->procedure(thread->argument);
+    return 0;
+}
+
+internal Bool
+platform_start_thread(Thread* thread, Thread_Procedure* procedure, void* argument)
+{
+    thread->procedure = procedure;
+    thread->argument = argument;
+    thread->handle = CreateThread(NULL, 0, run_thread_procedure, thread, 0, NULL);
+    return thread->handle != NULL;
+}
+
+internal void
+platform_join_thread(Thread* thread)
+{
+    ASSERT(WaitForSingleObject(thread->handle, INFINITE) == WAIT_OBJECT_0);
+    CloseHandle(thread->handle);
+}
+
+#include "win32_restore_hacks.h" // IWYU pragma: export
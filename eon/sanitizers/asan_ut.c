@@ -13,6 +13,7 @@
 #    endif
 #endif
 
+#include <eon/containers.h>
 #include <eon/memory.h>
 #include <eon/sanitizers/asan.h>
 
@@ -187,8 +188,142 @@ test_buffer_underruns_in_arenas(Test_Context* test_context)
     }
 }
 
+internal void
+test_redzones_in_arenas(Test_Context* test_context)
+{
+    // NOTE(vlad): Overrun into the padding up to the next shadow granule.
+    {
+        global_sanitizer_was_triggered = false;
+
+        Arena* arena = create_arena("asan-test-arena", MiB(1), MiB(1));
+
+        char* characters = allocate_array(arena, 3, char);
+        char* other_characters = allocate_array(arena, 3, char);
+        UNUSED(other_characters);
+
+        characters[3] = 'a';
+
+        ASSERT_TRUE(global_sanitizer_was_triggered);
+
+        destroy_arena(arena);
+    }
+
+    // NOTE(vlad): Small allocations don't waste pages on redzones.
+    {
+        global_sanitizer_was_triggered = false;
+
+        Arena* arena = create_arena("asan-test-arena", MiB(1), MiB(1));
+
+        const Index position = arena_get_position(arena);
+        for (Index i = 0;
+             i < 1000;
+             ++i)
+        {
+            allocate(arena, int);
+        }
+
+        ASSERT_TRUE(arena_get_position(arena) - position <= 1000 * 64);
+        ASSERT_FALSE(global_sanitizer_was_triggered);
+
+        destroy_arena(arena);
+    }
+
+    // NOTE(vlad): Page-sized redzones find overruns that skip over small redzones.
+    {
+        enum { TEST_ARRAY_SIZE = 10 };
+
+        global_sanitizer_was_triggered = false;
+
+        Arena* arena = create_arena_with_flags("asan-test-arena", MiB(1), MiB(1), ARENA_FLAG_PAGE_SIZED_REDZONES);
+
+        int* values = allocate_array(arena, TEST_ARRAY_SIZE, int);
+        int* other_values = allocate_array(arena, TEST_ARRAY_SIZE, int);
+        UNUSED(other_values);
+
+        values[TEST_ARRAY_SIZE + 64] = 10;
+
+        ASSERT_TRUE(global_sanitizer_was_triggered);
+
+        destroy_arena(arena);
+    }
+}
+
+internal void
+test_arrays(Test_Context* test_context)
+{
+    struct Array
+    {
+        array(int, values);
+    };
+    typedef struct Array Array;
+
+    // NOTE(vlad): Use after move when the array grows.
+    {
+        global_sanitizer_was_triggered = false;
+
+        Arena* arena = create_arena("asan-test-arena", MiB(1), MiB(1));
+
+        Array array = {0};
+        append_array(arena, array.values, int, 10);
+
+        int* first_value = &array.values[0];
+        while (array.values_count < array.values_capacity)
+        {
+            append_array(arena, array.values, int, 20);
+        }
+
+        *first_value = 30;
+        ASSERT_FALSE(global_sanitizer_was_triggered);
+
+        append_array(arena, array.values, int, 20);
+
+        *first_value = 30;
+        ASSERT_TRUE(global_sanitizer_was_triggered);
+
+        destroy_arena(arena);
+    }
+
+    // NOTE(vlad): Access to the unused capacity.
+    {
+        global_sanitizer_was_triggered = false;
+
+        Arena* arena = create_arena("asan-test-arena", MiB(1), MiB(1));
+
+        Array array = {0};
+        append_array(arena, array.values, int, 10);
+        append_array(arena, array.values, int, 20);
+        append_array(arena, array.values, int, 30);
+
+        ASSERT_TRUE(array.values_capacity > array.values_count);
+
+        array.values[array.values_count] = 40;
+        ASSERT_TRUE(global_sanitizer_was_triggered);
+
+        destroy_arena(arena);
+    }
+
+    // NOTE(vlad): Access to a removed element.
+    {
+        global_sanitizer_was_triggered = false;
+
+        Arena* arena = create_arena("asan-test-arena", MiB(1), MiB(1));
+
+        Array array = {0};
+        append_array(arena, array.values, int, 10);
+        append_array(arena, array.values, int, 20);
+        remove_last_array_element(array.values, int);
+
+        array.values[1] = 40;
+        ASSERT_TRUE(global_sanitizer_was_triggered);
+
+        destroy_arena(arena);
+    }
+}
+
 REGISTER_TESTS(
     test_use_after_free_in_arenas,
     test_buffer_overruns_in_arenas,
-    test_buffer_underruns_in_arenas
+    test_buffer_underruns_in_arenas,
+    test_redzones_in_arenas,
+    test_arrays
 )
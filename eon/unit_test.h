@@ -75,7 +75,9 @@ main(const int argc, const char* argv[])
     Tests_Registry registry = {0};
     registry_register_tests(test_registry_arena, &registry);
 
-    Arena* test_arena = create_arena("unit-test-arena", GiB(1), MiB(1));
+    // NOTE(vlad): This arena is cleared after every test.
+    Arena* test_arena = create_arena_with_flags("unit-test-arena", GiB(1), MiB(1),
+                                                ARENA_FLAG_RETAIN_COMMITTED_PAGES);
 
     const Timestamp tests_start_timestamp = platform_get_current_monotonic_timestamp();
 
@@ -86,7 +88,7 @@ main(const int argc, const char* argv[])
         Test_Context test_context = {0};
         test_context.arena = test_arena;
 
-        const Size initial_free_memory_offset = test_arena->free_memory_offset;
+        const Index initial_position = arena_get_position(test_arena);
 
         Test_Info* test = &registry.tests[i];
         test->run(&test_context);
@@ -103,7 +105,7 @@ main(const int argc, const char* argv[])
             registry.failed_tests_count += 1;
         }
 
-        test->memory_consumption_in_bytes = test_arena->free_memory_offset - initial_free_memory_offset;
+        test->memory_consumption_in_bytes = arena_get_position(test_arena) - initial_position;
 
         arena_clear(test_arena);
     }
@@ -103,3 +103,18 @@ validate_ast(Compilation_Context* context)
         validate_ast_jumps_in_code_block(context, NULL, &function->body);
     }
 }
+
+internal inline Ast_Expression*
+get_ast_expression_by_id(Ast* ast, const Ast_Expression_Id id)
+{
+    ASSERT(id != INVALID_AST_EXPRESSION_ID);
+    ASSERT(id < ast->expressions_count);
+    return &ast->expressions[id];
+}
+
+internal inline Ast_Expression_Id
+get_ast_call_argument_id(const Ast* ast, const Ast_Call* call, const Index argument_index)
+{
+    ASSERT(0 <= argument_index && argument_index < call->arguments_count);
+    return ast->call_arguments[call->first_argument_index + argument_index];
+}
@@ -7,7 +7,6 @@
 #include "eon_lexer.h"
 
 struct Ast_Type;
-struct Ast_Expression;
 struct Ast_Statement;
 
 struct Ast_Identifier
@@ -24,9 +23,9 @@ struct Ast_Number
 };
 typedef struct Ast_Number Ast_Number;
 
+// NOTE(vlad): The quoted literal is the location of the expression.
 struct Ast_String_Literal
 {
-    Token token;
     String_View value;
 };
 typedef struct Ast_String_Literal Ast_String_Literal;
@@ -67,26 +66,32 @@ enum Ast_Expression_Type
 };
 typedef enum Ast_Expression_Type Ast_Expression_Kind;
 
+// NOTE(vlad): Expressions live in 'Ast.expressions' and refer to each other by ids, which
+//             keeps the nodes small and lets the passes keep per-expression data in side
+//             tables indexed by the same ids instead of the nodes themselves.
+
 struct Ast_Unary_Expression
 {
     Token operator;
-    struct Ast_Expression* operand;
+    Ast_Expression_Id operand;
 };
 typedef struct Ast_Unary_Expression Ast_Unary_Expression;
 
 struct Ast_Binary_Expression
 {
     Token operator;
-    struct Ast_Expression* lhs;
-    struct Ast_Expression* rhs;
+    Ast_Expression_Id lhs;
+    Ast_Expression_Id rhs;
 };
 typedef struct Ast_Binary_Expression Ast_Binary_Expression;
 
+// NOTE(vlad): Arguments of a call are stored contiguously in 'Ast.call_arguments'.
 struct Ast_Call
 {
-    struct Ast_Expression* called_expression;
+    Ast_Expression_Id called_expression;
 
-    array(struct Ast_Expression*, arguments);
+    u32 first_argument_index;
+    u32 arguments_count;
 };
 typedef struct Ast_Call Ast_Call;
 
@@ -96,10 +101,6 @@ struct Ast_Expression
 
     Ast_Expression_Kind kind;
 
-    Type_Id type_id;
-
-    Tac_Instructions_Range tac_instructions_range;
-
     union
     {
         Ast_Number number;
@@ -145,7 +146,7 @@ struct Ast_Function_Parameter
     struct Ast_Type* type;
 
     Bool has_default_value;
-    Ast_Expression default_value;
+    Ast_Expression_Id default_value;
 };
 typedef struct Ast_Function_Parameter Ast_Function_Parameter;
 
@@ -214,14 +215,14 @@ struct Ast_Variable_Definition
     Ast_Type* type;
 
     Bool has_initial_value;
-    Ast_Expression initial_value;
+    Ast_Expression_Id initial_value;
 };
 typedef struct Ast_Variable_Definition Ast_Variable_Definition;
 
 struct Ast_Assignment
 {
-    Ast_Expression lhs;
-    Ast_Expression rhs;
+    Ast_Expression_Id lhs;
+    Ast_Expression_Id rhs;
 };
 typedef struct Ast_Assignment Ast_Assignment;
 
@@ -230,7 +231,7 @@ struct Ast_Return_Statement
     Bool is_empty;
     union
     {
-        Ast_Expression expression;
+        Ast_Expression_Id expression;
         Source_Location empty_expression_location;
     };
 };
@@ -238,7 +239,7 @@ typedef struct Ast_Return_Statement Ast_Return_Statement;
 
 struct Ast_If_Statement
 {
-    Ast_Expression condition;
+    Ast_Expression_Id condition;
     Ast_Code_Block if_statements; // TODO(vlad): Rename to 'then_statements'?
     Ast_Code_Block else_statements; // TODO(vlad): Rename to 'else_statements'?
 };
@@ -246,7 +247,7 @@ typedef struct Ast_If_Statement Ast_If_Statement;
 
 struct Ast_While_Statement
 {
-    Ast_Expression condition;
+    Ast_Expression_Id condition;
     Ast_Code_Block body;
 
     Tac_Label_Id start_label_id;
@@ -256,7 +257,7 @@ typedef struct Ast_While_Statement Ast_While_Statement;
 
 struct Ast_Call_Statement
 {
-    Ast_Expression call_expression;
+    Ast_Expression_Id call_expression;
 };
 typedef struct Ast_Call_Statement Ast_Call_Statement;
 
@@ -292,6 +293,10 @@ struct Ast_Function_Definition
     Ast_Identifier name;
     Ast_Type* type;
 
+    // NOTE(vlad): The body is left empty if it didn't change since the previous compilation,
+    //             see 'Function_Fingerprint.is_reused'. Its TAC is copied from there.
+    Bool body_is_reused;
+    Index fingerprint_index;
     Ast_Code_Block body;
 };
 typedef struct Ast_Function_Definition Ast_Function_Definition;
@@ -299,8 +304,17 @@ typedef struct Ast_Function_Definition Ast_Function_Definition;
 struct Ast
 {
     array(Ast_Function_Definition, function_definitions);
+
+    // NOTE(vlad): Indexed by 'Ast_Expression_Id', the first one is reserved for 'INVALID_AST_EXPRESSION_ID'.
+    array(Ast_Expression, expressions);
+    array(Ast_Expression_Id, call_arguments);
 };
 typedef struct Ast Ast;
 
 maybe_unused internal void validate_ast(struct Compilation_Context* context);
 
+maybe_unused internal inline Ast_Expression* get_ast_expression_by_id(Ast* ast, const Ast_Expression_Id id);
+maybe_unused internal inline Ast_Expression_Id get_ast_call_argument_id(const Ast* ast,
+                                                                       const Ast_Call* call,
+                                                                       const Index argument_index);
+
@@ -50,30 +50,30 @@ test_break_and_continue_statements_validation(Test_Context* test_context)
 
         {
             const Ast_Statement* statement = &function_definition->body.statements[0];
-            ASSERT_EQUAL(statement->start_location.line, 1);
-            ASSERT_EQUAL(statement->start_location.column, 4);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 1);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_WHILE);
 
             const Ast_While_Statement* while_statement = &statement->while_statement;
 
-            const Ast_Expression* condition = &while_statement->condition;
+            const Ast_Expression* condition = AST_EXPRESSION(while_statement->condition);
             ASSERT_ENUM_VALUES_ARE_EQUAL(condition->kind, AST_EXPRESSION_NOT_EQUAL);
             ASSERT_STRINGS_ARE_EQUAL(condition->binary_expression.operator.lexeme, "!=");
 
-            ASSERT_ENUM_VALUES_ARE_EQUAL(condition->binary_expression.lhs->kind, AST_EXPRESSION_NUMBER);
-            ASSERT_STRINGS_ARE_EQUAL(condition->binary_expression.lhs->number.token.lexeme, "1");
-            ASSERT_FALSE(condition->binary_expression.lhs->number.is_a_floating_point_number);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(condition->binary_expression.lhs)->kind, AST_EXPRESSION_NUMBER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(condition->binary_expression.lhs)->number.token.lexeme, "1");
+            ASSERT_FALSE(AST_EXPRESSION(condition->binary_expression.lhs)->number.is_a_floating_point_number);
 
-            ASSERT_ENUM_VALUES_ARE_EQUAL(condition->binary_expression.rhs->kind, AST_EXPRESSION_NUMBER);
-            ASSERT_STRINGS_ARE_EQUAL(condition->binary_expression.rhs->number.token.lexeme, "2");
-            ASSERT_FALSE(condition->binary_expression.rhs->number.is_a_floating_point_number);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(condition->binary_expression.rhs)->kind, AST_EXPRESSION_NUMBER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(condition->binary_expression.rhs)->number.token.lexeme, "2");
+            ASSERT_FALSE(AST_EXPRESSION(condition->binary_expression.rhs)->number.is_a_floating_point_number);
 
             ASSERT_EQUAL(while_statement->body.statements_count, 1);
 
             const Ast_Statement* inner_statement = &while_statement->body.statements[0];
-            ASSERT_EQUAL(inner_statement->start_location.line, 3);
-            ASSERT_EQUAL(inner_statement->start_location.column, 8);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, inner_statement->start_location).line, 3);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, inner_statement->start_location).column, 8);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(inner_statement->kind, AST_STATEMENT_BREAK);
             ASSERT_STRINGS_ARE_EQUAL(inner_statement->jump.token.lexeme, "break");
@@ -128,30 +128,30 @@ test_break_and_continue_statements_validation(Test_Context* test_context)
 
         {
             const Ast_Statement* statement = &function_definition->body.statements[0];
-            ASSERT_EQUAL(statement->start_location.line, 1);
-            ASSERT_EQUAL(statement->start_location.column, 4);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 1);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_WHILE);
 
             const Ast_While_Statement* while_statement = &statement->while_statement;
 
-            const Ast_Expression* condition = &while_statement->condition;
+            const Ast_Expression* condition = AST_EXPRESSION(while_statement->condition);
             ASSERT_ENUM_VALUES_ARE_EQUAL(condition->kind, AST_EXPRESSION_NOT_EQUAL);
             ASSERT_STRINGS_ARE_EQUAL(condition->binary_expression.operator.lexeme, "!=");
 
-            ASSERT_ENUM_VALUES_ARE_EQUAL(condition->binary_expression.lhs->kind, AST_EXPRESSION_NUMBER);
-            ASSERT_STRINGS_ARE_EQUAL(condition->binary_expression.lhs->number.token.lexeme, "1");
-            ASSERT_FALSE(condition->binary_expression.lhs->number.is_a_floating_point_number);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(condition->binary_expression.lhs)->kind, AST_EXPRESSION_NUMBER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(condition->binary_expression.lhs)->number.token.lexeme, "1");
+            ASSERT_FALSE(AST_EXPRESSION(condition->binary_expression.lhs)->number.is_a_floating_point_number);
 
-            ASSERT_ENUM_VALUES_ARE_EQUAL(condition->binary_expression.rhs->kind, AST_EXPRESSION_NUMBER);
-            ASSERT_STRINGS_ARE_EQUAL(condition->binary_expression.rhs->number.token.lexeme, "2");
-            ASSERT_FALSE(condition->binary_expression.rhs->number.is_a_floating_point_number);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(condition->binary_expression.rhs)->kind, AST_EXPRESSION_NUMBER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(condition->binary_expression.rhs)->number.token.lexeme, "2");
+            ASSERT_FALSE(AST_EXPRESSION(condition->binary_expression.rhs)->number.is_a_floating_point_number);
 
             ASSERT_EQUAL(while_statement->body.statements_count, 1);
 
             const Ast_Statement* inner_statement = &while_statement->body.statements[0];
-            ASSERT_EQUAL(inner_statement->start_location.line, 3);
-            ASSERT_EQUAL(inner_statement->start_location.column, 8);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, inner_statement->start_location).line, 3);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, inner_statement->start_location).column, 8);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(inner_statement->kind, AST_STATEMENT_CONTINUE);
             ASSERT_STRINGS_ARE_EQUAL(inner_statement->jump.token.lexeme, "continue");
@@ -209,31 +209,31 @@ test_break_and_continue_statements_validation(Test_Context* test_context)
 
         {
             const Ast_Statement* statement = &function_definition->body.statements[0];
-            ASSERT_EQUAL(statement->start_location.line, 1);
-            ASSERT_EQUAL(statement->start_location.column, 4);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 1);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_WHILE);
 
             const Ast_While_Statement* while_statement = &statement->while_statement;
 
-            const Ast_Expression* condition = &while_statement->condition;
+            const Ast_Expression* condition = AST_EXPRESSION(while_statement->condition);
             ASSERT_ENUM_VALUES_ARE_EQUAL(condition->kind, AST_EXPRESSION_NOT_EQUAL);
             ASSERT_STRINGS_ARE_EQUAL(condition->binary_expression.operator.lexeme, "!=");
 
-            ASSERT_ENUM_VALUES_ARE_EQUAL(condition->binary_expression.lhs->kind, AST_EXPRESSION_NUMBER);
-            ASSERT_STRINGS_ARE_EQUAL(condition->binary_expression.lhs->number.token.lexeme, "1");
-            ASSERT_FALSE(condition->binary_expression.lhs->number.is_a_floating_point_number);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(condition->binary_expression.lhs)->kind, AST_EXPRESSION_NUMBER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(condition->binary_expression.lhs)->number.token.lexeme, "1");
+            ASSERT_FALSE(AST_EXPRESSION(condition->binary_expression.lhs)->number.is_a_floating_point_number);
 
-            ASSERT_ENUM_VALUES_ARE_EQUAL(condition->binary_expression.rhs->kind, AST_EXPRESSION_NUMBER);
-            ASSERT_STRINGS_ARE_EQUAL(condition->binary_expression.rhs->number.token.lexeme, "2");
-            ASSERT_FALSE(condition->binary_expression.rhs->number.is_a_floating_point_number);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(condition->binary_expression.rhs)->kind, AST_EXPRESSION_NUMBER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(condition->binary_expression.rhs)->number.token.lexeme, "2");
+            ASSERT_FALSE(AST_EXPRESSION(condition->binary_expression.rhs)->number.is_a_floating_point_number);
 
             ASSERT_EQUAL(while_statement->body.statements_count, 4);
 
             {
                 const Ast_Statement* inner_statement = &while_statement->body.statements[0];
-                ASSERT_EQUAL(inner_statement->start_location.line, 3);
-                ASSERT_EQUAL(inner_statement->start_location.column, 8);
+                ASSERT_EQUAL(resolve_source_location(&context.source_file, inner_statement->start_location).line, 3);
+                ASSERT_EQUAL(resolve_source_location(&context.source_file, inner_statement->start_location).column, 8);
 
                 ASSERT_ENUM_VALUES_ARE_EQUAL(inner_statement->kind, AST_STATEMENT_BREAK);
                 ASSERT_STRINGS_ARE_EQUAL(inner_statement->jump.token.lexeme, "break");
@@ -242,8 +242,8 @@ test_break_and_continue_statements_validation(Test_Context* test_context)
 
             {
                 const Ast_Statement* inner_statement = &while_statement->body.statements[1];
-                ASSERT_EQUAL(inner_statement->start_location.line, 4);
-                ASSERT_EQUAL(inner_statement->start_location.column, 8);
+                ASSERT_EQUAL(resolve_source_location(&context.source_file, inner_statement->start_location).line, 4);
+                ASSERT_EQUAL(resolve_source_location(&context.source_file, inner_statement->start_location).column, 8);
 
                 ASSERT_ENUM_VALUES_ARE_EQUAL(inner_statement->kind, AST_STATEMENT_BREAK);
                 ASSERT_STRINGS_ARE_EQUAL(inner_statement->jump.token.lexeme, "break");
@@ -252,8 +252,8 @@ test_break_and_continue_statements_validation(Test_Context* test_context)
 
             {
                 const Ast_Statement* inner_statement = &while_statement->body.statements[2];
-                ASSERT_EQUAL(inner_statement->start_location.line, 5);
-                ASSERT_EQUAL(inner_statement->start_location.column, 8);
+                ASSERT_EQUAL(resolve_source_location(&context.source_file, inner_statement->start_location).line, 5);
+                ASSERT_EQUAL(resolve_source_location(&context.source_file, inner_statement->start_location).column, 8);
 
                 ASSERT_ENUM_VALUES_ARE_EQUAL(inner_statement->kind, AST_STATEMENT_BREAK);
                 ASSERT_STRINGS_ARE_EQUAL(inner_statement->jump.token.lexeme, "break");
@@ -262,8 +262,8 @@ test_break_and_continue_statements_validation(Test_Context* test_context)
 
             {
                 const Ast_Statement* inner_statement = &while_statement->body.statements[3];
-                ASSERT_EQUAL(inner_statement->start_location.line, 6);
-                ASSERT_EQUAL(inner_statement->start_location.column, 8);
+                ASSERT_EQUAL(resolve_source_location(&context.source_file, inner_statement->start_location).line, 6);
+                ASSERT_EQUAL(resolve_source_location(&context.source_file, inner_statement->start_location).column, 8);
 
                 ASSERT_ENUM_VALUES_ARE_EQUAL(inner_statement->kind, AST_STATEMENT_BREAK);
                 ASSERT_STRINGS_ARE_EQUAL(inner_statement->jump.token.lexeme, "break");
@@ -322,31 +322,31 @@ test_break_and_continue_statements_validation(Test_Context* test_context)
 
         {
             const Ast_Statement* statement = &function_definition->body.statements[0];
-            ASSERT_EQUAL(statement->start_location.line, 1);
-            ASSERT_EQUAL(statement->start_location.column, 4);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 1);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_WHILE);
 
             const Ast_While_Statement* while_statement = &statement->while_statement;
 
-            const Ast_Expression* condition = &while_statement->condition;
+            const Ast_Expression* condition = AST_EXPRESSION(while_statement->condition);
             ASSERT_ENUM_VALUES_ARE_EQUAL(condition->kind, AST_EXPRESSION_NOT_EQUAL);
             ASSERT_STRINGS_ARE_EQUAL(condition->binary_expression.operator.lexeme, "!=");
 
-            ASSERT_ENUM_VALUES_ARE_EQUAL(condition->binary_expression.lhs->kind, AST_EXPRESSION_NUMBER);
-            ASSERT_STRINGS_ARE_EQUAL(condition->binary_expression.lhs->number.token.lexeme, "1");
-            ASSERT_FALSE(condition->binary_expression.lhs->number.is_a_floating_point_number);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(condition->binary_expression.lhs)->kind, AST_EXPRESSION_NUMBER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(condition->binary_expression.lhs)->number.token.lexeme, "1");
+            ASSERT_FALSE(AST_EXPRESSION(condition->binary_expression.lhs)->number.is_a_floating_point_number);
 
-            ASSERT_ENUM_VALUES_ARE_EQUAL(condition->binary_expression.rhs->kind, AST_EXPRESSION_NUMBER);
-            ASSERT_STRINGS_ARE_EQUAL(condition->binary_expression.rhs->number.token.lexeme, "2");
-            ASSERT_FALSE(condition->binary_expression.rhs->number.is_a_floating_point_number);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(condition->binary_expression.rhs)->kind, AST_EXPRESSION_NUMBER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(condition->binary_expression.rhs)->number.token.lexeme, "2");
+            ASSERT_FALSE(AST_EXPRESSION(condition->binary_expression.rhs)->number.is_a_floating_point_number);
 
             ASSERT_EQUAL(while_statement->body.statements_count, 4);
 
             {
                 const Ast_Statement* inner_statement = &while_statement->body.statements[0];
-                ASSERT_EQUAL(inner_statement->start_location.line, 3);
-                ASSERT_EQUAL(inner_statement->start_location.column, 8);
+                ASSERT_EQUAL(resolve_source_location(&context.source_file, inner_statement->start_location).line, 3);
+                ASSERT_EQUAL(resolve_source_location(&context.source_file, inner_statement->start_location).column, 8);
 
                 ASSERT_ENUM_VALUES_ARE_EQUAL(inner_statement->kind, AST_STATEMENT_BREAK);
                 ASSERT_STRINGS_ARE_EQUAL(inner_statement->jump.token.lexeme, "break");
@@ -355,8 +355,8 @@ test_break_and_continue_statements_validation(Test_Context* test_context)
 
             {
                 const Ast_Statement* inner_statement = &while_statement->body.statements[1];
-                ASSERT_EQUAL(inner_statement->start_location.line, 4);
-                ASSERT_EQUAL(inner_statement->start_location.column, 8);
+                ASSERT_EQUAL(resolve_source_location(&context.source_file, inner_statement->start_location).line, 4);
+                ASSERT_EQUAL(resolve_source_location(&context.source_file, inner_statement->start_location).column, 8);
 
                 ASSERT_ENUM_VALUES_ARE_EQUAL(inner_statement->kind, AST_STATEMENT_BREAK);
                 ASSERT_STRINGS_ARE_EQUAL(inner_statement->jump.token.lexeme, "break");
@@ -365,8 +365,8 @@ test_break_and_continue_statements_validation(Test_Context* test_context)
 
             {
                 const Ast_Statement* inner_statement = &while_statement->body.statements[2];
-                ASSERT_EQUAL(inner_statement->start_location.line, 5);
-                ASSERT_EQUAL(inner_statement->start_location.column, 8);
+                ASSERT_EQUAL(resolve_source_location(&context.source_file, inner_statement->start_location).line, 5);
+                ASSERT_EQUAL(resolve_source_location(&context.source_file, inner_statement->start_location).column, 8);
 
                 ASSERT_ENUM_VALUES_ARE_EQUAL(inner_statement->kind, AST_STATEMENT_BREAK);
                 ASSERT_STRINGS_ARE_EQUAL(inner_statement->jump.token.lexeme, "break");
@@ -375,8 +375,8 @@ test_break_and_continue_statements_validation(Test_Context* test_context)
 
             {
                 const Ast_Statement* inner_statement = &while_statement->body.statements[3];
-                ASSERT_EQUAL(inner_statement->start_location.line, 6);
-                ASSERT_EQUAL(inner_statement->start_location.column, 8);
+                ASSERT_EQUAL(resolve_source_location(&context.source_file, inner_statement->start_location).line, 6);
+                ASSERT_EQUAL(resolve_source_location(&context.source_file, inner_statement->start_location).column, 8);
 
                 ASSERT_ENUM_VALUES_ARE_EQUAL(inner_statement->kind, AST_STATEMENT_BREAK);
                 ASSERT_STRINGS_ARE_EQUAL(inner_statement->jump.token.lexeme, "break");
@@ -386,14 +386,14 @@ test_break_and_continue_statements_validation(Test_Context* test_context)
 
         {
             const Ast_Statement* statement = &function_definition->body.statements[1];
-            ASSERT_EQUAL(statement->start_location.line, 8);
-            ASSERT_EQUAL(statement->start_location.column, 4);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 8);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_RETURN);
             ASSERT_FALSE(statement->return_statement.is_empty);
-            ASSERT_ENUM_VALUES_ARE_EQUAL(statement->return_statement.expression.kind, AST_EXPRESSION_NUMBER);
-            ASSERT_STRINGS_ARE_EQUAL(statement->return_statement.expression.number.token.lexeme, "10");
-            ASSERT_FALSE(statement->return_statement.expression.number.is_a_floating_point_number);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(statement->return_statement.expression)->kind, AST_EXPRESSION_NUMBER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(statement->return_statement.expression)->number.token.lexeme, "10");
+            ASSERT_FALSE(AST_EXPRESSION(statement->return_statement.expression)->number.is_a_floating_point_number);
         }
 
         destroy_parser(&parser);
@@ -14,29 +14,6 @@ create_cfg_block(Compilation_Context* context,
 
     Cfg_Block* block = &tac_function->cfg_blocks[this_block_index];
 
-    block->edges_arena = acquire_arena_from_provider(context->arena_provider,
-                                                     string_view("cfg-edges"),
-                                                     GiB(1),
-                                                     MiB(1));
-    block->predecessors_arena = acquire_arena_from_provider(context->arena_provider,
-                                                            string_view("cfg-predecessors"),
-                                                            GiB(1),
-                                                            MiB(1));
-    block->dominance_frontier_arena = acquire_arena_from_provider(context->arena_provider,
-                                                                  string_view("cfg-dominance-frontier"),
-                                                                  GiB(1),
-                                                                  MiB(1));
-
-    block->phi_nodes_arena = acquire_arena_from_provider(context->arena_provider,
-                                                         string_view("cfg-phi-nodes"),
-                                                         GiB(1),
-                                                         MiB(1));
-
-    block->dominated_block_ids_arena = acquire_arena_from_provider(context->arena_provider,
-                                                                   string_view("cfg-dominated-block-ids"),
-                                                                   GiB(1),
-                                                                   MiB(1));
-
     block->instructions_range = instructions_range;
     block->immediate_dominator_id.index = INVALID_CFG_BLOCK_INDEX;
 
@@ -65,10 +42,9 @@ tac_function_label_ids_are_equal(const Tac_Function_Label_Id lhs, const Tac_Func
     return lhs.index == rhs.index;
 }
 
-internal void
-insert_edge(Cfg_Block* block, const Cfg_Block_Id new_block_id)
+internal inline void
+append_cfg_edge_if_needed(Cfg_Block* block, const Cfg_Block_Id new_block_id)
 {
-    Bool should_append_edge = true;
     for (Index edge_index = 0;
          edge_index < block->edges_count;
          ++edge_index)
@@ -76,18 +52,12 @@ insert_edge(Cfg_Block* block, const Cfg_Block_Id new_block_id)
         const Cfg_Block_Id edge_id = block->edges[edge_index];
         if (edge_id.index == new_block_id.index)
         {
-            should_append_edge = false;
-            break;
+            return;
         }
     }
 
-    if (should_append_edge)
-    {
-        append_array(block->edges_arena,
-                     block->edges,
-                     Cfg_Block_Id,
-                     new_block_id);
-    }
+    // NOTE(vlad): The memory for this edge was reserved in 'wire_cfg_edges'.
+    block->edges[block->edges_count++] = new_block_id;
 }
 
 internal Bool
@@ -110,33 +80,6 @@ remove_edge(Cfg_Block* block, const Cfg_Block_Id block_id)
     return false;
 }
 
-internal void
-insert_predecessor(Cfg_Block* block, const Cfg_Block_Id new_block_id)
-{
-    Bool should_append_predecessor = true;
-    for (Index predecessor_index = 0;
-         predecessor_index < block->predecessors_count;
-         ++predecessor_index)
-    {
-        const Cfg_Block_Id predecessor_id = block->predecessors[predecessor_index];
-        if (predecessor_id.index == new_block_id.index)
-        {
-            should_append_predecessor = false;
-            break;
-        }
-    }
-
-    if (should_append_predecessor)
-    {
-        append_array(block->predecessors_arena,
-                     block->predecessors,
-                     Cfg_Block_Id,
-                     new_block_id);
-
-        ASSERT(block->phi_nodes_count == 0);
-    }
-}
-
 internal Bool
 remove_predecessor(Cfg_Block* block, const Cfg_Block_Id block_id)
 {
@@ -336,32 +279,22 @@ remove_last_cfg_block(Compilation_Context* context, Tac_Function* tac_function)
         }
     }
 
-    free_cfg_block(context, last_block);
-
     remove_last_array_element(tac_function->cfg_blocks, Cfg_Block);
 }
 
-internal void
-add_cfg_edge(Tac_Function* tac_function,
-             const Cfg_Block_Id source_block_id,
-             const Cfg_Block_Id destination_block_id)
-{
-    Cfg_Block* source_block = get_cfg_block_by_id(tac_function, source_block_id);
-    Cfg_Block* destination_block = get_cfg_block_by_id(tac_function, destination_block_id);
-
-    insert_edge(source_block, destination_block_id);
-    insert_predecessor(destination_block, source_block_id);
-}
-
-internal inline void
-add_cfg_fall_through_edge_if_needed(Tac_Function* tac_function, const Cfg_Block_Id source_block_id)
+// NOTE(vlad): Returns INVALID_CFG_BLOCK_INDEX if the block is the last one in the function.
+internal inline Cfg_Block_Id
+find_cfg_fall_through_block_id(Tac_Function* tac_function, const Cfg_Block_Id source_block_id)
 {
     const Cfg_Block* block = get_cfg_block_by_id(tac_function, source_block_id);
 
+    Cfg_Block_Id result = {0};
+    result.index = INVALID_CFG_BLOCK_INDEX;
+
     const Index next_instruction_index = block->instructions_range.end_instruction_index;
     if (next_instruction_index == tac_function->instructions_count)
     {
-        return;
+        return result;
     }
 
     for (Index successor_block_index = source_block_id.index + 1;
@@ -374,17 +307,26 @@ add_cfg_fall_through_edge_if_needed(Tac_Function* tac_function, const Cfg_Block_
         if (candidate_instructions_range->start_instruction_index <= next_instruction_index
             && next_instruction_index < candidate_instructions_range->end_instruction_index)
         {
-            Cfg_Block_Id destination_block_id = {0};
-            destination_block_id.index = successor_block_index;
-
-            add_cfg_edge(tac_function, source_block_id, destination_block_id);
-            return;
+            result.index = successor_block_index;
+            return result;
         }
     }
 
     UNREACHABLE();
 }
 
+internal inline void
+append_cfg_fall_through_edge_if_needed(Tac_Function* tac_function, const Cfg_Block_Id source_block_id)
+{
+    const Cfg_Block_Id destination_block_id = find_cfg_fall_through_block_id(tac_function, source_block_id);
+
+    if (destination_block_id.index != INVALID_CFG_BLOCK_INDEX)
+    {
+        Cfg_Block* source_block = get_cfg_block_by_id(tac_function, source_block_id);
+        append_cfg_edge_if_needed(source_block, destination_block_id);
+    }
+}
+
 internal inline Bool
 tac_operation_is_a_cfg_block_terminator(const Tac_Operation operation)
 {
@@ -425,6 +367,165 @@ tac_operation_is_a_cfg_block_terminator(const Tac_Operation operation)
     UNREACHABLE();
 }
 
+internal void
+wire_cfg_edges(Compilation_Context* context, Tac_Function* tac_function)
+{
+    Tac* tac = &context->tac;
+
+    // NOTE(vlad): Every block has at most two successors, so we are reserving
+    //             memory for all edges up front and then filling blocks' slices.
+    Cfg_Block_Id* edges = allocate_uninitialized_array(context->cfg_adjacency_arena,
+                                                       2 * tac_function->cfg_blocks_count,
+                                                       Cfg_Block_Id);
+    Size edges_count = 0;
+
+    for (Index this_block_index = 0;
+         this_block_index < tac_function->cfg_blocks_count;
+         ++this_block_index)
+    {
+        Cfg_Block* block = &tac_function->cfg_blocks[this_block_index];
+        block->edges = edges + edges_count;
+        block->edges_count = 0;
+
+        const Index last_instruction_index = block->instructions_range.end_instruction_index - 1;
+        ASSERT(block->instructions_range.start_instruction_index <= last_instruction_index);
+
+        const Tac_Instruction* last_instruction = &tac_function->instructions[last_instruction_index];
+
+        Cfg_Block_Id source_block_id = {0};
+        source_block_id.index = this_block_index;
+
+        switch (last_instruction->operation)
+        {
+            case TAC_JUMP:
+            {
+                const Tac_Label_Id destination_label_id = last_instruction->destination.label_id;
+                const Cfg_Block_Id destination_block_id = tac->label_index_to_cfg_block_id_map[destination_label_id.index];
+
+                append_cfg_edge_if_needed(block, destination_block_id);
+            } break;
+
+            case TAC_JUMP_IF_TRUE:
+            case TAC_JUMP_IF_FALSE:
+            {
+                const Tac_Label_Id destination_label_id = last_instruction->destination.label_id;
+                const Cfg_Block_Id destination_block_id = tac->label_index_to_cfg_block_id_map[destination_label_id.index];
+
+                append_cfg_edge_if_needed(block, destination_block_id);
+                append_cfg_fall_through_edge_if_needed(tac_function, source_block_id);
+            } break;
+
+            case TAC_RETURN:
+            {
+                // NOTE(vlad): This block does not have successors.
+            } break;
+
+            case TAC_NOP:
+            case TAC_ASSIGN:
+            case TAC_GET_ADDRESS:
+            case TAC_LOAD_BY_ADDRESS:
+            case TAC_STORE_BY_ADDRESS:
+            case TAC_ADD:
+            case TAC_SUBTRACT:
+            case TAC_MULTIPLY:
+            case TAC_DIVIDE:
+            case TAC_EQUAL:
+            case TAC_NOT_EQUAL:
+            case TAC_LESS:
+            case TAC_LESS_OR_EQUAL:
+            case TAC_GREATER:
+            case TAC_GREATER_OR_EQUAL:
+            case TAC_LABEL:
+            case TAC_SET_PARAMETER:
+            case TAC_GET_PARAMETER:
+            case TAC_CALL:
+            {
+                append_cfg_fall_through_edge_if_needed(tac_function, source_block_id);
+            } break;
+        }
+
+        edges_count += block->edges_count;
+    }
+
+    // NOTE(vlad): Counting predecessors of every block.
+    for (Index block_index = 0;
+         block_index < tac_function->cfg_blocks_count;
+         ++block_index)
+    {
+        const Cfg_Block* block = &tac_function->cfg_blocks[block_index];
+
+        for (Index edge_index = 0;
+             edge_index < block->edges_count;
+             ++edge_index)
+        {
+            Cfg_Block* successor = get_cfg_block_by_id(tac_function, block->edges[edge_index]);
+            successor->predecessors_count += 1;
+        }
+    }
+
+    Cfg_Block_Id* predecessors = allocate_uninitialized_array(context->cfg_adjacency_arena,
+                                                              edges_count,
+                                                              Cfg_Block_Id);
+    Size predecessors_count = 0;
+
+    for (Index block_index = 0;
+         block_index < tac_function->cfg_blocks_count;
+         ++block_index)
+    {
+        Cfg_Block* block = &tac_function->cfg_blocks[block_index];
+        block->predecessors = predecessors + predecessors_count;
+        predecessors_count += block->predecessors_count;
+        block->predecessors_count = 0;
+    }
+
+    ASSERT(predecessors_count == edges_count);
+
+    // NOTE(vlad): Filling predecessors in the order of their sources.
+    for (Index block_index = 0;
+         block_index < tac_function->cfg_blocks_count;
+         ++block_index)
+    {
+        const Cfg_Block* block = &tac_function->cfg_blocks[block_index];
+
+        Cfg_Block_Id block_id = {0};
+        block_id.index = block_index;
+
+        for (Index edge_index = 0;
+             edge_index < block->edges_count;
+             ++edge_index)
+        {
+            Cfg_Block* successor = get_cfg_block_by_id(tac_function, block->edges[edge_index]);
+            successor->predecessors[successor->predecessors_count++] = block_id;
+        }
+    }
+}
+
+internal void
+map_tac_labels_to_cfg_blocks(Tac* tac, const Tac_Function* tac_function)
+{
+    for (Index block_index = 0;
+         block_index < tac_function->cfg_blocks_count;
+         ++block_index)
+    {
+        const Cfg_Block* block = &tac_function->cfg_blocks[block_index];
+
+        ASSERT(block->instructions_range.start_instruction_index != block->instructions_range.end_instruction_index);
+        const Tac_Instruction* instruction = &tac_function->instructions[block->instructions_range.start_instruction_index];
+
+        if (instruction->operation == TAC_LABEL)
+        {
+            const Tac_Label_Id label_id = instruction->destination.label_id;
+            ASSERT(0 < label_id.index && label_id.index <= tac->labels_count);
+
+            Cfg_Block_Id block_id = {0};
+            block_id.index = block_index;
+
+            ASSERT(tac->label_index_to_cfg_block_id_map[label_id.index].index == INVALID_CFG_BLOCK_INDEX);
+            tac->label_index_to_cfg_block_id_map[label_id.index] = block_id;
+        }
+    }
+}
+
 internal void
 construct_cfg_from_tac(Compilation_Context* context)
 {
@@ -453,6 +554,14 @@ construct_cfg_from_tac(Compilation_Context* context)
     {
         Tac_Function* tac_function = &tac->functions[function_index];
 
+        // NOTE(vlad): Its blocks are copied by 'lower_ast_to_tac'. Labels of the blocks that
+        //             the previous compilation removed stay unmapped, nothing jumps to them.
+        if (tac_function->is_reused)
+        {
+            map_tac_labels_to_cfg_blocks(tac, tac_function);
+            continue;
+        }
+
         Cfg_Block_Id entry_block_id = {0};
         entry_block_id.index = tac_function->cfg_blocks_count;
 
@@ -506,102 +615,18 @@ construct_cfg_from_tac(Compilation_Context* context)
             ASSERT(entry_block_id.index == ENTRY_BLOCK_INDEX);
         }
 
-        // NOTE(vlad): Populating label_id to cfg_block_id map.
+        map_tac_labels_to_cfg_blocks(tac, tac_function);
 
-        for (Index block_index = 0;
-             block_index < tac_function->cfg_blocks_count;
-             ++block_index)
+        for (Index label_index = tac_function->first_tac_label_index;
+             label_index < tac_function->last_tac_label_index;
+             ++label_index)
         {
-            const Cfg_Block* block = &tac_function->cfg_blocks[block_index];
-
-            ASSERT(block->instructions_range.start_instruction_index != block->instructions_range.end_instruction_index);
-            const Tac_Instruction* instruction = &tac_function->instructions[block->instructions_range.start_instruction_index];
-
-            if (instruction->operation == TAC_LABEL)
-            {
-                const Tac_Label_Id label_id = instruction->destination.label_id;
-                ASSERT(0 < label_id.index && label_id.index <= total_labels_count);
-
-                Cfg_Block_Id block_id = {0};
-                block_id.index = block_index;
-
-                ASSERT(tac->label_index_to_cfg_block_id_map[label_id.index].index == INVALID_CFG_BLOCK_INDEX);
-                tac->label_index_to_cfg_block_id_map[label_id.index] = block_id;
-            }
+            ASSERT(tac->label_index_to_cfg_block_id_map[label_index].index != INVALID_CFG_BLOCK_INDEX);
         }
 
         // NOTE(vlad): Wiring CFG edges.
 
-        for (Index this_block_index = 0;
-             this_block_index < tac_function->cfg_blocks_count;
-             ++this_block_index)
-        {
-            Cfg_Block* block = &tac_function->cfg_blocks[this_block_index];
-
-            const Index last_instruction_index = block->instructions_range.end_instruction_index - 1;
-            ASSERT(block->instructions_range.start_instruction_index <= last_instruction_index);
-
-            const Tac_Instruction* last_instruction = &tac_function->instructions[last_instruction_index];
-
-            Cfg_Block_Id source_block_id = {0};
-            source_block_id.index = this_block_index;
-
-            switch (last_instruction->operation)
-            {
-                case TAC_JUMP:
-                {
-                    const Tac_Label_Id destination_label_id = last_instruction->destination.label_id;
-                    const Cfg_Block_Id destination_block_id = tac->label_index_to_cfg_block_id_map[destination_label_id.index];
-
-                    add_cfg_edge(tac_function, source_block_id, destination_block_id);
-                } break;
-
-                case TAC_JUMP_IF_TRUE:
-                case TAC_JUMP_IF_FALSE:
-                {
-                    const Tac_Label_Id destination_label_id = last_instruction->destination.label_id;
-                    const Cfg_Block_Id destination_block_id = tac->label_index_to_cfg_block_id_map[destination_label_id.index];
-
-                    add_cfg_edge(tac_function, source_block_id, destination_block_id);
-                    add_cfg_fall_through_edge_if_needed(tac_function, source_block_id);
-                } break;
-
-                case TAC_RETURN:
-                {
-                    // NOTE(vlad): This block does not have successors.
-                } break;
-
-                case TAC_NOP:
-                case TAC_ASSIGN:
-                case TAC_GET_ADDRESS:
-                case TAC_LOAD_BY_ADDRESS:
-                case TAC_STORE_BY_ADDRESS:
-                case TAC_ADD:
-                case TAC_SUBTRACT:
-                case TAC_MULTIPLY:
-                case TAC_DIVIDE:
-                case TAC_EQUAL:
-                case TAC_NOT_EQUAL:
-                case TAC_LESS:
-                case TAC_LESS_OR_EQUAL:
-                case TAC_GREATER:
-                case TAC_GREATER_OR_EQUAL:
-                case TAC_LABEL:
-                case TAC_SET_PARAMETER:
-                case TAC_GET_PARAMETER:
-                case TAC_CALL:
-                {
-                    add_cfg_fall_through_edge_if_needed(tac_function, source_block_id);
-                } break;
-            }
-        }
-    }
-
-    for (Index label_index = INVALID_TAC_INDEX + 1;
-         label_index < total_labels_count;
-         ++label_index)
-    {
-        ASSERT(tac->label_index_to_cfg_block_id_map[label_index].index != INVALID_CFG_BLOCK_INDEX);
+        wire_cfg_edges(context, tac_function);
     }
 
     request_arena_reset(context->arena_provider, context->scratch_arena);
@@ -691,6 +716,10 @@ remove_unreachable_cfg_blocks(Compilation_Context* context)
          ++function_index)
     {
         Tac_Function* tac_function = &tac->functions[function_index];
+        if (tac_function->is_reused)
+        {
+            continue;
+        }
 
         // TODO(vlad): Reuse this memory?
         Cfg_Block_Reachability_Info* reachability_info = allocate_array(context->scratch_arena,
@@ -788,16 +817,6 @@ remove_unreachable_cfg_blocks(Compilation_Context* context)
     request_arena_reset(context->arena_provider, context->scratch_arena);
 }
 
-internal inline void
-free_cfg_block(Compilation_Context* context, Cfg_Block* block)
-{
-    release_arena_to_provider(context->arena_provider, block->edges_arena);
-    release_arena_to_provider(context->arena_provider, block->predecessors_arena);
-    release_arena_to_provider(context->arena_provider, block->dominance_frontier_arena);
-    release_arena_to_provider(context->arena_provider, block->phi_nodes_arena);
-    release_arena_to_provider(context->arena_provider, block->dominated_block_ids_arena);
-}
-
 internal inline Cfg_Block*
 get_cfg_block_by_id(Tac_Function* tac_function, const Cfg_Block_Id id)
 {
@@ -20,22 +20,29 @@ struct Phi_Node
 };
 typedef struct Phi_Node Phi_Node;
 
+// NOTE(vlad): Adjacency lists of all blocks of a function are stored contiguously
+//             in the compressed sparse row form: 'edges', 'predecessors', etc. are
+//             slices of per-function arrays that are built once in 'construct_cfg_from_tac'
+//             (or in the corresponding SSA pass). Edges and predecessors can only
+//             be removed afterwards.
 struct Cfg_Block
 {
-    Arena* edges_arena;
-    Arena* predecessors_arena;
-    Arena* dominance_frontier_arena;
-    Arena* dominated_block_ids_arena;
-    Arena* phi_nodes_arena;
-
     Tac_Instructions_Range instructions_range;
 
-    array(Cfg_Block_Id, edges);
-    array(Cfg_Block_Id, predecessors);
-    array(Cfg_Block_Id, dominance_frontier);
-    array(Cfg_Block_Id, dominated_block_ids);
+    Cfg_Block_Id* edges;
+    Size edges_count;
+
+    Cfg_Block_Id* predecessors;
+    Size predecessors_count;
+
+    Cfg_Block_Id* dominance_frontier;
+    Size dominance_frontier_count;
 
-    array(Phi_Node, phi_nodes);
+    Cfg_Block_Id* dominated_block_ids;
+    Size dominated_block_ids_count;
+
+    Phi_Node* phi_nodes;
+    Size phi_nodes_count;
 
     Index postorder_index;
     Cfg_Block_Id immediate_dominator_id;
@@ -48,7 +55,5 @@ maybe_unused internal void remove_unreachable_cfg_blocks(struct Compilation_Cont
 maybe_unused internal Bool remove_edge(Cfg_Block* block, const Cfg_Block_Id block_id);
 maybe_unused internal Bool remove_predecessor(Cfg_Block* block, const Cfg_Block_Id block_id);
 
-maybe_unused internal inline void free_cfg_block(struct Compilation_Context* context, Cfg_Block* block);
-
 maybe_unused internal inline Cfg_Block* get_cfg_block_by_id(Tac_Function* tac_function, const Cfg_Block_Id id);
 maybe_unused internal inline Bool cfg_block_is_empty(const Cfg_Block* block);
@@ -11,28 +11,53 @@ create_compilation_context(Compilation_Context* context,
 {
     context->arena_provider = arena_provider;
 
-    context->scratch_arena = acquire_arena_from_provider(arena_provider, string_view("scratch"), GiB(1), MiB(1));
-    context->keywords_arena = acquire_arena_from_provider(arena_provider, string_view("keywords"), GiB(1), MiB(1));
-
-    context->diagnostic_message_texts_arena = acquire_arena_from_provider(arena_provider, string_view("diagnostic-message-texts"), GiB(1), MiB(1));
-    context->diagnostic_messages_arena = acquire_arena_from_provider(arena_provider, string_view("diagnostic-messages"), GiB(1), MiB(1));
-    context->ast_arena = acquire_arena_from_provider(arena_provider, string_view("ast"), GiB(1), MiB(1));
-    context->lexical_scopes_arena = acquire_arena_from_provider(arena_provider, string_view("lexical-scopes"), GiB(1), MiB(1));
-    context->symbols_arena = acquire_arena_from_provider(arena_provider, string_view("symbols"), GiB(1), MiB(1));
-    context->types_arena = acquire_arena_from_provider(arena_provider, string_view("types"), GiB(1), MiB(1));
-    context->parameter_type_ids_arena = acquire_arena_from_provider(arena_provider, string_view("function-parameter-type-ids"), GiB(1), MiB(1));
-
-    context->tac_functions_arena = acquire_arena_from_provider(arena_provider, string_view("tac-functions"), GiB(1), MiB(1));
-    context->tac_function_labels_arena = acquire_arena_from_provider(arena_provider, string_view("tac-function-labels"), GiB(1), MiB(1));
-    context->tac_variables_arena = acquire_arena_from_provider(arena_provider, string_view("tac-variables"), GiB(1), MiB(1));
-    context->tac_constants_arena = acquire_arena_from_provider(arena_provider, string_view("tac-constants"), GiB(1), MiB(1));
-    context->tac_labels_arena = acquire_arena_from_provider(arena_provider, string_view("tac-labels"), GiB(1), MiB(1));
-    context->tac_label_to_cfg_block_map_arena = acquire_arena_from_provider(arena_provider, string_view("tac-label-to-cfg-block-map"), GiB(1), MiB(1));
-
-    context->cfg_blocks_arena = acquire_arena_from_provider(arena_provider, string_view("cfg-blocks"), GiB(1), MiB(1));
-    context->phi_node_arguments_arena = acquire_arena_from_provider(arena_provider, string_view("cfg-phi-node-arguments"), GiB(1), MiB(1));
-
-    context->source_file = *source_file;
+    // NOTE(vlad): Scratch arena is reset after every pass, keeping its pages warm.
+    context->scratch_arena = acquire_arena_with_flags_from_provider(arena_provider,
+                                                                    string_view("scratch"),
+                                                                    MiB(16),
+                                                                    KiB(64),
+                                                                    ARENA_FLAG_RETAIN_COMMITTED_PAGES);
+
+    context->diagnostic_message_texts_arena = acquire_arena_from_provider(arena_provider, string_view("diagnostic-message-texts"), MiB(16), KiB(64));
+    context->diagnostic_messages_arena = acquire_arena_from_provider(arena_provider, string_view("diagnostic-messages"), MiB(16), KiB(64));
+    context->source_file_arena = acquire_arena_from_provider(arena_provider, string_view("source-file"), MiB(16), KiB(64));
+    context->tokens_arena = acquire_arena_from_provider(arena_provider, string_view("tokens"), MiB(16), KiB(64));
+    context->ast_arena = acquire_arena_from_provider(arena_provider, string_view("ast"), MiB(16), KiB(64));
+    context->ast_expressions_arena = acquire_arena_from_provider(arena_provider, string_view("ast-expressions"), MiB(16), KiB(64));
+    context->lexical_scopes_arena = acquire_arena_from_provider(arena_provider, string_view("lexical-scopes"), MiB(16), KiB(64));
+    context->symbols_arena = acquire_arena_from_provider(arena_provider, string_view("symbols"), MiB(16), KiB(64));
+    context->types_arena = acquire_arena_from_provider(arena_provider, string_view("types"), MiB(16), KiB(64));
+    context->parameter_type_ids_arena = acquire_arena_from_provider(arena_provider, string_view("function-parameter-type-ids"), MiB(16), KiB(64));
+    context->interned_types_arena = acquire_arena_from_provider(arena_provider, string_view("interned-types"), MiB(16), KiB(64));
+    context->type_strings_arena = acquire_arena_from_provider(arena_provider, string_view("type-strings"), MiB(16), KiB(64));
+    context->expression_type_ids_arena = acquire_arena_from_provider(arena_provider, string_view("expression-type-ids"), MiB(16), KiB(64));
+
+    context->tac_functions_arena = acquire_arena_from_provider(arena_provider, string_view("tac-functions"), MiB(16), KiB(64));
+    context->tac_function_labels_arena = acquire_arena_from_provider(arena_provider, string_view("tac-function-labels"), MiB(16), KiB(64));
+    context->tac_variables_arena = acquire_arena_from_provider(arena_provider, string_view("tac-variables"), MiB(16), KiB(64));
+    context->tac_constants_arena = acquire_arena_from_provider(arena_provider, string_view("tac-constants"), MiB(16), KiB(64));
+    context->tac_labels_arena = acquire_arena_from_provider(arena_provider, string_view("tac-labels"), MiB(16), KiB(64));
+    context->tac_expression_instructions_ranges_arena = acquire_arena_from_provider(arena_provider, string_view("tac-expression-instructions-ranges"), MiB(16), KiB(64));
+    context->tac_label_to_cfg_block_map_arena = acquire_arena_from_provider(arena_provider, string_view("tac-label-to-cfg-block-map"), MiB(16), KiB(64));
+    context->tac_reused_function_instructions_arena = acquire_arena_from_provider(arena_provider, string_view("tac-reused-function-instructions"), MiB(16), KiB(64));
+
+    context->cfg_blocks_arena = acquire_arena_from_provider(arena_provider, string_view("cfg-blocks"), MiB(16), KiB(64));
+    context->cfg_adjacency_arena = acquire_arena_from_provider(arena_provider, string_view("cfg-adjacency"), MiB(16), KiB(64));
+    context->phi_node_arguments_arena = acquire_arena_from_provider(arena_provider, string_view("cfg-phi-node-arguments"), MiB(16), KiB(64));
+
+    context->names_arena = acquire_arena_from_provider(arena_provider, string_view("names"), MiB(16), KiB(64));
+
+    context->source_file = (Source_File) {
+        .filename = source_file->filename,
+        .code = source_file->code,
+    };
+    build_line_start_offsets(context->source_file_arena, &context->source_file);
+
+    // NOTE(vlad): Reserving 'INVALID_NAME_ID'.
+    append_array(context->names_arena, context->names, String_View, (String_View){0});
+
+    // NOTE(vlad): Reserving 'INVALID_AST_EXPRESSION_ID'.
+    append_array(context->ast_expressions_arena, context->ast.expressions, Ast_Expression, (Ast_Expression){0});
 }
 
 internal void
@@ -51,36 +76,55 @@ destroy_compilation_context(Compilation_Context* context)
          ++tac_function_index)
     {
         Tac_Function* tac_function = &context->tac.functions[tac_function_index];
-
-        for (Index block_index = 0;
-             block_index < tac_function->cfg_blocks_count;
-             ++block_index)
+        if (tac_function->instructions_arena != NULL)
         {
-            Cfg_Block* block = &tac_function->cfg_blocks[block_index];
-            free_cfg_block(context, block);
+            release_arena_to_provider(context->arena_provider, tac_function->instructions_arena);
         }
     }
 
+    for (Index arena_index = 0;
+         arena_index < context->worker_arenas_count;
+         ++arena_index)
+    {
+        release_arena_to_provider(context->arena_provider, context->worker_arenas[arena_index]);
+    }
+
     release_arena_to_provider(context->arena_provider, context->scratch_arena);
-    release_arena_to_provider(context->arena_provider, context->keywords_arena);
 
     release_arena_to_provider(context->arena_provider, context->diagnostic_message_texts_arena);
     release_arena_to_provider(context->arena_provider, context->diagnostic_messages_arena);
+    release_arena_to_provider(context->arena_provider, context->source_file_arena);
+    release_arena_to_provider(context->arena_provider, context->tokens_arena);
     release_arena_to_provider(context->arena_provider, context->ast_arena);
+    release_arena_to_provider(context->arena_provider, context->ast_expressions_arena);
     release_arena_to_provider(context->arena_provider, context->lexical_scopes_arena);
     release_arena_to_provider(context->arena_provider, context->symbols_arena);
     release_arena_to_provider(context->arena_provider, context->types_arena);
     release_arena_to_provider(context->arena_provider, context->parameter_type_ids_arena);
+    release_arena_to_provider(context->arena_provider, context->interned_types_arena);
+    release_arena_to_provider(context->arena_provider, context->type_strings_arena);
+    release_arena_to_provider(context->arena_provider, context->expression_type_ids_arena);
 
     release_arena_to_provider(context->arena_provider, context->tac_functions_arena);
     release_arena_to_provider(context->arena_provider, context->tac_function_labels_arena);
     release_arena_to_provider(context->arena_provider, context->tac_variables_arena);
     release_arena_to_provider(context->arena_provider, context->tac_constants_arena);
     release_arena_to_provider(context->arena_provider, context->tac_labels_arena);
+    release_arena_to_provider(context->arena_provider, context->tac_expression_instructions_ranges_arena);
     release_arena_to_provider(context->arena_provider, context->tac_label_to_cfg_block_map_arena);
+    release_arena_to_provider(context->arena_provider, context->tac_reused_function_instructions_arena);
 
     release_arena_to_provider(context->arena_provider, context->cfg_blocks_arena);
+    release_arena_to_provider(context->arena_provider, context->cfg_adjacency_arena);
     release_arena_to_provider(context->arena_provider, context->phi_node_arguments_arena);
+
+    release_arena_to_provider(context->arena_provider, context->names_arena);
+}
+
+internal void
+reuse_unchanged_functions_of_previous_compilation(Compilation_Context* context, const Compilation_Context* previous_context)
+{
+    context->previous_context = previous_context;
 }
 
 internal Bool
@@ -187,6 +231,348 @@ dump_diagnostic_messages(Arena* messages_arena,
     return string_view(result);
 }
 
+struct Arena_Statistics_Entry
+{
+    String_View name;
+    Size arenas_count;
+
+    Size peak_bytes_count;
+    Size committed_bytes_count;
+
+    Arena_Page_Counters page_counters;
+    Arena_Statistics statistics;
+};
+typedef struct Arena_Statistics_Entry Arena_Statistics_Entry;
+
+struct Arena_Statistics_Table
+{
+    array(Arena_Statistics_Entry, entries);
+};
+typedef struct Arena_Statistics_Table Arena_Statistics_Table;
+
+internal void
+add_arena_to_statistics_table(Arena* output_arena, Arena_Statistics_Table* table, const Arena* arena)
+{
+    Arena_Statistics_Entry* entry = NULL;
+
+    // NOTE(vlad): There are only a couple dozens of distinct arena names.
+    for (Index entry_index = 0;
+         entry_index < table->entries_count;
+         ++entry_index)
+    {
+        if (strings_are_equal(table->entries[entry_index].name, arena->name))
+        {
+            entry = &table->entries[entry_index];
+            break;
+        }
+    }
+
+    if (entry == NULL)
+    {
+        Arena_Statistics_Entry new_entry = {0};
+        new_entry.name = arena->name;
+        append_array(output_arena, table->entries, Arena_Statistics_Entry, new_entry);
+        entry = &table->entries[table->entries_count - 1];
+    }
+
+    entry->arenas_count += 1;
+
+    // NOTE(vlad): Peak position includes block headers, so it's closer to what the arena
+    //             actually costs us.
+    entry->peak_bytes_count += MAX(arena->peak_position, arena->statistics.peak_position);
+    entry->committed_bytes_count += arena_get_committed_bytes_count(arena);
+
+    entry->page_counters.commits_count += arena->page_counters.commits_count;
+    entry->page_counters.committed_bytes_count += arena->page_counters.committed_bytes_count;
+    entry->page_counters.decommits_count += arena->page_counters.decommits_count;
+    entry->page_counters.decommitted_bytes_count += arena->page_counters.decommitted_bytes_count;
+    entry->page_counters.lazy_decommits_count += arena->page_counters.lazy_decommits_count;
+    entry->page_counters.lazily_decommitted_bytes_count += arena->page_counters.lazily_decommitted_bytes_count;
+
+    entry->statistics.pushes_count += arena->statistics.pushes_count;
+    entry->statistics.pushed_bytes_count += arena->statistics.pushed_bytes_count;
+    entry->statistics.in_place_reallocations_count += arena->statistics.in_place_reallocations_count;
+    entry->statistics.copying_reallocations_count += arena->statistics.copying_reallocations_count;
+    entry->statistics.copied_bytes_count += arena->statistics.copied_bytes_count;
+    entry->statistics.alignment_waste_bytes_count += arena->statistics.alignment_waste_bytes_count;
+    entry->statistics.redzone_bytes_count += arena->statistics.redzone_bytes_count;
+}
+
+internal inline Bool
+arena_statistics_entry_goes_before(const Arena_Statistics_Entry* lhs, const Arena_Statistics_Entry* rhs)
+{
+    if (lhs->peak_bytes_count != rhs->peak_bytes_count)
+    {
+        return lhs->peak_bytes_count > rhs->peak_bytes_count;
+    }
+
+    return compare_strings(lhs->name, rhs->name) < 0;
+}
+
+internal void
+sort_arena_statistics_table(Arena_Statistics_Table* table)
+{
+    // NOTE(vlad): Insertion sort is fine for a couple dozens of entries.
+    for (Index i = 1;
+         i < table->entries_count;
+         ++i)
+    {
+        const Arena_Statistics_Entry entry = table->entries[i];
+
+        Index j = i;
+        while (j > 0 && arena_statistics_entry_goes_before(&entry, &table->entries[j - 1]))
+        {
+            table->entries[j] = table->entries[j - 1];
+            j -= 1;
+        }
+
+        table->entries[j] = entry;
+    }
+}
+
+#define ARENA_STATISTICS_COLUMNS_COUNT 13
+#define ARENA_STATISTICS_NUMBER_COLUMN_WIDTH 12
+
+internal void
+append_arena_statistics_cell(String_Builder* builder,
+                             const String_View text,
+                             const Size width,
+                             const Bool align_to_the_left)
+{
+    const Size padding = (text.length < width) ? width - text.length : 0;
+
+    if (align_to_the_left)
+    {
+        append_string(builder, text);
+    }
+
+    for (Index i = 0;
+         i < padding;
+         ++i)
+    {
+        append_string(builder, string_view(" "));
+    }
+
+    if (!align_to_the_left)
+    {
+        append_string(builder, text);
+    }
+}
+
+internal void
+append_arena_statistics_row(String_Builder* builder,
+                            const String_View cells[ARENA_STATISTICS_COLUMNS_COUNT],
+                            const Size name_column_width)
+{
+    append_arena_statistics_cell(builder, cells[0], name_column_width, true);
+
+    for (Index column_index = 1;
+         column_index < ARENA_STATISTICS_COLUMNS_COUNT;
+         ++column_index)
+    {
+        append_string(builder, string_view(" "));
+        append_arena_statistics_cell(builder, cells[column_index], ARENA_STATISTICS_NUMBER_COLUMN_WIDTH, false);
+    }
+
+    append_string(builder, string_view("\n"));
+}
+
+internal void
+append_arena_statistics_entry(Arena* output_arena,
+                              String_Builder* builder,
+                              const Arena_Statistics_Entry* entry,
+                              const Size name_column_width)
+{
+    const String_View cells[ARENA_STATISTICS_COLUMNS_COUNT] = {
+        entry->name,
+        string_view(format_string(output_arena, "{}", entry->arenas_count)),
+        string_view(format_string(output_arena, "{}", entry->peak_bytes_count)),
+        string_view(format_string(output_arena, "{}", entry->committed_bytes_count)),
+        string_view(format_string(output_arena, "{}", entry->statistics.pushes_count)),
+        string_view(format_string(output_arena, "{}", entry->statistics.pushed_bytes_count)),
+        string_view(format_string(output_arena, "{}", entry->page_counters.commits_count)),
+        string_view(format_string(output_arena, "{}", entry->page_counters.decommits_count
+                                  + entry->page_counters.lazy_decommits_count)),
+        string_view(format_string(output_arena, "{}", entry->statistics.in_place_reallocations_count)),
+        string_view(format_string(output_arena, "{}", entry->statistics.copying_reallocations_count)),
+        string_view(format_string(output_arena, "{}", entry->statistics.copied_bytes_count)),
+        string_view(format_string(output_arena, "{}", entry->statistics.alignment_waste_bytes_count)),
+        string_view(format_string(output_arena, "{}", entry->statistics.redzone_bytes_count)),
+    };
+
+    append_arena_statistics_row(builder, cells, name_column_width);
+}
+
+internal String_View
+dump_arena_statistics(Arena* output_arena, Compilation_Context* context)
+{
+    Arena* const context_arenas[] = {
+        context->scratch_arena,
+
+        context->diagnostic_message_texts_arena,
+        context->diagnostic_messages_arena,
+        context->source_file_arena,
+        context->tokens_arena,
+        context->ast_arena,
+        context->ast_expressions_arena,
+        context->lexical_scopes_arena,
+        context->symbols_arena,
+        context->types_arena,
+        context->parameter_type_ids_arena,
+        context->interned_types_arena,
+        context->type_strings_arena,
+        context->expression_type_ids_arena,
+
+        context->tac_functions_arena,
+        context->tac_function_labels_arena,
+        context->tac_variables_arena,
+        context->tac_constants_arena,
+        context->tac_labels_arena,
+        context->tac_expression_instructions_ranges_arena,
+        context->tac_label_to_cfg_block_map_arena,
+        context->tac_reused_function_instructions_arena,
+
+        context->cfg_blocks_arena,
+        context->cfg_adjacency_arena,
+        context->phi_node_arguments_arena,
+
+        context->names_arena,
+    };
+    const Size context_arenas_count = size_of(context_arenas) / size_of(context_arenas[0]);
+
+    Arena_Statistics_Table table = {0};
+
+    // NOTE(vlad): The same arena can be shared by several fields (e.g. in unit tests),
+    //             it must be counted only once. Per-scope and per-function arenas are
+    //             always acquired separately, so only checking them against the context ones.
+    for (Index arena_index = 0;
+         arena_index < context_arenas_count;
+         ++arena_index)
+    {
+        Bool already_counted = false;
+        for (Index other_arena_index = 0;
+             other_arena_index < arena_index;
+             ++other_arena_index)
+        {
+            already_counted |= context_arenas[other_arena_index] == context_arenas[arena_index];
+        }
+
+        if (!already_counted)
+        {
+            add_arena_to_statistics_table(output_arena, &table, context_arenas[arena_index]);
+        }
+    }
+
+    for (Index scope_index = 0;
+         scope_index < context->lexical_scopes_count;
+         ++scope_index)
+    {
+        const Arena* arena = context->lexical_scopes[scope_index].symbol_ids_arena;
+
+        Bool already_counted = false;
+        for (Index arena_index = 0;
+             arena_index < context_arenas_count;
+             ++arena_index)
+        {
+            already_counted |= context_arenas[arena_index] == arena;
+        }
+
+        if (!already_counted)
+        {
+            add_arena_to_statistics_table(output_arena, &table, arena);
+        }
+    }
+
+    // NOTE(vlad): Worker arenas are never shared, see 'acquire_worker_arena_from_provider'.
+    for (Index arena_index = 0;
+         arena_index < context->worker_arenas_count;
+         ++arena_index)
+    {
+        add_arena_to_statistics_table(output_arena, &table, context->worker_arenas[arena_index]);
+    }
+
+    for (Index tac_function_index = 0;
+         tac_function_index < context->tac.functions_count;
+         ++tac_function_index)
+    {
+        const Arena* arena = context->tac.functions[tac_function_index].instructions_arena;
+
+        Bool already_counted = arena == NULL;
+        for (Index arena_index = 0;
+             arena_index < context_arenas_count;
+             ++arena_index)
+        {
+            already_counted |= context_arenas[arena_index] == arena;
+        }
+
+        if (!already_counted)
+        {
+            add_arena_to_statistics_table(output_arena, &table, arena);
+        }
+    }
+
+    sort_arena_statistics_table(&table);
+
+    Arena_Statistics_Entry total = {0};
+    total.name = string_view("total");
+
+    Size name_column_width = string_view("arena").length;
+    for (Index entry_index = 0;
+         entry_index < table.entries_count;
+         ++entry_index)
+    {
+        const Arena_Statistics_Entry* entry = &table.entries[entry_index];
+        name_column_width = MAX(name_column_width, entry->name.length);
+
+        total.arenas_count += entry->arenas_count;
+        total.peak_bytes_count += entry->peak_bytes_count;
+        total.committed_bytes_count += entry->committed_bytes_count;
+        total.page_counters.commits_count += entry->page_counters.commits_count;
+        total.page_counters.decommits_count += entry->page_counters.decommits_count;
+        total.page_counters.lazy_decommits_count += entry->page_counters.lazy_decommits_count;
+        total.statistics.pushes_count += entry->statistics.pushes_count;
+        total.statistics.pushed_bytes_count += entry->statistics.pushed_bytes_count;
+        total.statistics.in_place_reallocations_count += entry->statistics.in_place_reallocations_count;
+        total.statistics.copying_reallocations_count += entry->statistics.copying_reallocations_count;
+        total.statistics.copied_bytes_count += entry->statistics.copied_bytes_count;
+        total.statistics.alignment_waste_bytes_count += entry->statistics.alignment_waste_bytes_count;
+        total.statistics.redzone_bytes_count += entry->statistics.redzone_bytes_count;
+    }
+
+    String_Builder builder = {0};
+    create_string_builder(&builder, output_arena);
+
+    // NOTE(vlad): 'grown' and 'moved' are reallocations that were done in place and
+    //             that had to copy memory, 'alignment' and 'redzones' are wasted bytes.
+    const String_View header[ARENA_STATISTICS_COLUMNS_COUNT] = {
+        string_view("arena"),
+        string_view("arenas"),
+        string_view("peak"),
+        string_view("committed"),
+        string_view("pushes"),
+        string_view("pushed"),
+        string_view("commits"),
+        string_view("decommits"),
+        string_view("grown"),
+        string_view("moved"),
+        string_view("copied"),
+        string_view("alignment"),
+        string_view("redzones"),
+    };
+    append_arena_statistics_row(&builder, header, name_column_width);
+
+    for (Index entry_index = 0;
+         entry_index < table.entries_count;
+         ++entry_index)
+    {
+        append_arena_statistics_entry(output_arena, &builder, &table.entries[entry_index], name_column_width);
+    }
+
+    append_arena_statistics_entry(output_arena, &builder, &total, name_column_width);
+
+    return string_builder_to_string(&builder);
+}
+
 internal Symbol_Id
 create_symbol(Compilation_Context* context)
 {
@@ -194,34 +580,104 @@ create_symbol(Compilation_Context* context)
     return context->symbols_count - 1;
 }
 
+internal Name_Id
+intern_string(Compilation_Context* context, const String_View string)
+{
+    Index slot_index = 0;
+    hash_map_find(context->name_ids, String_View, string, hash_string, strings_are_equal, slot_index);
+    if (slot_index != -1)
+    {
+        return context->name_ids[slot_index];
+    }
+
+    ASSERT(context->names_count < MAX_VALUE(Name_Id));
+    const Name_Id name_id = (Name_Id)context->names_count;
+
+    append_array(context->names_arena, context->names, String_View, string);
+    hash_map_insert(context->names_arena, context->name_ids, String_View, Name_Id, string, name_id, hash_string, strings_are_equal);
+
+    return name_id;
+}
+
+internal Name_Id
+find_name_id(Compilation_Context* context, const String_View string)
+{
+    Index slot_index = 0;
+    hash_map_find(context->name_ids, String_View, string, hash_string, strings_are_equal, slot_index);
+    return (slot_index != -1) ? context->name_ids[slot_index] : INVALID_NAME_ID;
+}
+
+internal inline String_View
+get_name_by_id(const Compilation_Context* context, const Name_Id name_id)
+{
+    ASSERT(name_id != INVALID_NAME_ID && name_id < context->names_count);
+    return context->names[name_id];
+}
+
 internal Symbol_Id
-find_symbol_id(Compilation_Context* context,
-               Lexical_Scope_Id this_lexical_scope_id,
-               const String_View name)
+find_symbol_id_in_lexical_scope(Compilation_Context* context,
+                                const Lexical_Scope_Id lexical_scope_id,
+                                const Name_Id name_id)
 {
-    while (this_lexical_scope_id != INVALID_LEXICAL_SCOPE_ID)
+    Lexical_Scope* scope = &context->lexical_scopes[lexical_scope_id];
+
+    if (scope->symbol_ids_by_name_id_capacity != 0)
+    {
+        Index slot_index = 0;
+        hash_map_find(scope->symbol_ids_by_name_id, Name_Id, name_id, hash_name_id, name_ids_are_equal, slot_index);
+        return (slot_index != -1) ? scope->symbol_ids_by_name_id[slot_index] : UNDEFINED_SYMBOL_ID;
+    }
+
+    for (Index symbol_id_index = 0;
+         symbol_id_index < scope->symbol_ids_count;
+         ++symbol_id_index)
     {
-        Lexical_Scope* scope = &context->lexical_scopes[this_lexical_scope_id];
+        const Symbol_Id current_symbol_id = scope->symbol_ids[symbol_id_index];
 
-        for (Index symbol_id_index = 0;
-             symbol_id_index < scope->symbol_ids_count;
-             ++symbol_id_index)
+        if (context->symbols[current_symbol_id].name_id == name_id)
         {
-            const Symbol_Id current_symbol_id = scope->symbol_ids[symbol_id_index];
+            return current_symbol_id;
+        }
+    }
+
+    return UNDEFINED_SYMBOL_ID;
+}
+
+internal Symbol_Id
+find_symbol_id_by_name_id(Compilation_Context* context,
+                          Lexical_Scope_Id this_lexical_scope_id,
+                          const Name_Id name_id)
+{
+    ASSERT(name_id != INVALID_NAME_ID);
 
-            Symbol* current_symbol = &context->symbols[current_symbol_id];
-            if (strings_are_equal(current_symbol->name, name))
-            {
-                return current_symbol_id;
-            }
+    while (this_lexical_scope_id != INVALID_LEXICAL_SCOPE_ID)
+    {
+        const Symbol_Id symbol_id = find_symbol_id_in_lexical_scope(context, this_lexical_scope_id, name_id);
+        if (symbol_id != UNDEFINED_SYMBOL_ID)
+        {
+            return symbol_id;
         }
 
-        this_lexical_scope_id = scope->parent_lexical_scope_id;
+        this_lexical_scope_id = context->lexical_scopes[this_lexical_scope_id].parent_lexical_scope_id;
     }
 
     return UNDEFINED_SYMBOL_ID;
 }
 
+internal Symbol_Id
+find_symbol_id(Compilation_Context* context,
+               Lexical_Scope_Id this_lexical_scope_id,
+               const String_View name)
+{
+    const Name_Id name_id = find_name_id(context, name);
+    if (name_id == INVALID_NAME_ID)
+    {
+        return UNDEFINED_SYMBOL_ID;
+    }
+
+    return find_symbol_id_by_name_id(context, this_lexical_scope_id, name_id);
+}
+
 internal inline Symbol*
 get_symbol_for_identifier(Compilation_Context* context, const Ast_Identifier* identifier)
 {
@@ -270,8 +726,16 @@ get_type_for_identifier(Compilation_Context* context, const Ast_Identifier* iden
     return get_type_by_id(context, symbol->type_id);
 }
 
+internal inline Type_Id
+get_expression_type_id(const Compilation_Context* context, const Ast_Expression_Id expression_id)
+{
+    ASSERT(expression_id != INVALID_AST_EXPRESSION_ID);
+    ASSERT(expression_id < context->expression_type_ids_count);
+    return context->expression_type_ids[expression_id];
+}
+
 internal inline Bool
-type_is_a_root_node(Type* type)
+type_is_a_root_node(const Type* type)
 {
     return type_id_is_undefined(type->parent_type_id);
 }
@@ -286,20 +750,29 @@ type_id_is_a_root_node(Compilation_Context* context, const Type_Id type_id)
 internal Type_Id
 find_root_type_id(Compilation_Context* context, const Type_Id type_id)
 {
-    Type* node = get_exact_type_by_id(context, type_id);
+    // NOTE(vlad): Path halving: every visited node is relinked to its grandparent. Unlike the
+    //             full compression it needs no recursion, so long chains of type variables
+    //             don't overflow the stack.
+    Type_Id node_type_id = type_id;
+    Type* node = get_exact_type_by_id(context, node_type_id);
 
-    if (!type_is_a_root_node(node))
+    while (!type_is_a_root_node(node))
     {
-        // NOTE(vlad): Performing type compression here.
-        node->parent_type_id = find_root_type_id(context, node->parent_type_id);
-        return node->parent_type_id;
+        const Type* parent = get_exact_type_by_id(context, node->parent_type_id);
+        if (!type_is_a_root_node(parent))
+        {
+            node->parent_type_id = parent->parent_type_id;
+        }
+
+        node_type_id = node->parent_type_id;
+        node = get_exact_type_by_id(context, node_type_id);
     }
 
-    return type_id;
+    return node_type_id;
 }
 
-// TODO(vlad): This test would fail for non-unified types like pointers with
-//             different type_ids. We should probably fix this.
+// TODO(vlad): This test would fail for non-unified types like pointers to type variables
+//             with different type_ids. Fully resolved types are interned and pass it.
 internal inline Bool
 type_ids_are_equal(Compilation_Context* context, const Type_Id lhs, const Type_Id rhs)
 {
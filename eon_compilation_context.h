@@ -14,44 +14,107 @@ internal Arena* acquire_arena_from_provider(struct Arena_Provider* provider,
                                             const String_View arena_name,
                                             const Size number_of_bytes_to_reserve,
                                             const Size number_of_bytes_to_commit);
+internal Arena* acquire_arena_with_flags_from_provider(struct Arena_Provider* provider,
+                                                       const String_View arena_name,
+                                                       const Size number_of_bytes_to_reserve,
+                                                       const Size number_of_bytes_to_commit,
+                                                       const Arena_Flags arena_flags);
+internal Arena* acquire_worker_arena_from_provider(struct Arena_Provider* provider,
+                                                   const String_View arena_name,
+                                                   const Size number_of_bytes_to_reserve,
+                                                   const Size number_of_bytes_to_commit);
 internal void request_arena_reset(struct Arena_Provider* provider, Arena* arena);
 internal void release_arena_to_provider(struct Arena_Provider* provider, Arena* arena);
 
+// NOTE(vlad): Where a function definition is in the token buffer and hashes of its source, so
+//             that the next compilation of an edited source can tell which functions changed.
+struct Function_Fingerprint
+{
+    String_View name;
+    String_View text;
+
+    u64 signature_hash; // NOTE(vlad): Everything before the body.
+    u64 text_hash;
+
+    Index first_token_index;
+    Index body_start_token_index;
+    Index end_token_index;
+
+    // NOTE(vlad): Neither the function nor the signatures of the functions it refers to changed
+    //             since the previous compilation, so its body is not compiled again.
+    Bool is_reused;
+    Index previous_function_index;
+};
+typedef struct Function_Fingerprint Function_Fingerprint;
+
 struct Compilation_Context
 {
     struct Arena_Provider* arena_provider;
 
     Arena* scratch_arena;
-    Arena* keywords_arena;
 
     Arena* diagnostic_message_texts_arena;
     Arena* diagnostic_messages_arena;
+    Arena* source_file_arena;
+    Arena* tokens_arena;
     Arena* ast_arena;
+    Arena* ast_expressions_arena;
     Arena* lexical_scopes_arena;
     Arena* symbols_arena;
     Arena* types_arena;
     Arena* parameter_type_ids_arena;
+    Arena* interned_types_arena;
+    Arena* type_strings_arena;
+    Arena* expression_type_ids_arena;
 
     Arena* tac_functions_arena;
     Arena* tac_function_labels_arena;
     Arena* tac_variables_arena;
     Arena* tac_constants_arena;
     Arena* tac_labels_arena;
+    Arena* tac_expression_instructions_ranges_arena;
     Arena* tac_label_to_cfg_block_map_arena;
+    Arena* tac_reused_function_instructions_arena; // NOTE(vlad): Reused functions don't get their own arenas.
 
     Arena* cfg_blocks_arena;
+    Arena* cfg_adjacency_arena;
     Arena* phi_node_arguments_arena;
 
+    Arena* names_arena;
+
+    // NOTE(vlad): Hold data produced on other threads, see 'parse_function_definitions_in_chunks'
+    //             and 'resolve_types_in_function_bodies'.
+    array(Arena*, worker_arenas);
+
     Source_File source_file;
 
+    // NOTE(vlad): Interned strings, indexed by 'Name_Id'.
+    array(String_View, names);
+    hash_map(String_View, Name_Id, name_ids);
+
     array(Diagnostic_Message, diagnostic_messages);
 
     Ast ast;
 
+    // NOTE(vlad): Filled by 'parse_ast' for every function definition in source order.
+    array(Function_Fingerprint, function_fingerprints);
+
+    // NOTE(vlad): See 'reuse_unchanged_functions_of_previous_compilation'.
+    const struct Compilation_Context* previous_context;
+
     array(struct Symbol, symbols);
     array(struct Lexical_Scope, lexical_scopes);
     array(struct Type, types);
 
+    // NOTE(vlad): Fully resolved structural types, keyed by their contents, see 'intern_type'.
+    hash_map(struct Type, Type_Id, interned_type_ids);
+
+    // NOTE(vlad): Keyed by root types, see 'convert_type_to_string'.
+    hash_map(Type_Id, struct Type_String, type_strings);
+
+    // NOTE(vlad): Indexed by 'Ast_Expression_Id', filled by 'resolve_types'.
+    array(Type_Id, expression_type_ids);
+
     Tac tac;
 };
 typedef struct Compilation_Context Compilation_Context;
@@ -61,6 +124,15 @@ maybe_unused internal void create_compilation_context(Compilation_Context* conte
                                                       const Source_File* source_file);
 maybe_unused internal void destroy_compilation_context(Compilation_Context* context);
 
+// NOTE(vlad): Bodies of the functions that are the same as in the previous compilation and only
+//             refer to functions with the same signatures are not parsed and checked again,
+//             'lower_ast_to_tac' copies their TAC, CFG and SSA from the previous compilation
+//             and the later passes leave them alone. The previous context must have gone through
+//             the same passes without errors (otherwise everything is compiled again) and outlive
+//             'lower_ast_to_tac' of this one, after that this context doesn't refer to it.
+maybe_unused internal void reuse_unchanged_functions_of_previous_compilation(Compilation_Context* context,
+                                                                            const Compilation_Context* previous_context);
+
 maybe_unused internal Bool has_compilation_errors(const Compilation_Context* context);
 maybe_unused internal inline Bool has_diagnostic_messages(const Compilation_Context* context);
 maybe_unused internal void emit_diagnostic_message(Compilation_Context* context, const Diagnostic_Message* message);
@@ -70,8 +142,41 @@ maybe_unused internal String_View dump_diagnostic_messages(Arena* messages_arena
                                                            Compilation_Context* context,
                                                            const Message_Level max_level);
 
+// NOTE(vlad): Aggregates statistics of all arenas of the context by arena name and formats
+//             them as a table sorted by peak memory usage. Arenas that are not created
+//             with 'ARENA_FLAG_COLLECT_STATISTICS' only report pages and peak usage.
+maybe_unused internal String_View dump_arena_statistics(Arena* output_arena, Compilation_Context* context);
+
+// NOTE(vlad): Returns the same id for equal strings. The string is not copied, so it must
+//             outlive the context, e.g. point into the source code or be a literal.
+maybe_unused internal Name_Id intern_string(Compilation_Context* context, const String_View string);
+// NOTE(vlad): Returns 'INVALID_NAME_ID' if the string was never interned.
+maybe_unused internal Name_Id find_name_id(Compilation_Context* context, const String_View string);
+maybe_unused internal inline String_View get_name_by_id(const Compilation_Context* context, const Name_Id name_id);
+
+maybe_unused internal inline u64
+hash_name_id(const Name_Id name_id)
+{
+    return hash_u64(name_id);
+}
+
+maybe_unused internal inline Bool
+name_ids_are_equal(const Name_Id lhs, const Name_Id rhs)
+{
+    return lhs == rhs;
+}
+
 maybe_unused internal Symbol_Id create_symbol(Compilation_Context* context);
 
+// NOTE(vlad): Looks for the symbol only in the given scope without its parents.
+maybe_unused internal Symbol_Id find_symbol_id_in_lexical_scope(Compilation_Context* context,
+                                                                const Lexical_Scope_Id lexical_scope_id,
+                                                                const Name_Id name_id);
+
+maybe_unused internal Symbol_Id find_symbol_id_by_name_id(Compilation_Context* context,
+                                                          Lexical_Scope_Id this_lexical_scope_id,
+                                                          const Name_Id name_id);
+
 maybe_unused internal Symbol_Id find_symbol_id(Compilation_Context* context,
                                                Lexical_Scope_Id this_lexical_scope_id,
                                                const String_View name);
@@ -80,8 +185,11 @@ maybe_unused internal inline struct Symbol* get_symbol_for_identifier(Compilatio
 maybe_unused internal inline struct Symbol* get_symbol_by_id(Compilation_Context* context, const Symbol_Id symbol_id);
 
 maybe_unused internal Type_Id create_type(Compilation_Context* context);
+maybe_unused internal inline struct Type* get_exact_type_by_id(Compilation_Context* context, const Type_Id type_id);
 maybe_unused internal inline struct Type* get_type_by_id(Compilation_Context* context, const Type_Id type_id);
 maybe_unused internal struct Type* get_type_for_identifier(Compilation_Context* context, const Ast_Identifier* identifier);
+maybe_unused internal inline Type_Id get_expression_type_id(const Compilation_Context* context,
+                                                          const Ast_Expression_Id expression_id);
 
 // FIXME(vlad): Move this to eon_types.
 maybe_unused internal Type_Id find_root_type_id(Compilation_Context* context, const Type_Id type_id);
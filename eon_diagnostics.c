@@ -2,6 +2,8 @@
 
 #include "eon_compilation_context.h"
 
+#include <eon/characters_block.h>
+
 internal inline String_View
 message_level_to_string(const Message_Level level)
 {
@@ -15,6 +17,71 @@ message_level_to_string(const Message_Level level)
     UNREACHABLE();
 }
 
+internal void
+build_line_start_offsets(Arena* arena, Source_File* source_file)
+{
+    const String_View code = source_file->code;
+    ASSERT(code.length <= MAX_VALUE(u32) && "Offsets in source files must fit in 32 bits");
+
+    Index i = 0;
+
+#if HAS_CHARACTERS_BLOCKS
+    for (;
+         i + CHARACTERS_BLOCK_SIZE <= code.length;
+         i += CHARACTERS_BLOCK_SIZE)
+    {
+        u32 newlines_mask = CHARACTERS_BLOCK_MASK(CHARACTERS_ARE_EQUAL(LOAD_CHARACTERS_BLOCK(code.data + i), '\n'));
+
+        while (newlines_mask != 0)
+        {
+            const Index newline_index = i + count_trailing_zeros(newlines_mask);
+            append_array(arena, source_file->line_start_offsets, u32, (u32)(newline_index + 1));
+
+            // NOTE(vlad): Clearing the lowest set bit.
+            newlines_mask &= newlines_mask - 1;
+        }
+    }
+#endif
+
+    for (;
+         i < code.length;
+         ++i)
+    {
+        if (code.data[i] == '\n')
+        {
+            append_array(arena, source_file->line_start_offsets, u32, (u32)(i + 1));
+        }
+    }
+}
+
+internal Line_And_Column
+resolve_source_location(const Source_File* source_file, const Source_Location location)
+{
+    // NOTE(vlad): The number of lines that start at or before the location is its line.
+    Index first_line_index = 0;
+    Index last_line_index = source_file->line_start_offsets_count;
+    while (first_line_index < last_line_index)
+    {
+        const Index middle_line_index = first_line_index + (last_line_index - first_line_index) / 2;
+        if (source_file->line_start_offsets[middle_line_index] <= location.offset_in_bytes)
+        {
+            first_line_index = middle_line_index + 1;
+        }
+        else
+        {
+            last_line_index = middle_line_index;
+        }
+    }
+
+    const Index line = first_line_index;
+    const u32 line_start_offset = (line > 0) ? source_file->line_start_offsets[line - 1] : 0;
+
+    return (Line_And_Column) {
+        .line = line,
+        .column = location.offset_in_bytes - line_start_offset,
+    };
+}
+
 internal inline String_View
 source_location_to_string(struct Compilation_Context* context,
                           const Source_Location* location)
@@ -38,45 +105,30 @@ format_diagnostic_message(Arena* arena,
                           Compilation_Context* context,
                           const Diagnostic_Message* message)
 {
-    Index current_line_start_index = message->location.offset_in_bytes;
-
-    while (current_line_start_index > 0)
-    {
-        const char this_char = context->source_file.code.data[current_line_start_index];
-        if (this_char == '\n')
-        {
-            current_line_start_index += 1;
-            break;
-        }
-
-        current_line_start_index -= 1;
-    }
+    const Source_File* source_file = &context->source_file;
+    const Line_And_Column line_and_column = resolve_source_location(source_file, message->location);
 
-    Index current_line_end_index = message->location.offset_in_bytes;
+    const Index current_line_start_index = (line_and_column.line > 0)
+        ? source_file->line_start_offsets[line_and_column.line - 1]
+        : 0;
 
-    while (current_line_end_index < context->source_file.code.length)
-    {
-        const char this_char = context->source_file.code.data[current_line_end_index];
-        if (this_char == '\n')
-        {
-            break;
-        }
-
-        current_line_end_index += 1;
-    }
+    // NOTE(vlad): Lines end right before the start of the next one, without the newline.
+    const Index current_line_end_index = (line_and_column.line < source_file->line_start_offsets_count)
+        ? source_file->line_start_offsets[line_and_column.line] - 1
+        : source_file->code.length;
 
     const String_View current_line = (String_View) {
-        .data = context->source_file.code.data + current_line_start_index,
+        .data = source_file->code.data + current_line_start_index,
         .length = current_line_end_index - current_line_start_index,
     };
 
     String result = {0};
 
-    const Index location_length = MAX(message->location.length_in_bytes, 1);
+    const Index location_length = MAX((Index)message->location.length_in_bytes, 1);
 
-    const String line_number_as_a_string = format_string(arena, "{}", message->location.line + 1);
+    const String line_number_as_a_string = format_string(arena, "{}", line_and_column.line + 1);
     const Size highlight_line_length = line_number_as_a_string.length + 3
-        + message->location.column + location_length;
+        + line_and_column.column + location_length;
 
     // TODO(vlad): Support multiline highlights?
 
@@ -95,7 +147,7 @@ format_diagnostic_message(Arena* arena,
     highlight_line.data[next_char_index++] = '|';
 
     for (Index i = 0;
-         i < message->location.column + 1;
+         i < line_and_column.column + 1;
          ++i)
     {
         highlight_line.data[next_char_index++] = ' ';
@@ -116,7 +168,7 @@ format_diagnostic_message(Arena* arena,
                            "  {}",
                            context->source_file.filename,
                            line_number_as_a_string,
-                           message->location.column + 1,
+                           line_and_column.column + 1,
                            message_level_to_string(message->level),
                            message->text,
                            line_number_as_a_string,
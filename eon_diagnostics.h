@@ -1,5 +1,6 @@
 #pragma once
 
+#include <eon/containers.h>
 #include <eon/types.h>
 #include <eon/string.h>
 
@@ -11,18 +12,28 @@ struct Source_File
 {
     String_View filename;
     String_View code;
+
+    // NOTE(vlad): Offsets of the first characters of lines 1, 2 and so on, line 0 starts at 0.
+    //             Built by 'build_line_start_offsets' when the compilation context is created.
+    array(u32, line_start_offsets);
 };
 typedef struct Source_File Source_File;
 
+// NOTE(vlad): Lines and columns are resolved on demand, see 'resolve_source_location'.
 struct Source_Location
 {
-    Size offset_in_bytes;
-    Size length_in_bytes; // TODO(vlad): Support encodings other than ASCII.
+    u32 offset_in_bytes;
+    u32 length_in_bytes; // TODO(vlad): Support encodings other than ASCII.
+};
+typedef struct Source_Location Source_Location;
 
+// NOTE(vlad): Both start at 0.
+struct Line_And_Column
+{
     Index line;
     Index column;
 };
-typedef struct Source_Location Source_Location;
+typedef struct Line_And_Column Line_And_Column;
 
 enum Message_Level
 {
@@ -41,6 +52,10 @@ struct Diagnostic_Message
 };
 typedef struct Diagnostic_Message Diagnostic_Message;
 
+maybe_unused internal void build_line_start_offsets(Arena* arena, Source_File* source_file);
+maybe_unused internal Line_And_Column resolve_source_location(const Source_File* source_file,
+                                                              const Source_Location location);
+
 maybe_unused internal inline String_View source_location_to_string(struct Compilation_Context* context,
                                                                    const Source_Location* location);
 maybe_unused internal inline void extend_location(Source_Location* location, const Source_Location* to_location);
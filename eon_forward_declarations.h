@@ -13,12 +13,27 @@ enum
 };
 
 struct Type;
+struct Type_String;
 struct Type_Id
 {
     Index index;
 };
 typedef struct Type_Id Type_Id;
 
+// NOTE(vlad): Dense id of an interned string, see 'intern_string'.
+typedef u32 Name_Id;
+enum
+{
+    INVALID_NAME_ID = 0,
+};
+
+// NOTE(vlad): Index into 'Ast.expressions', side tables of the passes use the same indices.
+typedef u32 Ast_Expression_Id;
+enum
+{
+    INVALID_AST_EXPRESSION_ID = 0,
+};
+
 struct Lexical_Scope;
 typedef Index Lexical_Scope_Id;
 enum
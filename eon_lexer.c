@@ -2,8 +2,39 @@
 
 #include "eon_compilation_context.h"
 
+#include <eon/characters_block.h>
 #include <eon/io.h>
 
+#include <eon/platform/threads.h>
+
+internal Token_Type
+classify_word(const String_View word)
+{
+    ASSERT(word.length > 0);
+
+    const Keyword* keyword = &global_keywords[HASH_KEYWORD(word.data[0],
+                                                           word.data[word.length - 1],
+                                                           word.length)];
+
+    // NOTE(vlad): Empty slots have zero length, so they never match.
+    if (keyword->lexeme.length != word.length)
+    {
+        return TOKEN_IDENTIFIER;
+    }
+
+    for (Index i = 0;
+         i < word.length;
+         ++i)
+    {
+        if (keyword->lexeme.data[i] != word.data[i])
+        {
+            return TOKEN_IDENTIFIER;
+        }
+    }
+
+    return keyword->type;
+}
+
 internal void
 create_lexer(Lexer* lexer, Compilation_Context* context)
 {
@@ -11,33 +42,9 @@ create_lexer(Lexer* lexer, Compilation_Context* context)
     lexer->code = context->source_file.code;
     lexer->lexeme_start_index = 0;
     lexer->current_index = 0;
-    lexer->current_line = 0;
-    lexer->current_column = 0;
-
-    const Keyword keywords[] = {
-        { .type = TOKEN_FOR,   .lexeme = string_view("for"), },
-        { .type = TOKEN_IF,    .lexeme = string_view("if"), },
-        { .type = TOKEN_ELSE,  .lexeme = string_view("else"), },
-        { .type = TOKEN_WHILE, .lexeme = string_view("while"), },
-        { .type = TOKEN_TRUE,  .lexeme = string_view("true"), },
-        { .type = TOKEN_FALSE, .lexeme = string_view("false"), },
-        { .type = TOKEN_ARROW, .lexeme = string_view("->"), },
-        { .type = TOKEN_RETURN, .lexeme = string_view("return"), },
-        { .type = TOKEN_BREAK, .lexeme = string_view("break"), },
-        { .type = TOKEN_CONTINUE, .lexeme = string_view("continue"), },
-        { .type = TOKEN_WILDCARD, .lexeme = string_view("_"), },
-
-        { .type = TOKEN_MUTABLE, .lexeme = string_view("mutable"), },
-    };
-
-    lexer->keywords_count = NUMBER_OF_STATIC_ARRAY_ELEMENTS(keywords);
-    lexer->keywords = allocate_array(context->keywords_arena, lexer->keywords_count, Keyword);
-    for (Index i = 0;
-         i < lexer->keywords_count;
-         ++i)
-    {
-        lexer->keywords[i] = keywords[i];
-    }
+    lexer->uses_vector_scans = true;
+    lexer->is_lexing_chunk = false;
+    lexer->error_offset = 0;
 }
 
 internal inline char
@@ -54,7 +61,6 @@ move_to_next_character(Lexer* lexer)
     if (lexer->current_index < lexer->code.length)
     {
         lexer->current_index += 1;
-        lexer->current_column += 1;
         return true;
     }
 
@@ -86,51 +92,252 @@ create_token(Lexer* lexer, Token* token, const Token_Type type)
     const Size lexeme_length = lexer->current_index - lexer->lexeme_start_index;
 
     token->type = type;
+    token->name_id = INVALID_NAME_ID;
     token->lexeme = (String_View) {
         .data   = lexer->code.data + lexer->lexeme_start_index,
         .length = lexeme_length,
     };
-    token->location.offset_in_bytes = lexer->lexeme_start_index;
-    token->location.length_in_bytes = lexeme_length;
-    token->location.line = lexer->current_line;
-    token->location.column = lexer->current_column - token->lexeme.length;
+    token->location.offset_in_bytes = (u32)lexer->lexeme_start_index;
+    token->location.length_in_bytes = (u32)lexeme_length;
 }
 
+enum Character_Class
+{
+    CHARACTER_CLASS_NONE = 0,
+
+    CHARACTER_CLASS_IDENTIFIER_HEAD = 1 << 0,
+    CHARACTER_CLASS_IDENTIFIER_TAIL = 1 << 1,
+    CHARACTER_CLASS_DIGIT_ONLY      = 1 << 2,
+
+    // NOTE(vlad): Whitespaces except for newlines, which also move the location to the next line.
+    CHARACTER_CLASS_BLANK           = 1 << 3,
+    CHARACTER_CLASS_NEWLINE         = 1 << 4,
+
+    // NOTE(vlad): Characters that can start or end a block comment.
+    CHARACTER_CLASS_COMMENT_DELIMITER = 1 << 5,
+};
+typedef enum Character_Class Character_Class;
+
+#define LETTER(c) [c] = CHARACTER_CLASS_IDENTIFIER_HEAD | CHARACTER_CLASS_IDENTIFIER_TAIL
+#define DIGIT(c) [c] = CHARACTER_CLASS_IDENTIFIER_TAIL | CHARACTER_CLASS_DIGIT_ONLY
+
+// NOTE(vlad): Every byte maps to a combination of 'Character_Class' flags, non-ASCII bytes
+//             don't belong to any class.
+global_variable const u8 global_character_classes[256] = {
+    LETTER('a'), LETTER('b'), LETTER('c'), LETTER('d'), LETTER('e'), LETTER('f'), LETTER('g'), LETTER('h'), LETTER('i'), LETTER('j'), LETTER('k'), LETTER('l'), LETTER('m'),
+    LETTER('n'), LETTER('o'), LETTER('p'), LETTER('q'), LETTER('r'), LETTER('s'), LETTER('t'), LETTER('u'), LETTER('v'), LETTER('w'), LETTER('x'), LETTER('y'), LETTER('z'),
+    LETTER('A'), LETTER('B'), LETTER('C'), LETTER('D'), LETTER('E'), LETTER('F'), LETTER('G'), LETTER('H'), LETTER('I'), LETTER('J'), LETTER('K'), LETTER('L'), LETTER('M'),
+    LETTER('N'), LETTER('O'), LETTER('P'), LETTER('Q'), LETTER('R'), LETTER('S'), LETTER('T'), LETTER('U'), LETTER('V'), LETTER('W'), LETTER('X'), LETTER('Y'), LETTER('Z'),
+    DIGIT('0'), DIGIT('1'), DIGIT('2'), DIGIT('3'), DIGIT('4'), DIGIT('5'), DIGIT('6'), DIGIT('7'), DIGIT('8'), DIGIT('9'),
+    ['_'] = CHARACTER_CLASS_IDENTIFIER_HEAD | CHARACTER_CLASS_IDENTIFIER_TAIL,
+
+    [' '] = CHARACTER_CLASS_BLANK, ['\t'] = CHARACTER_CLASS_BLANK, ['\r'] = CHARACTER_CLASS_BLANK,
+    ['\n'] = CHARACTER_CLASS_NEWLINE,
+
+    ['*'] = CHARACTER_CLASS_COMMENT_DELIMITER, ['/'] = CHARACTER_CLASS_COMMENT_DELIMITER,
+};
+
+#undef LETTER
+#undef DIGIT
+
 internal inline Bool
-is_a_part_of_identifier_tail(const char c)
+character_has_class(const char c, const Character_Class character_class)
 {
-    return is_ascii_letter(c)
-        || is_ascii_digit(c)
-        || c == '_';
+    return (global_character_classes[(u8)c] & character_class) != 0;
 }
 
-internal inline Bool
-is_not_a_newline(const char c)
+// NOTE(vlad): Vector scans look at a block of characters at a time and stop at the first
+//             character that ends the scan. Blocks are loaded only when they fit in the code
+//             completely, the remaining characters are scanned one by one.
+#if HAS_CHARACTERS_BLOCKS
+// NOTE(vlad): These return a mask with bits set for the characters that continue the scan.
+internal inline u32
+match_identifier_tail_block(const Characters_Block block)
+{
+    // NOTE(vlad): Setting the 0x20 bit lowercases letters and doesn't turn anything else into one.
+    const Characters_Block lowercase_block = CHARACTERS_OR(block, BROADCAST_CHARACTER(0x20));
+
+    return CHARACTERS_BLOCK_MASK(CHARACTERS_OR(CHARACTERS_OR(CHARACTERS_ARE_IN_RANGE(lowercase_block, 'a', 'z'),
+                                                             CHARACTERS_ARE_IN_RANGE(block, '0', '9')),
+                                               CHARACTERS_ARE_EQUAL(block, '_')));
+}
+
+internal inline u32
+match_blanks_block(const Characters_Block block)
 {
-    return c != '\n';
+    return CHARACTERS_BLOCK_MASK(CHARACTERS_OR(CHARACTERS_OR(CHARACTERS_ARE_EQUAL(block, ' '),
+                                                             CHARACTERS_ARE_EQUAL(block, '\t')),
+                                               CHARACTERS_ARE_EQUAL(block, '\r')));
 }
 
-typedef Bool (*Character_Predicate)(const char lookahead_char);
+internal inline u32
+match_line_comment_body_block(const Characters_Block block)
+{
+    return ~CHARACTERS_BLOCK_MASK(CHARACTERS_ARE_EQUAL(block, '\n')) & CHARACTERS_BLOCK_FULL_MASK;
+}
+
+internal inline u32
+match_block_comment_body_block(const Characters_Block block)
+{
+    return ~CHARACTERS_BLOCK_MASK(CHARACTERS_OR(CHARACTERS_ARE_EQUAL(block, '*'),
+                                                CHARACTERS_ARE_EQUAL(block, '/')))
+        & CHARACTERS_BLOCK_FULL_MASK;
+}
+
+internal inline u32
+match_plain_code_block(const Characters_Block block)
+{
+    return ~CHARACTERS_BLOCK_MASK(CHARACTERS_OR(CHARACTERS_ARE_EQUAL(block, '"'),
+                                                CHARACTERS_ARE_EQUAL(block, '/')))
+        & CHARACTERS_BLOCK_FULL_MASK;
+}
+
+#    define SCAN_CHARACTERS_BLOCKS(lexer, characters, count, result, match_block)     \
+    do                                                                              \
+    {                                                                               \
+        while ((lexer)->uses_vector_scans && (result) + CHARACTERS_BLOCK_SIZE <= (count)) \
+        {                                                                           \
+            const u32 mask = match_block(LOAD_CHARACTERS_BLOCK((characters) + (result))); \
+            if (mask != CHARACTERS_BLOCK_FULL_MASK)                                 \
+            {                                                                       \
+                return (result) + count_trailing_zeros(~mask);                      \
+            }                                                                       \
+                                                                                    \
+            (result) += CHARACTERS_BLOCK_SIZE;                                      \
+        }                                                                           \
+    }                                                                               \
+    while (0)
+#else
+#    define SCAN_CHARACTERS_BLOCKS(lexer, characters, count, result, match_block) UNUSED(lexer)
+#endif
+
+// NOTE(vlad): Defines 'count_<name>_characters', which returns the number of leading characters
+//             that continue the scan.
+#define DEFINE_CHARACTERS_SCAN(name, match_block, character_continues_scan)        \
+    internal Size                                                                   \
+    count_##name##_characters(const Lexer* lexer, const char* characters, const Size count) \
+    {                                                                               \
+        Size result = 0;                                                            \
+                                                                                    \
+        SCAN_CHARACTERS_BLOCKS(lexer, characters, count, result, match_block);      \
+                                                                                    \
+        while (result < count && character_continues_scan(characters[result]))      \
+        {                                                                           \
+            result += 1;                                                            \
+        }                                                                           \
+                                                                                    \
+        return result;                                                              \
+    }
+
+#define IS_IDENTIFIER_TAIL(c) character_has_class((c), CHARACTER_CLASS_IDENTIFIER_TAIL)
+#define IS_BLANK(c) character_has_class((c), CHARACTER_CLASS_BLANK)
+#define IS_NOT_NEWLINE(c) !character_has_class((c), CHARACTER_CLASS_NEWLINE)
+#define IS_NOT_COMMENT_DELIMITER(c) !character_has_class((c), CHARACTER_CLASS_COMMENT_DELIMITER)
+// NOTE(vlad): Characters that can't start a string literal or a comment.
+#define IS_PLAIN_CODE(c) ((c) != '"' && (c) != '/')
+
+DEFINE_CHARACTERS_SCAN(identifier_tail, match_identifier_tail_block, IS_IDENTIFIER_TAIL)
+DEFINE_CHARACTERS_SCAN(blank, match_blanks_block, IS_BLANK)
+DEFINE_CHARACTERS_SCAN(line_comment_body, match_line_comment_body_block, IS_NOT_NEWLINE)
+DEFINE_CHARACTERS_SCAN(block_comment_body, match_block_comment_body_block, IS_NOT_COMMENT_DELIMITER)
+DEFINE_CHARACTERS_SCAN(plain_code, match_plain_code_block, IS_PLAIN_CODE)
+
+#undef IS_IDENTIFIER_TAIL
+#undef IS_BLANK
+#undef IS_NOT_NEWLINE
+#undef IS_NOT_COMMENT_DELIMITER
+#undef IS_PLAIN_CODE
+
+internal inline void
+skip_characters(Lexer* lexer, const Size count)
+{
+    ASSERT(lexer->current_index + count <= lexer->code.length);
+
+    lexer->current_index += count;
+}
+
+#define SKIP_CHARACTERS(lexer, name)                                                    \
+    skip_characters((lexer),                                                            \
+                    count_##name##_characters((lexer),                                  \
+                                              (lexer)->code.data + (lexer)->current_index, \
+                                              (lexer)->code.length - (lexer)->current_index))
 
 internal void
-consume_characters_while_preciate_is_true(Lexer* lexer,
-                                          const Character_Predicate predicate)
+skip_digits(Lexer* lexer)
 {
-    while (lexer->current_index < lexer->code.length)
+    while (lexer->current_index < lexer->code.length
+           && character_has_class(get_current_character(lexer), CHARACTER_CLASS_DIGIT_ONLY))
     {
-        const char lookahead_char = get_current_character(lexer);
+        move_to_next_character(lexer);
+    }
+}
 
-        if (predicate(lookahead_char))
+// NOTE(vlad): Skips the rest of a string literal after the opening quote. Returns false if
+//             the code ends before the closing quote.
+internal Bool
+skip_string_literal(Lexer* lexer)
+{
+    // XXX(vlad): Remove multiline strings support?
+    while (lexer->current_index < lexer->code.length)
+    {
+        if (consume_current_character_if_matched(lexer, '"'))
         {
-            move_to_next_character(lexer);
+            return true;
         }
         else
         {
-            break;
+            // FIXME(vlad): This skips the character after a newline too.
+            consume_current_character_if_matched(lexer, '\n');
+        }
+
+        move_to_next_character(lexer);
+    }
+
+    return false;
+}
+
+// NOTE(vlad): Skips the rest of a block comment after the opening '/*', nested comments included.
+internal void
+skip_block_comment(Lexer* lexer)
+{
+    Size comment_depth = 1;
+
+    while (lexer->current_index < lexer->code.length)
+    {
+        SKIP_CHARACTERS(lexer, block_comment_body);
+
+        if (consume_current_character_if_matched(lexer, '*')
+            && consume_current_character_if_matched(lexer, '/'))
+        {
+            comment_depth -= 1;
+            if (comment_depth == 0)
+            {
+                break;
+            }
         }
+
+        if (consume_current_character_if_matched(lexer, '/')
+            && consume_current_character_if_matched(lexer, '*'))
+        {
+            comment_depth += 1;
+        }
+
+        move_to_next_character(lexer);
     }
 }
 
+internal void
+report_unexpected_character(Compilation_Context* context, const Index offset)
+{
+    Diagnostic_Message error = {0};
+    error.level = MESSAGE_LEVEL_ERROR;
+    error.location.offset_in_bytes = (u32)offset;
+    error.location.length_in_bytes = 1;
+    error.text = string_view("Unexpected character encountered");
+
+    emit_diagnostic_message(context, &error);
+}
+
 internal Bool
 get_next_token(Lexer* lexer, Token* token)
 {
@@ -151,37 +358,33 @@ get_next_token(Lexer* lexer, Token* token)
         // FIXME(vlad): Do not advance here?
         const char current_char = consume_current_character(lexer);
 
-        if (is_ascii_letter(current_char) || current_char == '_')
+        const u8 character_classes = global_character_classes[(u8)current_char];
+
+        if (character_classes & CHARACTER_CLASS_IDENTIFIER_HEAD)
         {
-            consume_characters_while_preciate_is_true(lexer,
-                                                      is_a_part_of_identifier_tail);
+            SKIP_CHARACTERS(lexer, identifier_tail);
 
             create_token(lexer, token, TOKEN_IDENTIFIER);
+            token->type = classify_word(token->lexeme);
 
-            for (Index i = 0;
-                 i < lexer->keywords_count;
-                 ++i)
-            {
-                const Keyword* keyword = &lexer->keywords[i];
-                if (strings_are_equal(token->lexeme, keyword->lexeme))
-                {
-                    token->type = keyword->type;
-                    break;
-                }
-            }
+            // NOTE(vlad): Some keywords are builtin symbols (e.g. 'true' and '_'), so they
+            //             have names too.
+            token->name_id = lexer->is_lexing_chunk
+                ? PENDING_NAME_ID
+                : intern_string(lexer->context, token->lexeme);
 
             return true;
         }
 
-        if (is_ascii_digit(current_char))
+        if (character_classes & CHARACTER_CLASS_DIGIT_ONLY)
         {
-            consume_characters_while_preciate_is_true(lexer, is_ascii_digit);
+            skip_digits(lexer);
 
             if (lexer->current_index < lexer->code.length
                 && get_current_character(lexer) == '.')
             {
                 move_to_next_character(lexer);
-                consume_characters_while_preciate_is_true(lexer, is_ascii_digit);
+                skip_digits(lexer);
             }
 
             create_token(lexer, token, TOKEN_NUMBER);
@@ -270,21 +473,10 @@ get_next_token(Lexer* lexer, Token* token)
 
             case '"':
             {
-                // XXX(vlad): Remove multiline strings support?
-                while (lexer->current_index < lexer->code.length)
+                if (skip_string_literal(lexer))
                 {
-                    if (consume_current_character_if_matched(lexer, '"'))
-                    {
-                        create_token(lexer, token, TOKEN_STRING);
-                        return true;
-                    }
-                    else if (consume_current_character_if_matched(lexer, '\n'))
-                    {
-                        lexer->current_column = 0; // TODO(vlad): 1?
-                        lexer->current_line += 1;
-                    }
-
-                    move_to_next_character(lexer);
+                    create_token(lexer, token, TOKEN_STRING);
+                    return true;
                 }
             } break;
 
@@ -293,35 +485,13 @@ get_next_token(Lexer* lexer, Token* token)
                 if (consume_current_character_if_matched(lexer, '/'))
                 {
                     // NOTE(vlad): Single line comment, skipping this line.
-                    consume_characters_while_preciate_is_true(lexer,
-                                                              is_not_a_newline);
-                    lexer->lexeme_start_index = lexer->current_index + 1;
+                    SKIP_CHARACTERS(lexer, line_comment_body);
+                    lexer->lexeme_start_index = lexer->current_index;
                 }
                 else if (consume_current_character_if_matched(lexer, '*'))
                 {
                     // NOTE(vlad): Block comment.
-                    Size comment_depth = 1;
-
-                    while (lexer->current_index < lexer->code.length)
-                    {
-                        if (consume_current_character_if_matched(lexer, '*')
-                            && consume_current_character_if_matched(lexer, '/'))
-                        {
-                            comment_depth -= 1;
-                            if (comment_depth == 0)
-                            {
-                                break;
-                            }
-                        }
-
-                        if (consume_current_character_if_matched(lexer, '/')
-                            && consume_current_character_if_matched(lexer, '*'))
-                        {
-                            comment_depth += 1;
-                        }
-
-                        move_to_next_character(lexer);
-                    }
+                    skip_block_comment(lexer);
                 }
                 else
                 {
@@ -334,28 +504,26 @@ get_next_token(Lexer* lexer, Token* token)
             case '\r':
             case '\t':
             {
-                lexer->lexeme_start_index = lexer->current_index;
                 // NOTE(vlad): Ignoring whitespaces.
+                SKIP_CHARACTERS(lexer, blank);
+                lexer->lexeme_start_index = lexer->current_index;
             } break;
 
             case '\n':
             {
-                lexer->current_column = 0;
-                lexer->current_line += 1;
                 lexer->lexeme_start_index = lexer->current_index;
             } break;
 
             default:
             {
-                Diagnostic_Message error = {0};
-                error.level = MESSAGE_LEVEL_ERROR;
-                error.location.offset_in_bytes = lexer->current_index;
-                error.location.length_in_bytes = 1;
-                error.location.line = lexer->current_line;
-                error.location.column = lexer->current_column - 1;
-                error.text = string_view("Unexpected character encountered");
-
-                emit_diagnostic_message(lexer->context, &error);
+                if (lexer->is_lexing_chunk)
+                {
+                    lexer->error_offset = lexer->current_index - 1;
+                }
+                else
+                {
+                    report_unexpected_character(lexer->context, lexer->current_index - 1);
+                }
 
                 // TODO(vlad): Do we really need this?
                 lexer->lexeme_start_index = lexer->current_index;
@@ -378,3 +546,297 @@ destroy_lexer(Lexer* lexer)
 {
     UNUSED(lexer);
 }
+
+internal Bool
+lex_all_tokens(Lexer* lexer, Arena* arena, Token_Buffer* buffer)
+{
+    ASSERT(lexer->code.length <= MAX_VALUE(u32) && "Offsets of tokens must fit in 32 bits");
+
+    // NOTE(vlad): An average token with the whitespace around it takes a few bytes, reserving
+    //             for that up front saves most of the copies on growth.
+    const Size expected_tokens_count = (lexer->code.length - lexer->current_index) / 4 + 1;
+    ensure_array_has_enough_capacity(arena, buffer->types, u8, expected_tokens_count);
+    ensure_array_has_enough_capacity(arena, buffer->offsets, u32, expected_tokens_count);
+    ensure_array_has_enough_capacity(arena, buffer->lengths, u32, expected_tokens_count);
+    ensure_array_has_enough_capacity(arena, buffer->name_ids, Name_Id, expected_tokens_count);
+
+    Bool lexed_without_errors = true;
+
+    while (true)
+    {
+        Token token = {0};
+        if (!get_next_token(lexer, &token))
+        {
+            lexed_without_errors = false;
+            break;
+        }
+
+        append_array(arena, buffer->types, u8, (u8)token.type);
+        append_array(arena, buffer->offsets, u32, token.location.offset_in_bytes);
+        append_array(arena, buffer->lengths, u32, token.location.length_in_bytes);
+        append_array(arena, buffer->name_ids, Name_Id, token.name_id);
+
+        if (token.type == TOKEN_EOF)
+        {
+            break;
+        }
+    }
+
+    return lexed_without_errors;
+}
+
+// NOTE(vlad): A chunk may start right after any newline outside of string literals and comments:
+//             no token spans a newline, so the lexer is always between two tokens there.
+//             The pre-scan only stops at quotes and slashes, skipping string literals and
+//             comments exactly like 'get_next_token' does.
+internal Size
+find_lexer_chunk_boundaries(const Lexer* lexer, const Size max_chunks_count, Index* boundaries)
+{
+    ASSERT(max_chunks_count > 0);
+
+    Lexer scanner = *lexer;
+
+    const Index code_start = scanner.current_index;
+    const Size code_length = scanner.code.length - code_start;
+
+    boundaries[0] = code_start;
+    Size chunks_count = 1;
+    Index next_chunk_target = code_start + code_length / max_chunks_count;
+
+    while (chunks_count < max_chunks_count && scanner.current_index < scanner.code.length)
+    {
+        const Index plain_code_start = scanner.current_index;
+        SKIP_CHARACTERS(&scanner, plain_code);
+
+        while (chunks_count < max_chunks_count && next_chunk_target < scanner.current_index)
+        {
+            // NOTE(vlad): Looking for a newline the same way line comments are skipped.
+            const Index search_start = MAX(plain_code_start, next_chunk_target);
+            const Index newline_index = search_start + count_line_comment_body_characters(&scanner,
+                                                                                          scanner.code.data + search_start,
+                                                                                          scanner.current_index - search_start);
+
+            // NOTE(vlad): The target moves to the next stretch of plain code then.
+            if (newline_index >= scanner.current_index || newline_index + 1 == scanner.code.length)
+            {
+                break;
+            }
+
+            boundaries[chunks_count] = newline_index + 1;
+            chunks_count += 1;
+
+            next_chunk_target = MAX(code_start + code_length * chunks_count / max_chunks_count, newline_index + 1);
+        }
+
+        if (scanner.current_index == scanner.code.length)
+        {
+            break;
+        }
+
+        if (consume_current_character(&scanner) == '"')
+        {
+            skip_string_literal(&scanner);
+        }
+        else if (consume_current_character_if_matched(&scanner, '/'))
+        {
+            SKIP_CHARACTERS(&scanner, line_comment_body);
+        }
+        else if (consume_current_character_if_matched(&scanner, '*'))
+        {
+            skip_block_comment(&scanner);
+        }
+    }
+
+    boundaries[chunks_count] = scanner.code.length;
+    return chunks_count;
+}
+
+struct Lexer_Chunk
+{
+    Lexer lexer;
+
+    Arena* arena;
+    Token_Buffer tokens;
+    Bool lexed_without_errors;
+
+    Thread thread;
+    Bool thread_started;
+};
+typedef struct Lexer_Chunk Lexer_Chunk;
+
+internal void
+lex_chunk(void* chunk_pointer)
+{
+    Lexer_Chunk* chunk = chunk_pointer;
+    chunk->lexed_without_errors = lex_all_tokens(&chunk->lexer, chunk->arena, &chunk->tokens);
+}
+
+// NOTE(vlad): Names are interned while stitching, in the order of tokens, so 'Name_Id's are
+//             the same as if the whole file was lexed sequentially.
+internal Bool
+append_chunk_tokens(Lexer* lexer, Arena* arena, Token_Buffer* buffer, const Lexer_Chunk* chunk, const Bool is_last_chunk)
+{
+    const Token_Buffer* tokens = &chunk->tokens;
+    const Index first_token_index = buffer->types_count;
+
+    // NOTE(vlad): Every chunk but the last one ends with its own EOF token.
+    const Size tokens_count = (chunk->lexed_without_errors && !is_last_chunk)
+        ? tokens->types_count - 1
+        : tokens->types_count;
+
+    append_array_elements(arena, buffer->types, u8, tokens->types, tokens_count);
+    append_array_elements(arena, buffer->offsets, u32, tokens->offsets, tokens_count);
+    append_array_elements(arena, buffer->lengths, u32, tokens->lengths, tokens_count);
+    append_array_elements(arena, buffer->name_ids, Name_Id, tokens->name_ids, tokens_count);
+
+    for (Index token_index = first_token_index;
+         token_index < buffer->name_ids_count;
+         ++token_index)
+    {
+        if (buffer->name_ids[token_index] == PENDING_NAME_ID)
+        {
+            const String_View name = {
+                .data   = lexer->code.data + buffer->offsets[token_index],
+                .length = buffer->lengths[token_index],
+            };
+            buffer->name_ids[token_index] = intern_string(lexer->context, name);
+        }
+    }
+
+    if (!chunk->lexed_without_errors)
+    {
+        report_unexpected_character(lexer->context, chunk->lexer.error_offset);
+    }
+
+    return chunk->lexed_without_errors;
+}
+
+internal Bool
+lex_all_tokens_in_chunks(Lexer* lexer, Arena* arena, Token_Buffer* buffer, const Index* boundaries, const Size chunks_count)
+{
+    ASSERT(chunks_count > 0 && boundaries[0] == lexer->current_index);
+
+    if (chunks_count == 1)
+    {
+        return lex_all_tokens(lexer, arena, buffer);
+    }
+
+    // NOTE(vlad): Arenas aren't thread-safe and the arena provider may hand out the same arena
+    //             twice (e.g. in tests), so every chunk gets an arena of its own.
+    Lexer_Chunk chunks[MAX_LEXER_CHUNKS_COUNT] = {0};
+    ASSERT(chunks_count <= MAX_LEXER_CHUNKS_COUNT);
+
+    for (Index chunk_index = 0;
+         chunk_index < chunks_count;
+         ++chunk_index)
+    {
+        Lexer_Chunk* chunk = &chunks[chunk_index];
+
+        chunk->lexer = *lexer;
+        chunk->lexer.code.length = boundaries[chunk_index + 1];
+        chunk->lexer.lexeme_start_index = boundaries[chunk_index];
+        chunk->lexer.current_index = boundaries[chunk_index];
+        chunk->lexer.is_lexing_chunk = true;
+
+        chunk->arena = create_arena("lexer-chunk", MiB(16), KiB(64));
+    }
+
+    // NOTE(vlad): The first chunk is lexed on the calling thread, which also takes over
+    //             the chunks whose threads failed to start.
+    for (Index chunk_index = 1;
+         chunk_index < chunks_count;
+         ++chunk_index)
+    {
+        chunks[chunk_index].thread_started = platform_start_thread(&chunks[chunk_index].thread, lex_chunk, &chunks[chunk_index]);
+    }
+
+    for (Index chunk_index = 0;
+         chunk_index < chunks_count;
+         ++chunk_index)
+    {
+        if (chunks[chunk_index].thread_started)
+        {
+            platform_join_thread(&chunks[chunk_index].thread);
+        }
+        else
+        {
+            lex_chunk(&chunks[chunk_index]);
+        }
+    }
+
+    Size tokens_count = 0;
+    for (Index chunk_index = 0;
+         chunk_index < chunks_count;
+         ++chunk_index)
+    {
+        tokens_count += chunks[chunk_index].tokens.types_count;
+    }
+
+    ensure_array_has_enough_capacity(arena, buffer->types, u8, tokens_count);
+    ensure_array_has_enough_capacity(arena, buffer->offsets, u32, tokens_count);
+    ensure_array_has_enough_capacity(arena, buffer->lengths, u32, tokens_count);
+    ensure_array_has_enough_capacity(arena, buffer->name_ids, Name_Id, tokens_count);
+
+    // NOTE(vlad): Tokens after the first unexpected character are dropped, the sequential
+    //             lexer stops there.
+    Bool lexed_without_errors = true;
+    Index last_chunk_index = 0;
+
+    for (;
+         last_chunk_index < chunks_count;
+         ++last_chunk_index)
+    {
+        const Bool is_last_chunk = (last_chunk_index == chunks_count - 1);
+        if (!append_chunk_tokens(lexer, arena, buffer, &chunks[last_chunk_index], is_last_chunk))
+        {
+            lexed_without_errors = false;
+            break;
+        }
+    }
+
+    const Lexer* last_lexer = &chunks[MIN(last_chunk_index, chunks_count - 1)].lexer;
+    lexer->lexeme_start_index = last_lexer->lexeme_start_index;
+    lexer->current_index = last_lexer->current_index;
+
+    for (Index chunk_index = 0;
+         chunk_index < chunks_count;
+         ++chunk_index)
+    {
+        destroy_arena(chunks[chunk_index].arena);
+    }
+
+    return lexed_without_errors;
+}
+
+internal Bool
+lex_all_tokens_in_parallel(Lexer* lexer, Arena* arena, Token_Buffer* buffer, const Size threads_count)
+{
+    const Size code_length = lexer->code.length - lexer->current_index;
+    const Size max_chunks_count = MIN(MIN(threads_count, code_length / MIN_BYTES_PER_LEXER_CHUNK),
+                                      MAX_LEXER_CHUNKS_COUNT);
+
+    Index boundaries[MAX_LEXER_CHUNKS_COUNT + 1] = {0};
+    const Size chunks_count = find_lexer_chunk_boundaries(lexer, MAX(max_chunks_count, 1), boundaries);
+
+    return lex_all_tokens_in_chunks(lexer, arena, buffer, boundaries, chunks_count);
+}
+
+internal Token
+get_buffered_token(const Token_Buffer* buffer, const String_View code, const Index token_index)
+{
+    ASSERT(0 <= token_index && token_index < buffer->types_count);
+
+    const u32 offset = buffer->offsets[token_index];
+    const u32 length = buffer->lengths[token_index];
+
+    Token token = {0};
+    token.type = (Token_Type)buffer->types[token_index];
+    token.lexeme = (String_View) {
+        .data   = code.data + offset,
+        .length = length,
+    };
+    token.location.offset_in_bytes = offset;
+    token.location.length_in_bytes = length;
+    token.name_id = buffer->name_ids[token_index];
+    return token;
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <eon/common.h>
+#include <eon/containers.h>
 #include <eon/string.h>
 
 #include "eon_forward_declarations.h"
@@ -42,11 +43,13 @@ enum Token_Type
 };
 typedef enum Token_Type Token_Type;
 
+// NOTE(vlad): Tokens are copied into AST nodes, the fields are ordered to keep it 32 bytes.
 struct Token
 {
-    Token_Type type;
     String_View lexeme;
     Source_Location location;
+    Token_Type type;
+    Name_Id name_id; // NOTE(vlad): Only set for identifiers and keywords.
 };
 typedef struct Token Token;
 
@@ -57,6 +60,59 @@ struct Keyword
 };
 typedef struct Keyword Keyword;
 
+// NOTE(vlad): A perfect hash of the reserved words: every keyword gets its own slot, so
+//             an identifier is a keyword only if it matches the single keyword in its slot.
+//             Designated initializers of colliding keywords override each other, which
+//             '-Woverride-init' (a part of '-Wextra') turns into a compilation error.
+#define KEYWORDS_TABLE_SIZE 16
+#define HASH_KEYWORD(first_char, last_char, length) \
+    ((Index)(((Size)(first_char) ^ ((Size)(last_char) << 2) ^ (Size)(length)) & (KEYWORDS_TABLE_SIZE - 1)))
+
+// NOTE(vlad): The first and the last characters are passed separately because indexing
+//             a string literal is not a constant expression.
+#define KEYWORD(keyword_type, keyword_lexeme, first_char, last_char)                               \
+    [HASH_KEYWORD(first_char, last_char, sizeof(keyword_lexeme) - 1)] = {                           \
+        .type = keyword_type,                                                                       \
+        .lexeme = { .data = keyword_lexeme, .length = sizeof(keyword_lexeme) - 1, },               \
+    }
+
+global_variable const Keyword global_keywords[KEYWORDS_TABLE_SIZE] = {
+    KEYWORD(TOKEN_FOR, "for", 'f', 'r'),
+    KEYWORD(TOKEN_IF, "if", 'i', 'f'),
+    KEYWORD(TOKEN_ELSE, "else", 'e', 'e'),
+    KEYWORD(TOKEN_WHILE, "while", 'w', 'e'),
+    KEYWORD(TOKEN_TRUE, "true", 't', 'e'),
+    KEYWORD(TOKEN_FALSE, "false", 'f', 'e'),
+    KEYWORD(TOKEN_RETURN, "return", 'r', 'n'),
+    KEYWORD(TOKEN_BREAK, "break", 'b', 'k'),
+    KEYWORD(TOKEN_CONTINUE, "continue", 'c', 'e'),
+    KEYWORD(TOKEN_WILDCARD, "_", '_', '_'),
+
+    KEYWORD(TOKEN_MUTABLE, "mutable", 'm', 'e'),
+};
+
+#undef KEYWORD
+
+// NOTE(vlad): Tokens of a whole source file in the structure-of-arrays form, so that the parser
+//             can look at any token by its index. Lexemes and locations are restored from
+//             the source code, see 'get_buffered_token'.
+struct Token_Buffer
+{
+    array(u8, types);
+    array(u32, offsets);
+    array(u32, lengths);
+    array(Name_Id, name_ids);
+};
+typedef struct Token_Buffer Token_Buffer;
+
+STATIC_ASSERT(TOKEN_EOF <= MAX_VALUE(u8));
+
+#define PENDING_NAME_ID MAX_VALUE(Name_Id)
+
+// NOTE(vlad): Smaller files are lexed on the calling thread, starting threads isn't worth it.
+#define MIN_BYTES_PER_LEXER_CHUNK KiB(256)
+#define MAX_LEXER_CHUNKS_COUNT 64
+
 struct Lexer
 {
     struct Compilation_Context* context;
@@ -66,14 +122,37 @@ struct Lexer
     Index lexeme_start_index;
     Index current_index;
 
-    Index current_line;
-    Index current_column;
+    // NOTE(vlad): Only disabled by tests that compare vector scans with scalar ones.
+    Bool uses_vector_scans;
 
-    Keyword* keywords;
-    Size keywords_count;
+    // NOTE(vlad): Chunks of a file are lexed on their own threads, where neither the interner
+    //             nor the diagnostics can be used. Names are left as 'PENDING_NAME_ID' and
+    //             the location of an unexpected character is kept in 'error_offset' until
+    //             the chunks are stitched together.
+    Bool is_lexing_chunk;
+    Index error_offset;
 };
 typedef struct Lexer Lexer;
 
 internal void create_lexer(Lexer* lexer, struct Compilation_Context* context);
 internal Bool get_next_token(Lexer* lexer, Token* token);
+// NOTE(vlad): Returns TOKEN_IDENTIFIER if the word is not a keyword.
+internal Token_Type classify_word(String_View word);
 internal void destroy_lexer(Lexer* lexer);
+
+internal Bool lex_all_tokens(Lexer* lexer, Arena* arena, Token_Buffer* buffer);
+// NOTE(vlad): Produces the same tokens, names and diagnostics as 'lex_all_tokens', lexing
+//             chunks of the code on up to 'threads_count' threads.
+maybe_unused internal Bool lex_all_tokens_in_parallel(Lexer* lexer, Arena* arena, Token_Buffer* buffer, Size threads_count);
+// NOTE(vlad): Splits the rest of the code into at most 'max_chunks_count' chunks that can be
+//             lexed independently and returns the number of chunks. Chunk 'i' spans from
+//             'boundaries[i]' to 'boundaries[i + 1]', so 'boundaries' must have room for
+//             'max_chunks_count + 1' elements.
+internal Size find_lexer_chunk_boundaries(const Lexer* lexer, Size max_chunks_count, Index* boundaries);
+// NOTE(vlad): Lexes every chunk from 'find_lexer_chunk_boundaries' on its own thread.
+internal Bool lex_all_tokens_in_chunks(Lexer* lexer,
+                                       Arena* arena,
+                                       Token_Buffer* buffer,
+                                       const Index* boundaries,
+                                       Size chunks_count);
+maybe_unused internal Token get_buffered_token(const Token_Buffer* buffer, String_View code, Index token_index);
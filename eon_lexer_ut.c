@@ -3,6 +3,8 @@
 #include "eon_lexer.h"
 #include "eon_compilation_context.h"
 
+#include <eon/platform/filesystem.h>
+
 internal void
 test_line_comments(Test_Context* test_context)
 {
@@ -47,8 +49,8 @@ test_line_comments(Test_Context* test_context)
         ASSERT_TRUE(get_next_token(&lexer, &token));
         ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_NUMBER);
         ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "123");
-        ASSERT_EQUAL(token.location.line, 1);
-        ASSERT_EQUAL(token.location.column, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 1);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 0);
 
         ASSERT_TRUE(get_next_token(&lexer, &token));
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
@@ -70,22 +72,22 @@ test_line_comments(Test_Context* test_context)
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
         ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_NUMBER);
         ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "2");
-        ASSERT_EQUAL(token.location.line, 0);
-        ASSERT_EQUAL(token.location.column, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 0);
 
         ASSERT_TRUE(get_next_token(&lexer, &token));
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
         ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_PLUS);
         ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "+");
-        ASSERT_EQUAL(token.location.line, 0);
-        ASSERT_EQUAL(token.location.column, 2);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 2);
 
         ASSERT_TRUE(get_next_token(&lexer, &token));
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
         ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_NUMBER);
         ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "2");
-        ASSERT_EQUAL(token.location.line, 1);
-        ASSERT_EQUAL(token.location.column, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 1);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 0);
 
         ASSERT_TRUE(get_next_token(&lexer, &token));
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
@@ -109,22 +111,22 @@ test_line_comments(Test_Context* test_context)
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
         ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_NUMBER);
         ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "2");
-        ASSERT_EQUAL(token.location.line, 0);
-        ASSERT_EQUAL(token.location.column, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 0);
 
         ASSERT_TRUE(get_next_token(&lexer, &token));
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
         ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_PLUS);
         ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "+");
-        ASSERT_EQUAL(token.location.line, 0);
-        ASSERT_EQUAL(token.location.column, 2);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 2);
 
         ASSERT_TRUE(get_next_token(&lexer, &token));
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
         ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_NUMBER);
         ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "2");
-        ASSERT_EQUAL(token.location.line, 0);
-        ASSERT_EQUAL(token.location.column, 24);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 24);
 
         ASSERT_TRUE(get_next_token(&lexer, &token));
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
@@ -146,22 +148,22 @@ test_line_comments(Test_Context* test_context)
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
         ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_NUMBER);
         ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "2");
-        ASSERT_EQUAL(token.location.line, 0);
-        ASSERT_EQUAL(token.location.column, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 0);
 
         ASSERT_TRUE(get_next_token(&lexer, &token));
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
         ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_PLUS);
         ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "+");
-        ASSERT_EQUAL(token.location.line, 0);
-        ASSERT_EQUAL(token.location.column, 2);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 2);
 
         ASSERT_TRUE(get_next_token(&lexer, &token));
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
         ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_NUMBER);
         ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "2");
-        ASSERT_EQUAL(token.location.line, 0);
-        ASSERT_EQUAL(token.location.column, 44);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 44);
 
         ASSERT_TRUE(get_next_token(&lexer, &token));
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
@@ -183,8 +185,8 @@ test_line_comments(Test_Context* test_context)
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
         ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_NUMBER);
         ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "2");
-        ASSERT_EQUAL(token.location.line, 0);
-        ASSERT_EQUAL(token.location.column, 54);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 54);
 
         ASSERT_TRUE(get_next_token(&lexer, &token));
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
@@ -210,22 +212,22 @@ test_numbers(Test_Context* test_context)
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
         ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_NUMBER);
         ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "2");
-        ASSERT_EQUAL(token.location.line, 0);
-        ASSERT_EQUAL(token.location.column, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 0);
 
         ASSERT_TRUE(get_next_token(&lexer, &token));
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
         ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_PLUS);
         ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "+");
-        ASSERT_EQUAL(token.location.line, 0);
-        ASSERT_EQUAL(token.location.column, 2);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 2);
 
         ASSERT_TRUE(get_next_token(&lexer, &token));
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
         ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_NUMBER);
         ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "2");
-        ASSERT_EQUAL(token.location.line, 0);
-        ASSERT_EQUAL(token.location.column, 4);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 4);
 
         ASSERT_TRUE(get_next_token(&lexer, &token));
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
@@ -247,22 +249,22 @@ test_numbers(Test_Context* test_context)
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
         ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_NUMBER);
         ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "1234567890");
-        ASSERT_EQUAL(token.location.line, 0);
-        ASSERT_EQUAL(token.location.column, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 0);
 
         ASSERT_TRUE(get_next_token(&lexer, &token));
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
         ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_PLUS);
         ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "+");
-        ASSERT_EQUAL(token.location.line, 0);
-        ASSERT_EQUAL(token.location.column, 11);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 11);
 
         ASSERT_TRUE(get_next_token(&lexer, &token));
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
         ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_NUMBER);
         ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "999999999999999");
-        ASSERT_EQUAL(token.location.line, 0);
-        ASSERT_EQUAL(token.location.column, 13);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 13);
 
         ASSERT_TRUE(get_next_token(&lexer, &token));
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
@@ -286,8 +288,8 @@ test_numbers(Test_Context* test_context)
             ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
             ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_NUMBER);
             ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "0.1");
-            ASSERT_EQUAL(token.location.line, 0);
-            ASSERT_EQUAL(token.location.column, 0);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 0);
 
             ASSERT_TRUE(get_next_token(&lexer, &token));
             ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
@@ -309,36 +311,36 @@ test_numbers(Test_Context* test_context)
             ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
             ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_IDENTIFIER);
             ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "a");
-            ASSERT_EQUAL(token.location.line, 0);
-            ASSERT_EQUAL(token.location.column, 0);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 0);
 
             ASSERT_TRUE(get_next_token(&lexer, &token));
             ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
             ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_COLON);
             ASSERT_STRINGS_ARE_EQUAL(token.lexeme, ":");
-            ASSERT_EQUAL(token.location.line, 0);
-            ASSERT_EQUAL(token.location.column, 2);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 2);
 
             ASSERT_TRUE(get_next_token(&lexer, &token));
             ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
             ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_ASSIGN);
             ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "=");
-            ASSERT_EQUAL(token.location.line, 0);
-            ASSERT_EQUAL(token.location.column, 3);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 3);
 
             ASSERT_TRUE(get_next_token(&lexer, &token));
             ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
             ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_NUMBER);
             ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "0.1");
-            ASSERT_EQUAL(token.location.line, 0);
-            ASSERT_EQUAL(token.location.column, 5);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 5);
 
             ASSERT_TRUE(get_next_token(&lexer, &token));
             ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
             ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_SEMICOLON);
             ASSERT_STRINGS_ARE_EQUAL(token.lexeme, ";");
-            ASSERT_EQUAL(token.location.line, 0);
-            ASSERT_EQUAL(token.location.column, 8);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 8);
 
             ASSERT_TRUE(get_next_token(&lexer, &token));
             ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
@@ -361,8 +363,8 @@ test_numbers(Test_Context* test_context)
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
         ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_AMPERSAND);
         ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "&");
-        ASSERT_EQUAL(token.location.line, 0);
-        ASSERT_EQUAL(token.location.column, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 0);
 
         ASSERT_TRUE(get_next_token(&lexer, &token));
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
@@ -390,22 +392,22 @@ test_identifiers(Test_Context* test_context)
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
         ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_IDENTIFIER);
         ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "a");
-        ASSERT_EQUAL(token.location.line, 0);
-        ASSERT_EQUAL(token.location.column, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 0);
 
         ASSERT_TRUE(get_next_token(&lexer, &token));
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
         ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_PLUS);
         ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "+");
-        ASSERT_EQUAL(token.location.line, 0);
-        ASSERT_EQUAL(token.location.column, 2);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 2);
 
         ASSERT_TRUE(get_next_token(&lexer, &token));
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
         ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_IDENTIFIER);
         ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "b");
-        ASSERT_EQUAL(token.location.line, 0);
-        ASSERT_EQUAL(token.location.column, 4);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 4);
 
         ASSERT_TRUE(get_next_token(&lexer, &token));
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
@@ -427,15 +429,15 @@ test_identifiers(Test_Context* test_context)
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
         ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_IDENTIFIER);
         ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "_hello");
-        ASSERT_EQUAL(token.location.line, 0);
-        ASSERT_EQUAL(token.location.column, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 0);
 
         ASSERT_TRUE(get_next_token(&lexer, &token));
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
         ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_IDENTIFIER);
         ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "world");
-        ASSERT_EQUAL(token.location.line, 0);
-        ASSERT_EQUAL(token.location.column, 7);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 7);
 
         ASSERT_TRUE(get_next_token(&lexer, &token));
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
@@ -459,50 +461,50 @@ test_identifiers(Test_Context* test_context)
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
         ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_IDENTIFIER);
         ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "main");
-        ASSERT_EQUAL(token.location.line, 0);
-        ASSERT_EQUAL(token.location.column, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 0);
 
         ASSERT_TRUE(get_next_token(&lexer, &token));
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
         ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_COLON);
         ASSERT_STRINGS_ARE_EQUAL(token.lexeme, ":");
-        ASSERT_EQUAL(token.location.line, 0);
-        ASSERT_EQUAL(token.location.column, 4);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 4);
 
         ASSERT_TRUE(get_next_token(&lexer, &token));
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
         ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_LEFT_PAREN);
         ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "(");
-        ASSERT_EQUAL(token.location.line, 0);
-        ASSERT_EQUAL(token.location.column, 6);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 6);
 
         ASSERT_TRUE(get_next_token(&lexer, &token));
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
         ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_RIGHT_PAREN);
         ASSERT_STRINGS_ARE_EQUAL(token.lexeme, ")");
-        ASSERT_EQUAL(token.location.line, 0);
-        ASSERT_EQUAL(token.location.column, 7);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 7);
 
         ASSERT_TRUE(get_next_token(&lexer, &token));
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
         ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_ASSIGN);
         ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "=");
-        ASSERT_EQUAL(token.location.line, 0);
-        ASSERT_EQUAL(token.location.column, 9);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 9);
 
         ASSERT_TRUE(get_next_token(&lexer, &token));
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
         ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_LEFT_BRACE);
         ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "{");
-        ASSERT_EQUAL(token.location.line, 0);
-        ASSERT_EQUAL(token.location.column, 11);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 11);
 
         ASSERT_TRUE(get_next_token(&lexer, &token));
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
         ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_RIGHT_BRACE);
         ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "}");
-        ASSERT_EQUAL(token.location.line, 0);
-        ASSERT_EQUAL(token.location.column, 12);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 12);
 
         ASSERT_TRUE(get_next_token(&lexer, &token));
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
@@ -526,43 +528,43 @@ test_identifiers(Test_Context* test_context)
             ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
             ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_IDENTIFIER);
             ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "arr");
-            ASSERT_EQUAL(token.location.line, 0);
-            ASSERT_EQUAL(token.location.column, 0);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 0);
 
             ASSERT_TRUE(get_next_token(&lexer, &token));
             ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
             ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_COLON);
             ASSERT_STRINGS_ARE_EQUAL(token.lexeme, ":");
-            ASSERT_EQUAL(token.location.line, 0);
-            ASSERT_EQUAL(token.location.column, 3);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 3);
 
             ASSERT_TRUE(get_next_token(&lexer, &token));
             ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
             ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_LEFT_BRACKET);
             ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "[");
-            ASSERT_EQUAL(token.location.line, 0);
-            ASSERT_EQUAL(token.location.column, 5);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 5);
 
             ASSERT_TRUE(get_next_token(&lexer, &token));
             ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
             ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_RIGHT_BRACKET);
             ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "]");
-            ASSERT_EQUAL(token.location.line, 0);
-            ASSERT_EQUAL(token.location.column, 6);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 6);
 
             ASSERT_TRUE(get_next_token(&lexer, &token));
             ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
             ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_IDENTIFIER);
             ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "s32");
-            ASSERT_EQUAL(token.location.line, 0);
-            ASSERT_EQUAL(token.location.column, 8);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 8);
 
             ASSERT_TRUE(get_next_token(&lexer, &token));
             ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
             ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_SEMICOLON);
             ASSERT_STRINGS_ARE_EQUAL(token.lexeme, ";");
-            ASSERT_EQUAL(token.location.line, 0);
-            ASSERT_EQUAL(token.location.column, 11);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 11);
 
             ASSERT_TRUE(get_next_token(&lexer, &token));
             ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
@@ -584,57 +586,57 @@ test_identifiers(Test_Context* test_context)
             ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
             ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_IDENTIFIER);
             ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "arr");
-            ASSERT_EQUAL(token.location.line, 0);
-            ASSERT_EQUAL(token.location.column, 0);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 0);
 
             ASSERT_TRUE(get_next_token(&lexer, &token));
             ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
             ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_COLON);
             ASSERT_STRINGS_ARE_EQUAL(token.lexeme, ":");
-            ASSERT_EQUAL(token.location.line, 0);
-            ASSERT_EQUAL(token.location.column, 3);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 3);
 
             ASSERT_TRUE(get_next_token(&lexer, &token));
             ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
             ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_LEFT_BRACKET);
             ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "[");
-            ASSERT_EQUAL(token.location.line, 0);
-            ASSERT_EQUAL(token.location.column, 5);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 5);
 
             ASSERT_TRUE(get_next_token(&lexer, &token));
             ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
             ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_RIGHT_BRACKET);
             ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "]");
-            ASSERT_EQUAL(token.location.line, 0);
-            ASSERT_EQUAL(token.location.column, 6);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 6);
 
             ASSERT_TRUE(get_next_token(&lexer, &token));
             ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
             ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_LEFT_BRACKET);
             ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "[");
-            ASSERT_EQUAL(token.location.line, 0);
-            ASSERT_EQUAL(token.location.column, 8);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 8);
 
             ASSERT_TRUE(get_next_token(&lexer, &token));
             ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
             ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_RIGHT_BRACKET);
             ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "]");
-            ASSERT_EQUAL(token.location.line, 0);
-            ASSERT_EQUAL(token.location.column, 9);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 9);
 
             ASSERT_TRUE(get_next_token(&lexer, &token));
             ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
             ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_IDENTIFIER);
             ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "s32");
-            ASSERT_EQUAL(token.location.line, 0);
-            ASSERT_EQUAL(token.location.column, 11);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 11);
 
             ASSERT_TRUE(get_next_token(&lexer, &token));
             ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
             ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_SEMICOLON);
             ASSERT_STRINGS_ARE_EQUAL(token.lexeme, ";");
-            ASSERT_EQUAL(token.location.line, 0);
-            ASSERT_EQUAL(token.location.column, 14);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 14);
 
             ASSERT_TRUE(get_next_token(&lexer, &token));
             ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
@@ -661,15 +663,15 @@ test_keywords_and_digraphs(Test_Context* test_context)
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
         ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_FOR);
         ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "for");
-        ASSERT_EQUAL(token.location.line, 0);
-        ASSERT_EQUAL(token.location.column, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 0);
 
         ASSERT_TRUE(get_next_token(&lexer, &token));
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
         ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_IDENTIFIER);
         ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "a");
-        ASSERT_EQUAL(token.location.line, 0);
-        ASSERT_EQUAL(token.location.column, 4);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 4);
 
         ASSERT_TRUE(get_next_token(&lexer, &token));
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
@@ -691,8 +693,8 @@ test_keywords_and_digraphs(Test_Context* test_context)
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
         ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_RETURN);
         ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "return");
-        ASSERT_EQUAL(token.location.line, 0);
-        ASSERT_EQUAL(token.location.column, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 0);
 
         ASSERT_TRUE(get_next_token(&lexer, &token));
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
@@ -714,8 +716,8 @@ test_keywords_and_digraphs(Test_Context* test_context)
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
         ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_ARROW);
         ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "->");
-        ASSERT_EQUAL(token.location.line, 0);
-        ASSERT_EQUAL(token.location.column, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 0);
 
         ASSERT_TRUE(get_next_token(&lexer, &token));
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
@@ -737,8 +739,8 @@ test_keywords_and_digraphs(Test_Context* test_context)
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
         ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_MUTABLE);
         ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "mutable");
-        ASSERT_EQUAL(token.location.line, 0);
-        ASSERT_EQUAL(token.location.column, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 0);
 
         ASSERT_TRUE(get_next_token(&lexer, &token));
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
@@ -760,8 +762,8 @@ test_keywords_and_digraphs(Test_Context* test_context)
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
         ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_WILDCARD);
         ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "_");
-        ASSERT_EQUAL(token.location.line, 0);
-        ASSERT_EQUAL(token.location.column, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 0);
 
         ASSERT_TRUE(get_next_token(&lexer, &token));
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
@@ -783,8 +785,8 @@ test_keywords_and_digraphs(Test_Context* test_context)
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
         ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_BREAK);
         ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "break");
-        ASSERT_EQUAL(token.location.line, 0);
-        ASSERT_EQUAL(token.location.column, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 0);
 
         ASSERT_TRUE(get_next_token(&lexer, &token));
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
@@ -806,8 +808,8 @@ test_keywords_and_digraphs(Test_Context* test_context)
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
         ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, TOKEN_CONTINUE);
         ASSERT_STRINGS_ARE_EQUAL(token.lexeme, "continue");
-        ASSERT_EQUAL(token.location.line, 0);
-        ASSERT_EQUAL(token.location.column, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).line, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, token.location).column, 0);
 
         ASSERT_TRUE(get_next_token(&lexer, &token));
         ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
@@ -818,6 +820,48 @@ test_keywords_and_digraphs(Test_Context* test_context)
     }
 }
 
+internal void
+test_keywords_are_told_apart_from_similar_identifiers(Test_Context* test_context)
+{
+    // NOTE(vlad): Every other word has the same length, first and last characters as the
+    //             keyword before it, so it lands in the same slot of the keywords table.
+    CREATE_TEST_COMPILATION_CONTEXT_FOR_CODE("for fxr if iff else elze while whale true tree "
+                                             "false fakse return retain break brrak "
+                                             "continue continuE _ __ mutable mutabie forx");
+
+    const Token_Type expected_types[] = {
+        TOKEN_FOR, TOKEN_IDENTIFIER,
+        TOKEN_IF, TOKEN_IDENTIFIER,
+        TOKEN_ELSE, TOKEN_IDENTIFIER,
+        TOKEN_WHILE, TOKEN_IDENTIFIER,
+        TOKEN_TRUE, TOKEN_IDENTIFIER,
+        TOKEN_FALSE, TOKEN_IDENTIFIER,
+        TOKEN_RETURN, TOKEN_IDENTIFIER,
+        TOKEN_BREAK, TOKEN_IDENTIFIER,
+        TOKEN_CONTINUE, TOKEN_IDENTIFIER,
+        TOKEN_WILDCARD, TOKEN_IDENTIFIER,
+        TOKEN_MUTABLE, TOKEN_IDENTIFIER,
+        TOKEN_IDENTIFIER,
+        TOKEN_EOF,
+    };
+
+    Lexer lexer = {0};
+    create_lexer(&lexer, &context);
+
+    for (Index i = 0;
+         i < NUMBER_OF_STATIC_ARRAY_ELEMENTS(expected_types);
+         ++i)
+    {
+        Token token = {0};
+        ASSERT_TRUE(get_next_token(&lexer, &token));
+        ASSERT_ENUM_VALUES_ARE_EQUAL(token.type, expected_types[i]);
+    }
+    ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
+
+    destroy_lexer(&lexer);
+    destroy_compilation_context(&context);
+}
+
 internal void
 test_errors(Test_Context* test_context)
 {
@@ -846,12 +890,390 @@ test_errors(Test_Context* test_context)
     }
 }
 
+internal void
+test_identifiers_are_interned(Test_Context* test_context)
+{
+    CREATE_TEST_COMPILATION_CONTEXT_FOR_CODE("foo bar foo true _ 10");
+
+    Lexer lexer = {0};
+    create_lexer(&lexer, &context);
+
+    Token tokens[6] = {0};
+    for (Index i = 0;
+         i < NUMBER_OF_STATIC_ARRAY_ELEMENTS(tokens);
+         ++i)
+    {
+        ASSERT_TRUE(get_next_token(&lexer, &tokens[i]));
+    }
+    ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
+
+    const Token* first_foo = &tokens[0];
+    const Token* bar = &tokens[1];
+    const Token* second_foo = &tokens[2];
+
+    ASSERT_NOT_EQUAL(first_foo->name_id, INVALID_NAME_ID);
+    ASSERT_NOT_EQUAL(bar->name_id, INVALID_NAME_ID);
+    ASSERT_EQUAL(first_foo->name_id, second_foo->name_id);
+    ASSERT_NOT_EQUAL(first_foo->name_id, bar->name_id);
+
+    ASSERT_STRINGS_ARE_EQUAL(get_name_by_id(&context, first_foo->name_id), "foo");
+    ASSERT_STRINGS_ARE_EQUAL(get_name_by_id(&context, bar->name_id), "bar");
+
+    // NOTE(vlad): Keywords that are builtin symbols have names too.
+    ASSERT_ENUM_VALUES_ARE_EQUAL(tokens[3].type, TOKEN_TRUE);
+    ASSERT_EQUAL(tokens[3].name_id, find_name_id(&context, string_view("true")));
+    ASSERT_ENUM_VALUES_ARE_EQUAL(tokens[4].type, TOKEN_WILDCARD);
+    ASSERT_EQUAL(tokens[4].name_id, intern_string(&context, string_view("_")));
+
+    ASSERT_ENUM_VALUES_ARE_EQUAL(tokens[5].type, TOKEN_NUMBER);
+    ASSERT_EQUAL(tokens[5].name_id, INVALID_NAME_ID);
+
+    ASSERT_EQUAL(find_name_id(&context, string_view("baz")), INVALID_NAME_ID);
+    ASSERT_EQUAL(intern_string(&context, string_view("foo")), first_foo->name_id);
+
+    destroy_lexer(&lexer);
+    destroy_compilation_context(&context);
+}
+
+enum Lexing_Mode
+{
+    LEXING_WITH_SCALAR_SCANS,
+    LEXING_WITH_VECTOR_SCANS,
+    LEXING_INTO_TOKEN_BUFFER,
+    LEXING_IN_CHUNKS,
+};
+typedef enum Lexing_Mode Lexing_Mode;
+
+struct Lexed_Tokens
+{
+    array(Token, tokens);
+    Bool lexed_without_errors;
+    Size diagnostic_messages_count;
+    u32 first_error_offset;
+};
+typedef struct Lexed_Tokens Lexed_Tokens;
+
+internal void
+lex_code_into_tokens(Test_Context* test_context,
+                     const String_View code,
+                     const Lexing_Mode mode,
+                     Lexed_Tokens* lexed_tokens)
+{
+    CREATE_TEST_COMPILATION_CONTEXT_FOR_CODE(code);
+
+    Lexer lexer = {0};
+    create_lexer(&lexer, &context);
+    lexer.uses_vector_scans = (mode != LEXING_WITH_SCALAR_SCANS);
+
+    if (mode == LEXING_INTO_TOKEN_BUFFER || mode == LEXING_IN_CHUNKS)
+    {
+        Token_Buffer buffer = {0};
+
+        if (mode == LEXING_IN_CHUNKS)
+        {
+            // NOTE(vlad): Small inputs are never split by 'lex_all_tokens_in_parallel', so
+            //             the chunks are made as small as they can be.
+            Index boundaries[MAX_LEXER_CHUNKS_COUNT + 1] = {0};
+            const Size chunks_count = find_lexer_chunk_boundaries(&lexer, MAX_LEXER_CHUNKS_COUNT, boundaries);
+            lexed_tokens->lexed_without_errors = lex_all_tokens_in_chunks(&lexer,
+                                                                          test_context->arena,
+                                                                          &buffer,
+                                                                          boundaries,
+                                                                          chunks_count);
+        }
+        else
+        {
+            lexed_tokens->lexed_without_errors = lex_all_tokens(&lexer, test_context->arena, &buffer);
+        }
+
+        for (Index i = 0;
+             i < buffer.types_count;
+             ++i)
+        {
+            append_array(test_context->arena, lexed_tokens->tokens, Token, get_buffered_token(&buffer, code, i));
+        }
+    }
+    else
+    {
+        while (true)
+        {
+            Token token = {0};
+            lexed_tokens->lexed_without_errors = get_next_token(&lexer, &token);
+
+            if (!lexed_tokens->lexed_without_errors)
+            {
+                break;
+            }
+
+            append_array(test_context->arena, lexed_tokens->tokens, Token, token);
+
+            if (token.type == TOKEN_EOF)
+            {
+                break;
+            }
+        }
+    }
+
+    lexed_tokens->diagnostic_messages_count = context.diagnostic_messages_count;
+    if (context.diagnostic_messages_count > 0)
+    {
+        lexed_tokens->first_error_offset = context.diagnostic_messages[0].location.offset_in_bytes;
+    }
+
+    destroy_lexer(&lexer);
+    destroy_compilation_context(&context);
+}
+
+internal void
+assert_that_lexing_modes_agree(Test_Context* test_context, const String_View code)
+{
+    Lexed_Tokens scalar = {0};
+    lex_code_into_tokens(test_context, code, LEXING_WITH_SCALAR_SCANS, &scalar);
+
+    const Lexing_Mode other_modes[] = { LEXING_WITH_VECTOR_SCANS, LEXING_INTO_TOKEN_BUFFER, LEXING_IN_CHUNKS };
+
+    for (Index mode_index = 0;
+         mode_index < NUMBER_OF_STATIC_ARRAY_ELEMENTS(other_modes);
+         ++mode_index)
+    {
+        Lexed_Tokens other = {0};
+        lex_code_into_tokens(test_context, code, other_modes[mode_index], &other);
+
+        ASSERT_EQUAL(other.lexed_without_errors, scalar.lexed_without_errors);
+        ASSERT_EQUAL(other.diagnostic_messages_count, scalar.diagnostic_messages_count);
+        ASSERT_EQUAL(other.first_error_offset, scalar.first_error_offset);
+        ASSERT_EQUAL(other.tokens_count, scalar.tokens_count);
+
+        for (Index i = 0;
+             i < scalar.tokens_count;
+             ++i)
+        {
+            const Token* scalar_token = &scalar.tokens[i];
+            const Token* other_token = &other.tokens[i];
+
+            ASSERT_ENUM_VALUES_ARE_EQUAL(other_token->type, scalar_token->type);
+            ASSERT_EQUAL(other_token->location.offset_in_bytes, scalar_token->location.offset_in_bytes);
+            ASSERT_EQUAL(other_token->location.length_in_bytes, scalar_token->location.length_in_bytes);
+            ASSERT_EQUAL(other_token->name_id, scalar_token->name_id);
+        }
+    }
+}
+
+internal String_View
+repeat_characters(Arena* arena, const char* characters, const Size count)
+{
+    const Size characters_count = string_view(characters).length;
+
+    String result = {0};
+    result.data = allocate_uninitialized_array(arena, MAX(count, 1), char);
+    result.length = count;
+
+    for (Index i = 0;
+         i < count;
+         ++i)
+    {
+        result.data[i] = characters[i % characters_count];
+    }
+
+    return string_view(result);
+}
+
+internal void
+test_lexing_modes_agree(Test_Context* test_context)
+{
+    // NOTE(vlad): The inputs of the other tests in this file.
+    const char* const snippets[] = {
+        "// line comment", "// nested // line // comments", "// line comment\n123",
+        "2 + 2", "2 + // line comment\n2", "2 + /* block comment */ 2",
+        "2 + /* nested /* block /* comments */ */ */ 2",
+        "/* // line comment inside block comment is ignored */ 2",
+        "0.1", "1234567890 + 999999999999999", "a := 0.1;",
+        "_", "_hello world", "a + b", "foo bar foo true _ 10",
+        "for a", "return", "break", "continue", "mutable", "->", "&",
+        "main: () = {}", "arr: [] s32;", "arr: [] [] s32;", "?",
+        "\"multiline\nstring\"", "/* unterminated block comment",
+    };
+
+    for (Index i = 0;
+         i < NUMBER_OF_STATIC_ARRAY_ELEMENTS(snippets);
+         ++i)
+    {
+        assert_that_lexing_modes_agree(test_context, string_view(snippets[i]));
+    }
+
+    const char* const test_filenames[] = {
+        "tests/old-interpreter-tests/calls/main.eon",
+        "tests/old-interpreter-tests/empty-file/main.eon",
+        "tests/old-interpreter-tests/empty-main-with-return/main.eon",
+        "tests/old-interpreter-tests/factorial/main.eon",
+        "tests/old-interpreter-tests/fibonacci/main.eon",
+        "tests/old-interpreter-tests/fibonacci-without-recursion/main.eon",
+        "tests/old-interpreter-tests/simple-floats-operations/main.eon",
+        "tests/old-interpreter-tests/square-root/main.eon",
+        "tests/ssa-tests/constant-folding/main.eon",
+        "tests/ssa-tests/general-cases/main.eon",
+        "tests/ssa-tests/loops/main.eon",
+        "tests/ssa-tests/regression-if-statement-with-return/main.eon",
+        "tests/ssa-tests/regression-nested-if-statement/main.eon",
+        "tests/ssa-tests/regression-while-loop-with-break-and-continue/main.eon",
+    };
+
+    for (Index i = 0;
+         i < NUMBER_OF_STATIC_ARRAY_ELEMENTS(test_filenames);
+         ++i)
+    {
+        const Read_File_Result file = platform_read_entire_text_file(test_context->arena,
+                                                                     string_view(test_filenames[i]));
+        ASSERT_ENUM_VALUES_ARE_EQUAL(file.status, READ_FILE_SUCCESS);
+
+        assert_that_lexing_modes_agree(test_context, string_view(file.content));
+    }
+
+    // NOTE(vlad): Runs of every length around the block size, starting at every offset in a block.
+    for (Size run_length = 0;
+         run_length <= 40;
+         ++run_length)
+    {
+        for (Size indentation = 0;
+             indentation <= 17;
+             ++indentation)
+        {
+            const String code = format_string(test_context->arena,
+                                              "{}{} {}\n// {}\n\t/*{}*/ {}\r\n",
+                                              repeat_characters(test_context->arena, " \t", indentation),
+                                              repeat_characters(test_context->arena, "aZ_9", run_length + 1),
+                                              repeat_characters(test_context->arena, "0123456789", run_length + 1),
+                                              repeat_characters(test_context->arena, "x*/ y", run_length),
+                                              repeat_characters(test_context->arena, "ab\n c", run_length),
+                                              repeat_characters(test_context->arena, "_", run_length + 1));
+
+            assert_that_lexing_modes_agree(test_context, string_view(code));
+        }
+    }
+
+    // NOTE(vlad): Pseudo-random mixes of the characters the scans care about, including
+    //             a non-ASCII byte that the lexer rejects.
+    const char alphabet[] = " \t\r\n_aZq09*/\"-=;\xC3";
+    u64 random_state = 0x9E3779B97F4A7C15ull;
+
+    for (Index input_index = 0;
+         input_index < 2000;
+         ++input_index)
+    {
+        random_state = random_state * 6364136223846793005ull + 1442695040888963407ull;
+        const Size length = (Size)((random_state >> 33) % 80);
+
+        String code = {0};
+        code.data = allocate_uninitialized_array(test_context->arena, MAX(length, 1), char);
+        code.length = length;
+
+        for (Index i = 0;
+             i < length;
+             ++i)
+        {
+            random_state = random_state * 6364136223846793005ull + 1442695040888963407ull;
+            code.data[i] = alphabet[(random_state >> 33) % (NUMBER_OF_STATIC_ARRAY_ELEMENTS(alphabet) - 1)];
+        }
+
+        assert_that_lexing_modes_agree(test_context, string_view(code));
+    }
+}
+
+internal void
+test_lexer_chunks_start_after_newlines_outside_of_strings_and_comments(Test_Context* test_context)
+{
+    CREATE_TEST_COMPILATION_CONTEXT_FOR_CODE("a\n\"b\nc\"\n/* d\n */ e\n// \"f\ng\n");
+
+    Lexer lexer = {0};
+    create_lexer(&lexer, &context);
+
+    Index boundaries[MAX_LEXER_CHUNKS_COUNT + 1] = {0};
+    const Size chunks_count = find_lexer_chunk_boundaries(&lexer, MAX_LEXER_CHUNKS_COUNT, boundaries);
+
+    // NOTE(vlad): The newlines inside the string and the block comment are skipped, and
+    //             the trailing one would leave the last chunk empty.
+    const Index expected_boundaries[] = {0, 2, 8, 19, 25, 27};
+    ASSERT_EQUAL(chunks_count + 1, NUMBER_OF_STATIC_ARRAY_ELEMENTS(expected_boundaries));
+
+    for (Index i = 0;
+         i <= chunks_count;
+         ++i)
+    {
+        ASSERT_EQUAL(boundaries[i], expected_boundaries[i]);
+    }
+
+    ASSERT_EQUAL(find_lexer_chunk_boundaries(&lexer, 1, boundaries), 1);
+    ASSERT_EQUAL(boundaries[1], 27);
+
+    destroy_lexer(&lexer);
+    destroy_compilation_context(&context);
+}
+
+internal void
+test_source_locations_are_resolved_by_line_starts(Test_Context* test_context)
+{
+    // NOTE(vlad): Lines of every length up to a few blocks, so that newlines land
+    //             at every position of a block.
+    String_Builder builder = {0};
+    create_string_builder(&builder, test_context->arena);
+
+    for (Size line_length = 0;
+         line_length <= 40;
+         ++line_length)
+    {
+        append_string(&builder, repeat_characters(test_context->arena, "a /* */", line_length));
+        append_string(&builder, string_view("\n"));
+    }
+    append_string(&builder, string_view("last line without a newline"));
+
+    CREATE_TEST_COMPILATION_CONTEXT_FOR_CODE(string_builder_to_string(&builder));
+
+    const String_View code = context.source_file.code;
+
+    Index expected_line = 0;
+    Index expected_column = 0;
+    Size expected_line_starts_count = 0;
+
+    for (Index offset = 0;
+         offset <= code.length;
+         ++offset)
+    {
+        const Source_Location location = { .offset_in_bytes = (u32)offset, .length_in_bytes = 0 };
+        const Line_And_Column line_and_column = resolve_source_location(&context.source_file, location);
+
+        ASSERT_EQUAL(line_and_column.line, expected_line);
+        ASSERT_EQUAL(line_and_column.column, expected_column);
+
+        if (offset < code.length && code.data[offset] == '\n')
+        {
+            ASSERT_EQUAL(context.source_file.line_start_offsets[expected_line_starts_count], offset + 1);
+            expected_line_starts_count += 1;
+
+            expected_line += 1;
+            expected_column = 0;
+        }
+        else
+        {
+            expected_column += 1;
+        }
+    }
+
+    ASSERT_EQUAL(context.source_file.line_start_offsets_count, expected_line_starts_count);
+
+    destroy_compilation_context(&context);
+}
+
 REGISTER_TESTS(
     test_line_comments,
     test_numbers,
     test_identifiers,
     test_keywords_and_digraphs,
-    test_errors
+    test_keywords_are_told_apart_from_similar_identifiers,
+    test_errors,
+    test_identifiers_are_interned,
+    test_lexing_modes_agree,
+    test_lexer_chunks_start_after_newlines_outside_of_strings_and_comments,
+    test_source_locations_are_resolved_by_line_starts
 )
 
 #include "eon_ast.c"
@@ -13,8 +13,8 @@ create_new_lexical_scope_with_parent(Compilation_Context* context, const Index p
     Lexical_Scope* created_scope = &context->lexical_scopes[context->lexical_scopes_count - 1];
     created_scope->symbol_ids_arena = acquire_arena_from_provider(context->arena_provider,
                                                                   string_view("lexical-scope-symbol-ids"),
-                                                                  GiB(1),
-                                                                  MiB(1));
+                                                                  KiB(64),
+                                                                  KiB(4));
     created_scope->parent_lexical_scope_id = parent_scope_index;
     return context->lexical_scopes_count - 1;
 }
@@ -32,45 +32,82 @@ add_symbol_id_to_lexical_scope(Compilation_Context* context,
 
     Symbol* symbol_to_add = get_symbol_by_id(context, symbol_id_to_add);
 
-    for (Index symbol_id_index = 0;
-         symbol_id_index < lexical_scope->symbol_ids_count;
-         ++symbol_id_index)
+    const Symbol_Id existing_symbol_id = find_symbol_id_in_lexical_scope(context,
+                                                                         lexical_scope_index,
+                                                                         symbol_to_add->name_id);
+    if (existing_symbol_id != UNDEFINED_SYMBOL_ID)
     {
-        const Symbol_Id existing_symbol_id = lexical_scope->symbol_ids[symbol_id_index];
         const Symbol* existing_symbol = &context->symbols[existing_symbol_id];
 
-        if (strings_are_equal(existing_symbol->name, symbol_to_add->name))
-        {
-            const String error_message_text = format_string(context->diagnostic_message_texts_arena,
-                                                            "Redefinition of '{}'",
-                                                            symbol_to_add->name);
+        const String error_message_text = format_string(context->diagnostic_message_texts_arena,
+                                                        "Redefinition of '{}'",
+                                                        symbol_to_add->name);
 
-            Diagnostic_Message error = {0};
-            error.level = MESSAGE_LEVEL_ERROR;
-            error.location = symbol_to_add->location;
-            error.text = string_view(error_message_text);
+        Diagnostic_Message error = {0};
+        error.level = MESSAGE_LEVEL_ERROR;
+        error.location = symbol_to_add->location;
+        error.text = string_view(error_message_text);
 
-            emit_diagnostic_message(context, &error);
+        emit_diagnostic_message(context, &error);
 
-            Diagnostic_Message note = {0};
-            note.level = MESSAGE_LEVEL_NOTE;
-            note.location = existing_symbol->location;
-            note.text = string_view("Previously defined here");
+        Diagnostic_Message note = {0};
+        note.level = MESSAGE_LEVEL_NOTE;
+        note.location = existing_symbol->location;
+        note.text = string_view("Previously defined here");
 
-            emit_diagnostic_message(context, &note);
+        emit_diagnostic_message(context, &note);
 
-            // TODO(vlad): Propagate this error to the callee?
-        }
+        // TODO(vlad): Propagate this error to the callee?
     }
 
     append_array(lexical_scope->symbol_ids_arena,
                  lexical_scope->symbol_ids,
                  Symbol_Id,
                  symbol_id_to_add);
+
+    if (lexical_scope->symbol_ids_by_name_id_capacity != 0)
+    {
+        if (existing_symbol_id == UNDEFINED_SYMBOL_ID)
+        {
+            hash_map_insert(lexical_scope->symbol_ids_arena,
+                            lexical_scope->symbol_ids_by_name_id,
+                            Name_Id,
+                            Symbol_Id,
+                            symbol_to_add->name_id,
+                            symbol_id_to_add,
+                            hash_name_id,
+                            name_ids_are_equal);
+        }
+    }
+    else if (lexical_scope->symbol_ids_count >= LEXICAL_SCOPE_MIN_SYMBOLS_COUNT_TO_INDEX)
+    {
+        hash_map_reserve(lexical_scope->symbol_ids_arena,
+                         lexical_scope->symbol_ids_by_name_id,
+                         Name_Id,
+                         Symbol_Id,
+                         lexical_scope->symbol_ids_count,
+                         hash_name_id);
+
+        // NOTE(vlad): Iterating backwards so that redefinitions are replaced by the first definition.
+        for (Index symbol_id_index = lexical_scope->symbol_ids_count - 1;
+             symbol_id_index >= 0;
+             --symbol_id_index)
+        {
+            const Symbol_Id symbol_id = lexical_scope->symbol_ids[symbol_id_index];
+            hash_map_insert(lexical_scope->symbol_ids_arena,
+                            lexical_scope->symbol_ids_by_name_id,
+                            Name_Id,
+                            Symbol_Id,
+                            context->symbols[symbol_id].name_id,
+                            symbol_id,
+                            hash_name_id,
+                            name_ids_are_equal);
+        }
+    }
 }
 
 internal void set_symbol_ids_for_identifiers_in_expression(Compilation_Context* context,
-                                                           Ast_Expression* expression,
+                                                           const Ast_Expression_Id expression_id,
                                                            const Lexical_Scope_Id this_lexical_scope_id);
 
 internal inline void
@@ -78,9 +115,9 @@ set_symbol_id_for_identifier(Compilation_Context* context,
                              Ast_Identifier* identifier,
                              const Lexical_Scope_Id this_lexical_scope_id)
 {
-    const Symbol_Id found_symbol_id = find_symbol_id(context,
-                                                     this_lexical_scope_id,
-                                                     identifier->token.lexeme);
+    const Symbol_Id found_symbol_id = find_symbol_id_by_name_id(context,
+                                                                this_lexical_scope_id,
+                                                                identifier->token.name_id);
 
     if (found_symbol_id == UNDEFINED_SYMBOL_ID)
     {
@@ -110,9 +147,9 @@ set_symbol_id_for_named_type(Compilation_Context* context,
 {
     ASSERT(type->kind == AST_TYPE_NAME);
 
-    const Symbol_Id found_symbol_id = find_symbol_id(context,
-                                                     this_lexical_scope_id,
-                                                     type->named_type.token.lexeme);
+    const Symbol_Id found_symbol_id = find_symbol_id_by_name_id(context,
+                                                                this_lexical_scope_id,
+                                                                type->named_type.token.name_id);
     if (found_symbol_id == UNDEFINED_SYMBOL_ID)
     {
         const String error_message_text = format_string(context->diagnostic_message_texts_arena,
@@ -145,8 +182,8 @@ set_symbol_ids_for_identifiers_in_call_expression(Compilation_Context* context,
          argument_index < call->arguments_count;
          ++argument_index)
     {
-        Ast_Expression* argument = call->arguments[argument_index];
-        set_symbol_ids_for_identifiers_in_expression(context, argument, this_lexical_scope_id);
+        const Ast_Expression_Id argument_id = get_ast_call_argument_id(&context->ast, call, argument_index);
+        set_symbol_ids_for_identifiers_in_expression(context, argument_id, this_lexical_scope_id);
     }
 }
 
@@ -192,6 +229,7 @@ set_symbol_ids_for_identifiers_in_type(Compilation_Context* context,
 
                     symbol->kind = SYMBOL_VARIABLE;
                     symbol->name = parameter->name.token.lexeme;
+                    symbol->name_id = parameter->name.token.name_id;
                     symbol->location = parameter->name.token.location;
                     symbol->binding_is_mutable = parameter->type->is_mutable;
 
@@ -217,9 +255,11 @@ set_symbol_ids_for_identifiers_in_type(Compilation_Context* context,
 
 internal void
 set_symbol_ids_for_identifiers_in_expression(Compilation_Context* context,
-                                             Ast_Expression* expression,
+                                             const Ast_Expression_Id expression_id,
                                              const Lexical_Scope_Id this_lexical_scope_id)
 {
+    Ast_Expression* expression = get_ast_expression_by_id(&context->ast, expression_id);
+
     switch (expression->kind)
     {
         case AST_EXPRESSION_UNDEFINED:
@@ -302,6 +342,7 @@ create_lexical_scopes_for_code_block(Compilation_Context* context, Ast_Code_Bloc
                     Symbol* symbol = get_symbol_by_id(context, symbol_id);
                     symbol->kind = SYMBOL_VARIABLE;
                     symbol->name = definition->name.token.lexeme;
+                    symbol->name_id = definition->name.token.name_id;
                     symbol->location = definition->name.token.location;
                     symbol->binding_is_mutable = definition->type->is_mutable;
                 }
@@ -312,7 +353,7 @@ create_lexical_scopes_for_code_block(Compilation_Context* context, Ast_Code_Bloc
                 if (definition->has_initial_value)
                 {
                     set_symbol_ids_for_identifiers_in_expression(context,
-                                                                 &definition->initial_value,
+                                                                 definition->initial_value,
                                                                  this_lexical_scope_id);
                 }
             } break;
@@ -322,10 +363,10 @@ create_lexical_scopes_for_code_block(Compilation_Context* context, Ast_Code_Bloc
                 Ast_Assignment* assignment = &statement->assignment;
 
                 set_symbol_ids_for_identifiers_in_expression(context,
-                                                             &assignment->lhs,
+                                                             assignment->lhs,
                                                              this_lexical_scope_id);
                 set_symbol_ids_for_identifiers_in_expression(context,
-                                                             &assignment->rhs,
+                                                             assignment->rhs,
                                                              this_lexical_scope_id);
             } break;
 
@@ -336,7 +377,7 @@ create_lexical_scopes_for_code_block(Compilation_Context* context, Ast_Code_Bloc
                 if (!return_statement->is_empty)
                 {
                     set_symbol_ids_for_identifiers_in_expression(context,
-                                                                 &return_statement->expression,
+                                                                 return_statement->expression,
                                                                  this_lexical_scope_id);
                 }
             } break;
@@ -345,7 +386,7 @@ create_lexical_scopes_for_code_block(Compilation_Context* context, Ast_Code_Bloc
             {
                 Ast_While_Statement* while_statement = &statement->while_statement;
 
-                set_symbol_ids_for_identifiers_in_expression(context, &while_statement->condition, this_lexical_scope_id);
+                set_symbol_ids_for_identifiers_in_expression(context, while_statement->condition, this_lexical_scope_id);
 
                 Ast_Code_Block* body = &while_statement->body;
                 const Lexical_Scope_Id new_scope_id = create_new_lexical_scope_with_parent(context, this_lexical_scope_id);
@@ -358,7 +399,7 @@ create_lexical_scopes_for_code_block(Compilation_Context* context, Ast_Code_Bloc
             {
                 Ast_If_Statement* if_statement = &statement->if_statement;
 
-                set_symbol_ids_for_identifiers_in_expression(context, &if_statement->condition, this_lexical_scope_id);
+                set_symbol_ids_for_identifiers_in_expression(context, if_statement->condition, this_lexical_scope_id);
 
                 Ast_Code_Block* then_code_block = &if_statement->if_statements;
                 const Lexical_Scope_Id then_scope_id = create_new_lexical_scope_with_parent(context, this_lexical_scope_id);
@@ -376,9 +417,9 @@ create_lexical_scopes_for_code_block(Compilation_Context* context, Ast_Code_Bloc
             case AST_STATEMENT_CALL:
             {
                 Ast_Call_Statement* call_statement = &statement->call_statement;
-                set_symbol_ids_for_identifiers_in_call_expression(context,
-                                                                  &call_statement->call_expression.call,
-                                                                  this_lexical_scope_id);
+                set_symbol_ids_for_identifiers_in_expression(context,
+                                                             call_statement->call_expression,
+                                                             this_lexical_scope_id);
             } break;
 
             case AST_STATEMENT_BREAK:
@@ -399,6 +440,7 @@ add_builtin_type_symbol(Compilation_Context* context, const C_String name)
         Symbol* symbol = get_symbol_by_id(context, symbol_id);
         symbol->kind = SYMBOL_TYPE;
         symbol->name = string_view(name);
+        symbol->name_id = intern_string(context, symbol->name);
         symbol->binding_is_mutable = false;
         symbol->is_builtin = true;
     }
@@ -416,6 +458,7 @@ add_builtin_variable_symbol(Compilation_Context* context, const C_String name)
         Symbol* symbol = get_symbol_by_id(context, symbol_id);
         symbol->kind = SYMBOL_VARIABLE;
         symbol->name = string_view(name);
+        symbol->name_id = intern_string(context, symbol->name);
         symbol->binding_is_mutable = false;
         symbol->is_builtin = true;
     }
@@ -449,6 +492,7 @@ create_lexical_scopes(Compilation_Context* context)
                 Symbol* symbol = get_symbol_by_id(context, symbol_id);
                 symbol->kind = SYMBOL_WILDCARD;
                 symbol->name = string_view("_");
+                symbol->name_id = intern_string(context, symbol->name);
                 symbol->binding_is_mutable = false;
                 symbol->is_builtin = true;
             }
@@ -506,6 +550,7 @@ create_lexical_scopes(Compilation_Context* context)
                     Symbol* symbol = get_symbol_by_id(context, symbol_id);
                     symbol->kind = SYMBOL_FUNCTION;
                     symbol->name = function_definition->name.token.lexeme;
+                    symbol->name_id = function_definition->name.token.name_id;
                     symbol->location = function_definition->name.token.location;
                     symbol->binding_is_mutable = function_definition->type->is_mutable;
                 }
@@ -522,7 +567,11 @@ create_lexical_scopes(Compilation_Context* context)
         Ast_Function_Definition* function_definition = &context->ast.function_definitions[function_definition_index];
         Ast_Code_Block* function_body = &function_definition->body;
 
-        const Lexical_Scope_Id function_scope_id = create_new_lexical_scope_with_parent(context, global_scope_id);
+        // NOTE(vlad): A reused body has no scope, its signature only refers to global types. Its
+        //             parameters still get symbols, the type checker binds their types.
+        const Lexical_Scope_Id function_scope_id = function_definition->body_is_reused
+                                                       ? global_scope_id
+                                                       : create_new_lexical_scope_with_parent(context, global_scope_id);
         function_body->lexical_scope_id = function_scope_id;
 
         ASSERT(function_definition->type->kind == AST_TYPE_FUNCTION);
@@ -546,13 +595,20 @@ create_lexical_scopes(Compilation_Context* context)
                 Symbol* symbol = get_symbol_by_id(context, symbol_id);
                 symbol->kind = SYMBOL_VARIABLE;
                 symbol->name = parameter->name.token.lexeme;
+                symbol->name_id = parameter->name.token.name_id;
                 symbol->location = parameter->name.token.location;
                 symbol->binding_is_mutable = parameter->type->is_mutable;
             }
 
-            add_symbol_id_to_lexical_scope(context, function_scope_id, symbol_id);
+            if (!function_definition->body_is_reused)
+            {
+                add_symbol_id_to_lexical_scope(context, function_scope_id, symbol_id);
+            }
         }
 
-        create_lexical_scopes_for_code_block(context, function_body);
+        if (!function_definition->body_is_reused)
+        {
+            create_lexical_scopes_for_code_block(context, function_body);
+        }
     }
 }
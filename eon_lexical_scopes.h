@@ -24,6 +24,7 @@ struct Symbol
     Symbol_Kind kind;
 
     String_View name;
+    Name_Id name_id;
     Source_Location location;
 
     Type_Id type_id;
@@ -34,6 +35,10 @@ struct Symbol
 };
 typedef struct Symbol Symbol;
 
+// NOTE(vlad): Scanning a handful of symbols is faster than hashing the name,
+//             so scopes are indexed by name only when they grow bigger than that.
+#define LEXICAL_SCOPE_MIN_SYMBOLS_COUNT_TO_INDEX 8
+
 struct Lexical_Scope
 {
     Arena* symbol_ids_arena;
@@ -42,7 +47,11 @@ struct Lexical_Scope
 
     Type_Id required_return_type_index;
 
-    array(Symbol_Id, symbol_ids);
+    array(Symbol_Id, symbol_ids); // NOTE(vlad): In the order of definition.
+
+    // NOTE(vlad): Maps names to the first symbol with that name, see
+    //             'LEXICAL_SCOPE_MIN_SYMBOLS_COUNT_TO_INDEX'.
+    hash_map(Name_Id, Symbol_Id, symbol_ids_by_name_id);
 };
 typedef struct Lexical_Scope Lexical_Scope;
 
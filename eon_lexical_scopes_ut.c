@@ -1414,7 +1414,7 @@ test_that_every_identifier_has_symbol_id_in_expressions(Test_Context* test_conte
 
             ASSERT_TRUE(variable_definition->has_initial_value);
 
-            const Ast_Expression* initial_value = &variable_definition->initial_value;
+            const Ast_Expression* initial_value = AST_EXPRESSION(variable_definition->initial_value);
             ASSERT_ENUM_VALUES_ARE_EQUAL(initial_value->kind, AST_EXPRESSION_IDENTIFIER);
 
             const Ast_Identifier* identifier = &initial_value->identifier;
@@ -1584,20 +1584,20 @@ test_that_every_identifier_has_symbol_id_in_expressions(Test_Context* test_conte
 
             ASSERT_TRUE(variable_definition->has_initial_value);
 
-            const Ast_Expression* initial_value = &variable_definition->initial_value;
+            const Ast_Expression* initial_value = AST_EXPRESSION(variable_definition->initial_value);
             ASSERT_ENUM_VALUES_ARE_EQUAL(initial_value->kind, AST_EXPRESSION_ADD);
 
             const Ast_Binary_Expression* add_expression = &initial_value->binary_expression;
-            ASSERT_ENUM_VALUES_ARE_EQUAL(add_expression->lhs->kind, AST_EXPRESSION_IDENTIFIER);
-            ASSERT_EQUAL(add_expression->lhs->identifier.symbol_id, a_symbol_id);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(add_expression->lhs)->kind, AST_EXPRESSION_IDENTIFIER);
+            ASSERT_EQUAL(AST_EXPRESSION(add_expression->lhs)->identifier.symbol_id, a_symbol_id);
 
-            ASSERT_ENUM_VALUES_ARE_EQUAL(add_expression->rhs->kind, AST_EXPRESSION_MULTIPLY);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(add_expression->rhs)->kind, AST_EXPRESSION_MULTIPLY);
 
-            const Ast_Binary_Expression* multiply_expression = &add_expression->rhs->binary_expression;
-            ASSERT_ENUM_VALUES_ARE_EQUAL(multiply_expression->lhs->kind, AST_EXPRESSION_IDENTIFIER);
-            ASSERT_EQUAL(multiply_expression->lhs->identifier.symbol_id, b_symbol_id);
+            const Ast_Binary_Expression* multiply_expression = &AST_EXPRESSION(add_expression->rhs)->binary_expression;
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(multiply_expression->lhs)->kind, AST_EXPRESSION_IDENTIFIER);
+            ASSERT_EQUAL(AST_EXPRESSION(multiply_expression->lhs)->identifier.symbol_id, b_symbol_id);
 
-            ASSERT_ENUM_VALUES_ARE_EQUAL(multiply_expression->rhs->kind, AST_EXPRESSION_NUMBER);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(multiply_expression->rhs)->kind, AST_EXPRESSION_NUMBER);
         }
 
         destroy_parser(&parser);
@@ -1707,17 +1707,17 @@ test_that_every_identifier_has_symbol_id_in_expressions(Test_Context* test_conte
 
             ASSERT_TRUE(variable_definition->has_initial_value);
 
-            const Ast_Expression* initial_value = &variable_definition->initial_value;
+            const Ast_Expression* initial_value = AST_EXPRESSION(variable_definition->initial_value);
             ASSERT_ENUM_VALUES_ARE_EQUAL(initial_value->kind, AST_EXPRESSION_ADD);
 
             const Ast_Binary_Expression* add_expression = &initial_value->binary_expression;
-            ASSERT_ENUM_VALUES_ARE_EQUAL(add_expression->lhs->kind, AST_EXPRESSION_CALL);
-            ASSERT_ENUM_VALUES_ARE_EQUAL(add_expression->lhs->call.called_expression->kind, AST_EXPRESSION_IDENTIFIER);
-            ASSERT_EQUAL(add_expression->lhs->call.called_expression->identifier.symbol_id, foo_symbol_id);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(add_expression->lhs)->kind, AST_EXPRESSION_CALL);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(AST_EXPRESSION(add_expression->lhs)->call.called_expression)->kind, AST_EXPRESSION_IDENTIFIER);
+            ASSERT_EQUAL(AST_EXPRESSION(AST_EXPRESSION(add_expression->lhs)->call.called_expression)->identifier.symbol_id, foo_symbol_id);
 
-            ASSERT_ENUM_VALUES_ARE_EQUAL(add_expression->rhs->kind, AST_EXPRESSION_CALL);
-            ASSERT_ENUM_VALUES_ARE_EQUAL(add_expression->rhs->call.called_expression->kind, AST_EXPRESSION_IDENTIFIER);
-            ASSERT_EQUAL(add_expression->rhs->call.called_expression->identifier.symbol_id, bar_symbol_id);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(add_expression->rhs)->kind, AST_EXPRESSION_CALL);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(AST_EXPRESSION(add_expression->rhs)->call.called_expression)->kind, AST_EXPRESSION_IDENTIFIER);
+            ASSERT_EQUAL(AST_EXPRESSION(AST_EXPRESSION(add_expression->rhs)->call.called_expression)->identifier.symbol_id, bar_symbol_id);
         }
 
         destroy_parser(&parser);
@@ -1828,17 +1828,17 @@ test_that_every_identifier_has_symbol_id_in_expressions(Test_Context* test_conte
 
             ASSERT_TRUE(variable_definition->has_initial_value);
 
-            const Ast_Expression* initial_value = &variable_definition->initial_value;
+            const Ast_Expression* initial_value = AST_EXPRESSION(variable_definition->initial_value);
             ASSERT_ENUM_VALUES_ARE_EQUAL(initial_value->kind, AST_EXPRESSION_ADD);
 
             const Ast_Binary_Expression* add_expression = &initial_value->binary_expression;
-            ASSERT_ENUM_VALUES_ARE_EQUAL(add_expression->lhs->kind, AST_EXPRESSION_CALL);
-            ASSERT_ENUM_VALUES_ARE_EQUAL(add_expression->lhs->call.called_expression->kind, AST_EXPRESSION_IDENTIFIER);
-            ASSERT_EQUAL(add_expression->lhs->call.called_expression->identifier.symbol_id, foo_symbol_id);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(add_expression->lhs)->kind, AST_EXPRESSION_CALL);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(AST_EXPRESSION(add_expression->lhs)->call.called_expression)->kind, AST_EXPRESSION_IDENTIFIER);
+            ASSERT_EQUAL(AST_EXPRESSION(AST_EXPRESSION(add_expression->lhs)->call.called_expression)->identifier.symbol_id, foo_symbol_id);
 
-            ASSERT_ENUM_VALUES_ARE_EQUAL(add_expression->rhs->kind, AST_EXPRESSION_CALL);
-            ASSERT_ENUM_VALUES_ARE_EQUAL(add_expression->rhs->call.called_expression->kind, AST_EXPRESSION_IDENTIFIER);
-            ASSERT_EQUAL(add_expression->rhs->call.called_expression->identifier.symbol_id, bar_symbol_id);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(add_expression->rhs)->kind, AST_EXPRESSION_CALL);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(AST_EXPRESSION(add_expression->rhs)->call.called_expression)->kind, AST_EXPRESSION_IDENTIFIER);
+            ASSERT_EQUAL(AST_EXPRESSION(AST_EXPRESSION(add_expression->rhs)->call.called_expression)->identifier.symbol_id, bar_symbol_id);
         }
 
         destroy_parser(&parser);
@@ -2094,6 +2094,105 @@ test_redefinitions(Test_Context* test_context)
     }
 }
 
+internal void
+test_scopes_with_many_symbols(Test_Context* test_context)
+{
+    enum { FUNCTIONS_COUNT = 50000 };
+
+    String_Builder builder = {0};
+    create_string_builder(&builder, test_context->arena);
+
+    for (Index function_index = 0;
+         function_index < FUNCTIONS_COUNT;
+         ++function_index)
+    {
+        append_string(&builder, string_view(format_string(test_context->arena,
+                                                          "function_{}: () -> s32 = {}\n",
+                                                          function_index,
+                                                          string_view("{}"))));
+    }
+
+    append_string(&builder, string_view("caller: () -> void = {\n"
+                                        "    first := function_0();\n"
+                                        "    last := function_49999();\n"
+                                        "}\n"
+                                        "function_12345: () -> s32 = {}\n"));
+
+    CREATE_TEST_COMPILATION_CONTEXT_FOR_CODE(string_builder_to_string(&builder));
+
+    Lexer lexer = {0};
+    Parser parser = {0};
+
+    create_lexer(&lexer, &context);
+    create_parser(&parser, &lexer, &context);
+
+    ASSERT_TRUE(parse_ast(&parser));
+    ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
+
+    validate_ast(&context);
+    ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
+
+    ASSERT_EQUAL(context.ast.function_definitions_count, FUNCTIONS_COUNT + 2);
+
+    create_lexical_scopes(&context);
+
+    // NOTE(vlad): The redefinition is reported once and points to the first definition.
+    ASSERT_EQUAL(context.diagnostic_messages_count, 2);
+    ASSERT_ENUM_VALUES_ARE_EQUAL(context.diagnostic_messages[0].level, MESSAGE_LEVEL_ERROR);
+    ASSERT_STRINGS_ARE_EQUAL(context.diagnostic_messages[0].text, "Redefinition of 'function_12345'");
+    ASSERT_ENUM_VALUES_ARE_EQUAL(context.diagnostic_messages[1].level, MESSAGE_LEVEL_NOTE);
+
+    const Lexical_Scope* global_scope = &context.lexical_scopes[GLOBAL_LEXICAL_SCOPE_ID];
+    ASSERT_TRUE(global_scope->symbol_ids_by_name_id_capacity != 0);
+    ASSERT_EQUAL(global_scope->symbol_ids_by_name_id_count + 1, global_scope->symbol_ids_count);
+
+    for (Index function_index = 0;
+         function_index < context.ast.function_definitions_count - 1;
+         ++function_index)
+    {
+        const Ast_Function_Definition* function_definition = &context.ast.function_definitions[function_index];
+
+        const Symbol_Id symbol_id = find_symbol_id(&context,
+                                                   function_definition->body.lexical_scope_id,
+                                                   function_definition->name.token.lexeme);
+        ASSERT_EQUAL(symbol_id, function_definition->name.symbol_id);
+    }
+
+    {
+        const Ast_Function_Definition* redefinition = &context.ast.function_definitions[FUNCTIONS_COUNT + 1];
+        const Ast_Function_Definition* first_definition = &context.ast.function_definitions[12345];
+
+        const Symbol_Id symbol_id = find_symbol_id(&context,
+                                                   GLOBAL_LEXICAL_SCOPE_ID,
+                                                   redefinition->name.token.lexeme);
+        ASSERT_EQUAL(symbol_id, first_definition->name.symbol_id);
+    }
+
+    {
+        const Ast_Function_Definition* caller = &context.ast.function_definitions[FUNCTIONS_COUNT];
+        ASSERT_EQUAL(caller->body.statements_count, 2);
+
+        const Symbol_Id first_symbol_id = find_symbol_id(&context,
+                                                         caller->body.lexical_scope_id,
+                                                         string_view("function_0"));
+        ASSERT_EQUAL(first_symbol_id, context.ast.function_definitions[0].name.symbol_id);
+
+        const Symbol_Id last_symbol_id = find_symbol_id(&context,
+                                                        caller->body.lexical_scope_id,
+                                                        string_view("function_49999"));
+        ASSERT_EQUAL(last_symbol_id, context.ast.function_definitions[FUNCTIONS_COUNT - 1].name.symbol_id);
+
+        const Symbol_Id missing_symbol_id = find_symbol_id(&context,
+                                                           caller->body.lexical_scope_id,
+                                                           string_view("function_50000"));
+        ASSERT_EQUAL(missing_symbol_id, UNDEFINED_SYMBOL_ID);
+    }
+
+    destroy_parser(&parser);
+    destroy_lexer(&lexer);
+    destroy_compilation_context(&context);
+}
+
 REGISTER_TESTS(
     test_function_scopes,
     test_function_pointers,
@@ -2101,7 +2200,8 @@ REGISTER_TESTS(
     test_while_loops_scopes,
     test_that_every_identifier_has_symbol_id_in_expressions,
     test_uses_of_undeclared_identifiers,
-    test_redefinitions
+    test_redefinitions,
+    test_scopes_with_many_symbols
 )
 
 #include "eon_ast.c"
@@ -2,6 +2,8 @@
 
 #include <eon/io.h>
 
+#include <eon/platform/threads.h>
+
 // FIXME(vlad): Report syntax errors here.
 
 // TODO(vlad): Move to 'eon_lexer.h'?
@@ -75,11 +77,13 @@ parser_fetch_token(Parser* parser)
         return true;
     }
 
-    if (!get_next_token(parser->lexer, &parser->current_token))
+    // NOTE(vlad): The lexer stopped at an error before this token.
+    if (parser->current_token_index >= parser->tokens.types_count)
     {
         return false;
     }
 
+    parser->current_token = get_buffered_token(&parser->tokens, parser->lexer->code, parser->current_token_index);
     return true;
 }
 
@@ -92,11 +96,13 @@ parser_fetch_lookahead_token(Parser* parser)
         return true;
     }
 
-    if (!get_next_token(parser->lexer, &parser->lookahead_token))
+    const Index lookahead_token_index = parser->current_token_index + 1;
+    if (lookahead_token_index >= parser->tokens.types_count)
     {
         return false;
     }
 
+    parser->lookahead_token = get_buffered_token(&parser->tokens, parser->lexer->code, lookahead_token_index);
     return true;
 }
 
@@ -105,6 +111,7 @@ internal inline void
 parser_consume_token(Parser* parser)
 {
     parser->previous_token_location = parser->current_token.location;
+    parser->current_token_index += 1;
     parser->current_token = parser->lookahead_token;
     parser->lookahead_token = (Token){0};
 }
@@ -170,7 +177,32 @@ create_parser(Parser* parser, Lexer* lexer, Compilation_Context* context)
     parser->context = context;
 
     parser->lexer = lexer;
+    parser->tokens = (Token_Buffer){0};
+    parser->current_token_index = 0;
     parser->current_token = (Token){0};
+    parser->lookahead_token = (Token){0};
+
+    parser->pending_call_arguments = NULL;
+    parser->pending_call_arguments_count = 0;
+    parser->pending_call_arguments_capacity = 0;
+
+    parser->defers_printing_failures = false;
+    parser->deferred_failures = NULL;
+    parser->deferred_failures_count = 0;
+    parser->deferred_failures_capacity = 0;
+}
+
+internal void
+print_parsing_failure(Parser* parser, const String_View failure)
+{
+    if (parser->defers_printing_failures)
+    {
+        append_array(parser->context->scratch_arena, parser->deferred_failures, String_View, failure);
+    }
+    else
+    {
+        println("{}", failure);
+    }
 }
 
 internal Bool
@@ -245,7 +277,7 @@ parse_type(Parser* parser, Ast_Type* type)
         default:
         {
             // TODO(vlad): Ensure that token has one of these types and report an error if it does not.
-            println("Failed to parse type");
+            print_parsing_failure(parser, string_view("Failed to parse type"));
             return false;
         };
     }
@@ -376,34 +408,66 @@ parse_pointer_type(Parser* parser, Ast_Type* type)
     return true;
 }
 
+internal Ast_Expression_Id
+create_ast_expression(Parser* parser)
+{
+    Ast* ast = &parser->context->ast;
+    append_array(parser->context->ast_expressions_arena, ast->expressions, Ast_Expression, (Ast_Expression){0});
+
+    const Ast_Expression_Id expression_id = (Ast_Expression_Id)(ast->expressions_count - 1);
+    return expression_id;
+}
+
+// NOTE(vlad): Creating expressions moves 'Ast.expressions', so the pointer must not be kept
+//             across parsing of other expressions.
+internal inline Ast_Expression*
+get_parsed_expression(Parser* parser, const Ast_Expression_Id expression_id)
+{
+    return get_ast_expression_by_id(&parser->context->ast, expression_id);
+}
+
+// NOTE(vlad): Moves the parsed expression into a new node, so that the old id can be reused for
+//             the expression that wraps it.
+internal Ast_Expression_Id
+move_ast_expression_to_new_node(Parser* parser, const Ast_Expression_Id expression_id)
+{
+    const Ast_Expression_Id new_expression_id = create_ast_expression(parser);
+    *get_parsed_expression(parser, new_expression_id) = *get_parsed_expression(parser, expression_id);
+    return new_expression_id;
+}
+
 internal void
-start_expression(Parser* parser, Ast_Expression* expression)
+start_expression(Parser* parser, const Ast_Expression_Id expression_id)
 {
     const Source_Location start_location = parser->current_token.location;
-    expression->location = start_location;
+    get_parsed_expression(parser, expression_id)->location = start_location;
 }
 
 internal void
-end_expression(Parser* parser, Ast_Expression* expression)
+end_expression(Parser* parser, const Ast_Expression_Id expression_id)
 {
     const Source_Location end_location = parser->previous_token_location;
-    extend_location(&expression->location, &end_location);
+    extend_location(&get_parsed_expression(parser, expression_id)->location, &end_location);
 }
 
-internal Bool parse_expression(Parser* parser, Ast_Expression* expression);
+internal Bool parse_expression(Parser* parser, const Ast_Expression_Id expression_id);
 
+// NOTE(vlad): Arguments of nested calls are parsed before the outer call ends, so they are
+//             collected on a stack and copied to 'Ast.call_arguments' once the call is parsed.
 internal Bool
-parse_arguments(Parser* parser, Ast_Call* call)
+parse_arguments(Parser* parser, const Ast_Expression_Id call_expression_id)
 {
+    const Index first_pending_argument_index = parser->pending_call_arguments_count;
+
     while (true)
     {
-        Ast_Expression* argument = allocate(parser->context->ast_arena, Ast_Expression);
-        if (!parse_expression(parser, argument))
+        const Ast_Expression_Id argument_id = create_ast_expression(parser);
+        if (!parse_expression(parser, argument_id))
         {
             return false;
         }
 
-        append_array(parser->context->ast_arena, call->arguments, Ast_Expression*, argument);
+        append_array(parser->context->scratch_arena, parser->pending_call_arguments, Ast_Expression_Id, argument_id);
 
         if (!parser_fetch_token(parser))
         {
@@ -412,21 +476,38 @@ parse_arguments(Parser* parser, Ast_Call* call)
 
         if (parser->current_token.type != TOKEN_COMMA)
         {
-            return true;
+            break;
         }
 
         parser_consume_token(parser);
     }
+
+    Ast* ast = &parser->context->ast;
+
+    Ast_Call* call = &get_parsed_expression(parser, call_expression_id)->call;
+    call->first_argument_index = (u32)ast->call_arguments_count;
+    call->arguments_count = (u32)(parser->pending_call_arguments_count - first_pending_argument_index);
+
+    append_array_elements(parser->context->ast_arena,
+                          ast->call_arguments,
+                          Ast_Expression_Id,
+                          &parser->pending_call_arguments[first_pending_argument_index],
+                          call->arguments_count);
+
+    parser->pending_call_arguments_count = first_pending_argument_index;
+    return true;
 }
 
 internal Bool
-parse_primary_expression(Parser* parser, Ast_Expression* expression)
+parse_primary_expression(Parser* parser, const Ast_Expression_Id expression_id)
 {
     if (!parser_fetch_token(parser))
     {
         return false;
     }
 
+    Ast_Expression* expression = get_parsed_expression(parser, expression_id);
+
     switch (parser->current_token.type)
     {
         case TOKEN_NUMBER:
@@ -454,9 +535,7 @@ parse_primary_expression(Parser* parser, Ast_Expression* expression)
         case TOKEN_STRING:
         {
             expression->kind = AST_EXPRESSION_STRING_LITERAL;
-            expression->string_literal.token = parser->current_token;
-
-            expression->string_literal.value = expression->string_literal.token.lexeme;
+            expression->string_literal.value = parser->current_token.lexeme;
             expression->string_literal.value.data += 1;
             expression->string_literal.value.length -= 2;
 
@@ -479,11 +558,11 @@ parse_primary_expression(Parser* parser, Ast_Expression* expression)
             parser_consume_token(parser);
 
             const Source_Location location_with_parens = expression->location;
-            if (!parse_expression(parser, expression))
+            if (!parse_expression(parser, expression_id))
             {
                 return false;
             }
-            expression->location = location_with_parens;
+            get_parsed_expression(parser, expression_id)->location = location_with_parens;
 
             if (!parser_fetch_and_consume_token_with_type(parser, TOKEN_RIGHT_PAREN))
             {
@@ -496,16 +575,18 @@ parse_primary_expression(Parser* parser, Ast_Expression* expression)
         default:
         {
             // TODO(vlad): Ensure that token has one of these types and report an error if it does not.
-            println("Failed to parse primary expression");
+            print_parsing_failure(parser, string_view("Failed to parse primary expression"));
             return false;
         } break;
     }
 }
 
+// NOTE(vlad): Calls and postfix operators. The called expression must be a primary one,
+//             thus there is at most one call and it comes before postfix operators.
 internal Bool
-parse_call_expression(Parser* parser, Ast_Expression* expression)
+parse_postfix_unary_expression(Parser* parser, const Ast_Expression_Id expression_id)
 {
-    if (!parse_primary_expression(parser, expression))
+    if (!parse_primary_expression(parser, expression_id))
     {
         return false;
     }
@@ -518,49 +599,34 @@ parse_call_expression(Parser* parser, Ast_Expression* expression)
     // TODO(vlad): Test that the primary expression is callable. Although we should
     //             probably do it after parsing (e.g. in the type system).
 
-    if (parser->current_token.type != TOKEN_LEFT_PAREN)
+    if (parser->current_token.type == TOKEN_LEFT_PAREN)
     {
-        return true;
-    }
-
-    parser_consume_token(parser);
-
-    Ast_Expression* called_expression = allocate(parser->context->ast_arena, Ast_Expression);
-    *called_expression = *expression;
-
-    expression->kind = AST_EXPRESSION_CALL;
-    expression->call = (Ast_Call){0};
+        parser_consume_token(parser);
 
-    Ast_Call* call = &expression->call;
-    call->called_expression = called_expression;
+        const Ast_Expression_Id called_expression_id = move_ast_expression_to_new_node(parser, expression_id);
 
-    if (!parser_fetch_token(parser))
-    {
-        return false;
-    }
+        Ast_Expression* expression = get_parsed_expression(parser, expression_id);
+        expression->kind = AST_EXPRESSION_CALL;
+        expression->call = (Ast_Call){0};
+        expression->call.called_expression = called_expression_id;
 
-    if (parser->current_token.type != TOKEN_RIGHT_PAREN)
-    {
-        if (!parse_arguments(parser, call))
+        if (!parser_fetch_token(parser))
         {
             return false;
         }
-    }
-
-    if (!parser_fetch_and_consume_token_with_type(parser, TOKEN_RIGHT_PAREN))
-    {
-        return false;
-    }
 
-    return true;
-}
+        if (parser->current_token.type != TOKEN_RIGHT_PAREN)
+        {
+            if (!parse_arguments(parser, expression_id))
+            {
+                return false;
+            }
+        }
 
-internal Bool
-parse_postfix_unary_expression(Parser* parser, Ast_Expression* expression)
-{
-    if (!parse_call_expression(parser, expression))
-    {
-        return false;
+        if (!parser_fetch_and_consume_token_with_type(parser, TOKEN_RIGHT_PAREN))
+        {
+            return false;
+        }
     }
 
     while (true)
@@ -600,8 +666,8 @@ parse_postfix_unary_expression(Parser* parser, Ast_Expression* expression)
         const Token operator = parser->current_token;
         parser_consume_token(parser);
 
-        Ast_Expression* operand = allocate(parser->context->ast_arena, Ast_Expression);
-        *operand = *expression;
+        const Ast_Expression_Id operand_id = move_ast_expression_to_new_node(parser, expression_id);
+        Ast_Expression* expression = get_parsed_expression(parser, expression_id);
 
         if (operator.type == TOKEN_STAR)
         {
@@ -617,12 +683,12 @@ parse_postfix_unary_expression(Parser* parser, Ast_Expression* expression)
         }
 
         expression->unary_expression.operator = operator;
-        expression->unary_expression.operand = operand;
+        expression->unary_expression.operand = operand_id;
     }
 }
 
 internal Bool
-parse_prefix_unary_expression(Parser* parser, Ast_Expression* expression)
+parse_prefix_unary_expression(Parser* parser, const Ast_Expression_Id expression_id)
 {
     if (!parser_fetch_token(parser))
     {
@@ -634,19 +700,20 @@ parse_prefix_unary_expression(Parser* parser, Ast_Expression* expression)
         const Token operator = parser->current_token;
         parser_consume_token(parser);
 
-        Ast_Expression* operand = allocate(parser->context->ast_arena, Ast_Expression);
-        if (!parse_prefix_unary_expression(parser, operand))
+        const Ast_Expression_Id operand_id = create_ast_expression(parser);
+        if (!parse_prefix_unary_expression(parser, operand_id))
         {
             return false;
         }
 
+        Ast_Expression* expression = get_parsed_expression(parser, expression_id);
         expression->kind = AST_EXPRESSION_NEGATE;
         expression->unary_expression.operator = operator;
-        expression->unary_expression.operand = operand;
+        expression->unary_expression.operand = operand_id;
         return true;
     }
 
-    if (!parse_postfix_unary_expression(parser, expression))
+    if (!parse_postfix_unary_expression(parser, expression_id))
     {
         return false;
     }
@@ -654,301 +721,103 @@ parse_prefix_unary_expression(Parser* parser, Ast_Expression* expression)
     return true;
 }
 
-internal Bool
-parse_multiplicative_expression(Parser* parser, Ast_Expression* expression)
+// NOTE(vlad): Higher precedence binds tighter. Tokens that aren't binary operators have
+//             'PRECEDENCE_NONE', which ends the expression.
+enum Binary_Operator_Precedence
 {
-    // TODO(vlad): Use 'expression' here, otherwise we would overallocate.
-    Ast_Expression* lhs = allocate(parser->context->ast_arena, Ast_Expression);
-
-    start_expression(parser, lhs);
-    if (!parse_prefix_unary_expression(parser, lhs))
-    {
-        return false;
-    }
-    end_expression(parser, lhs);
-
-    if (!parser_fetch_token(parser))
-    {
-        return false;
-    }
-
-    switch (parser->current_token.type)
-    {
-        case TOKEN_STAR:
-        {
-            const Token operator = parser->current_token;
-            parser_consume_token(parser);
-
-            Ast_Expression* rhs = allocate(parser->context->ast_arena, Ast_Expression);
-            if (!parse_multiplicative_expression(parser, rhs))
-            {
-                return false;
-            }
-
-            expression->kind = AST_EXPRESSION_MULTIPLY;
-            expression->binary_expression.operator = operator;
-            expression->binary_expression.lhs = lhs;
-            expression->binary_expression.rhs = rhs;
-            return true;
-        } break;
-
-        case TOKEN_SLASH:
-        {
-            const Token operator = parser->current_token;
-            parser_consume_token(parser);
-
-            Ast_Expression* rhs = allocate(parser->context->ast_arena, Ast_Expression);
-            if (!parse_multiplicative_expression(parser, rhs))
-            {
-                return false;
-            }
-
-            expression->kind = AST_EXPRESSION_DIVIDE;
-            expression->binary_expression.operator = operator;
-            expression->binary_expression.lhs = lhs;
-            expression->binary_expression.rhs = rhs;
-            return true;
-        } break;
-
-        default:
-        {
-            *expression = *lhs;
-            return true;
-        }
-    }
-}
-
-internal Bool
-parse_additive_expression(Parser* parser, Ast_Expression* expression)
+    PRECEDENCE_NONE = 0,
+    PRECEDENCE_COMPARISON,
+    PRECEDENCE_ADDITIVE,
+    PRECEDENCE_MULTIPLICATIVE,
+};
+typedef enum Binary_Operator_Precedence Binary_Operator_Precedence;
+
+struct Binary_Operator
 {
-    // TODO(vlad): Use 'expression' here, otherwise we would overallocate.
-    Ast_Expression* lhs = allocate(parser->context->ast_arena, Ast_Expression);
-
-    start_expression(parser, lhs);
-    if (!parse_multiplicative_expression(parser, lhs))
-    {
-        return false;
-    }
-    end_expression(parser, lhs);
-
-    if (!parser_fetch_token(parser))
-    {
-        return false;
-    }
-
-    switch (parser->current_token.type)
-    {
-        case TOKEN_PLUS:
-        {
-            const Token operator = parser->current_token;
-            parser_consume_token(parser);
-
-            Ast_Expression* rhs = allocate(parser->context->ast_arena, Ast_Expression);
-            if (!parse_additive_expression(parser, rhs))
-            {
-                return false;
-            }
-
-            expression->kind = AST_EXPRESSION_ADD;
-            expression->binary_expression.operator = operator;
-            expression->binary_expression.lhs = lhs;
-            expression->binary_expression.rhs = rhs;
-            return true;
-        } break;
-
-        case TOKEN_MINUS:
-        {
-            const Token operator = parser->current_token;
-            parser_consume_token(parser);
-
-            Ast_Expression* rhs = allocate(parser->context->ast_arena, Ast_Expression);
-            if (!parse_additive_expression(parser, rhs))
-            {
-                return false;
-            }
-
-            expression->kind = AST_EXPRESSION_SUBTRACT;
-            expression->binary_expression.operator = operator;
-            expression->binary_expression.lhs = lhs;
-            expression->binary_expression.rhs = rhs;
-            return true;
-        } break;
-
-        default:
-        {
-            *expression = *lhs;
-            return true;
-        }
-    }
-}
-
+    Ast_Expression_Kind kind;
+    Binary_Operator_Precedence precedence;
+};
+typedef struct Binary_Operator Binary_Operator;
+
+#define BINARY_OPERATOR(token_type, expression_kind, operator_precedence) \
+    [token_type] = { .kind = expression_kind, .precedence = operator_precedence }
+
+// NOTE(vlad): Adding a binary operator takes a token, an expression kind and an entry here.
+//             All of them are right-associative, as in the grammar: the right operand is
+//             parsed with the precedence of the operator itself.
+global_variable const Binary_Operator global_binary_operators[TOKEN_EOF + 1] = {
+    BINARY_OPERATOR(TOKEN_EQUAL, AST_EXPRESSION_EQUAL, PRECEDENCE_COMPARISON),
+    BINARY_OPERATOR(TOKEN_NOT_EQUAL, AST_EXPRESSION_NOT_EQUAL, PRECEDENCE_COMPARISON),
+    BINARY_OPERATOR(TOKEN_LESS, AST_EXPRESSION_LESS, PRECEDENCE_COMPARISON),
+    BINARY_OPERATOR(TOKEN_LESS_OR_EQUAL, AST_EXPRESSION_LESS_OR_EQUAL, PRECEDENCE_COMPARISON),
+    BINARY_OPERATOR(TOKEN_GREATER, AST_EXPRESSION_GREATER, PRECEDENCE_COMPARISON),
+    BINARY_OPERATOR(TOKEN_GREATER_OR_EQUAL, AST_EXPRESSION_GREATER_OR_EQUAL, PRECEDENCE_COMPARISON),
+
+    BINARY_OPERATOR(TOKEN_PLUS, AST_EXPRESSION_ADD, PRECEDENCE_ADDITIVE),
+    BINARY_OPERATOR(TOKEN_MINUS, AST_EXPRESSION_SUBTRACT, PRECEDENCE_ADDITIVE),
+
+    BINARY_OPERATOR(TOKEN_STAR, AST_EXPRESSION_MULTIPLY, PRECEDENCE_MULTIPLICATIVE),
+    BINARY_OPERATOR(TOKEN_SLASH, AST_EXPRESSION_DIVIDE, PRECEDENCE_MULTIPLICATIVE),
+};
+
+#undef BINARY_OPERATOR
+
+// NOTE(vlad): Precedence climbing: parses an operand, then keeps folding binary operators that
+//             bind at least as tight as 'min_precedence' into the expression.
 internal Bool
-parse_comparison_expression(Parser* parser, Ast_Expression* expression)
+parse_binary_expression(Parser* parser,
+                        const Ast_Expression_Id expression_id,
+                        const Binary_Operator_Precedence min_precedence)
 {
-    // TODO(vlad): Use 'expression' here, otherwise we would overallocate.
-    Ast_Expression* lhs = allocate(parser->context->ast_arena, Ast_Expression);
-
-    start_expression(parser, lhs);
-    if (!parse_additive_expression(parser, lhs))
-    {
-        return false;
-    }
-    end_expression(parser, lhs);
-
-    if (!parser_fetch_token(parser))
+    start_expression(parser, expression_id);
+    if (!parse_prefix_unary_expression(parser, expression_id))
     {
         return false;
     }
+    end_expression(parser, expression_id);
 
-    switch (parser->current_token.type)
+    while (true)
     {
-        case TOKEN_EQUAL:
-        {
-            const Token operator = parser->current_token;
-            parser_consume_token(parser);
-
-            Ast_Expression* rhs = allocate(parser->context->ast_arena, Ast_Expression);
-
-            start_expression(parser, rhs);
-            if (!parse_comparison_expression(parser, rhs))
-            {
-                return false;
-            }
-            end_expression(parser, rhs);
-
-            expression->kind = AST_EXPRESSION_EQUAL;
-            expression->binary_expression.operator = operator;
-            expression->binary_expression.lhs = lhs;
-            expression->binary_expression.rhs = rhs;
-            return true;
-        } break;
-
-        case TOKEN_NOT_EQUAL:
-        {
-            const Token operator = parser->current_token;
-            parser_consume_token(parser);
-
-            Ast_Expression* rhs = allocate(parser->context->ast_arena, Ast_Expression);
-
-            start_expression(parser, rhs);
-            if (!parse_comparison_expression(parser, rhs))
-            {
-                return false;
-            }
-            end_expression(parser, rhs);
-
-            expression->kind = AST_EXPRESSION_NOT_EQUAL;
-            expression->binary_expression.operator = operator;
-            expression->binary_expression.lhs = lhs;
-            expression->binary_expression.rhs = rhs;
-            return true;
-        } break;
-
-        case TOKEN_LESS:
-        {
-            const Token operator = parser->current_token;
-            parser_consume_token(parser);
-
-            Ast_Expression* rhs = allocate(parser->context->ast_arena, Ast_Expression);
-
-            start_expression(parser, rhs);
-            if (!parse_comparison_expression(parser, rhs))
-            {
-                return false;
-            }
-            end_expression(parser, rhs);
-
-            expression->kind = AST_EXPRESSION_LESS;
-            expression->binary_expression.operator = operator;
-            expression->binary_expression.lhs = lhs;
-            expression->binary_expression.rhs = rhs;
-            return true;
-        } break;
-
-        case TOKEN_LESS_OR_EQUAL:
+        if (!parser_fetch_token(parser))
         {
-            const Token operator = parser->current_token;
-            parser_consume_token(parser);
-
-            Ast_Expression* rhs = allocate(parser->context->ast_arena, Ast_Expression);
-
-            start_expression(parser, rhs);
-            if (!parse_comparison_expression(parser, rhs))
-            {
-                return false;
-            }
-            end_expression(parser, rhs);
-
-            expression->kind = AST_EXPRESSION_LESS_OR_EQUAL;
-            expression->binary_expression.operator = operator;
-            expression->binary_expression.lhs = lhs;
-            expression->binary_expression.rhs = rhs;
-            return true;
-        } break;
+            return false;
+        }
 
-        case TOKEN_GREATER:
+        const Binary_Operator* binary_operator = &global_binary_operators[parser->current_token.type];
+        if (binary_operator->precedence == PRECEDENCE_NONE || binary_operator->precedence < min_precedence)
         {
-            const Token operator = parser->current_token;
-            parser_consume_token(parser);
-
-            Ast_Expression* rhs = allocate(parser->context->ast_arena, Ast_Expression);
-
-            start_expression(parser, rhs);
-            if (!parse_comparison_expression(parser, rhs))
-            {
-                return false;
-            }
-            end_expression(parser, rhs);
-
-            expression->kind = AST_EXPRESSION_GREATER;
-            expression->binary_expression.operator = operator;
-            expression->binary_expression.lhs = lhs;
-            expression->binary_expression.rhs = rhs;
             return true;
-        } break;
-
-        case TOKEN_GREATER_OR_EQUAL:
-        {
-            const Token operator = parser->current_token;
-            parser_consume_token(parser);
-
-            Ast_Expression* rhs = allocate(parser->context->ast_arena, Ast_Expression);
+        }
 
-            start_expression(parser, rhs);
-            if (!parse_comparison_expression(parser, rhs))
-            {
-                return false;
-            }
-            end_expression(parser, rhs);
+        const Token operator = parser->current_token;
+        parser_consume_token(parser);
 
-            expression->kind = AST_EXPRESSION_GREATER_OR_EQUAL;
-            expression->binary_expression.operator = operator;
-            expression->binary_expression.lhs = lhs;
-            expression->binary_expression.rhs = rhs;
-            return true;
-        } break;
+        const Ast_Expression_Id lhs_id = move_ast_expression_to_new_node(parser, expression_id);
 
-        default:
+        const Ast_Expression_Id rhs_id = create_ast_expression(parser);
+        if (!parser_fetch_token(parser) || !parse_binary_expression(parser, rhs_id, binary_operator->precedence))
         {
-            *expression = *lhs;
-            return true;
+            return false;
         }
+
+        Ast_Expression* expression = get_parsed_expression(parser, expression_id);
+        expression->kind = binary_operator->kind;
+        expression->binary_expression.operator = operator;
+        expression->binary_expression.lhs = lhs_id;
+        expression->binary_expression.rhs = rhs_id;
+        end_expression(parser, expression_id);
     }
 }
 
 internal Bool
-parse_expression(Parser* parser, Ast_Expression* expression)
+parse_expression(Parser* parser, const Ast_Expression_Id expression_id)
 {
     if (!parser_fetch_token(parser))
     {
         return false;
     }
 
-    start_expression(parser, expression);
-    const Bool result = parse_comparison_expression(parser, expression);
-    end_expression(parser, expression);
-
-    return result;
+    return parse_binary_expression(parser, expression_id, PRECEDENCE_COMPARISON);
 }
 
 // FIXME(vlad): Inline this function in 'parse_code_block'.
@@ -967,7 +836,8 @@ parse_optional_variable_assignment(Parser* parser, Ast_Variable_Definition* defi
         parser_consume_token(parser);
 
         definition->has_initial_value = true;
-        if (!parse_expression(parser, &definition->initial_value))
+        definition->initial_value = create_ast_expression(parser);
+        if (!parse_expression(parser, definition->initial_value))
         {
             return false;
         }
@@ -1024,17 +894,18 @@ parse_variable_definition(Parser* parser,
 
 internal Bool
 parse_assignment(Parser* parser,
-                 Ast_Expression* expression,
+                 const Ast_Expression_Id lhs_id,
                  Ast_Assignment* assignment)
 {
-    assignment->lhs = *expression;
+    assignment->lhs = lhs_id;
 
     if (!parser_fetch_and_consume_token_with_type(parser, TOKEN_ASSIGN))
     {
         return false;
     }
 
-    if (!parse_expression(parser, &assignment->rhs))
+    assignment->rhs = create_ast_expression(parser);
+    if (!parse_expression(parser, assignment->rhs))
     {
         return false;
     }
@@ -1052,12 +923,14 @@ parse_assignment(Parser* parser,
 internal Bool
 parse_assignment_or_definition_or_call(Parser* parser, Ast_Statement* statement)
 {
-    Ast_Expression expression = {0};
-    if (!parse_expression(parser, &expression))
+    const Ast_Expression_Id expression_id = create_ast_expression(parser);
+    if (!parse_expression(parser, expression_id))
     {
         return false;
     }
 
+    const Ast_Expression* expression = get_parsed_expression(parser, expression_id);
+
     if (!parser_fetch_token(parser))
     {
         return false;
@@ -1067,37 +940,43 @@ parse_assignment_or_definition_or_call(Parser* parser, Ast_Statement* statement)
     {
         case TOKEN_COLON:
         {
-            if (expression.kind != AST_EXPRESSION_IDENTIFIER)
+            if (expression->kind != AST_EXPRESSION_IDENTIFIER)
             {
 
                 Diagnostic_Message error = {0};
                 error.level = MESSAGE_LEVEL_ERROR;
-                error.location = expression.location;
+                error.location = expression->location;
                 error.text = string_view("Expected identifier, found expression.");
                 emit_diagnostic_message(parser->context, &error);
 
                 return false;
             }
 
-            Ast_Identifier* identifier = &expression.identifier;
+            Ast_Identifier identifier = expression->identifier;
+
+            // NOTE(vlad): The name is stored in the definition itself. An identifier has no
+            //             children, so its node is the last one and can be given back.
+            Ast* ast = &parser->context->ast;
+            ASSERT(expression_id == ast->expressions_count - 1);
+            ast->expressions_count -= 1;
 
             statement->kind = AST_STATEMENT_VARIABLE_DEFINITION;
-            return parse_variable_definition(parser, identifier, &statement->variable_definition);
+            return parse_variable_definition(parser, &identifier, &statement->variable_definition);
         } break;
 
         case TOKEN_ASSIGN:
         {
             statement->kind = AST_STATEMENT_ASSIGNMENT;
-            return parse_assignment(parser, &expression, &statement->assignment);
+            return parse_assignment(parser, expression_id, &statement->assignment);
         } break;
 
         case TOKEN_SEMICOLON:
         {
-            if (expression.kind != AST_EXPRESSION_CALL)
+            if (expression->kind != AST_EXPRESSION_CALL)
             {
                 Diagnostic_Message error = {0};
                 error.level = MESSAGE_LEVEL_ERROR;
-                error.location = expression.location;
+                error.location = expression->location;
                 // TODO(vlad): Change error description to 'Expression result is unused'?
                 //             An what if this expression's type is 'void'? We won't know that until the type system
                 //             checks.
@@ -1108,7 +987,7 @@ parse_assignment_or_definition_or_call(Parser* parser, Ast_Statement* statement)
             }
 
             statement->kind = AST_STATEMENT_CALL;
-            statement->call_statement.call_expression = expression;
+            statement->call_statement.call_expression = expression_id;
 
             ASSERT(parser_fetch_and_consume_token_with_type(parser, TOKEN_SEMICOLON));
             return true;
@@ -1150,7 +1029,8 @@ parse_return_statement(Parser* parser, Ast_Statement* statement)
 
     return_statement->is_empty = false;
 
-    if (!parse_expression(parser, &return_statement->expression))
+    return_statement->expression = create_ast_expression(parser);
+    if (!parse_expression(parser, return_statement->expression))
     {
         return false;
     }
@@ -1214,7 +1094,8 @@ parse_while_statement(Parser* parser, Ast_Statement* statement)
         return false;
     }
 
-    if (!parse_expression(parser, &while_statement->condition))
+    while_statement->condition = create_ast_expression(parser);
+    if (!parse_expression(parser, while_statement->condition))
     {
         return false;
     }
@@ -1239,7 +1120,8 @@ parse_if_statement(Parser* parser, Ast_Statement* statement)
         return false;
     }
 
-    if (!parse_expression(parser, &if_statement->condition))
+    if_statement->condition = create_ast_expression(parser);
+    if (!parse_expression(parser, if_statement->condition))
     {
         return false;
     }
@@ -1384,40 +1266,460 @@ parse_statement(Parser* parser, Ast_Statement* statement)
     UNREACHABLE();
 }
 
-internal Bool
-parse_function_definition(Parser* parser, Ast_Function_Definition* function_definition)
+internal String_View
+get_source_between_tokens(const Parser* parser, const Index first_token_index, const Index last_token_index)
 {
-    if (!parse_identifier(parser, &function_definition->name))
-    {
-        return false;
-    }
+    const u32 start_offset = parser->tokens.offsets[first_token_index];
+    const u32 end_offset = parser->tokens.offsets[last_token_index] + parser->tokens.lengths[last_token_index];
 
-    if (!parser_fetch_and_consume_token_with_type(parser, TOKEN_COLON))
-    {
-        return false;
-    }
+    return (String_View){
+        .data   = parser->lexer->code.data + start_offset,
+        .length = end_offset - start_offset,
+    };
+}
 
-    function_definition->type = allocate(parser->context->ast_arena, Ast_Type);
-    if (!parse_function_type(parser, function_definition->type))
-    {
-        return false;
-    }
+// NOTE(vlad): Function definitions end at the '}' that closes the first top-level '{', the
+//             same way 'find_parser_chunk_boundaries' splits them. Stray braces end the
+//             search, the functions after them are always compiled.
+internal void
+compute_function_fingerprints(Parser* parser)
+{
+    Compilation_Context* context = parser->context;
+    const Token_Buffer* tokens = &parser->tokens;
 
-    if (!parser_fetch_and_consume_token_with_type(parser, TOKEN_ASSIGN))
-    {
-        return false;
-    }
+    Index first_token_index = parser->current_token_index;
+    Index body_start_token_index = -1;
+    s64 depth = 0;
 
-    if (!parse_code_block(parser, &function_definition->body))
+    for (Index token_index = first_token_index;
+         token_index < tokens->types_count && depth >= 0;
+         ++token_index)
     {
-        return false;
-    }
+        const Token_Type type = (Token_Type)tokens->types[token_index];
 
-    return true;
+        if (type == TOKEN_LEFT_BRACE)
+        {
+            if (depth == 0)
+            {
+                body_start_token_index = token_index;
+            }
+
+            depth += 1;
+        }
+        else if (type == TOKEN_RIGHT_BRACE)
+        {
+            depth -= 1;
+
+            if (depth == 0 && body_start_token_index > first_token_index)
+            {
+                Function_Fingerprint fingerprint = {0};
+                fingerprint.name = get_source_between_tokens(parser, first_token_index, first_token_index);
+                fingerprint.signature_hash = hash_string(get_source_between_tokens(parser, first_token_index, body_start_token_index - 1));
+                fingerprint.text = get_source_between_tokens(parser, first_token_index, token_index);
+                fingerprint.text_hash = hash_string(fingerprint.text);
+                fingerprint.first_token_index = first_token_index;
+                fingerprint.body_start_token_index = body_start_token_index;
+                fingerprint.end_token_index = token_index + 1;
+
+                append_array(context->ast_arena, context->function_fingerprints, Function_Fingerprint, fingerprint);
+
+                first_token_index = token_index + 1;
+            }
+        }
+    }
+}
+
+struct Function_Indices_By_Name
+{
+    // NOTE(vlad): The index is -1 if there are several functions with the name.
+    hash_map(String_View, Index, indices);
+};
+typedef struct Function_Indices_By_Name Function_Indices_By_Name;
+
+internal void
+add_function_indices_by_name(Arena* arena, Function_Indices_By_Name* map, const Function_Fingerprint* fingerprints, const Size fingerprints_count)
+{
+    hash_map_reserve(arena, map->indices, String_View, Index, fingerprints_count, hash_string);
+
+    for (Index i = 0;
+         i < fingerprints_count;
+         ++i)
+    {
+        Index slot_index = -1;
+        hash_map_find(map->indices, String_View, fingerprints[i].name, hash_string, strings_are_equal, slot_index);
+
+        const Index function_index = (slot_index == -1) ? i : -1;
+        hash_map_insert(arena, map->indices, String_View, Index, fingerprints[i].name, function_index, hash_string, strings_are_equal);
+    }
+}
+
+internal Index
+find_function_index_by_name(const Function_Indices_By_Name* map, const String_View name, Bool* is_found)
+{
+    Index slot_index = -1;
+    hash_map_find(map->indices, String_View, name, hash_string, strings_are_equal, slot_index);
+
+    *is_found = (slot_index != -1);
+    return *is_found ? map->indices[slot_index] : -1;
+}
+
+// NOTE(vlad): A function is reused if its text is the same and none of the names in its body
+//             is a function whose signature changed, that was added or removed, or that is
+//             defined several times. Names are matched by text, so locals that happen to have
+//             such names make the function compiled again, which is fine.
+internal void
+find_reused_function_definitions(Parser* parser)
+{
+    Compilation_Context* context = parser->context;
+    const Compilation_Context* previous_context = context->previous_context;
+
+    // NOTE(vlad): TAC of the previous functions is found by their indices, so every function
+    //             must have been lowered.
+    if (previous_context == NULL ||
+        has_compilation_errors(previous_context) ||
+        previous_context->function_fingerprints_count != previous_context->ast.function_definitions_count ||
+        previous_context->tac.functions_count != previous_context->ast.function_definitions_count)
+    {
+        return;
+    }
+
+    Arena* arena = context->scratch_arena;
+
+    Function_Indices_By_Name previous_functions = {0};
+    add_function_indices_by_name(arena, &previous_functions, previous_context->function_fingerprints, previous_context->function_fingerprints_count);
+
+    Function_Indices_By_Name functions = {0};
+    add_function_indices_by_name(arena, &functions, context->function_fingerprints, context->function_fingerprints_count);
+
+    Function_Indices_By_Name changed_functions = {0};
+
+    for (Index i = 0;
+         i < context->function_fingerprints_count;
+         ++i)
+    {
+        const Function_Fingerprint* fingerprint = &context->function_fingerprints[i];
+
+        Bool is_found = false;
+        const Index previous_index = find_function_index_by_name(&previous_functions, fingerprint->name, &is_found);
+        const Index index = find_function_index_by_name(&functions, fingerprint->name, &is_found);
+
+        if (previous_index == -1 || index == -1 ||
+            previous_context->function_fingerprints[previous_index].signature_hash != fingerprint->signature_hash)
+        {
+            hash_map_insert(arena, changed_functions.indices, String_View, Index, fingerprint->name, i, hash_string, strings_are_equal);
+        }
+    }
+
+    for (Index i = 0;
+         i < previous_context->function_fingerprints_count;
+         ++i)
+    {
+        const Function_Fingerprint* previous_fingerprint = &previous_context->function_fingerprints[i];
+
+        Bool is_found = false;
+        find_function_index_by_name(&functions, previous_fingerprint->name, &is_found);
+
+        if (!is_found)
+        {
+            hash_map_insert(arena, changed_functions.indices, String_View, Index, previous_fingerprint->name, i, hash_string, strings_are_equal);
+        }
+    }
+
+    for (Index i = 0;
+         i < context->function_fingerprints_count;
+         ++i)
+    {
+        Function_Fingerprint* fingerprint = &context->function_fingerprints[i];
+
+        Bool is_changed = false;
+        find_function_index_by_name(&changed_functions, fingerprint->name, &is_changed);
+
+        if (is_changed)
+        {
+            continue;
+        }
+
+        Bool is_found = false;
+        const Index previous_index = find_function_index_by_name(&previous_functions, fingerprint->name, &is_found);
+        const Function_Fingerprint* previous_fingerprint = &previous_context->function_fingerprints[previous_index];
+
+        // NOTE(vlad): Hashes only tell quickly that texts differ, equal hashes may still collide.
+        if (previous_fingerprint->text_hash != fingerprint->text_hash ||
+            !strings_are_equal(previous_fingerprint->text, fingerprint->text))
+        {
+            continue;
+        }
+
+        Bool refers_to_changed_function = false;
+
+        for (Index token_index = fingerprint->body_start_token_index;
+             token_index < fingerprint->end_token_index && changed_functions.indices_count > 0 && !refers_to_changed_function;
+             ++token_index)
+        {
+            if (parser->tokens.types[token_index] == TOKEN_IDENTIFIER)
+            {
+                find_function_index_by_name(&changed_functions,
+                                            get_source_between_tokens(parser, token_index, token_index),
+                                            &refers_to_changed_function);
+            }
+        }
+
+        fingerprint->is_reused = !refers_to_changed_function;
+        fingerprint->previous_function_index = previous_index;
+    }
+}
+
+internal inline u32
+get_function_fingerprint_offset(const Compilation_Context* context, const Function_Fingerprint* fingerprint)
+{
+    return (u32)(fingerprint->text.data - context->source_file.code.data);
+}
+
+// NOTE(vlad): Returns -1 if the offset is outside of all function definitions.
+internal Index
+find_function_fingerprint_index_by_offset(const Compilation_Context* context, const u32 offset)
+{
+    Index low = 0;
+    Index high = context->function_fingerprints_count;
+
+    while (low < high)
+    {
+        const Index middle = low + (high - low) / 2;
+        const Function_Fingerprint* fingerprint = &context->function_fingerprints[middle];
+
+        if (get_function_fingerprint_offset(context, fingerprint) + fingerprint->text.length <= offset)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    const Bool is_found = (low < context->function_fingerprints_count &&
+                           get_function_fingerprint_offset(context, &context->function_fingerprints[low]) <= offset);
+
+    return is_found ? low : -1;
+}
+
+// NOTE(vlad): Reused bodies are not checked again, so the messages about them are copied from
+//             the previous compilation and moved to where the functions are now.
+internal void
+copy_diagnostic_messages_of_reused_functions(Parser* parser)
+{
+    Compilation_Context* context = parser->context;
+    const Compilation_Context* previous_context = context->previous_context;
+
+    if (previous_context == NULL || previous_context->diagnostic_messages_count == 0)
+    {
+        return;
+    }
+
+    Index* reused_fingerprint_indices = allocate_uninitialized_array(context->scratch_arena,
+                                                                     previous_context->function_fingerprints_count,
+                                                                     Index);
+    for (Index previous_index = 0;
+         previous_index < previous_context->function_fingerprints_count;
+         ++previous_index)
+    {
+        reused_fingerprint_indices[previous_index] = -1;
+    }
+
+    for (Index fingerprint_index = 0;
+         fingerprint_index < context->function_fingerprints_count;
+         ++fingerprint_index)
+    {
+        const Function_Fingerprint* fingerprint = &context->function_fingerprints[fingerprint_index];
+
+        if (fingerprint->is_reused)
+        {
+            reused_fingerprint_indices[fingerprint->previous_function_index] = fingerprint_index;
+        }
+    }
+
+    for (Index message_index = 0;
+         message_index < previous_context->diagnostic_messages_count;
+         ++message_index)
+    {
+        const Diagnostic_Message* previous_message = &previous_context->diagnostic_messages[message_index];
+
+        const Index previous_index = find_function_fingerprint_index_by_offset(previous_context,
+                                                                               previous_message->location.offset_in_bytes);
+        if (previous_index == -1 || reused_fingerprint_indices[previous_index] == -1)
+        {
+            continue;
+        }
+
+        const Function_Fingerprint* previous_fingerprint = &previous_context->function_fingerprints[previous_index];
+        const Function_Fingerprint* fingerprint = &context->function_fingerprints[reused_fingerprint_indices[previous_index]];
+
+        Diagnostic_Message message = *previous_message;
+        message.location.offset_in_bytes = previous_message->location.offset_in_bytes
+                                           - get_function_fingerprint_offset(previous_context, previous_fingerprint)
+                                           + get_function_fingerprint_offset(context, fingerprint);
+        message.text = string_view(copy_string(context->diagnostic_message_texts_arena, previous_message->text));
+
+        emit_diagnostic_message(context, &message);
+    }
+}
+
+internal const Function_Fingerprint*
+find_reused_function_fingerprint(const Parser* parser, const Index first_token_index)
+{
+    const Function_Fingerprint* fingerprints = parser->context->function_fingerprints;
+
+    Index low = 0;
+    Index high = parser->context->function_fingerprints_count;
+
+    while (low < high)
+    {
+        const Index middle = low + (high - low) / 2;
+
+        if (fingerprints[middle].first_token_index < first_token_index)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    const Bool is_reused = (low < parser->context->function_fingerprints_count &&
+                            fingerprints[low].first_token_index == first_token_index &&
+                            fingerprints[low].is_reused);
+
+    return is_reused ? &fingerprints[low] : NULL;
+}
+
+internal void
+skip_reused_function_body(Parser* parser, Ast_Code_Block* body, const Function_Fingerprint* fingerprint)
+{
+    ASSERT(parser->current_token_index == fingerprint->body_start_token_index);
+
+    const Index closing_brace_index = fingerprint->end_token_index - 1;
+
+    parser->current_token_index = fingerprint->end_token_index;
+    parser->current_token = (Token){0};
+    parser->lookahead_token = (Token){0};
+    parser->previous_token_location = get_buffered_token(&parser->tokens, parser->lexer->code, closing_brace_index).location;
+
+    body->end_location = parser->previous_token_location;
 }
 
 internal Bool
-parse_ast(Parser* parser)
+parse_function_definition(Parser* parser, Ast_Function_Definition* function_definition)
+{
+    const Index first_token_index = parser->current_token_index;
+
+    if (!parse_identifier(parser, &function_definition->name))
+    {
+        return false;
+    }
+
+    if (!parser_fetch_and_consume_token_with_type(parser, TOKEN_COLON))
+    {
+        return false;
+    }
+
+    function_definition->type = allocate(parser->context->ast_arena, Ast_Type);
+    if (!parse_function_type(parser, function_definition->type))
+    {
+        return false;
+    }
+
+    if (!parser_fetch_and_consume_token_with_type(parser, TOKEN_ASSIGN))
+    {
+        return false;
+    }
+
+    const Function_Fingerprint* reused_fingerprint = find_reused_function_fingerprint(parser, first_token_index);
+    if (reused_fingerprint != NULL)
+    {
+        function_definition->body_is_reused = true;
+        function_definition->fingerprint_index = reused_fingerprint - parser->context->function_fingerprints;
+        skip_reused_function_body(parser, &function_definition->body, reused_fingerprint);
+        return true;
+    }
+
+    if (!parse_code_block(parser, &function_definition->body))
+    {
+        return false;
+    }
+
+    return true;
+}
+
+// NOTE(vlad): Every expression node is created at its own token: a primary expression at its
+//             literal or identifier, an operator at its operator and a call at its '('.
+//             Counting those gives an upper estimate of the number of nodes, so the pool is
+//             allocated once instead of doubling and copying all nodes while parsing.
+//             Reused function bodies are skipped, they are not parsed.
+internal Size
+estimate_number_of_ast_expressions(const Parser* parser, const Index first_token_index, const Index end_token_index)
+{
+    const Token_Buffer* tokens = &parser->tokens;
+    const Compilation_Context* context = parser->context;
+
+    Size number_of_expressions = 0;
+    Index fingerprint_index = 0;
+
+    for (Index i = first_token_index;
+         i < end_token_index;
+         ++i)
+    {
+        while (fingerprint_index < context->function_fingerprints_count &&
+               context->function_fingerprints[fingerprint_index].end_token_index <= i)
+        {
+            fingerprint_index += 1;
+        }
+
+        if (fingerprint_index < context->function_fingerprints_count &&
+            context->function_fingerprints[fingerprint_index].is_reused &&
+            context->function_fingerprints[fingerprint_index].body_start_token_index == i)
+        {
+            i = context->function_fingerprints[fingerprint_index].end_token_index - 1;
+            continue;
+        }
+
+        switch ((Token_Type)tokens->types[i])
+        {
+            case TOKEN_IDENTIFIER:
+            case TOKEN_NUMBER:
+            case TOKEN_STRING:
+            case TOKEN_TRUE:
+            case TOKEN_FALSE:
+            case TOKEN_LEFT_PAREN:
+            case TOKEN_MINUS:
+            case TOKEN_PLUS:
+            case TOKEN_SLASH:
+            case TOKEN_STAR:
+            case TOKEN_NOT:
+            case TOKEN_AMPERSAND:
+            case TOKEN_EQUAL:
+            case TOKEN_NOT_EQUAL:
+            case TOKEN_LESS:
+            case TOKEN_LESS_OR_EQUAL:
+            case TOKEN_GREATER:
+            case TOKEN_GREATER_OR_EQUAL:
+            {
+                number_of_expressions += 1;
+            } break;
+
+            default:
+            {
+            } break;
+        }
+    }
+
+    return number_of_expressions;
+}
+
+// NOTE(vlad): Parses function definitions until the end of file or until the next one starts
+//             at 'end_token_index' or after it.
+internal Bool
+parse_function_definitions(Parser* parser, const Index end_token_index, Bool* failed_to_parse_function_definition)
 {
     Ast* ast = &parser->context->ast;
 
@@ -1426,7 +1728,7 @@ parse_ast(Parser* parser)
         Ast_Function_Definition function_definition = {0};
         if (!parse_function_definition(parser, &function_definition))
         {
-            println("Failed to parse function definition");
+            *failed_to_parse_function_definition = true;
             return false;
         }
 
@@ -1441,11 +1743,490 @@ parse_ast(Parser* parser)
             return false;
         }
     }
-    while (parser->current_token.type != TOKEN_EOF);
+    while (parser->current_token.type != TOKEN_EOF && parser->current_token_index < end_token_index);
 
     return true;
 }
 
+// NOTE(vlad): Function definitions are 'identifier ":" function_type "=" code_block' and function
+//             types have no braces, so every function ends at the '}' that closes the first
+//             top-level '{'. A chunk starts after such a '}', the parser checks that the previous
+//             chunk really ended there.
+internal Size
+find_parser_chunk_boundaries(const Parser* parser, const Size max_chunks_count, Index* boundaries)
+{
+    ASSERT(max_chunks_count > 0);
+
+    const Token_Buffer* tokens = &parser->tokens;
+
+    const Index first_token_index = parser->current_token_index;
+    const Size tokens_count = tokens->types_count - first_token_index;
+
+    boundaries[0] = first_token_index;
+    Size chunks_count = 1;
+    Index next_chunk_target = first_token_index + tokens_count / max_chunks_count;
+
+    s64 depth = 0;
+
+    for (Index token_index = first_token_index;
+         token_index < tokens->types_count && chunks_count < max_chunks_count;
+         ++token_index)
+    {
+        const Token_Type type = (Token_Type)tokens->types[token_index];
+
+        if (type == TOKEN_LEFT_BRACE)
+        {
+            depth += 1;
+        }
+        else if (type == TOKEN_RIGHT_BRACE)
+        {
+            depth -= 1;
+
+            const Index next_token_index = token_index + 1;
+
+            if (depth == 0 &&
+                next_token_index >= next_chunk_target &&
+                next_token_index < tokens->types_count &&
+                tokens->types[next_token_index] != TOKEN_EOF)
+            {
+                boundaries[chunks_count] = next_token_index;
+                chunks_count += 1;
+
+                next_chunk_target = MAX(first_token_index + tokens_count * chunks_count / max_chunks_count,
+                                        next_token_index);
+            }
+        }
+    }
+
+    boundaries[chunks_count] = tokens->types_count;
+    return chunks_count;
+}
+
+struct Parser_Chunk
+{
+    // NOTE(vlad): A copy of the context with the arenas and the AST of this chunk, expression ids
+    //             and call argument indices are relocated when the chunk is appended to the AST.
+    Compilation_Context context;
+    Parser parser;
+
+    Index end_token_index;
+
+    Bool parsed_without_errors;
+    Bool failed_to_parse_function_definition;
+
+    Thread thread;
+    Bool thread_started;
+};
+typedef struct Parser_Chunk Parser_Chunk;
+
+internal void
+parse_chunk(void* chunk_pointer)
+{
+    Parser_Chunk* chunk = chunk_pointer;
+    Parser* parser = &chunk->parser;
+
+    ensure_array_has_enough_capacity(chunk->context.ast_expressions_arena,
+                                     chunk->context.ast.expressions,
+                                     Ast_Expression,
+                                     estimate_number_of_ast_expressions(parser,
+                                                                        parser->current_token_index,
+                                                                        chunk->end_token_index));
+
+    chunk->parsed_without_errors = parse_function_definitions(parser,
+                                                              chunk->end_token_index,
+                                                              &chunk->failed_to_parse_function_definition);
+}
+
+internal inline void
+relocate_ast_expression_id(Ast_Expression_Id* expression_id, const u32 expression_ids_shift)
+{
+    if (*expression_id != INVALID_AST_EXPRESSION_ID)
+    {
+        *expression_id += expression_ids_shift;
+    }
+}
+
+internal void
+relocate_ast_expression_ids_in_type(Ast_Type* type, const u32 expression_ids_shift)
+{
+    if (type == NULL)
+    {
+        return;
+    }
+
+    if (type->kind == AST_TYPE_POINTER)
+    {
+        relocate_ast_expression_ids_in_type(type->pointer.pointed_to, expression_ids_shift);
+    }
+    else if (type->kind == AST_TYPE_FUNCTION)
+    {
+        for (Index i = 0;
+             i < type->function.parameters_count;
+             ++i)
+        {
+            Ast_Function_Parameter* parameter = &type->function.parameters[i];
+
+            relocate_ast_expression_ids_in_type(parameter->type, expression_ids_shift);
+            relocate_ast_expression_id(&parameter->default_value, expression_ids_shift);
+        }
+
+        relocate_ast_expression_ids_in_type(type->function.return_type, expression_ids_shift);
+    }
+}
+
+internal void
+relocate_ast_expression_ids_in_code_block(Ast_Code_Block* code_block, const u32 expression_ids_shift)
+{
+    for (Index i = 0;
+         i < code_block->statements_count;
+         ++i)
+    {
+        Ast_Statement* statement = &code_block->statements[i];
+
+        switch (statement->kind)
+        {
+            case AST_STATEMENT_VARIABLE_DEFINITION:
+            {
+                relocate_ast_expression_ids_in_type(statement->variable_definition.type, expression_ids_shift);
+                relocate_ast_expression_id(&statement->variable_definition.initial_value, expression_ids_shift);
+            } break;
+
+            case AST_STATEMENT_ASSIGNMENT:
+            {
+                relocate_ast_expression_id(&statement->assignment.lhs, expression_ids_shift);
+                relocate_ast_expression_id(&statement->assignment.rhs, expression_ids_shift);
+            } break;
+
+            case AST_STATEMENT_RETURN:
+            {
+                if (!statement->return_statement.is_empty)
+                {
+                    relocate_ast_expression_id(&statement->return_statement.expression, expression_ids_shift);
+                }
+            } break;
+
+            case AST_STATEMENT_WHILE:
+            {
+                relocate_ast_expression_id(&statement->while_statement.condition, expression_ids_shift);
+                relocate_ast_expression_ids_in_code_block(&statement->while_statement.body, expression_ids_shift);
+            } break;
+
+            case AST_STATEMENT_IF:
+            {
+                relocate_ast_expression_id(&statement->if_statement.condition, expression_ids_shift);
+                relocate_ast_expression_ids_in_code_block(&statement->if_statement.if_statements, expression_ids_shift);
+                relocate_ast_expression_ids_in_code_block(&statement->if_statement.else_statements, expression_ids_shift);
+            } break;
+
+            case AST_STATEMENT_CALL:
+            {
+                relocate_ast_expression_id(&statement->call_statement.call_expression, expression_ids_shift);
+            } break;
+
+            case AST_STATEMENT_BREAK:
+            case AST_STATEMENT_CONTINUE:
+            {
+            } break;
+
+            case AST_STATEMENT_UNDEFINED:
+            {
+                UNREACHABLE();
+            } break;
+        }
+    }
+}
+
+// NOTE(vlad): Chunks are appended in source order, so the ids and indices are the same as if
+//             the whole file was parsed sequentially.
+internal void
+append_parser_chunk_ast(Compilation_Context* context, Parser_Chunk* chunk)
+{
+    Ast* ast = &context->ast;
+    Ast* chunk_ast = &chunk->context.ast;
+
+    // NOTE(vlad): Both pools start with 'INVALID_AST_EXPRESSION_ID'.
+    const u32 expression_ids_shift = (u32)(ast->expressions_count - 1);
+    const u32 call_arguments_shift = (u32)ast->call_arguments_count;
+
+    const Index first_expression_index = ast->expressions_count;
+    append_array_elements(context->ast_expressions_arena,
+                          ast->expressions,
+                          Ast_Expression,
+                          chunk_ast->expressions + 1,
+                          chunk_ast->expressions_count - 1);
+
+    const Index first_call_argument_index = ast->call_arguments_count;
+    append_array_elements(context->ast_arena,
+                          ast->call_arguments,
+                          Ast_Expression_Id,
+                          chunk_ast->call_arguments,
+                          chunk_ast->call_arguments_count);
+
+    const Bool ids_must_be_relocated = (expression_ids_shift != 0 || call_arguments_shift != 0);
+
+    for (Index i = first_expression_index;
+         ids_must_be_relocated && i < ast->expressions_count;
+         ++i)
+    {
+        Ast_Expression* expression = &ast->expressions[i];
+
+        switch (expression->kind)
+        {
+            case AST_EXPRESSION_ADD:
+            case AST_EXPRESSION_SUBTRACT:
+            case AST_EXPRESSION_MULTIPLY:
+            case AST_EXPRESSION_DIVIDE:
+            case AST_EXPRESSION_EQUAL:
+            case AST_EXPRESSION_NOT_EQUAL:
+            case AST_EXPRESSION_LESS:
+            case AST_EXPRESSION_LESS_OR_EQUAL:
+            case AST_EXPRESSION_GREATER:
+            case AST_EXPRESSION_GREATER_OR_EQUAL:
+            {
+                relocate_ast_expression_id(&expression->binary_expression.lhs, expression_ids_shift);
+                relocate_ast_expression_id(&expression->binary_expression.rhs, expression_ids_shift);
+            } break;
+
+            case AST_EXPRESSION_NEGATE:
+            case AST_EXPRESSION_DEREFERENCE:
+            case AST_EXPRESSION_ADDRESS_OF:
+            {
+                relocate_ast_expression_id(&expression->unary_expression.operand, expression_ids_shift);
+            } break;
+
+            case AST_EXPRESSION_CALL:
+            {
+                relocate_ast_expression_id(&expression->call.called_expression, expression_ids_shift);
+                expression->call.first_argument_index += call_arguments_shift;
+            } break;
+
+            default:
+            {
+            } break;
+        }
+    }
+
+    for (Index i = first_call_argument_index;
+         ids_must_be_relocated && i < ast->call_arguments_count;
+         ++i)
+    {
+        relocate_ast_expression_id(&ast->call_arguments[i], expression_ids_shift);
+    }
+
+    for (Index i = 0;
+         i < chunk_ast->function_definitions_count;
+         ++i)
+    {
+        Ast_Function_Definition* function_definition = &chunk_ast->function_definitions[i];
+
+        if (ids_must_be_relocated)
+        {
+            relocate_ast_expression_ids_in_type(function_definition->type, expression_ids_shift);
+            relocate_ast_expression_ids_in_code_block(&function_definition->body, expression_ids_shift);
+        }
+
+        append_array(context->ast_arena, ast->function_definitions, Ast_Function_Definition, *function_definition);
+    }
+
+    for (Index i = 0;
+         i < chunk->context.diagnostic_messages_count;
+         ++i)
+    {
+        emit_diagnostic_message(context, &chunk->context.diagnostic_messages[i]);
+    }
+}
+
+internal Bool
+parse_function_definitions_in_chunks(Parser* parser, const Index* boundaries, const Size chunks_count)
+{
+    ASSERT(chunks_count > 0 && boundaries[0] == parser->current_token_index);
+
+    Compilation_Context* context = parser->context;
+    Ast* ast = &context->ast;
+
+    ensure_array_has_enough_capacity(context->ast_expressions_arena,
+                                     ast->expressions,
+                                     Ast_Expression,
+                                     estimate_number_of_ast_expressions(parser,
+                                                                        boundaries[0],
+                                                                        boundaries[chunks_count]));
+
+    Bool failed_to_parse_function_definition = false;
+
+    if (chunks_count == 1)
+    {
+        const Bool parsed_without_errors = parse_function_definitions(parser,
+                                                                      boundaries[1],
+                                                                      &failed_to_parse_function_definition);
+        if (failed_to_parse_function_definition)
+        {
+            println("Failed to parse function definition");
+        }
+
+        return parsed_without_errors;
+    }
+
+    // NOTE(vlad): Arenas aren't thread-safe, so every chunk gets worker arenas of its own.
+    //             Statements, types and diagnostic texts stay in them until the context is
+    //             destroyed, the rest is copied out.
+    Parser_Chunk* chunks = allocate_array(context->scratch_arena, chunks_count, Parser_Chunk);
+    Arena** temporary_arenas = allocate_array(context->scratch_arena, chunks_count, Arena*);
+
+    for (Index chunk_index = 0;
+         chunk_index < chunks_count;
+         ++chunk_index)
+    {
+        Parser_Chunk* chunk = &chunks[chunk_index];
+
+        // NOTE(vlad): Names outlive the arenas, so they are kept next to 'worker_arenas'.
+        const String_View chunk_arena_name = string_view(format_string(context->ast_arena, "parser-chunk-{}", chunk_index));
+        const String_View temporary_arena_name = string_view(format_string(context->ast_arena, "parser-chunk-{}-expressions", chunk_index));
+        const String_View scratch_arena_name = string_view(format_string(context->ast_arena, "parser-chunk-{}-scratch", chunk_index));
+
+        Arena* chunk_arena = acquire_worker_arena_from_provider(context->arena_provider, chunk_arena_name, MiB(16), KiB(64));
+        append_array(context->ast_arena, context->worker_arenas, Arena*, chunk_arena);
+
+        temporary_arenas[chunk_index] = acquire_worker_arena_from_provider(context->arena_provider, temporary_arena_name, MiB(16), KiB(64));
+
+        chunk->context = *context;
+        chunk->context.ast = (Ast){0};
+        chunk->context.diagnostic_messages = NULL;
+        chunk->context.diagnostic_messages_count = 0;
+        chunk->context.diagnostic_messages_capacity = 0;
+
+        chunk->context.ast_arena = chunk_arena;
+        chunk->context.diagnostic_message_texts_arena = chunk_arena;
+        chunk->context.ast_expressions_arena = temporary_arenas[chunk_index];
+        chunk->context.diagnostic_messages_arena = temporary_arenas[chunk_index];
+        chunk->context.scratch_arena = acquire_worker_arena_from_provider(context->arena_provider, scratch_arena_name, MiB(16), KiB(64));
+
+        append_array(chunk->context.ast_expressions_arena, chunk->context.ast.expressions, Ast_Expression, (Ast_Expression){0});
+
+        create_parser(&chunk->parser, parser->lexer, &chunk->context);
+        chunk->parser.tokens = parser->tokens;
+        chunk->parser.current_token_index = boundaries[chunk_index];
+        chunk->parser.defers_printing_failures = true;
+
+        chunk->end_token_index = boundaries[chunk_index + 1];
+    }
+
+    // NOTE(vlad): The first chunk is parsed on the calling thread, which also takes over
+    //             the chunks whose threads failed to start.
+    for (Index chunk_index = 1;
+         chunk_index < chunks_count;
+         ++chunk_index)
+    {
+        chunks[chunk_index].thread_started = platform_start_thread(&chunks[chunk_index].thread, parse_chunk, &chunks[chunk_index]);
+    }
+
+    for (Index chunk_index = 0;
+         chunk_index < chunks_count;
+         ++chunk_index)
+    {
+        if (chunks[chunk_index].thread_started)
+        {
+            platform_join_thread(&chunks[chunk_index].thread);
+        }
+        else
+        {
+            parse_chunk(&chunks[chunk_index]);
+        }
+    }
+
+    // NOTE(vlad): The sequential parser stops at the first function it fails to parse, so are
+    //             the chunks and the chunks after the first failed one are dropped.
+    Bool parsed_without_errors = true;
+    Bool continue_sequentially = false;
+    const Parser* last_parser = NULL;
+
+    for (Index chunk_index = 0;
+         chunk_index < chunks_count;
+         ++chunk_index)
+    {
+        Parser_Chunk* chunk = &chunks[chunk_index];
+
+        append_parser_chunk_ast(context, chunk);
+        last_parser = &chunk->parser;
+
+        for (Index i = 0;
+             i < chunk->parser.deferred_failures_count;
+             ++i)
+        {
+            println("{}", chunk->parser.deferred_failures[i]);
+        }
+
+        if (!chunk->parsed_without_errors)
+        {
+            parsed_without_errors = false;
+            failed_to_parse_function_definition = chunk->failed_to_parse_function_definition;
+            break;
+        }
+
+        if (chunk->parser.current_token.type == TOKEN_EOF)
+        {
+            break;
+        }
+
+        // NOTE(vlad): A function ran past its boundary, the next chunk started in the middle of
+        //             it and its results are not what the sequential parser would get.
+        if (chunk->parser.current_token_index != chunk->end_token_index)
+        {
+            continue_sequentially = true;
+            break;
+        }
+    }
+
+    parser->current_token_index = last_parser->current_token_index;
+    parser->current_token = last_parser->current_token;
+    parser->lookahead_token = last_parser->lookahead_token;
+    parser->previous_token_location = last_parser->previous_token_location;
+
+    for (Index chunk_index = 0;
+         chunk_index < chunks_count;
+         ++chunk_index)
+    {
+        release_arena_to_provider(context->arena_provider, chunks[chunk_index].context.scratch_arena);
+        release_arena_to_provider(context->arena_provider, temporary_arenas[chunk_index]);
+    }
+
+    if (continue_sequentially)
+    {
+        parsed_without_errors = parse_function_definitions(parser,
+                                                           boundaries[chunks_count],
+                                                           &failed_to_parse_function_definition);
+    }
+
+    if (failed_to_parse_function_definition)
+    {
+        println("Failed to parse function definition");
+    }
+
+    return parsed_without_errors;
+}
+
+internal Bool
+parse_ast(Parser* parser)
+{
+    // NOTE(vlad): Lexing errors are already reported, the parser stops where the lexer did.
+    lex_all_tokens_in_parallel(parser->lexer,
+                               parser->context->tokens_arena,
+                               &parser->tokens,
+                               platform_get_number_of_processors());
+
+    compute_function_fingerprints(parser);
+    find_reused_function_definitions(parser);
+    copy_diagnostic_messages_of_reused_functions(parser);
+
+    const Size tokens_count = parser->tokens.types_count - parser->current_token_index;
+    const Size max_chunks_count = MIN(MIN(platform_get_number_of_processors(), tokens_count / MIN_TOKENS_PER_PARSER_CHUNK),
+                                      MAX_PARSER_CHUNKS_COUNT);
+
+    Index boundaries[MAX_PARSER_CHUNKS_COUNT + 1] = {0};
+    const Size chunks_count = find_parser_chunk_boundaries(parser, MAX(max_chunks_count, 1), boundaries);
+
+    return parse_function_definitions_in_chunks(parser, boundaries, chunks_count);
+}
+
 internal void
 destroy_parser(Parser* parser)
 {
@@ -8,18 +8,45 @@
 
 #include "eon_compilation_context.h"
 
+// NOTE(vlad): Smaller files are parsed on the calling thread, starting threads isn't worth it.
+#define MIN_TOKENS_PER_PARSER_CHUNK 65536
+#define MAX_PARSER_CHUNKS_COUNT 64
+
 struct Parser
 {
     Compilation_Context* context;
 
     Lexer* lexer;
+
+    // NOTE(vlad): The whole file is lexed before parsing, 'current_token' and 'lookahead_token'
+    //             are the tokens at 'current_token_index' and the one after it once fetched.
+    Token_Buffer tokens;
+    Index current_token_index;
+
     Token current_token;
     Token lookahead_token;
 
     Source_Location previous_token_location;
+
+    // NOTE(vlad): Arguments of the calls that are being parsed, see 'parse_arguments'.
+    array(Ast_Expression_Id, pending_call_arguments);
+
+    // NOTE(vlad): Chunks are parsed on other threads that must not print, their failures are
+    //             printed in source order when the chunks are merged.
+    Bool defers_printing_failures;
+    array(String_View, deferred_failures);
 };
 typedef struct Parser Parser;
 
 internal void create_parser(Parser* parser, Lexer* lexer, Compilation_Context* context);
 internal Bool parse_ast(Parser* parser);
+
+// NOTE(vlad): Splits the tokens after the current one into at most 'max_chunks_count' chunks of
+//             whole function definitions and returns the number of chunks. Chunk 'i' spans from
+//             'boundaries[i]' to 'boundaries[i + 1]' tokens, 'boundaries' must have at least
+//             'max_chunks_count + 1' elements.
+internal Size find_parser_chunk_boundaries(const Parser* parser, Size max_chunks_count, Index* boundaries);
+// NOTE(vlad): Parses every chunk from 'find_parser_chunk_boundaries' on its own thread, the AST and
+//             the diagnostic messages are the same as if the chunks were parsed one after another.
+internal Bool parse_function_definitions_in_chunks(Parser* parser, const Index* boundaries, Size chunks_count);
 internal void destroy_parser(Parser* parser);
@@ -2,6 +2,12 @@
 
 #include "eon_parser.h"
 
+#include "eon_cfg.h"
+#include "eon_lexical_scopes.h"
+#include "eon_ssa.h"
+#include "eon_tac.h"
+#include "eon_types.h"
+
 internal void
 test_function_definitions_parsing(Test_Context* test_context)
 {
@@ -819,8 +825,8 @@ test_variable_definitions_parsing(Test_Context* test_context)
 
         const Ast_Statement* statement = &definition->body.statements[0];
         ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_VARIABLE_DEFINITION);
-        ASSERT_EQUAL(statement->start_location.line, 0);
-        ASSERT_EQUAL(statement->start_location.column, 20);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 0);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 20);
         ASSERT_STRINGS_ARE_EQUAL(statement->variable_definition.name.token.lexeme, "variable");
 
         const Ast_Type* variable_type = statement->variable_definition.type;
@@ -873,8 +879,8 @@ test_variable_definitions_parsing(Test_Context* test_context)
 
         const Ast_Statement* statement = &function_definition->body.statements[0];
         ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_VARIABLE_DEFINITION);
-        ASSERT_EQUAL(statement->start_location.line, 1);
-        ASSERT_EQUAL(statement->start_location.column, 4);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 1);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
         const Ast_Variable_Definition* definition = &statement->variable_definition;
         ASSERT_STRINGS_ARE_EQUAL(definition->name.token.lexeme, "variable");
@@ -884,9 +890,9 @@ test_variable_definitions_parsing(Test_Context* test_context)
         ASSERT_LOCATION_STRINGS_ARE_EQUAL(&definition->type->location, "s32");
 
         ASSERT_TRUE(definition->has_initial_value);
-        ASSERT_ENUM_VALUES_ARE_EQUAL(definition->initial_value.kind, AST_EXPRESSION_NUMBER);
-        ASSERT_STRINGS_ARE_EQUAL(definition->initial_value.number.token.lexeme, "123");
-        ASSERT_FALSE(definition->initial_value.number.is_a_floating_point_number);
+        ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(definition->initial_value)->kind, AST_EXPRESSION_NUMBER);
+        ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(definition->initial_value)->number.token.lexeme, "123");
+        ASSERT_FALSE(AST_EXPRESSION(definition->initial_value)->number.is_a_floating_point_number);
 
         destroy_parser(&parser);
         destroy_lexer(&lexer);
@@ -931,8 +937,8 @@ test_variable_definitions_parsing(Test_Context* test_context)
 
         const Ast_Statement* statement = &function_definition->body.statements[0];
         ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_VARIABLE_DEFINITION);
-        ASSERT_EQUAL(statement->start_location.line, 1);
-        ASSERT_EQUAL(statement->start_location.column, 4);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 1);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
         const Ast_Variable_Definition* definition = &statement->variable_definition;
         ASSERT_STRINGS_ARE_EQUAL(definition->name.token.lexeme, "variable");
@@ -941,9 +947,9 @@ test_variable_definitions_parsing(Test_Context* test_context)
         ASSERT_LOCATION_STRINGS_ARE_EQUAL(&definition->type->location, "");
 
         ASSERT_TRUE(definition->has_initial_value);
-        ASSERT_ENUM_VALUES_ARE_EQUAL(definition->initial_value.kind, AST_EXPRESSION_NUMBER);
-        ASSERT_STRINGS_ARE_EQUAL(definition->initial_value.number.token.lexeme, "123");
-        ASSERT_FALSE(definition->initial_value.number.is_a_floating_point_number);
+        ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(definition->initial_value)->kind, AST_EXPRESSION_NUMBER);
+        ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(definition->initial_value)->number.token.lexeme, "123");
+        ASSERT_FALSE(AST_EXPRESSION(definition->initial_value)->number.is_a_floating_point_number);
 
         destroy_parser(&parser);
         destroy_lexer(&lexer);
@@ -990,8 +996,8 @@ test_variable_definitions_parsing(Test_Context* test_context)
         {
             const Ast_Statement* statement = &function_definition->body.statements[0];
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_VARIABLE_DEFINITION);
-            ASSERT_EQUAL(statement->start_location.line, 1);
-            ASSERT_EQUAL(statement->start_location.column, 4);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 1);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
             const Ast_Variable_Definition* definition = &statement->variable_definition;
             ASSERT_STRINGS_ARE_EQUAL(definition->name.token.lexeme, "var1");
@@ -999,16 +1005,16 @@ test_variable_definitions_parsing(Test_Context* test_context)
             ASSERT_FALSE(definition->type->is_mutable);
             ASSERT_LOCATION_STRINGS_ARE_EQUAL(&definition->type->location, "");
             ASSERT_TRUE(definition->has_initial_value);
-            ASSERT_ENUM_VALUES_ARE_EQUAL(definition->initial_value.kind, AST_EXPRESSION_NUMBER);
-            ASSERT_STRINGS_ARE_EQUAL(definition->initial_value.number.token.lexeme, "123");
-            ASSERT_FALSE(definition->initial_value.number.is_a_floating_point_number);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(definition->initial_value)->kind, AST_EXPRESSION_NUMBER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(definition->initial_value)->number.token.lexeme, "123");
+            ASSERT_FALSE(AST_EXPRESSION(definition->initial_value)->number.is_a_floating_point_number);
         }
 
         {
             const Ast_Statement* statement = &function_definition->body.statements[1];
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_VARIABLE_DEFINITION);
-            ASSERT_EQUAL(statement->start_location.line, 2);
-            ASSERT_EQUAL(statement->start_location.column, 4);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 2);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
             const Ast_Variable_Definition* definition = &statement->variable_definition;
             ASSERT_STRINGS_ARE_EQUAL(definition->name.token.lexeme, "var2");
@@ -1062,8 +1068,8 @@ test_variable_definitions_parsing(Test_Context* test_context)
 
         const Ast_Statement* statement = &function_definition->body.statements[0];
         ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_VARIABLE_DEFINITION);
-        ASSERT_EQUAL(statement->start_location.line, 1);
-        ASSERT_EQUAL(statement->start_location.column, 4);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 1);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
         const Ast_Variable_Definition* definition = &statement->variable_definition;
         ASSERT_STRINGS_ARE_EQUAL(definition->name.token.lexeme, "var");
@@ -1072,9 +1078,9 @@ test_variable_definitions_parsing(Test_Context* test_context)
         ASSERT_STRINGS_ARE_EQUAL(definition->type->named_type.token.lexeme, "String_View");
         ASSERT_LOCATION_STRINGS_ARE_EQUAL(&definition->type->location, "String_View");
         ASSERT_TRUE(definition->has_initial_value);
-        ASSERT_ENUM_VALUES_ARE_EQUAL(definition->initial_value.kind, AST_EXPRESSION_STRING_LITERAL);
-        ASSERT_STRINGS_ARE_EQUAL(definition->initial_value.string_literal.value, "Hello");
-        ASSERT_STRINGS_ARE_EQUAL(definition->initial_value.string_literal.token.lexeme, "\"Hello\"");
+        ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(definition->initial_value)->kind, AST_EXPRESSION_STRING_LITERAL);
+        ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(definition->initial_value)->string_literal.value, "Hello");
+        ASSERT_EQUAL(AST_EXPRESSION(definition->initial_value)->location.length_in_bytes, 7);
 
         destroy_parser(&parser);
         destroy_lexer(&lexer);
@@ -1121,8 +1127,8 @@ test_variable_definitions_parsing(Test_Context* test_context)
         {
             const Ast_Statement* statement = &function_definition->body.statements[0];
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_VARIABLE_DEFINITION);
-            ASSERT_EQUAL(statement->start_location.line, 1);
-            ASSERT_EQUAL(statement->start_location.column, 4);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 1);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
             const Ast_Variable_Definition* definition = &statement->variable_definition;
             ASSERT_STRINGS_ARE_EQUAL(definition->name.token.lexeme, "var1");
@@ -1130,16 +1136,16 @@ test_variable_definitions_parsing(Test_Context* test_context)
             ASSERT_FALSE(definition->type->is_mutable);
             ASSERT_LOCATION_STRINGS_ARE_EQUAL(&definition->type->location, "");
             ASSERT_TRUE(definition->has_initial_value);
-            ASSERT_ENUM_VALUES_ARE_EQUAL(definition->initial_value.kind, AST_EXPRESSION_NUMBER);
-            ASSERT_STRINGS_ARE_EQUAL(definition->initial_value.number.token.lexeme, "123");
-            ASSERT_FALSE(definition->initial_value.number.is_a_floating_point_number);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(definition->initial_value)->kind, AST_EXPRESSION_NUMBER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(definition->initial_value)->number.token.lexeme, "123");
+            ASSERT_FALSE(AST_EXPRESSION(definition->initial_value)->number.is_a_floating_point_number);
         }
 
         {
             const Ast_Statement* statement = &function_definition->body.statements[1];
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_VARIABLE_DEFINITION);
-            ASSERT_EQUAL(statement->start_location.line, 2);
-            ASSERT_EQUAL(statement->start_location.column, 4);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 2);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
             const Ast_Variable_Definition* definition = &statement->variable_definition;
             ASSERT_STRINGS_ARE_EQUAL(definition->name.token.lexeme, "var2");
@@ -1147,8 +1153,8 @@ test_variable_definitions_parsing(Test_Context* test_context)
             ASSERT_FALSE(definition->type->is_mutable);
             ASSERT_LOCATION_STRINGS_ARE_EQUAL(&definition->type->location, "");
             ASSERT_TRUE(definition->has_initial_value);
-            ASSERT_ENUM_VALUES_ARE_EQUAL(definition->initial_value.kind, AST_EXPRESSION_IDENTIFIER);
-            ASSERT_STRINGS_ARE_EQUAL(definition->initial_value.identifier.token.lexeme, "var1");
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(definition->initial_value)->kind, AST_EXPRESSION_IDENTIFIER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(definition->initial_value)->identifier.token.lexeme, "var1");
         }
 
         destroy_parser(&parser);
@@ -1193,8 +1199,8 @@ test_variable_definitions_parsing(Test_Context* test_context)
 
         const Ast_Statement* statement = &function_definition->body.statements[0];
         ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_VARIABLE_DEFINITION);
-        ASSERT_EQUAL(statement->start_location.line, 1);
-        ASSERT_EQUAL(statement->start_location.column, 4);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 1);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
         const Ast_Variable_Definition* definition = &statement->variable_definition;
         ASSERT_STRINGS_ARE_EQUAL(definition->name.token.lexeme, "pointer");
@@ -1251,8 +1257,8 @@ test_variable_definitions_parsing(Test_Context* test_context)
 
         const Ast_Statement* statement = &function_definition->body.statements[0];
         ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_VARIABLE_DEFINITION);
-        ASSERT_EQUAL(statement->start_location.line, 1);
-        ASSERT_EQUAL(statement->start_location.column, 4);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 1);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
         const Ast_Variable_Definition* definition = &statement->variable_definition;
         ASSERT_STRINGS_ARE_EQUAL(definition->name.token.lexeme, "pointer");
@@ -1313,8 +1319,8 @@ test_variable_definitions_parsing(Test_Context* test_context)
 
             const Ast_Statement* statement = &definition->body.statements[0];
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_VARIABLE_DEFINITION);
-            ASSERT_EQUAL(statement->start_location.line, 1);
-            ASSERT_EQUAL(statement->start_location.column, 4);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 1);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
             ASSERT_STRINGS_ARE_EQUAL(statement->variable_definition.name.token.lexeme, "variable");
 
@@ -1366,8 +1372,8 @@ test_variable_definitions_parsing(Test_Context* test_context)
 
             const Ast_Statement* statement = &function_definition->body.statements[0];
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_VARIABLE_DEFINITION);
-            ASSERT_EQUAL(statement->start_location.line, 1);
-            ASSERT_EQUAL(statement->start_location.column, 4);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 1);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
             const Ast_Variable_Definition* definition = &statement->variable_definition;
             ASSERT_STRINGS_ARE_EQUAL(definition->name.token.lexeme, "pointer");
@@ -1423,8 +1429,8 @@ test_variable_definitions_parsing(Test_Context* test_context)
 
             const Ast_Statement* statement = &function_definition->body.statements[0];
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_VARIABLE_DEFINITION);
-            ASSERT_EQUAL(statement->start_location.line, 1);
-            ASSERT_EQUAL(statement->start_location.column, 4);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 1);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
             const Ast_Variable_Definition* definition = &statement->variable_definition;
             ASSERT_STRINGS_ARE_EQUAL(definition->name.token.lexeme, "pointer");
@@ -1481,8 +1487,8 @@ test_variable_definitions_parsing(Test_Context* test_context)
             const Ast_Statement* statement = &definition->body.statements[0];
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_VARIABLE_DEFINITION);
             ASSERT_STRINGS_ARE_EQUAL(statement->variable_definition.name.token.lexeme, "variable");
-            ASSERT_EQUAL(statement->start_location.line, 1);
-            ASSERT_EQUAL(statement->start_location.column, 4);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 1);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
             const Ast_Type* variable_type = statement->variable_definition.type;
             ASSERT_ENUM_VALUES_ARE_EQUAL(variable_type->kind, AST_TYPE_NAME);
@@ -1491,9 +1497,9 @@ test_variable_definitions_parsing(Test_Context* test_context)
             ASSERT_LOCATION_STRINGS_ARE_EQUAL(&variable_type->location, "mutable _");
 
             ASSERT_TRUE(statement->variable_definition.has_initial_value);
-            ASSERT_ENUM_VALUES_ARE_EQUAL(statement->variable_definition.initial_value.kind, AST_EXPRESSION_NUMBER);
-            ASSERT_STRINGS_ARE_EQUAL(statement->variable_definition.initial_value.number.token.lexeme, "123");
-            ASSERT_FALSE(statement->variable_definition.initial_value.number.is_a_floating_point_number);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(statement->variable_definition.initial_value)->kind, AST_EXPRESSION_NUMBER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(statement->variable_definition.initial_value)->number.token.lexeme, "123");
+            ASSERT_FALSE(AST_EXPRESSION(statement->variable_definition.initial_value)->number.is_a_floating_point_number);
 
             destroy_parser(&parser);
             destroy_lexer(&lexer);
@@ -1543,8 +1549,8 @@ test_return_statement_parsing(Test_Context* test_context)
         const Ast_Statement* statement = &definition->body.statements[0];
         ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_RETURN);
         ASSERT_TRUE(statement->return_statement.is_empty);
-        ASSERT_EQUAL(statement->start_location.line, 1);
-        ASSERT_EQUAL(statement->start_location.column, 4);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 1);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
         destroy_parser(&parser);
         destroy_lexer(&lexer);
@@ -1587,15 +1593,15 @@ test_return_statement_parsing(Test_Context* test_context)
         ASSERT_EQUAL(definition->body.statements_count, 1);
 
         const Ast_Statement* statement = &definition->body.statements[0];
-        ASSERT_EQUAL(statement->start_location.line, 1);
-        ASSERT_EQUAL(statement->start_location.column, 4);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 1);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
         ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_RETURN);
         ASSERT_FALSE(statement->return_statement.is_empty);
-        ASSERT_ENUM_VALUES_ARE_EQUAL(statement->return_statement.expression.kind, AST_EXPRESSION_NUMBER);
-        ASSERT_STRINGS_ARE_EQUAL(statement->return_statement.expression.number.token.lexeme,
+        ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(statement->return_statement.expression)->kind, AST_EXPRESSION_NUMBER);
+        ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(statement->return_statement.expression)->number.token.lexeme,
                                  "123");
-        ASSERT_FALSE(statement->return_statement.expression.number.is_a_floating_point_number);
+        ASSERT_FALSE(AST_EXPRESSION(statement->return_statement.expression)->number.is_a_floating_point_number);
 
         destroy_parser(&parser);
         destroy_lexer(&lexer);
@@ -1642,20 +1648,20 @@ test_if_statement_parsing(Test_Context* test_context)
         ASSERT_EQUAL(definition->body.statements_count, 1);
 
         const Ast_Statement* statement = &definition->body.statements[0];
-        ASSERT_EQUAL(statement->start_location.line, 1);
-        ASSERT_EQUAL(statement->start_location.column, 4);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 1);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
         ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_IF);
         const Ast_If_Statement* if_statement = &statement->if_statement;
-        ASSERT_ENUM_VALUES_ARE_EQUAL(if_statement->condition.kind, AST_EXPRESSION_IDENTIFIER);
-        ASSERT_ENUM_VALUES_ARE_EQUAL(if_statement->condition.identifier.token.type, TOKEN_TRUE);
+        ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(if_statement->condition)->kind, AST_EXPRESSION_IDENTIFIER);
+        ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(if_statement->condition)->identifier.token.type, TOKEN_TRUE);
 
         const Ast_Code_Block* then_code_block = &if_statement->if_statements;
         ASSERT_EQUAL(then_code_block->statements_count, 1);
         {
             const Ast_Statement* substatement = &then_code_block->statements[0];
-            ASSERT_EQUAL(substatement->start_location.line, 1);
-            ASSERT_EQUAL(substatement->start_location.column, 14);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, substatement->start_location).line, 1);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, substatement->start_location).column, 14);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(substatement->kind, AST_STATEMENT_RETURN);
             ASSERT_TRUE(substatement->return_statement.is_empty);
@@ -1706,21 +1712,21 @@ test_if_statement_parsing(Test_Context* test_context)
         ASSERT_EQUAL(definition->body.statements_count, 1);
 
         const Ast_Statement* statement = &definition->body.statements[0];
-        ASSERT_EQUAL(statement->start_location.line, 1);
-        ASSERT_EQUAL(statement->start_location.column, 4);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 1);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
         ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_IF);
         const Ast_If_Statement* if_statement = &statement->if_statement;
-        ASSERT_ENUM_VALUES_ARE_EQUAL(if_statement->condition.kind, AST_EXPRESSION_IDENTIFIER);
-        ASSERT_ENUM_VALUES_ARE_EQUAL(if_statement->condition.identifier.token.type, TOKEN_TRUE);
+        ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(if_statement->condition)->kind, AST_EXPRESSION_IDENTIFIER);
+        ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(if_statement->condition)->identifier.token.type, TOKEN_TRUE);
 
         const Ast_Code_Block* then_code_block = &if_statement->if_statements;
         ASSERT_EQUAL(then_code_block->statements_count, 1);
 
         {
             const Ast_Statement* substatement = &then_code_block->statements[0];
-            ASSERT_EQUAL(substatement->start_location.line, 1);
-            ASSERT_EQUAL(substatement->start_location.column, 14);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, substatement->start_location).line, 1);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, substatement->start_location).column, 14);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(substatement->kind, AST_STATEMENT_RETURN);
             ASSERT_TRUE(substatement->return_statement.is_empty);
@@ -1732,8 +1738,8 @@ test_if_statement_parsing(Test_Context* test_context)
 
         {
             const Ast_Statement* substatement = &else_code_block->statements[0];
-            ASSERT_EQUAL(substatement->start_location.line, 2);
-            ASSERT_EQUAL(substatement->start_location.column, 11);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, substatement->start_location).line, 2);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, substatement->start_location).column, 11);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(substatement->kind, AST_STATEMENT_VARIABLE_DEFINITION);
 
@@ -1744,9 +1750,9 @@ test_if_statement_parsing(Test_Context* test_context)
             ASSERT_FALSE(variable_definition->type->is_mutable);
             ASSERT_LOCATION_STRINGS_ARE_EQUAL(&variable_definition->type->location, "");
             ASSERT_TRUE(variable_definition->has_initial_value);
-            ASSERT_ENUM_VALUES_ARE_EQUAL(variable_definition->initial_value.kind, AST_EXPRESSION_NUMBER);
-            ASSERT_STRINGS_ARE_EQUAL(variable_definition->initial_value.number.token.lexeme, "1");
-            ASSERT_FALSE(variable_definition->initial_value.number.is_a_floating_point_number);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(variable_definition->initial_value)->kind, AST_EXPRESSION_NUMBER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(variable_definition->initial_value)->number.token.lexeme, "1");
+            ASSERT_FALSE(AST_EXPRESSION(variable_definition->initial_value)->number.is_a_floating_point_number);
         }
 
         destroy_parser(&parser);
@@ -1792,62 +1798,62 @@ test_if_statement_parsing(Test_Context* test_context)
         ASSERT_EQUAL(definition->body.statements_count, 1);
 
         const Ast_Statement* statement = &definition->body.statements[0];
-        ASSERT_EQUAL(statement->start_location.line, 1);
-        ASSERT_EQUAL(statement->start_location.column, 4);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 1);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
         ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_IF);
 
         const Ast_If_Statement* if_statement = &statement->if_statement;
-        ASSERT_ENUM_VALUES_ARE_EQUAL(if_statement->condition.kind, AST_EXPRESSION_NUMBER);
-        ASSERT_STRINGS_ARE_EQUAL(if_statement->condition.number.token.lexeme, "1");
-        ASSERT_FALSE(if_statement->condition.number.is_a_floating_point_number);
+        ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(if_statement->condition)->kind, AST_EXPRESSION_NUMBER);
+        ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(if_statement->condition)->number.token.lexeme, "1");
+        ASSERT_FALSE(AST_EXPRESSION(if_statement->condition)->number.is_a_floating_point_number);
 
         const Ast_Code_Block* then_code_block = &if_statement->if_statements;
         ASSERT_EQUAL(then_code_block->statements_count, 1);
-        ASSERT_EQUAL(then_code_block->statements[0].start_location.line, 1);
-        ASSERT_EQUAL(then_code_block->statements[0].start_location.column, 11);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, then_code_block->statements[0].start_location).line, 1);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, then_code_block->statements[0].start_location).column, 11);
         ASSERT_ENUM_VALUES_ARE_EQUAL(then_code_block->statements[0].kind, AST_STATEMENT_RETURN);
 
         const Ast_Return_Statement* first_return = &then_code_block->statements[0].return_statement;
         ASSERT_FALSE(first_return->is_empty);
-        ASSERT_ENUM_VALUES_ARE_EQUAL(first_return->expression.kind, AST_EXPRESSION_NUMBER);
-        ASSERT_STRINGS_ARE_EQUAL(first_return->expression.number.token.lexeme, "1");
-        ASSERT_FALSE(first_return->expression.number.is_a_floating_point_number);
+        ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(first_return->expression)->kind, AST_EXPRESSION_NUMBER);
+        ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(first_return->expression)->number.token.lexeme, "1");
+        ASSERT_FALSE(AST_EXPRESSION(first_return->expression)->number.is_a_floating_point_number);
 
         const Ast_Code_Block* else_code_block = &if_statement->else_statements;
         ASSERT_EQUAL(else_code_block->statements_count, 1);
-        ASSERT_EQUAL(else_code_block->statements[0].start_location.line, 2);
-        ASSERT_EQUAL(else_code_block->statements[0].start_location.column, 9);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, else_code_block->statements[0].start_location).line, 2);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, else_code_block->statements[0].start_location).column, 9);
         ASSERT_ENUM_VALUES_ARE_EQUAL(else_code_block->statements[0].kind, AST_STATEMENT_IF);
 
         const Ast_If_Statement* else_if_statement = &else_code_block->statements[0].if_statement;
-        ASSERT_ENUM_VALUES_ARE_EQUAL(else_if_statement->condition.kind, AST_EXPRESSION_NUMBER);
-        ASSERT_STRINGS_ARE_EQUAL(else_if_statement->condition.number.token.lexeme, "2");
-        ASSERT_FALSE(else_if_statement->condition.number.is_a_floating_point_number);
+        ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(else_if_statement->condition)->kind, AST_EXPRESSION_NUMBER);
+        ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(else_if_statement->condition)->number.token.lexeme, "2");
+        ASSERT_FALSE(AST_EXPRESSION(else_if_statement->condition)->number.is_a_floating_point_number);
 
         const Ast_Code_Block* else_if_true_code_block = &else_if_statement->if_statements;
         ASSERT_EQUAL(else_if_true_code_block->statements_count, 1);
-        ASSERT_EQUAL(else_if_true_code_block->statements[0].start_location.line, 2);
-        ASSERT_EQUAL(else_if_true_code_block->statements[0].start_location.column, 16);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, else_if_true_code_block->statements[0].start_location).line, 2);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, else_if_true_code_block->statements[0].start_location).column, 16);
         ASSERT_ENUM_VALUES_ARE_EQUAL(else_if_true_code_block->statements[0].kind, AST_STATEMENT_RETURN);
 
         const Ast_Return_Statement* second_return = &else_if_true_code_block->statements[0].return_statement;
         ASSERT_FALSE(second_return->is_empty);
-        ASSERT_ENUM_VALUES_ARE_EQUAL(second_return->expression.kind, AST_EXPRESSION_NUMBER);
-        ASSERT_STRINGS_ARE_EQUAL(second_return->expression.number.token.lexeme, "2");
-        ASSERT_FALSE(second_return->expression.number.is_a_floating_point_number);
+        ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(second_return->expression)->kind, AST_EXPRESSION_NUMBER);
+        ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(second_return->expression)->number.token.lexeme, "2");
+        ASSERT_FALSE(AST_EXPRESSION(second_return->expression)->number.is_a_floating_point_number);
 
         const Ast_Code_Block* else_if_false_code_block = &else_if_statement->else_statements;
         ASSERT_EQUAL(else_if_false_code_block->statements_count, 1);
-        ASSERT_EQUAL(else_if_false_code_block->statements[0].start_location.line, 3);
-        ASSERT_EQUAL(else_if_false_code_block->statements[0].start_location.column, 11);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, else_if_false_code_block->statements[0].start_location).line, 3);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, else_if_false_code_block->statements[0].start_location).column, 11);
         ASSERT_ENUM_VALUES_ARE_EQUAL(else_if_false_code_block->statements[0].kind, AST_STATEMENT_RETURN);
 
         const Ast_Return_Statement* third_return = &else_if_false_code_block->statements[0].return_statement;
         ASSERT_FALSE(third_return->is_empty);
-        ASSERT_ENUM_VALUES_ARE_EQUAL(third_return->expression.kind, AST_EXPRESSION_NUMBER);
-        ASSERT_STRINGS_ARE_EQUAL(third_return->expression.number.token.lexeme, "3");
-        ASSERT_FALSE(third_return->expression.number.is_a_floating_point_number);
+        ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(third_return->expression)->kind, AST_EXPRESSION_NUMBER);
+        ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(third_return->expression)->number.token.lexeme, "3");
+        ASSERT_FALSE(AST_EXPRESSION(third_return->expression)->number.is_a_floating_point_number);
 
         destroy_parser(&parser);
         destroy_lexer(&lexer);
@@ -1895,8 +1901,8 @@ test_expressions(Test_Context* test_context)
 
         {
             const Ast_Statement* statement = &function_definition->body.statements[0];
-            ASSERT_EQUAL(statement->start_location.line, 1);
-            ASSERT_EQUAL(statement->start_location.column, 4);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 1);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_VARIABLE_DEFINITION);
 
@@ -1907,17 +1913,17 @@ test_expressions(Test_Context* test_context)
             ASSERT_LOCATION_STRINGS_ARE_EQUAL(&definition->type->location, "");
 
             ASSERT_TRUE(definition->has_initial_value);
-            ASSERT_ENUM_VALUES_ARE_EQUAL(definition->initial_value.kind, AST_EXPRESSION_NUMBER);
-            ASSERT_STRINGS_ARE_EQUAL(definition->initial_value.number.token.lexeme, "0");
-            ASSERT_FALSE(definition->initial_value.number.is_a_floating_point_number);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(definition->initial_value)->kind, AST_EXPRESSION_NUMBER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(definition->initial_value)->number.token.lexeme, "0");
+            ASSERT_FALSE(AST_EXPRESSION(definition->initial_value)->number.is_a_floating_point_number);
 
-            ASSERT_LOCATION_STRINGS_ARE_EQUAL(&definition->initial_value.location, "0");
+            ASSERT_LOCATION_STRINGS_ARE_EQUAL(&AST_EXPRESSION(definition->initial_value)->location, "0");
         }
 
         {
             const Ast_Statement* statement = &function_definition->body.statements[1];
-            ASSERT_EQUAL(statement->start_location.line, 2);
-            ASSERT_EQUAL(statement->start_location.column, 4);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 2);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_VARIABLE_DEFINITION);
 
@@ -1928,9 +1934,9 @@ test_expressions(Test_Context* test_context)
             ASSERT_LOCATION_STRINGS_ARE_EQUAL(&definition->type->location, "");
 
             ASSERT_TRUE(definition->has_initial_value);
-            ASSERT_ENUM_VALUES_ARE_EQUAL(definition->initial_value.kind, AST_EXPRESSION_IDENTIFIER);
-            ASSERT_STRINGS_ARE_EQUAL(definition->initial_value.identifier.token.lexeme, "var1");
-            ASSERT_LOCATION_STRINGS_ARE_EQUAL(&definition->initial_value.location, "(var1)");
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(definition->initial_value)->kind, AST_EXPRESSION_IDENTIFIER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(definition->initial_value)->identifier.token.lexeme, "var1");
+            ASSERT_LOCATION_STRINGS_ARE_EQUAL(&AST_EXPRESSION(definition->initial_value)->location, "(var1)");
         }
 
         destroy_parser(&parser);
@@ -2017,8 +2023,8 @@ test_expressions(Test_Context* test_context)
             ASSERT_EQUAL(function_definition->body.statements_count, 1);
 
             const Ast_Statement* statement = &function_definition->body.statements[0];
-            ASSERT_EQUAL(statement->start_location.line, 1);
-            ASSERT_EQUAL(statement->start_location.column, 4);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 1);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_VARIABLE_DEFINITION);
 
@@ -2030,7 +2036,7 @@ test_expressions(Test_Context* test_context)
 
             ASSERT_TRUE(definition->has_initial_value);
 
-            switch (definition->initial_value.kind)
+            switch (AST_EXPRESSION(definition->initial_value)->kind)
             {
                 case AST_EXPRESSION_ADD:
                 case AST_EXPRESSION_SUBTRACT:
@@ -2053,19 +2059,19 @@ test_expressions(Test_Context* test_context)
                 } break;
             }
 
-            ASSERT_STRINGS_ARE_EQUAL(definition->initial_value.binary_expression.operator.lexeme,
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(definition->initial_value)->binary_expression.operator.lexeme,
                                      test_info.expected_operator_lexeme);
 
-            ASSERT_ENUM_VALUES_ARE_EQUAL(definition->initial_value.binary_expression.lhs->kind, AST_EXPRESSION_NUMBER);
-            ASSERT_STRINGS_ARE_EQUAL(definition->initial_value.binary_expression.lhs->number.token.lexeme,
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(AST_EXPRESSION(definition->initial_value)->binary_expression.lhs)->kind, AST_EXPRESSION_NUMBER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(AST_EXPRESSION(definition->initial_value)->binary_expression.lhs)->number.token.lexeme,
                                      test_info.expected_operand_lexeme);
-            ASSERT_EQUAL(definition->initial_value.binary_expression.lhs->number.is_a_floating_point_number,
+            ASSERT_EQUAL(AST_EXPRESSION(AST_EXPRESSION(definition->initial_value)->binary_expression.lhs)->number.is_a_floating_point_number,
                          test_info.operand_is_a_floating_point_number);
 
-            ASSERT_ENUM_VALUES_ARE_EQUAL(definition->initial_value.binary_expression.rhs->kind, AST_EXPRESSION_NUMBER);
-            ASSERT_STRINGS_ARE_EQUAL(definition->initial_value.binary_expression.rhs->number.token.lexeme,
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(AST_EXPRESSION(definition->initial_value)->binary_expression.rhs)->kind, AST_EXPRESSION_NUMBER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(AST_EXPRESSION(definition->initial_value)->binary_expression.rhs)->number.token.lexeme,
                                      test_info.expected_operand_lexeme);
-            ASSERT_EQUAL(definition->initial_value.binary_expression.rhs->number.is_a_floating_point_number,
+            ASSERT_EQUAL(AST_EXPRESSION(AST_EXPRESSION(definition->initial_value)->binary_expression.rhs)->number.is_a_floating_point_number,
                          test_info.operand_is_a_floating_point_number);
 
             {
@@ -2074,7 +2080,7 @@ test_expressions(Test_Context* test_context)
                                                                       test_info.expected_operand_lexeme,
                                                                       test_info.expected_operator_lexeme,
                                                                       test_info.expected_operand_lexeme);
-                ASSERT_LOCATION_STRINGS_ARE_EQUAL(&definition->initial_value.location, expected_location_string);
+                ASSERT_LOCATION_STRINGS_ARE_EQUAL(&AST_EXPRESSION(definition->initial_value)->location, expected_location_string);
             }
 
             destroy_parser(&parser);
@@ -2121,17 +2127,17 @@ test_expressions(Test_Context* test_context)
             ASSERT_EQUAL(function_definition->body.statements_count, 1);
 
             const Ast_Statement* statement = &function_definition->body.statements[0];
-            ASSERT_EQUAL(statement->start_location.line, 0);
-            ASSERT_EQUAL(statement->start_location.column, 19);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 0);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 19);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_RETURN);
             ASSERT_FALSE(statement->return_statement.is_empty);
-            ASSERT_ENUM_VALUES_ARE_EQUAL(statement->return_statement.expression.kind, AST_EXPRESSION_NUMBER);
-            ASSERT_STRINGS_ARE_EQUAL(statement->return_statement.expression.number.token.lexeme,
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(statement->return_statement.expression)->kind, AST_EXPRESSION_NUMBER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(statement->return_statement.expression)->number.token.lexeme,
                                      "123");
-            ASSERT_FALSE(statement->return_statement.expression.number.is_a_floating_point_number);
+            ASSERT_FALSE(AST_EXPRESSION(statement->return_statement.expression)->number.is_a_floating_point_number);
 
-            ASSERT_LOCATION_STRINGS_ARE_EQUAL(&statement->return_statement.expression.location, "123");
+            ASSERT_LOCATION_STRINGS_ARE_EQUAL(&AST_EXPRESSION(statement->return_statement.expression)->location, "123");
         }
 
         {
@@ -2154,8 +2160,8 @@ test_expressions(Test_Context* test_context)
             ASSERT_EQUAL(function_definition->body.statements_count, 1);
 
             const Ast_Statement* statement = &function_definition->body.statements[0];
-            ASSERT_EQUAL(statement->start_location.line, 2);
-            ASSERT_EQUAL(statement->start_location.column, 4);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 2);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_VARIABLE_DEFINITION);
 
@@ -2165,10 +2171,10 @@ test_expressions(Test_Context* test_context)
             ASSERT_FALSE(definition->type->is_mutable);
             ASSERT_LOCATION_STRINGS_ARE_EQUAL(&definition->type->location, "");
             ASSERT_TRUE(definition->has_initial_value);
-            ASSERT_ENUM_VALUES_ARE_EQUAL(definition->initial_value.kind, AST_EXPRESSION_CALL);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(definition->initial_value)->kind, AST_EXPRESSION_CALL);
 
-            const Ast_Call* call = &definition->initial_value.call;
-            const Ast_Expression* called_expression = call->called_expression;
+            const Ast_Call* call = &AST_EXPRESSION(definition->initial_value)->call;
+            const Ast_Expression* called_expression = AST_EXPRESSION(call->called_expression);
             ASSERT_ENUM_VALUES_ARE_EQUAL(called_expression->kind, AST_EXPRESSION_IDENTIFIER);
             ASSERT_STRINGS_ARE_EQUAL(called_expression->identifier.token.lexeme, "foo");
             ASSERT_EQUAL(call->arguments_count, 0);
@@ -2217,8 +2223,8 @@ test_expressions(Test_Context* test_context)
             ASSERT_EQUAL(function_definition->body.statements_count, 1);
 
             const Ast_Statement* statement = &function_definition->body.statements[0];
-            ASSERT_EQUAL(statement->start_location.line, 2);
-            ASSERT_EQUAL(statement->start_location.column, 4);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 2);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_VARIABLE_DEFINITION);
 
@@ -2227,29 +2233,29 @@ test_expressions(Test_Context* test_context)
             ASSERT_ENUM_VALUES_ARE_EQUAL(definition->type->kind, AST_TYPE_OMITTED);
             ASSERT_FALSE(definition->type->is_mutable);
             ASSERT_TRUE(definition->has_initial_value);
-            ASSERT_ENUM_VALUES_ARE_EQUAL(definition->initial_value.kind, AST_EXPRESSION_CALL);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(definition->initial_value)->kind, AST_EXPRESSION_CALL);
 
-            const Ast_Call* call = &definition->initial_value.call;
-            const Ast_Expression* called_expression = call->called_expression;
+            const Ast_Call* call = &AST_EXPRESSION(definition->initial_value)->call;
+            const Ast_Expression* called_expression = AST_EXPRESSION(call->called_expression);
             ASSERT_ENUM_VALUES_ARE_EQUAL(called_expression->kind, AST_EXPRESSION_IDENTIFIER);
             ASSERT_STRINGS_ARE_EQUAL(called_expression->identifier.token.lexeme, "foo");
             ASSERT_EQUAL(call->arguments_count, 2);
 
             {
-                const Ast_Expression* first_argument = call->arguments[0];
+                const Ast_Expression* first_argument = AST_CALL_ARGUMENT(call, 0);
                 ASSERT_ENUM_VALUES_ARE_EQUAL(first_argument->kind, AST_EXPRESSION_NUMBER);
                 ASSERT_STRINGS_ARE_EQUAL(first_argument->number.token.lexeme, "10");
                 ASSERT_FALSE(first_argument->number.is_a_floating_point_number);
             }
 
             {
-                const Ast_Expression* second_argument = call->arguments[1];
+                const Ast_Expression* second_argument = AST_CALL_ARGUMENT(call, 1);
                 ASSERT_ENUM_VALUES_ARE_EQUAL(second_argument->kind, AST_EXPRESSION_NUMBER);
                 ASSERT_STRINGS_ARE_EQUAL(second_argument->number.token.lexeme, "20");
                 ASSERT_FALSE(second_argument->number.is_a_floating_point_number);
             }
 
-            ASSERT_LOCATION_STRINGS_ARE_EQUAL(&definition->initial_value.location, "foo(10, 20)");
+            ASSERT_LOCATION_STRINGS_ARE_EQUAL(&AST_EXPRESSION(definition->initial_value)->location, "foo(10, 20)");
         }
 
         destroy_parser(&parser);
@@ -2294,8 +2300,8 @@ test_expressions(Test_Context* test_context)
             ASSERT_EQUAL(function_definition->body.statements_count, 1);
 
             const Ast_Statement* statement = &function_definition->body.statements[0];
-            ASSERT_EQUAL(statement->start_location.line, 1);
-            ASSERT_EQUAL(statement->start_location.column, 4);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 1);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_VARIABLE_DEFINITION);
 
@@ -2305,62 +2311,62 @@ test_expressions(Test_Context* test_context)
             ASSERT_FALSE(definition->type->is_mutable);
             ASSERT_LOCATION_STRINGS_ARE_EQUAL(&definition->type->location, "");
             ASSERT_TRUE(definition->has_initial_value);
-            ASSERT_ENUM_VALUES_ARE_EQUAL(definition->initial_value.kind, AST_EXPRESSION_CALL);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(definition->initial_value)->kind, AST_EXPRESSION_CALL);
 
-            const Ast_Call* call = &definition->initial_value.call;
-            const Ast_Expression* called_expression = call->called_expression;
+            const Ast_Call* call = &AST_EXPRESSION(definition->initial_value)->call;
+            const Ast_Expression* called_expression = AST_EXPRESSION(call->called_expression);
             ASSERT_ENUM_VALUES_ARE_EQUAL(called_expression->kind, AST_EXPRESSION_IDENTIFIER);
             ASSERT_STRINGS_ARE_EQUAL(called_expression->identifier.token.lexeme, "bar");
             ASSERT_EQUAL(call->arguments_count, 2);
 
             {
-                const Ast_Expression* first_argument = call->arguments[0];
+                const Ast_Expression* first_argument = AST_CALL_ARGUMENT(call, 0);
                 ASSERT_ENUM_VALUES_ARE_EQUAL(first_argument->kind, AST_EXPRESSION_ADD);
 
                 ASSERT_STRINGS_ARE_EQUAL(first_argument->binary_expression.operator.lexeme, "+");
 
                 {
-                    const Ast_Expression* lhs = first_argument->binary_expression.lhs;
+                    const Ast_Expression* lhs = AST_EXPRESSION(first_argument->binary_expression.lhs);
                     ASSERT_ENUM_VALUES_ARE_EQUAL(lhs->kind, AST_EXPRESSION_NUMBER);
                     ASSERT_STRINGS_ARE_EQUAL(lhs->number.token.lexeme, "10");
                     ASSERT_FALSE(lhs->number.is_a_floating_point_number);
                 }
 
                 {
-                    const Ast_Expression* rhs = first_argument->binary_expression.rhs;
+                    const Ast_Expression* rhs = AST_EXPRESSION(first_argument->binary_expression.rhs);
                     ASSERT_ENUM_VALUES_ARE_EQUAL(rhs->kind, AST_EXPRESSION_MULTIPLY);
                     ASSERT_STRINGS_ARE_EQUAL(rhs->binary_expression.operator.lexeme, "*");
 
-                    ASSERT_ENUM_VALUES_ARE_EQUAL(rhs->binary_expression.lhs->kind, AST_EXPRESSION_IDENTIFIER);
-                    ASSERT_STRINGS_ARE_EQUAL(rhs->binary_expression.lhs->identifier.token.lexeme, "something");
+                    ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(rhs->binary_expression.lhs)->kind, AST_EXPRESSION_IDENTIFIER);
+                    ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(rhs->binary_expression.lhs)->identifier.token.lexeme, "something");
 
-                    ASSERT_ENUM_VALUES_ARE_EQUAL(rhs->binary_expression.rhs->kind, AST_EXPRESSION_NUMBER);
-                    ASSERT_STRINGS_ARE_EQUAL(rhs->binary_expression.rhs->number.token.lexeme, "30");
-                    ASSERT_FALSE(rhs->binary_expression.rhs->number.is_a_floating_point_number);
+                    ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(rhs->binary_expression.rhs)->kind, AST_EXPRESSION_NUMBER);
+                    ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(rhs->binary_expression.rhs)->number.token.lexeme, "30");
+                    ASSERT_FALSE(AST_EXPRESSION(rhs->binary_expression.rhs)->number.is_a_floating_point_number);
                 }
             }
 
             {
-                const Ast_Expression* second_argument = call->arguments[1];
+                const Ast_Expression* second_argument = AST_CALL_ARGUMENT(call, 1);
                 ASSERT_ENUM_VALUES_ARE_EQUAL(second_argument->kind, AST_EXPRESSION_CALL);
 
                 const Ast_Call* nested_call = &second_argument->call;
-                const Ast_Expression* nested_called_expression = nested_call->called_expression;
+                const Ast_Expression* nested_called_expression = AST_EXPRESSION(nested_call->called_expression);
                 ASSERT_ENUM_VALUES_ARE_EQUAL(nested_called_expression->kind, AST_EXPRESSION_IDENTIFIER);
                 ASSERT_STRINGS_ARE_EQUAL(nested_called_expression->identifier.token.lexeme, "baz");
 
                 ASSERT_EQUAL(nested_call->arguments_count, 2);
 
-                ASSERT_ENUM_VALUES_ARE_EQUAL(nested_call->arguments[0]->kind, AST_EXPRESSION_NUMBER);
-                ASSERT_STRINGS_ARE_EQUAL(nested_call->arguments[0]->number.token.lexeme, "10");
-                ASSERT_FALSE(nested_call->arguments[0]->number.is_a_floating_point_number);
+                ASSERT_ENUM_VALUES_ARE_EQUAL(AST_CALL_ARGUMENT(nested_call, 0)->kind, AST_EXPRESSION_NUMBER);
+                ASSERT_STRINGS_ARE_EQUAL(AST_CALL_ARGUMENT(nested_call, 0)->number.token.lexeme, "10");
+                ASSERT_FALSE(AST_CALL_ARGUMENT(nested_call, 0)->number.is_a_floating_point_number);
 
-                ASSERT_ENUM_VALUES_ARE_EQUAL(nested_call->arguments[1]->kind, AST_EXPRESSION_NUMBER);
-                ASSERT_STRINGS_ARE_EQUAL(nested_call->arguments[1]->number.token.lexeme, "20");
-                ASSERT_FALSE(nested_call->arguments[1]->number.is_a_floating_point_number);
+                ASSERT_ENUM_VALUES_ARE_EQUAL(AST_CALL_ARGUMENT(nested_call, 1)->kind, AST_EXPRESSION_NUMBER);
+                ASSERT_STRINGS_ARE_EQUAL(AST_CALL_ARGUMENT(nested_call, 1)->number.token.lexeme, "20");
+                ASSERT_FALSE(AST_CALL_ARGUMENT(nested_call, 1)->number.is_a_floating_point_number);
             }
 
-            ASSERT_LOCATION_STRINGS_ARE_EQUAL(&definition->initial_value.location,
+            ASSERT_LOCATION_STRINGS_ARE_EQUAL(&AST_EXPRESSION(definition->initial_value)->location,
                                               "bar(10 + something * 30, baz(10, 20))");
         }
 
@@ -2406,8 +2412,8 @@ test_expressions(Test_Context* test_context)
             ASSERT_EQUAL(function_definition->body.statements_count, 1);
 
             const Ast_Statement* statement = &function_definition->body.statements[0];
-            ASSERT_EQUAL(statement->start_location.line, 1);
-            ASSERT_EQUAL(statement->start_location.column, 4);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 1);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_VARIABLE_DEFINITION);
 
@@ -2417,15 +2423,15 @@ test_expressions(Test_Context* test_context)
             ASSERT_FALSE(definition->type->is_mutable);
             ASSERT_LOCATION_STRINGS_ARE_EQUAL(&definition->type->location, "");
             ASSERT_TRUE(definition->has_initial_value);
-            ASSERT_ENUM_VALUES_ARE_EQUAL(definition->initial_value.kind, AST_EXPRESSION_NEGATE);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(definition->initial_value)->kind, AST_EXPRESSION_NEGATE);
 
-            const Ast_Unary_Expression* unary_expression = &definition->initial_value.unary_expression;
+            const Ast_Unary_Expression* unary_expression = &AST_EXPRESSION(definition->initial_value)->unary_expression;
 
             ASSERT_STRINGS_ARE_EQUAL(unary_expression->operator.lexeme, "-");
 
-            ASSERT_ENUM_VALUES_ARE_EQUAL(unary_expression->operand->kind, AST_EXPRESSION_NUMBER);
-            ASSERT_STRINGS_ARE_EQUAL(unary_expression->operand->number.token.lexeme, "1");
-            ASSERT_FALSE(unary_expression->operand->number.is_a_floating_point_number);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(unary_expression->operand)->kind, AST_EXPRESSION_NUMBER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(unary_expression->operand)->number.token.lexeme, "1");
+            ASSERT_FALSE(AST_EXPRESSION(unary_expression->operand)->number.is_a_floating_point_number);
 
             destroy_parser(&parser);
             destroy_lexer(&lexer);
@@ -2481,8 +2487,8 @@ test_expressions(Test_Context* test_context)
             ASSERT_EQUAL(function_definition->body.statements_count, 1);
 
             const Ast_Statement* statement = &function_definition->body.statements[0];
-            ASSERT_EQUAL(statement->start_location.line, 1);
-            ASSERT_EQUAL(statement->start_location.column, 4);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 1);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_VARIABLE_DEFINITION);
 
@@ -2492,26 +2498,26 @@ test_expressions(Test_Context* test_context)
             ASSERT_FALSE(definition->type->is_mutable);
             ASSERT_LOCATION_STRINGS_ARE_EQUAL(&definition->type->location, "");
             ASSERT_TRUE(definition->has_initial_value);
-            ASSERT_ENUM_VALUES_ARE_EQUAL(definition->initial_value.kind, AST_EXPRESSION_MULTIPLY);
-            ASSERT_LOCATION_STRINGS_ARE_EQUAL(&definition->initial_value.location, "arg* * 2");
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(definition->initial_value)->kind, AST_EXPRESSION_MULTIPLY);
+            ASSERT_LOCATION_STRINGS_ARE_EQUAL(&AST_EXPRESSION(definition->initial_value)->location, "arg* * 2");
 
             {
-                const Ast_Binary_Expression* binary_expression = &definition->initial_value.binary_expression;
+                const Ast_Binary_Expression* binary_expression = &AST_EXPRESSION(definition->initial_value)->binary_expression;
 
                 ASSERT_STRINGS_ARE_EQUAL(binary_expression->operator.lexeme, "*");
 
-                const Ast_Expression* lhs = binary_expression->lhs;
+                const Ast_Expression* lhs = AST_EXPRESSION(binary_expression->lhs);
                 ASSERT_ENUM_VALUES_ARE_EQUAL(lhs->kind, AST_EXPRESSION_DEREFERENCE);
                 ASSERT_STRINGS_ARE_EQUAL(lhs->unary_expression.operator.lexeme, "*");
                 ASSERT_LOCATION_STRINGS_ARE_EQUAL(&lhs->location, "arg*");
 
-                ASSERT_ENUM_VALUES_ARE_EQUAL(lhs->unary_expression.operand->kind, AST_EXPRESSION_IDENTIFIER);
-                ASSERT_LOCATION_STRINGS_ARE_EQUAL(&lhs->unary_expression.operand->location, "arg");
+                ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(lhs->unary_expression.operand)->kind, AST_EXPRESSION_IDENTIFIER);
+                ASSERT_LOCATION_STRINGS_ARE_EQUAL(&AST_EXPRESSION(lhs->unary_expression.operand)->location, "arg");
 
-                ASSERT_STRINGS_ARE_EQUAL(lhs->unary_expression.operand->identifier.token.lexeme, "arg");
-                ASSERT_LOCATION_STRINGS_ARE_EQUAL(&lhs->unary_expression.operand->identifier.token.location, "arg");
+                ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(lhs->unary_expression.operand)->identifier.token.lexeme, "arg");
+                ASSERT_LOCATION_STRINGS_ARE_EQUAL(&AST_EXPRESSION(lhs->unary_expression.operand)->identifier.token.location, "arg");
 
-                const Ast_Expression* rhs = binary_expression->rhs;
+                const Ast_Expression* rhs = AST_EXPRESSION(binary_expression->rhs);
                 ASSERT_ENUM_VALUES_ARE_EQUAL(rhs->kind, AST_EXPRESSION_NUMBER);
                 ASSERT_LOCATION_STRINGS_ARE_EQUAL(&rhs->location, "2");
                 ASSERT_FALSE(rhs->number.is_a_floating_point_number);
@@ -2574,8 +2580,8 @@ test_expressions(Test_Context* test_context)
             ASSERT_EQUAL(function_definition->body.statements_count, 1);
 
             const Ast_Statement* statement = &function_definition->body.statements[0];
-            ASSERT_EQUAL(statement->start_location.line, 1);
-            ASSERT_EQUAL(statement->start_location.column, 4);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 1);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_VARIABLE_DEFINITION);
 
@@ -2585,20 +2591,20 @@ test_expressions(Test_Context* test_context)
             ASSERT_FALSE(definition->type->is_mutable);
             ASSERT_LOCATION_STRINGS_ARE_EQUAL(&definition->type->location, "");
             ASSERT_TRUE(definition->has_initial_value);
-            ASSERT_ENUM_VALUES_ARE_EQUAL(definition->initial_value.kind, AST_EXPRESSION_ADD);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(definition->initial_value)->kind, AST_EXPRESSION_ADD);
 
             {
-                const Ast_Binary_Expression* binary_expression = &definition->initial_value.binary_expression;
+                const Ast_Binary_Expression* binary_expression = &AST_EXPRESSION(definition->initial_value)->binary_expression;
 
                 ASSERT_STRINGS_ARE_EQUAL(binary_expression->operator.lexeme, "+");
 
-                const Ast_Expression* lhs = binary_expression->lhs;
+                const Ast_Expression* lhs = AST_EXPRESSION(binary_expression->lhs);
                 ASSERT_ENUM_VALUES_ARE_EQUAL(lhs->kind, AST_EXPRESSION_DEREFERENCE);
                 ASSERT_STRINGS_ARE_EQUAL(lhs->unary_expression.operator.lexeme, "*");
-                ASSERT_ENUM_VALUES_ARE_EQUAL(lhs->unary_expression.operand->kind, AST_EXPRESSION_IDENTIFIER);
-                ASSERT_STRINGS_ARE_EQUAL(lhs->unary_expression.operand->identifier.token.lexeme, "arg");
+                ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(lhs->unary_expression.operand)->kind, AST_EXPRESSION_IDENTIFIER);
+                ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(lhs->unary_expression.operand)->identifier.token.lexeme, "arg");
 
-                const Ast_Expression* rhs = binary_expression->rhs;
+                const Ast_Expression* rhs = AST_EXPRESSION(binary_expression->rhs);
                 ASSERT_ENUM_VALUES_ARE_EQUAL(rhs->kind, AST_EXPRESSION_NUMBER);
                 ASSERT_STRINGS_ARE_EQUAL(rhs->number.token.lexeme, "2");
                 ASSERT_FALSE(rhs->number.is_a_floating_point_number);
@@ -2663,8 +2669,8 @@ test_expressions(Test_Context* test_context)
             ASSERT_EQUAL(function_definition->body.statements_count, 1);
 
             const Ast_Statement* statement = &function_definition->body.statements[0];
-            ASSERT_EQUAL(statement->start_location.line, 1);
-            ASSERT_EQUAL(statement->start_location.column, 4);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 1);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_VARIABLE_DEFINITION);
 
@@ -2674,27 +2680,27 @@ test_expressions(Test_Context* test_context)
             ASSERT_FALSE(definition->type->is_mutable);
             ASSERT_LOCATION_STRINGS_ARE_EQUAL(&definition->type->location, "");
             ASSERT_TRUE(definition->has_initial_value);
-            ASSERT_ENUM_VALUES_ARE_EQUAL(definition->initial_value.kind, AST_EXPRESSION_MULTIPLY);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(definition->initial_value)->kind, AST_EXPRESSION_MULTIPLY);
 
             {
-                const Ast_Binary_Expression* binary_expression = &definition->initial_value.binary_expression;
+                const Ast_Binary_Expression* binary_expression = &AST_EXPRESSION(definition->initial_value)->binary_expression;
 
                 ASSERT_STRINGS_ARE_EQUAL(binary_expression->operator.lexeme, "*");
 
-                const Ast_Expression* lhs = binary_expression->lhs;
+                const Ast_Expression* lhs = AST_EXPRESSION(binary_expression->lhs);
                 ASSERT_ENUM_VALUES_ARE_EQUAL(lhs->kind, AST_EXPRESSION_DEREFERENCE);
                 {
                     const Ast_Unary_Expression* first_dereference = &lhs->unary_expression;
                     ASSERT_STRINGS_ARE_EQUAL(first_dereference->operator.lexeme, "*");
-                    ASSERT_ENUM_VALUES_ARE_EQUAL(first_dereference->operand->kind, AST_EXPRESSION_DEREFERENCE);
+                    ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(first_dereference->operand)->kind, AST_EXPRESSION_DEREFERENCE);
 
-                    const Ast_Unary_Expression* second_dereference = &first_dereference->operand->unary_expression;
+                    const Ast_Unary_Expression* second_dereference = &AST_EXPRESSION(first_dereference->operand)->unary_expression;
                     ASSERT_STRINGS_ARE_EQUAL(second_dereference->operator.lexeme, "*");
-                    ASSERT_ENUM_VALUES_ARE_EQUAL(second_dereference->operand->kind, AST_EXPRESSION_IDENTIFIER);
-                    ASSERT_STRINGS_ARE_EQUAL(second_dereference->operand->identifier.token.lexeme, "arg");
+                    ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(second_dereference->operand)->kind, AST_EXPRESSION_IDENTIFIER);
+                    ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(second_dereference->operand)->identifier.token.lexeme, "arg");
                 }
 
-                const Ast_Expression* rhs = binary_expression->rhs;
+                const Ast_Expression* rhs = AST_EXPRESSION(binary_expression->rhs);
                 ASSERT_ENUM_VALUES_ARE_EQUAL(rhs->kind, AST_EXPRESSION_NUMBER);
                 ASSERT_STRINGS_ARE_EQUAL(rhs->number.token.lexeme, "2");
                 ASSERT_FALSE(rhs->number.is_a_floating_point_number);
@@ -2760,8 +2766,8 @@ test_expressions(Test_Context* test_context)
             ASSERT_EQUAL(function_definition->body.statements_count, 1);
 
             const Ast_Statement* statement = &function_definition->body.statements[0];
-            ASSERT_EQUAL(statement->start_location.line, 1);
-            ASSERT_EQUAL(statement->start_location.column, 4);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 1);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_VARIABLE_DEFINITION);
 
@@ -2771,27 +2777,27 @@ test_expressions(Test_Context* test_context)
             ASSERT_FALSE(definition->type->is_mutable);
             ASSERT_LOCATION_STRINGS_ARE_EQUAL(&definition->type->location, "");
             ASSERT_TRUE(definition->has_initial_value);
-            ASSERT_ENUM_VALUES_ARE_EQUAL(definition->initial_value.kind, AST_EXPRESSION_MULTIPLY);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(definition->initial_value)->kind, AST_EXPRESSION_MULTIPLY);
 
             {
-                const Ast_Binary_Expression* binary_expression = &definition->initial_value.binary_expression;
+                const Ast_Binary_Expression* binary_expression = &AST_EXPRESSION(definition->initial_value)->binary_expression;
 
                 ASSERT_STRINGS_ARE_EQUAL(binary_expression->operator.lexeme, "*");
 
-                const Ast_Expression* lhs = binary_expression->lhs;
+                const Ast_Expression* lhs = AST_EXPRESSION(binary_expression->lhs);
                 ASSERT_ENUM_VALUES_ARE_EQUAL(lhs->kind, AST_EXPRESSION_DEREFERENCE);
                 {
                     const Ast_Unary_Expression* first_dereference = &lhs->unary_expression;
                     ASSERT_STRINGS_ARE_EQUAL(first_dereference->operator.lexeme, "*");
-                    ASSERT_ENUM_VALUES_ARE_EQUAL(first_dereference->operand->kind, AST_EXPRESSION_DEREFERENCE);
+                    ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(first_dereference->operand)->kind, AST_EXPRESSION_DEREFERENCE);
 
-                    const Ast_Unary_Expression* second_dereference = &first_dereference->operand->unary_expression;
+                    const Ast_Unary_Expression* second_dereference = &AST_EXPRESSION(first_dereference->operand)->unary_expression;
                     ASSERT_STRINGS_ARE_EQUAL(second_dereference->operator.lexeme, "*");
-                    ASSERT_ENUM_VALUES_ARE_EQUAL(second_dereference->operand->kind, AST_EXPRESSION_IDENTIFIER);
-                    ASSERT_STRINGS_ARE_EQUAL(second_dereference->operand->identifier.token.lexeme, "arg");
+                    ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(second_dereference->operand)->kind, AST_EXPRESSION_IDENTIFIER);
+                    ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(second_dereference->operand)->identifier.token.lexeme, "arg");
                 }
 
-                const Ast_Expression* rhs = binary_expression->rhs;
+                const Ast_Expression* rhs = AST_EXPRESSION(binary_expression->rhs);
                 ASSERT_ENUM_VALUES_ARE_EQUAL(rhs->kind, AST_EXPRESSION_NUMBER);
                 ASSERT_STRINGS_ARE_EQUAL(rhs->number.token.lexeme, "2");
                 ASSERT_FALSE(rhs->number.is_a_floating_point_number);
@@ -2847,8 +2853,8 @@ test_expressions(Test_Context* test_context)
             ASSERT_EQUAL(function_definition->body.statements_count, 1);
 
             const Ast_Statement* statement = &function_definition->body.statements[0];
-            ASSERT_EQUAL(statement->start_location.line, 1);
-            ASSERT_EQUAL(statement->start_location.column, 4);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 1);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_VARIABLE_DEFINITION);
 
@@ -2858,12 +2864,12 @@ test_expressions(Test_Context* test_context)
             ASSERT_FALSE(definition->type->is_mutable);
             ASSERT_LOCATION_STRINGS_ARE_EQUAL(&definition->type->location, "");
             ASSERT_TRUE(definition->has_initial_value);
-            ASSERT_ENUM_VALUES_ARE_EQUAL(definition->initial_value.kind, AST_EXPRESSION_ADDRESS_OF);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(definition->initial_value)->kind, AST_EXPRESSION_ADDRESS_OF);
 
-            const Ast_Unary_Expression* unary_expression = &definition->initial_value.unary_expression;
+            const Ast_Unary_Expression* unary_expression = &AST_EXPRESSION(definition->initial_value)->unary_expression;
             ASSERT_STRINGS_ARE_EQUAL(unary_expression->operator.lexeme, "&");
-            ASSERT_ENUM_VALUES_ARE_EQUAL(unary_expression->operand->kind, AST_EXPRESSION_IDENTIFIER);
-            ASSERT_STRINGS_ARE_EQUAL(unary_expression->operand->identifier.token.lexeme, "arg");
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(unary_expression->operand)->kind, AST_EXPRESSION_IDENTIFIER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(unary_expression->operand)->identifier.token.lexeme, "arg");
 
             destroy_parser(&parser);
             destroy_lexer(&lexer);
@@ -2915,8 +2921,8 @@ test_expressions(Test_Context* test_context)
             ASSERT_EQUAL(function_definition->body.statements_count, 1);
 
             const Ast_Statement* statement = &function_definition->body.statements[0];
-            ASSERT_EQUAL(statement->start_location.line, 1);
-            ASSERT_EQUAL(statement->start_location.column, 4);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 1);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_VARIABLE_DEFINITION);
 
@@ -2926,27 +2932,27 @@ test_expressions(Test_Context* test_context)
             ASSERT_FALSE(definition->type->is_mutable);
             ASSERT_LOCATION_STRINGS_ARE_EQUAL(&definition->type->location, "");
             ASSERT_TRUE(definition->has_initial_value);
-            ASSERT_ENUM_VALUES_ARE_EQUAL(definition->initial_value.kind, AST_EXPRESSION_MULTIPLY);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(definition->initial_value)->kind, AST_EXPRESSION_MULTIPLY);
 
             {
-                const Ast_Binary_Expression* binary_expression = &definition->initial_value.binary_expression;
+                const Ast_Binary_Expression* binary_expression = &AST_EXPRESSION(definition->initial_value)->binary_expression;
 
                 ASSERT_STRINGS_ARE_EQUAL(binary_expression->operator.lexeme, "*");
 
-                const Ast_Expression* lhs = binary_expression->lhs;
+                const Ast_Expression* lhs = AST_EXPRESSION(binary_expression->lhs);
                 ASSERT_ENUM_VALUES_ARE_EQUAL(lhs->kind, AST_EXPRESSION_DEREFERENCE);
                 {
                     const Ast_Unary_Expression* dereference = &lhs->unary_expression;
                     ASSERT_STRINGS_ARE_EQUAL(dereference->operator.lexeme, "*");
-                    ASSERT_ENUM_VALUES_ARE_EQUAL(dereference->operand->kind, AST_EXPRESSION_ADDRESS_OF);
+                    ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(dereference->operand)->kind, AST_EXPRESSION_ADDRESS_OF);
 
-                    const Ast_Unary_Expression* address_of = &dereference->operand->unary_expression;
+                    const Ast_Unary_Expression* address_of = &AST_EXPRESSION(dereference->operand)->unary_expression;
                     ASSERT_STRINGS_ARE_EQUAL(address_of->operator.lexeme, "&");
-                    ASSERT_ENUM_VALUES_ARE_EQUAL(address_of->operand->kind, AST_EXPRESSION_IDENTIFIER);
-                    ASSERT_STRINGS_ARE_EQUAL(address_of->operand->identifier.token.lexeme, "arg");
+                    ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(address_of->operand)->kind, AST_EXPRESSION_IDENTIFIER);
+                    ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(address_of->operand)->identifier.token.lexeme, "arg");
                 }
 
-                const Ast_Expression* rhs = binary_expression->rhs;
+                const Ast_Expression* rhs = AST_EXPRESSION(binary_expression->rhs);
                 ASSERT_ENUM_VALUES_ARE_EQUAL(rhs->kind, AST_EXPRESSION_NUMBER);
                 ASSERT_STRINGS_ARE_EQUAL(rhs->number.token.lexeme, "2");
                 ASSERT_FALSE(rhs->number.is_a_floating_point_number);
@@ -2998,8 +3004,8 @@ test_operator_precedence(Test_Context* test_context)
         ASSERT_EQUAL(function_definition->body.statements_count, 1);
 
         const Ast_Statement* statement = &function_definition->body.statements[0];
-        ASSERT_EQUAL(statement->start_location.line, 1);
-        ASSERT_EQUAL(statement->start_location.column, 4);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 1);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
         ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_VARIABLE_DEFINITION);
 
@@ -3009,28 +3015,28 @@ test_operator_precedence(Test_Context* test_context)
         ASSERT_FALSE(definition->type->is_mutable);
         ASSERT_LOCATION_STRINGS_ARE_EQUAL(&definition->type->location, "");
         ASSERT_TRUE(definition->has_initial_value);
-        ASSERT_ENUM_VALUES_ARE_EQUAL(definition->initial_value.kind, AST_EXPRESSION_ADD);
-        ASSERT_STRINGS_ARE_EQUAL(definition->initial_value.binary_expression.operator.lexeme, "+");
+        ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(definition->initial_value)->kind, AST_EXPRESSION_ADD);
+        ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(definition->initial_value)->binary_expression.operator.lexeme, "+");
 
         {
-            const Ast_Expression* lhs = definition->initial_value.binary_expression.lhs;
+            const Ast_Expression* lhs = AST_EXPRESSION(AST_EXPRESSION(definition->initial_value)->binary_expression.lhs);
             ASSERT_ENUM_VALUES_ARE_EQUAL(lhs->kind, AST_EXPRESSION_NUMBER);
             ASSERT_STRINGS_ARE_EQUAL(lhs->number.token.lexeme, "1");
             ASSERT_FALSE(lhs->number.is_a_floating_point_number);
         }
 
         {
-            const Ast_Expression* rhs = definition->initial_value.binary_expression.rhs;
+            const Ast_Expression* rhs = AST_EXPRESSION(AST_EXPRESSION(definition->initial_value)->binary_expression.rhs);
             ASSERT_ENUM_VALUES_ARE_EQUAL(rhs->kind, AST_EXPRESSION_MULTIPLY);
             ASSERT_STRINGS_ARE_EQUAL(rhs->binary_expression.operator.lexeme, "*");
 
-            ASSERT_ENUM_VALUES_ARE_EQUAL(rhs->binary_expression.lhs->kind, AST_EXPRESSION_NUMBER);
-            ASSERT_STRINGS_ARE_EQUAL(rhs->binary_expression.lhs->number.token.lexeme, "2");
-            ASSERT_FALSE(rhs->binary_expression.lhs->number.is_a_floating_point_number);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(rhs->binary_expression.lhs)->kind, AST_EXPRESSION_NUMBER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(rhs->binary_expression.lhs)->number.token.lexeme, "2");
+            ASSERT_FALSE(AST_EXPRESSION(rhs->binary_expression.lhs)->number.is_a_floating_point_number);
 
-            ASSERT_ENUM_VALUES_ARE_EQUAL(rhs->binary_expression.rhs->kind, AST_EXPRESSION_NUMBER);
-            ASSERT_STRINGS_ARE_EQUAL(rhs->binary_expression.rhs->number.token.lexeme, "3");
-            ASSERT_FALSE(rhs->binary_expression.rhs->number.is_a_floating_point_number);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(rhs->binary_expression.rhs)->kind, AST_EXPRESSION_NUMBER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(rhs->binary_expression.rhs)->number.token.lexeme, "3");
+            ASSERT_FALSE(AST_EXPRESSION(rhs->binary_expression.rhs)->number.is_a_floating_point_number);
         }
 
         destroy_parser(&parser);
@@ -3074,8 +3080,8 @@ test_operator_precedence(Test_Context* test_context)
         ASSERT_EQUAL(function_definition->body.statements_count, 1);
 
         const Ast_Statement* statement = &function_definition->body.statements[0];
-        ASSERT_EQUAL(statement->start_location.line, 1);
-        ASSERT_EQUAL(statement->start_location.column, 4);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 1);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
         ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_VARIABLE_DEFINITION);
 
@@ -3086,25 +3092,25 @@ test_operator_precedence(Test_Context* test_context)
         ASSERT_LOCATION_STRINGS_ARE_EQUAL(&definition->type->location, "");
         ASSERT_TRUE(definition->has_initial_value);
 
-        ASSERT_ENUM_VALUES_ARE_EQUAL(definition->initial_value.kind, AST_EXPRESSION_MULTIPLY);
-        ASSERT_STRINGS_ARE_EQUAL(definition->initial_value.binary_expression.operator.lexeme, "*");
+        ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(definition->initial_value)->kind, AST_EXPRESSION_MULTIPLY);
+        ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(definition->initial_value)->binary_expression.operator.lexeme, "*");
 
         {
-            const Ast_Expression* lhs = definition->initial_value.binary_expression.lhs;
+            const Ast_Expression* lhs = AST_EXPRESSION(AST_EXPRESSION(definition->initial_value)->binary_expression.lhs);
             ASSERT_ENUM_VALUES_ARE_EQUAL(lhs->kind, AST_EXPRESSION_ADD);
             ASSERT_STRINGS_ARE_EQUAL(lhs->binary_expression.operator.lexeme, "+");
 
-            ASSERT_ENUM_VALUES_ARE_EQUAL(lhs->binary_expression.lhs->kind, AST_EXPRESSION_NUMBER);
-            ASSERT_STRINGS_ARE_EQUAL(lhs->binary_expression.lhs->number.token.lexeme, "1");
-            ASSERT_FALSE(lhs->binary_expression.lhs->number.is_a_floating_point_number);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(lhs->binary_expression.lhs)->kind, AST_EXPRESSION_NUMBER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(lhs->binary_expression.lhs)->number.token.lexeme, "1");
+            ASSERT_FALSE(AST_EXPRESSION(lhs->binary_expression.lhs)->number.is_a_floating_point_number);
 
-            ASSERT_ENUM_VALUES_ARE_EQUAL(lhs->binary_expression.rhs->kind, AST_EXPRESSION_NUMBER);
-            ASSERT_STRINGS_ARE_EQUAL(lhs->binary_expression.rhs->number.token.lexeme, "2");
-            ASSERT_FALSE(lhs->binary_expression.rhs->number.is_a_floating_point_number);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(lhs->binary_expression.rhs)->kind, AST_EXPRESSION_NUMBER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(lhs->binary_expression.rhs)->number.token.lexeme, "2");
+            ASSERT_FALSE(AST_EXPRESSION(lhs->binary_expression.rhs)->number.is_a_floating_point_number);
         }
 
         {
-            const Ast_Expression* rhs = definition->initial_value.binary_expression.rhs;
+            const Ast_Expression* rhs = AST_EXPRESSION(AST_EXPRESSION(definition->initial_value)->binary_expression.rhs);
             ASSERT_ENUM_VALUES_ARE_EQUAL(rhs->kind, AST_EXPRESSION_NUMBER);
             ASSERT_STRINGS_ARE_EQUAL(rhs->number.token.lexeme, "3");
             ASSERT_FALSE(rhs->number.is_a_floating_point_number);
@@ -3151,8 +3157,8 @@ test_operator_precedence(Test_Context* test_context)
         ASSERT_EQUAL(function_definition->body.statements_count, 1);
 
         const Ast_Statement* statement = &function_definition->body.statements[0];
-        ASSERT_EQUAL(statement->start_location.line, 1);
-        ASSERT_EQUAL(statement->start_location.column, 4);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 1);
+        ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
         ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_VARIABLE_DEFINITION);
 
@@ -3162,22 +3168,22 @@ test_operator_precedence(Test_Context* test_context)
         ASSERT_FALSE(definition->type->is_mutable);
         ASSERT_LOCATION_STRINGS_ARE_EQUAL(&definition->type->location, "");
         ASSERT_TRUE(definition->has_initial_value);
-        ASSERT_ENUM_VALUES_ARE_EQUAL(definition->initial_value.kind, AST_EXPRESSION_ADD);
-        ASSERT_STRINGS_ARE_EQUAL(definition->initial_value.binary_expression.operator.lexeme, "+");
+        ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(definition->initial_value)->kind, AST_EXPRESSION_ADD);
+        ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(definition->initial_value)->binary_expression.operator.lexeme, "+");
 
         {
-            const Ast_Expression* lhs = definition->initial_value.binary_expression.lhs;
+            const Ast_Expression* lhs = AST_EXPRESSION(AST_EXPRESSION(definition->initial_value)->binary_expression.lhs);
             ASSERT_ENUM_VALUES_ARE_EQUAL(lhs->kind, AST_EXPRESSION_NUMBER);
             ASSERT_STRINGS_ARE_EQUAL(lhs->number.token.lexeme, "3");
             ASSERT_FALSE(lhs->number.is_a_floating_point_number);
         }
 
         {
-            const Ast_Expression* rhs = definition->initial_value.binary_expression.rhs;
+            const Ast_Expression* rhs = AST_EXPRESSION(AST_EXPRESSION(definition->initial_value)->binary_expression.rhs);
             ASSERT_ENUM_VALUES_ARE_EQUAL(rhs->kind, AST_EXPRESSION_CALL);
 
             const Ast_Call* call = &rhs->call;
-            const Ast_Expression* called_expression = call->called_expression;
+            const Ast_Expression* called_expression = AST_EXPRESSION(call->called_expression);
             ASSERT_ENUM_VALUES_ARE_EQUAL(called_expression->kind, AST_EXPRESSION_IDENTIFIER);
             ASSERT_STRINGS_ARE_EQUAL(called_expression->identifier.token.lexeme, "bar");
             ASSERT_EQUAL(call->arguments_count, 0);
@@ -3187,6 +3193,57 @@ test_operator_precedence(Test_Context* test_context)
         destroy_lexer(&lexer);
         destroy_compilation_context(&context);
     }
+
+    {
+        // NOTE(vlad): Binary operators are right-associative and every operand of a chain
+        //             spans its own tokens.
+        CREATE_TEST_COMPILATION_CONTEXT_FOR_CODE("foo: () -> void = {\n"
+                                                 "    var := a < b - c - d * e / f == g;\n"
+                                                 "}");
+
+        Lexer lexer = {0};
+        Parser parser = {0};
+
+        create_lexer(&lexer, &context);
+        create_parser(&parser, &lexer, &context);
+
+        ASSERT_TRUE(parse_ast(&parser));
+        ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
+
+        const Ast_Statement* statement = &context.ast.function_definitions[0].body.statements[0];
+        ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_VARIABLE_DEFINITION);
+
+        const Ast_Expression* less = AST_EXPRESSION(statement->variable_definition.initial_value);
+        ASSERT_ENUM_VALUES_ARE_EQUAL(less->kind, AST_EXPRESSION_LESS);
+        ASSERT_LOCATION_STRINGS_ARE_EQUAL(&less->location, "a < b - c - d * e / f == g");
+        ASSERT_LOCATION_STRINGS_ARE_EQUAL(&AST_EXPRESSION(less->binary_expression.lhs)->location, "a");
+
+        const Ast_Expression* equal = AST_EXPRESSION(less->binary_expression.rhs);
+        ASSERT_ENUM_VALUES_ARE_EQUAL(equal->kind, AST_EXPRESSION_EQUAL);
+        ASSERT_LOCATION_STRINGS_ARE_EQUAL(&equal->location, "b - c - d * e / f == g");
+        ASSERT_LOCATION_STRINGS_ARE_EQUAL(&AST_EXPRESSION(equal->binary_expression.rhs)->location, "g");
+
+        const Ast_Expression* outer_subtraction = AST_EXPRESSION(equal->binary_expression.lhs);
+        ASSERT_ENUM_VALUES_ARE_EQUAL(outer_subtraction->kind, AST_EXPRESSION_SUBTRACT);
+        ASSERT_LOCATION_STRINGS_ARE_EQUAL(&outer_subtraction->location, "b - c - d * e / f");
+        ASSERT_LOCATION_STRINGS_ARE_EQUAL(&AST_EXPRESSION(outer_subtraction->binary_expression.lhs)->location, "b");
+
+        const Ast_Expression* inner_subtraction = AST_EXPRESSION(outer_subtraction->binary_expression.rhs);
+        ASSERT_ENUM_VALUES_ARE_EQUAL(inner_subtraction->kind, AST_EXPRESSION_SUBTRACT);
+        ASSERT_LOCATION_STRINGS_ARE_EQUAL(&inner_subtraction->location, "c - d * e / f");
+
+        const Ast_Expression* multiplication = AST_EXPRESSION(inner_subtraction->binary_expression.rhs);
+        ASSERT_ENUM_VALUES_ARE_EQUAL(multiplication->kind, AST_EXPRESSION_MULTIPLY);
+        ASSERT_LOCATION_STRINGS_ARE_EQUAL(&multiplication->location, "d * e / f");
+
+        const Ast_Expression* division = AST_EXPRESSION(multiplication->binary_expression.rhs);
+        ASSERT_ENUM_VALUES_ARE_EQUAL(division->kind, AST_EXPRESSION_DIVIDE);
+        ASSERT_LOCATION_STRINGS_ARE_EQUAL(&division->location, "e / f");
+
+        destroy_parser(&parser);
+        destroy_lexer(&lexer);
+        destroy_compilation_context(&context);
+    }
 }
 
 internal void
@@ -3230,8 +3287,8 @@ test_assignments(Test_Context* test_context)
 
         {
             const Ast_Statement* statement = &function_definition->body.statements[0];
-            ASSERT_EQUAL(statement->start_location.line, 1);
-            ASSERT_EQUAL(statement->start_location.column, 4);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 1);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_VARIABLE_DEFINITION);
 
@@ -3241,26 +3298,26 @@ test_assignments(Test_Context* test_context)
             ASSERT_FALSE(definition->type->is_mutable);
             ASSERT_LOCATION_STRINGS_ARE_EQUAL(&definition->type->location, "");
             ASSERT_TRUE(definition->has_initial_value);
-            ASSERT_ENUM_VALUES_ARE_EQUAL(definition->initial_value.kind, AST_EXPRESSION_NUMBER);
-            ASSERT_STRINGS_ARE_EQUAL(definition->initial_value.number.token.lexeme, "1");
-            ASSERT_FALSE(definition->initial_value.number.is_a_floating_point_number);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(definition->initial_value)->kind, AST_EXPRESSION_NUMBER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(definition->initial_value)->number.token.lexeme, "1");
+            ASSERT_FALSE(AST_EXPRESSION(definition->initial_value)->number.is_a_floating_point_number);
         }
 
         {
             const Ast_Statement* statement = &function_definition->body.statements[1];
-            ASSERT_EQUAL(statement->start_location.line, 2);
-            ASSERT_EQUAL(statement->start_location.column, 4);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 2);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_ASSIGNMENT);
 
             const Ast_Assignment* assignment = &statement->assignment;
 
-            ASSERT_ENUM_VALUES_ARE_EQUAL(assignment->lhs.kind, AST_EXPRESSION_IDENTIFIER);
-            ASSERT_STRINGS_ARE_EQUAL(assignment->lhs.identifier.token.lexeme, "var");
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(assignment->lhs)->kind, AST_EXPRESSION_IDENTIFIER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(assignment->lhs)->identifier.token.lexeme, "var");
 
-            ASSERT_ENUM_VALUES_ARE_EQUAL(assignment->rhs.kind, AST_EXPRESSION_NUMBER);
-            ASSERT_STRINGS_ARE_EQUAL(assignment->rhs.number.token.lexeme, "2");
-            ASSERT_FALSE(assignment->rhs.number.is_a_floating_point_number);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(assignment->rhs)->kind, AST_EXPRESSION_NUMBER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(assignment->rhs)->number.token.lexeme, "2");
+            ASSERT_FALSE(AST_EXPRESSION(assignment->rhs)->number.is_a_floating_point_number);
         }
 
         destroy_parser(&parser);
@@ -3306,8 +3363,8 @@ test_assignments(Test_Context* test_context)
 
         {
             const Ast_Statement* statement = &function_definition->body.statements[0];
-            ASSERT_EQUAL(statement->start_location.line, 1);
-            ASSERT_EQUAL(statement->start_location.column, 4);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 1);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_VARIABLE_DEFINITION);
 
@@ -3317,34 +3374,34 @@ test_assignments(Test_Context* test_context)
             ASSERT_FALSE(definition->type->is_mutable);
             ASSERT_LOCATION_STRINGS_ARE_EQUAL(&definition->type->location, "");
             ASSERT_TRUE(definition->has_initial_value);
-            ASSERT_ENUM_VALUES_ARE_EQUAL(definition->initial_value.kind, AST_EXPRESSION_NUMBER);
-            ASSERT_STRINGS_ARE_EQUAL(definition->initial_value.number.token.lexeme, "1");
-            ASSERT_FALSE(definition->initial_value.number.is_a_floating_point_number);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(definition->initial_value)->kind, AST_EXPRESSION_NUMBER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(definition->initial_value)->number.token.lexeme, "1");
+            ASSERT_FALSE(AST_EXPRESSION(definition->initial_value)->number.is_a_floating_point_number);
         }
 
         {
             const Ast_Statement* statement = &function_definition->body.statements[1];
-            ASSERT_EQUAL(statement->start_location.line, 2);
-            ASSERT_EQUAL(statement->start_location.column, 4);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 2);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_ASSIGNMENT);
 
             const Ast_Assignment* assignment = &statement->assignment;
 
-            ASSERT_ENUM_VALUES_ARE_EQUAL(assignment->lhs.kind, AST_EXPRESSION_IDENTIFIER);
-            ASSERT_STRINGS_ARE_EQUAL(assignment->lhs.identifier.token.lexeme, "var");
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(assignment->lhs)->kind, AST_EXPRESSION_IDENTIFIER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(assignment->lhs)->identifier.token.lexeme, "var");
 
-            ASSERT_ENUM_VALUES_ARE_EQUAL(assignment->rhs.kind, AST_EXPRESSION_ADD);
-            ASSERT_STRINGS_ARE_EQUAL(assignment->rhs.binary_expression.operator.lexeme, "+");
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(assignment->rhs)->kind, AST_EXPRESSION_ADD);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(assignment->rhs)->binary_expression.operator.lexeme, "+");
 
             {
-                const Ast_Expression* lhs = assignment->rhs.binary_expression.lhs;
+                const Ast_Expression* lhs = AST_EXPRESSION(AST_EXPRESSION(assignment->rhs)->binary_expression.lhs);
                 ASSERT_ENUM_VALUES_ARE_EQUAL(lhs->kind, AST_EXPRESSION_IDENTIFIER);
                 ASSERT_STRINGS_ARE_EQUAL(lhs->identifier.token.lexeme, "var");
             }
 
             {
-                const Ast_Expression* rhs = assignment->rhs.binary_expression.rhs;
+                const Ast_Expression* rhs = AST_EXPRESSION(AST_EXPRESSION(assignment->rhs)->binary_expression.rhs);
                 ASSERT_ENUM_VALUES_ARE_EQUAL(rhs->kind, AST_EXPRESSION_NUMBER);
                 ASSERT_STRINGS_ARE_EQUAL(rhs->number.token.lexeme, "1");
                 ASSERT_FALSE(rhs->number.is_a_floating_point_number);
@@ -3409,32 +3466,32 @@ test_assignments(Test_Context* test_context)
 
         {
             const Ast_Statement* statement = &function_definition->body.statements[0];
-            ASSERT_EQUAL(statement->start_location.line, 1);
-            ASSERT_EQUAL(statement->start_location.column, 4);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 1);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_ASSIGNMENT);
 
             const Ast_Assignment* assignment = &statement->assignment;
 
             {
-                ASSERT_ENUM_VALUES_ARE_EQUAL(assignment->lhs.kind, AST_EXPRESSION_DEREFERENCE);
-                ASSERT_LOCATION_STRINGS_ARE_EQUAL(&assignment->lhs.location, "parameter*");
+                ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(assignment->lhs)->kind, AST_EXPRESSION_DEREFERENCE);
+                ASSERT_LOCATION_STRINGS_ARE_EQUAL(&AST_EXPRESSION(assignment->lhs)->location, "parameter*");
 
-                const Ast_Unary_Expression* dereference = &assignment->lhs.unary_expression;
+                const Ast_Unary_Expression* dereference = &AST_EXPRESSION(assignment->lhs)->unary_expression;
                 ASSERT_STRINGS_ARE_EQUAL(dereference->operator.lexeme, "*");
 
-                ASSERT_ENUM_VALUES_ARE_EQUAL(dereference->operand->kind, AST_EXPRESSION_IDENTIFIER);
-                ASSERT_LOCATION_STRINGS_ARE_EQUAL(&dereference->operand->location, "parameter");
+                ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(dereference->operand)->kind, AST_EXPRESSION_IDENTIFIER);
+                ASSERT_LOCATION_STRINGS_ARE_EQUAL(&AST_EXPRESSION(dereference->operand)->location, "parameter");
 
-                ASSERT_STRINGS_ARE_EQUAL(dereference->operand->identifier.token.lexeme, "parameter");
-                ASSERT_LOCATION_STRINGS_ARE_EQUAL(&dereference->operand->identifier.token.location, "parameter");
+                ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(dereference->operand)->identifier.token.lexeme, "parameter");
+                ASSERT_LOCATION_STRINGS_ARE_EQUAL(&AST_EXPRESSION(dereference->operand)->identifier.token.location, "parameter");
             }
 
             {
-                ASSERT_ENUM_VALUES_ARE_EQUAL(assignment->rhs.kind, AST_EXPRESSION_NUMBER);
-                ASSERT_LOCATION_STRINGS_ARE_EQUAL(&assignment->rhs.location, "10");
+                ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(assignment->rhs)->kind, AST_EXPRESSION_NUMBER);
+                ASSERT_LOCATION_STRINGS_ARE_EQUAL(&AST_EXPRESSION(assignment->rhs)->location, "10");
 
-                const Ast_Number* number = &assignment->rhs.number;
+                const Ast_Number* number = &AST_EXPRESSION(assignment->rhs)->number;
                 ASSERT_STRINGS_ARE_EQUAL(number->token.lexeme, "10");
                 ASSERT_FALSE(number->is_a_floating_point_number);
             }
@@ -3484,27 +3541,27 @@ test_assignments(Test_Context* test_context)
 
         {
             const Ast_Statement* statement = &function_definition->body.statements[0];
-            ASSERT_EQUAL(statement->start_location.line, 1);
-            ASSERT_EQUAL(statement->start_location.column, 4);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 1);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_ASSIGNMENT);
 
             const Ast_Assignment* assignment = &statement->assignment;
 
             {
-                ASSERT_ENUM_VALUES_ARE_EQUAL(assignment->lhs.kind, AST_EXPRESSION_NUMBER);
-                ASSERT_LOCATION_STRINGS_ARE_EQUAL(&assignment->lhs.location, "10");
+                ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(assignment->lhs)->kind, AST_EXPRESSION_NUMBER);
+                ASSERT_LOCATION_STRINGS_ARE_EQUAL(&AST_EXPRESSION(assignment->lhs)->location, "10");
 
-                const Ast_Number* number = &assignment->lhs.number;
+                const Ast_Number* number = &AST_EXPRESSION(assignment->lhs)->number;
                 ASSERT_STRINGS_ARE_EQUAL(number->token.lexeme, "10");
                 ASSERT_FALSE(number->is_a_floating_point_number);
             }
 
             {
-                ASSERT_ENUM_VALUES_ARE_EQUAL(assignment->rhs.kind, AST_EXPRESSION_NUMBER);
-                ASSERT_LOCATION_STRINGS_ARE_EQUAL(&assignment->rhs.location, "10");
+                ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(assignment->rhs)->kind, AST_EXPRESSION_NUMBER);
+                ASSERT_LOCATION_STRINGS_ARE_EQUAL(&AST_EXPRESSION(assignment->rhs)->location, "10");
 
-                const Ast_Number* number = &assignment->rhs.number;
+                const Ast_Number* number = &AST_EXPRESSION(assignment->rhs)->number;
                 ASSERT_STRINGS_ARE_EQUAL(number->token.lexeme, "10");
                 ASSERT_FALSE(number->is_a_floating_point_number);
             }
@@ -3560,8 +3617,8 @@ test_while_statements(Test_Context* test_context)
 
         {
             const Ast_Statement* statement = &function_definition->body.statements[0];
-            ASSERT_EQUAL(statement->start_location.line, 1);
-            ASSERT_EQUAL(statement->start_location.column, 4);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 1);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_VARIABLE_DEFINITION);
 
@@ -3571,51 +3628,51 @@ test_while_statements(Test_Context* test_context)
             ASSERT_FALSE(definition->type->is_mutable);
             ASSERT_LOCATION_STRINGS_ARE_EQUAL(&definition->type->location, "");
             ASSERT_TRUE(definition->has_initial_value);
-            ASSERT_ENUM_VALUES_ARE_EQUAL(definition->initial_value.kind, AST_EXPRESSION_NUMBER);
-            ASSERT_STRINGS_ARE_EQUAL(definition->initial_value.number.token.lexeme, "10");
-            ASSERT_FALSE(definition->initial_value.number.is_a_floating_point_number);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(definition->initial_value)->kind, AST_EXPRESSION_NUMBER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(definition->initial_value)->number.token.lexeme, "10");
+            ASSERT_FALSE(AST_EXPRESSION(definition->initial_value)->number.is_a_floating_point_number);
         }
 
         {
             const Ast_Statement* statement = &function_definition->body.statements[1];
-            ASSERT_EQUAL(statement->start_location.line, 2);
-            ASSERT_EQUAL(statement->start_location.column, 4);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 2);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_WHILE);
 
             const Ast_While_Statement* while_statement = &statement->while_statement;
 
-            const Ast_Expression* condition = &while_statement->condition;
+            const Ast_Expression* condition = AST_EXPRESSION(while_statement->condition);
             ASSERT_ENUM_VALUES_ARE_EQUAL(condition->kind, AST_EXPRESSION_NOT_EQUAL);
             ASSERT_STRINGS_ARE_EQUAL(condition->binary_expression.operator.lexeme, "!=");
 
-            ASSERT_ENUM_VALUES_ARE_EQUAL(condition->binary_expression.lhs->kind, AST_EXPRESSION_IDENTIFIER);
-            ASSERT_STRINGS_ARE_EQUAL(condition->binary_expression.lhs->identifier.token.lexeme, "var");
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(condition->binary_expression.lhs)->kind, AST_EXPRESSION_IDENTIFIER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(condition->binary_expression.lhs)->identifier.token.lexeme, "var");
 
-            ASSERT_ENUM_VALUES_ARE_EQUAL(condition->binary_expression.rhs->kind, AST_EXPRESSION_NUMBER);
-            ASSERT_STRINGS_ARE_EQUAL(condition->binary_expression.rhs->number.token.lexeme, "0");
-            ASSERT_FALSE(condition->binary_expression.rhs->number.is_a_floating_point_number);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(condition->binary_expression.rhs)->kind, AST_EXPRESSION_NUMBER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(condition->binary_expression.rhs)->number.token.lexeme, "0");
+            ASSERT_FALSE(AST_EXPRESSION(condition->binary_expression.rhs)->number.is_a_floating_point_number);
 
             ASSERT_EQUAL(while_statement->body.statements_count, 1);
 
             const Ast_Statement* inner_statement = &while_statement->body.statements[0];
-            ASSERT_EQUAL(inner_statement->start_location.line, 4);
-            ASSERT_EQUAL(inner_statement->start_location.column, 8);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, inner_statement->start_location).line, 4);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, inner_statement->start_location).column, 8);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(inner_statement->kind, AST_STATEMENT_ASSIGNMENT);
 
             const Ast_Assignment* assignment = &inner_statement->assignment;
 
-            ASSERT_ENUM_VALUES_ARE_EQUAL(assignment->lhs.kind, AST_EXPRESSION_IDENTIFIER);
-            ASSERT_STRINGS_ARE_EQUAL(assignment->lhs.identifier.token.lexeme, "var");
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(assignment->lhs)->kind, AST_EXPRESSION_IDENTIFIER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(assignment->lhs)->identifier.token.lexeme, "var");
 
-            ASSERT_ENUM_VALUES_ARE_EQUAL(assignment->rhs.kind, AST_EXPRESSION_SUBTRACT);
-            ASSERT_ENUM_VALUES_ARE_EQUAL(assignment->rhs.binary_expression.lhs->kind, AST_EXPRESSION_IDENTIFIER);
-            ASSERT_STRINGS_ARE_EQUAL(assignment->rhs.binary_expression.lhs->identifier.token.lexeme, "var");
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(assignment->rhs)->kind, AST_EXPRESSION_SUBTRACT);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(AST_EXPRESSION(assignment->rhs)->binary_expression.lhs)->kind, AST_EXPRESSION_IDENTIFIER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(AST_EXPRESSION(assignment->rhs)->binary_expression.lhs)->identifier.token.lexeme, "var");
 
-            ASSERT_ENUM_VALUES_ARE_EQUAL(assignment->rhs.binary_expression.rhs->kind, AST_EXPRESSION_NUMBER);
-            ASSERT_STRINGS_ARE_EQUAL(assignment->rhs.binary_expression.rhs->number.token.lexeme, "1");
-            ASSERT_FALSE(assignment->rhs.binary_expression.rhs->number.is_a_floating_point_number);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(AST_EXPRESSION(assignment->rhs)->binary_expression.rhs)->kind, AST_EXPRESSION_NUMBER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(AST_EXPRESSION(assignment->rhs)->binary_expression.rhs)->number.token.lexeme, "1");
+            ASSERT_FALSE(AST_EXPRESSION(AST_EXPRESSION(assignment->rhs)->binary_expression.rhs)->number.is_a_floating_point_number);
         }
 
         destroy_parser(&parser);
@@ -3663,30 +3720,30 @@ test_while_statements(Test_Context* test_context)
 
         {
             const Ast_Statement* statement = &function_definition->body.statements[0];
-            ASSERT_EQUAL(statement->start_location.line, 1);
-            ASSERT_EQUAL(statement->start_location.column, 4);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 1);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_WHILE);
 
             const Ast_While_Statement* while_statement = &statement->while_statement;
 
-            const Ast_Expression* condition = &while_statement->condition;
+            const Ast_Expression* condition = AST_EXPRESSION(while_statement->condition);
             ASSERT_ENUM_VALUES_ARE_EQUAL(condition->kind, AST_EXPRESSION_NOT_EQUAL);
             ASSERT_STRINGS_ARE_EQUAL(condition->binary_expression.operator.lexeme, "!=");
 
-            ASSERT_ENUM_VALUES_ARE_EQUAL(condition->binary_expression.lhs->kind, AST_EXPRESSION_NUMBER);
-            ASSERT_STRINGS_ARE_EQUAL(condition->binary_expression.lhs->number.token.lexeme, "1");
-            ASSERT_FALSE(condition->binary_expression.lhs->number.is_a_floating_point_number);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(condition->binary_expression.lhs)->kind, AST_EXPRESSION_NUMBER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(condition->binary_expression.lhs)->number.token.lexeme, "1");
+            ASSERT_FALSE(AST_EXPRESSION(condition->binary_expression.lhs)->number.is_a_floating_point_number);
 
-            ASSERT_ENUM_VALUES_ARE_EQUAL(condition->binary_expression.rhs->kind, AST_EXPRESSION_NUMBER);
-            ASSERT_STRINGS_ARE_EQUAL(condition->binary_expression.rhs->number.token.lexeme, "2");
-            ASSERT_FALSE(condition->binary_expression.rhs->number.is_a_floating_point_number);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(condition->binary_expression.rhs)->kind, AST_EXPRESSION_NUMBER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(condition->binary_expression.rhs)->number.token.lexeme, "2");
+            ASSERT_FALSE(AST_EXPRESSION(condition->binary_expression.rhs)->number.is_a_floating_point_number);
 
             ASSERT_EQUAL(while_statement->body.statements_count, 1);
 
             const Ast_Statement* inner_statement = &while_statement->body.statements[0];
-            ASSERT_EQUAL(inner_statement->start_location.line, 3);
-            ASSERT_EQUAL(inner_statement->start_location.column, 8);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, inner_statement->start_location).line, 3);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, inner_statement->start_location).column, 8);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(inner_statement->kind, AST_STATEMENT_BREAK);
             ASSERT_STRINGS_ARE_EQUAL(inner_statement->jump.token.lexeme, "break");
@@ -3738,30 +3795,30 @@ test_while_statements(Test_Context* test_context)
 
         {
             const Ast_Statement* statement = &function_definition->body.statements[0];
-            ASSERT_EQUAL(statement->start_location.line, 1);
-            ASSERT_EQUAL(statement->start_location.column, 4);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 1);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_WHILE);
 
             const Ast_While_Statement* while_statement = &statement->while_statement;
 
-            const Ast_Expression* condition = &while_statement->condition;
+            const Ast_Expression* condition = AST_EXPRESSION(while_statement->condition);
             ASSERT_ENUM_VALUES_ARE_EQUAL(condition->kind, AST_EXPRESSION_NOT_EQUAL);
             ASSERT_STRINGS_ARE_EQUAL(condition->binary_expression.operator.lexeme, "!=");
 
-            ASSERT_ENUM_VALUES_ARE_EQUAL(condition->binary_expression.lhs->kind, AST_EXPRESSION_NUMBER);
-            ASSERT_STRINGS_ARE_EQUAL(condition->binary_expression.lhs->number.token.lexeme, "1");
-            ASSERT_FALSE(condition->binary_expression.lhs->number.is_a_floating_point_number);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(condition->binary_expression.lhs)->kind, AST_EXPRESSION_NUMBER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(condition->binary_expression.lhs)->number.token.lexeme, "1");
+            ASSERT_FALSE(AST_EXPRESSION(condition->binary_expression.lhs)->number.is_a_floating_point_number);
 
-            ASSERT_ENUM_VALUES_ARE_EQUAL(condition->binary_expression.rhs->kind, AST_EXPRESSION_NUMBER);
-            ASSERT_STRINGS_ARE_EQUAL(condition->binary_expression.rhs->number.token.lexeme, "2");
-            ASSERT_FALSE(condition->binary_expression.rhs->number.is_a_floating_point_number);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(condition->binary_expression.rhs)->kind, AST_EXPRESSION_NUMBER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(condition->binary_expression.rhs)->number.token.lexeme, "2");
+            ASSERT_FALSE(AST_EXPRESSION(condition->binary_expression.rhs)->number.is_a_floating_point_number);
 
             ASSERT_EQUAL(while_statement->body.statements_count, 1);
 
             const Ast_Statement* inner_statement = &while_statement->body.statements[0];
-            ASSERT_EQUAL(inner_statement->start_location.line, 3);
-            ASSERT_EQUAL(inner_statement->start_location.column, 8);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, inner_statement->start_location).line, 3);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, inner_statement->start_location).column, 8);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(inner_statement->kind, AST_STATEMENT_CONTINUE);
             ASSERT_STRINGS_ARE_EQUAL(inner_statement->jump.token.lexeme, "continue");
@@ -3816,31 +3873,31 @@ test_while_statements(Test_Context* test_context)
 
         {
             const Ast_Statement* statement = &function_definition->body.statements[0];
-            ASSERT_EQUAL(statement->start_location.line, 1);
-            ASSERT_EQUAL(statement->start_location.column, 4);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 1);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_WHILE);
 
             const Ast_While_Statement* while_statement = &statement->while_statement;
 
-            const Ast_Expression* condition = &while_statement->condition;
+            const Ast_Expression* condition = AST_EXPRESSION(while_statement->condition);
             ASSERT_ENUM_VALUES_ARE_EQUAL(condition->kind, AST_EXPRESSION_NOT_EQUAL);
             ASSERT_STRINGS_ARE_EQUAL(condition->binary_expression.operator.lexeme, "!=");
 
-            ASSERT_ENUM_VALUES_ARE_EQUAL(condition->binary_expression.lhs->kind, AST_EXPRESSION_NUMBER);
-            ASSERT_STRINGS_ARE_EQUAL(condition->binary_expression.lhs->number.token.lexeme, "1");
-            ASSERT_FALSE(condition->binary_expression.lhs->number.is_a_floating_point_number);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(condition->binary_expression.lhs)->kind, AST_EXPRESSION_NUMBER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(condition->binary_expression.lhs)->number.token.lexeme, "1");
+            ASSERT_FALSE(AST_EXPRESSION(condition->binary_expression.lhs)->number.is_a_floating_point_number);
 
-            ASSERT_ENUM_VALUES_ARE_EQUAL(condition->binary_expression.rhs->kind, AST_EXPRESSION_NUMBER);
-            ASSERT_STRINGS_ARE_EQUAL(condition->binary_expression.rhs->number.token.lexeme, "2");
-            ASSERT_FALSE(condition->binary_expression.rhs->number.is_a_floating_point_number);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(condition->binary_expression.rhs)->kind, AST_EXPRESSION_NUMBER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(condition->binary_expression.rhs)->number.token.lexeme, "2");
+            ASSERT_FALSE(AST_EXPRESSION(condition->binary_expression.rhs)->number.is_a_floating_point_number);
 
             ASSERT_EQUAL(while_statement->body.statements_count, 4);
 
             {
                 const Ast_Statement* inner_statement = &while_statement->body.statements[0];
-                ASSERT_EQUAL(inner_statement->start_location.line, 3);
-                ASSERT_EQUAL(inner_statement->start_location.column, 8);
+                ASSERT_EQUAL(resolve_source_location(&context.source_file, inner_statement->start_location).line, 3);
+                ASSERT_EQUAL(resolve_source_location(&context.source_file, inner_statement->start_location).column, 8);
 
                 ASSERT_ENUM_VALUES_ARE_EQUAL(inner_statement->kind, AST_STATEMENT_BREAK);
                 ASSERT_STRINGS_ARE_EQUAL(inner_statement->jump.token.lexeme, "break");
@@ -3849,8 +3906,8 @@ test_while_statements(Test_Context* test_context)
 
             {
                 const Ast_Statement* inner_statement = &while_statement->body.statements[1];
-                ASSERT_EQUAL(inner_statement->start_location.line, 4);
-                ASSERT_EQUAL(inner_statement->start_location.column, 8);
+                ASSERT_EQUAL(resolve_source_location(&context.source_file, inner_statement->start_location).line, 4);
+                ASSERT_EQUAL(resolve_source_location(&context.source_file, inner_statement->start_location).column, 8);
 
                 ASSERT_ENUM_VALUES_ARE_EQUAL(inner_statement->kind, AST_STATEMENT_BREAK);
                 ASSERT_STRINGS_ARE_EQUAL(inner_statement->jump.token.lexeme, "break");
@@ -3859,8 +3916,8 @@ test_while_statements(Test_Context* test_context)
 
             {
                 const Ast_Statement* inner_statement = &while_statement->body.statements[2];
-                ASSERT_EQUAL(inner_statement->start_location.line, 5);
-                ASSERT_EQUAL(inner_statement->start_location.column, 8);
+                ASSERT_EQUAL(resolve_source_location(&context.source_file, inner_statement->start_location).line, 5);
+                ASSERT_EQUAL(resolve_source_location(&context.source_file, inner_statement->start_location).column, 8);
 
                 ASSERT_ENUM_VALUES_ARE_EQUAL(inner_statement->kind, AST_STATEMENT_BREAK);
                 ASSERT_STRINGS_ARE_EQUAL(inner_statement->jump.token.lexeme, "break");
@@ -3869,8 +3926,8 @@ test_while_statements(Test_Context* test_context)
 
             {
                 const Ast_Statement* inner_statement = &while_statement->body.statements[3];
-                ASSERT_EQUAL(inner_statement->start_location.line, 6);
-                ASSERT_EQUAL(inner_statement->start_location.column, 8);
+                ASSERT_EQUAL(resolve_source_location(&context.source_file, inner_statement->start_location).line, 6);
+                ASSERT_EQUAL(resolve_source_location(&context.source_file, inner_statement->start_location).column, 8);
 
                 ASSERT_ENUM_VALUES_ARE_EQUAL(inner_statement->kind, AST_STATEMENT_BREAK);
                 ASSERT_STRINGS_ARE_EQUAL(inner_statement->jump.token.lexeme, "break");
@@ -3926,31 +3983,31 @@ test_while_statements(Test_Context* test_context)
 
         {
             const Ast_Statement* statement = &function_definition->body.statements[0];
-            ASSERT_EQUAL(statement->start_location.line, 1);
-            ASSERT_EQUAL(statement->start_location.column, 4);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 1);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_WHILE);
 
             const Ast_While_Statement* while_statement = &statement->while_statement;
 
-            const Ast_Expression* condition = &while_statement->condition;
+            const Ast_Expression* condition = AST_EXPRESSION(while_statement->condition);
             ASSERT_ENUM_VALUES_ARE_EQUAL(condition->kind, AST_EXPRESSION_NOT_EQUAL);
             ASSERT_STRINGS_ARE_EQUAL(condition->binary_expression.operator.lexeme, "!=");
 
-            ASSERT_ENUM_VALUES_ARE_EQUAL(condition->binary_expression.lhs->kind, AST_EXPRESSION_NUMBER);
-            ASSERT_STRINGS_ARE_EQUAL(condition->binary_expression.lhs->number.token.lexeme, "1");
-            ASSERT_FALSE(condition->binary_expression.lhs->number.is_a_floating_point_number);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(condition->binary_expression.lhs)->kind, AST_EXPRESSION_NUMBER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(condition->binary_expression.lhs)->number.token.lexeme, "1");
+            ASSERT_FALSE(AST_EXPRESSION(condition->binary_expression.lhs)->number.is_a_floating_point_number);
 
-            ASSERT_ENUM_VALUES_ARE_EQUAL(condition->binary_expression.rhs->kind, AST_EXPRESSION_NUMBER);
-            ASSERT_STRINGS_ARE_EQUAL(condition->binary_expression.rhs->number.token.lexeme, "2");
-            ASSERT_FALSE(condition->binary_expression.rhs->number.is_a_floating_point_number);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(condition->binary_expression.rhs)->kind, AST_EXPRESSION_NUMBER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(condition->binary_expression.rhs)->number.token.lexeme, "2");
+            ASSERT_FALSE(AST_EXPRESSION(condition->binary_expression.rhs)->number.is_a_floating_point_number);
 
             ASSERT_EQUAL(while_statement->body.statements_count, 4);
 
             {
                 const Ast_Statement* inner_statement = &while_statement->body.statements[0];
-                ASSERT_EQUAL(inner_statement->start_location.line, 3);
-                ASSERT_EQUAL(inner_statement->start_location.column, 8);
+                ASSERT_EQUAL(resolve_source_location(&context.source_file, inner_statement->start_location).line, 3);
+                ASSERT_EQUAL(resolve_source_location(&context.source_file, inner_statement->start_location).column, 8);
 
                 ASSERT_ENUM_VALUES_ARE_EQUAL(inner_statement->kind, AST_STATEMENT_BREAK);
                 ASSERT_STRINGS_ARE_EQUAL(inner_statement->jump.token.lexeme, "break");
@@ -3959,8 +4016,8 @@ test_while_statements(Test_Context* test_context)
 
             {
                 const Ast_Statement* inner_statement = &while_statement->body.statements[1];
-                ASSERT_EQUAL(inner_statement->start_location.line, 4);
-                ASSERT_EQUAL(inner_statement->start_location.column, 8);
+                ASSERT_EQUAL(resolve_source_location(&context.source_file, inner_statement->start_location).line, 4);
+                ASSERT_EQUAL(resolve_source_location(&context.source_file, inner_statement->start_location).column, 8);
 
                 ASSERT_ENUM_VALUES_ARE_EQUAL(inner_statement->kind, AST_STATEMENT_BREAK);
                 ASSERT_STRINGS_ARE_EQUAL(inner_statement->jump.token.lexeme, "break");
@@ -3969,8 +4026,8 @@ test_while_statements(Test_Context* test_context)
 
             {
                 const Ast_Statement* inner_statement = &while_statement->body.statements[2];
-                ASSERT_EQUAL(inner_statement->start_location.line, 5);
-                ASSERT_EQUAL(inner_statement->start_location.column, 8);
+                ASSERT_EQUAL(resolve_source_location(&context.source_file, inner_statement->start_location).line, 5);
+                ASSERT_EQUAL(resolve_source_location(&context.source_file, inner_statement->start_location).column, 8);
 
                 ASSERT_ENUM_VALUES_ARE_EQUAL(inner_statement->kind, AST_STATEMENT_BREAK);
                 ASSERT_STRINGS_ARE_EQUAL(inner_statement->jump.token.lexeme, "break");
@@ -3979,8 +4036,8 @@ test_while_statements(Test_Context* test_context)
 
             {
                 const Ast_Statement* inner_statement = &while_statement->body.statements[3];
-                ASSERT_EQUAL(inner_statement->start_location.line, 6);
-                ASSERT_EQUAL(inner_statement->start_location.column, 8);
+                ASSERT_EQUAL(resolve_source_location(&context.source_file, inner_statement->start_location).line, 6);
+                ASSERT_EQUAL(resolve_source_location(&context.source_file, inner_statement->start_location).column, 8);
 
                 ASSERT_ENUM_VALUES_ARE_EQUAL(inner_statement->kind, AST_STATEMENT_BREAK);
                 ASSERT_STRINGS_ARE_EQUAL(inner_statement->jump.token.lexeme, "break");
@@ -3990,14 +4047,14 @@ test_while_statements(Test_Context* test_context)
 
         {
             const Ast_Statement* statement = &function_definition->body.statements[1];
-            ASSERT_EQUAL(statement->start_location.line, 8);
-            ASSERT_EQUAL(statement->start_location.column, 4);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 8);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_RETURN);
             ASSERT_FALSE(statement->return_statement.is_empty);
-            ASSERT_ENUM_VALUES_ARE_EQUAL(statement->return_statement.expression.kind, AST_EXPRESSION_NUMBER);
-            ASSERT_STRINGS_ARE_EQUAL(statement->return_statement.expression.number.token.lexeme, "10");
-            ASSERT_FALSE(statement->return_statement.expression.number.is_a_floating_point_number);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(statement->return_statement.expression)->kind, AST_EXPRESSION_NUMBER);
+            ASSERT_STRINGS_ARE_EQUAL(AST_EXPRESSION(statement->return_statement.expression)->number.token.lexeme, "10");
+            ASSERT_FALSE(AST_EXPRESSION(statement->return_statement.expression)->number.is_a_floating_point_number);
         }
 
         destroy_parser(&parser);
@@ -4046,23 +4103,23 @@ test_call_statements(Test_Context* test_context)
 
         {
             const Ast_Statement* statement = &function_definition->body.statements[0];
-            ASSERT_EQUAL(statement->start_location.line, 1);
-            ASSERT_EQUAL(statement->start_location.column, 4);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).line, 1);
+            ASSERT_EQUAL(resolve_source_location(&context.source_file, statement->start_location).column, 4);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_CALL);
 
             const Ast_Call_Statement* call_statement = &statement->call_statement;
-            const Ast_Expression* call_expression = &call_statement->call_expression;
+            const Ast_Expression* call_expression = AST_EXPRESSION(call_statement->call_expression);
             ASSERT_ENUM_VALUES_ARE_EQUAL(call_expression->kind, AST_EXPRESSION_CALL);
             const Ast_Call* call = &call_expression->call;
 
-            const Ast_Expression* called_expression = call->called_expression;
+            const Ast_Expression* called_expression = AST_EXPRESSION(call->called_expression);
             ASSERT_ENUM_VALUES_ARE_EQUAL(called_expression->kind, AST_EXPRESSION_IDENTIFIER);
             ASSERT_STRINGS_ARE_EQUAL(called_expression->identifier.token.lexeme, "bar");
             ASSERT_EQUAL(call->arguments_count, 1);
 
             {
-                const Ast_Expression* argument = call->arguments[0];
+                const Ast_Expression* argument = AST_CALL_ARGUMENT(call, 0);
                 ASSERT_ENUM_VALUES_ARE_EQUAL(argument->kind, AST_EXPRESSION_NUMBER);
                 ASSERT_STRINGS_ARE_EQUAL(argument->number.token.lexeme, "10");
                 ASSERT_FALSE(argument->number.is_a_floating_point_number);
@@ -4160,6 +4217,488 @@ test_syntax_errors(Test_Context* test_context)
     }
 }
 
+internal Bool
+parse_code_in_chunks(Compilation_Context* context, Lexer* lexer, const Size max_chunks_count)
+{
+    Parser parser = {0};
+
+    create_lexer(lexer, context);
+    create_parser(&parser, lexer, context);
+
+    lex_all_tokens(lexer, context->tokens_arena, &parser.tokens);
+
+    // NOTE(vlad): Small inputs are never split by 'parse_ast', so the chunks are made as small
+    //             as they can be.
+    Index boundaries[MAX_PARSER_CHUNKS_COUNT + 1] = {0};
+    const Size chunks_count = find_parser_chunk_boundaries(&parser, max_chunks_count, boundaries);
+    const Bool parsed_without_errors = parse_function_definitions_in_chunks(&parser, boundaries, chunks_count);
+
+    destroy_parser(&parser);
+
+    return parsed_without_errors;
+}
+
+internal String_View
+get_bytes(const void* memory, const Size number_of_bytes)
+{
+    return (String_View){ .data = memory, .length = number_of_bytes };
+}
+
+internal void
+assert_that_types_are_equal(Test_Context* test_context, const Ast_Type* actual, const Ast_Type* expected)
+{
+    ASSERT_EQUAL(actual == NULL, expected == NULL);
+    if (actual == NULL || expected == NULL)
+    {
+        return;
+    }
+
+    ASSERT_ENUM_VALUES_ARE_EQUAL(actual->kind, expected->kind);
+    ASSERT_EQUAL(actual->location.offset_in_bytes, expected->location.offset_in_bytes);
+
+    if (actual->kind == AST_TYPE_POINTER)
+    {
+        assert_that_types_are_equal(test_context, actual->pointer.pointed_to, expected->pointer.pointed_to);
+    }
+    else if (actual->kind == AST_TYPE_FUNCTION)
+    {
+        ASSERT_EQUAL(actual->function.parameters_count, expected->function.parameters_count);
+
+        for (Index i = 0;
+             i < MIN(actual->function.parameters_count, expected->function.parameters_count);
+             ++i)
+        {
+            assert_that_types_are_equal(test_context, actual->function.parameters[i].type, expected->function.parameters[i].type);
+            ASSERT_EQUAL(actual->function.parameters[i].default_value, expected->function.parameters[i].default_value);
+        }
+
+        assert_that_types_are_equal(test_context, actual->function.return_type, expected->function.return_type);
+    }
+}
+
+internal void
+assert_that_code_blocks_are_equal(Test_Context* test_context, const Ast_Code_Block* actual, const Ast_Code_Block* expected)
+{
+    ASSERT_EQUAL(actual->end_location.offset_in_bytes, expected->end_location.offset_in_bytes);
+    ASSERT_EQUAL(actual->statements_count, expected->statements_count);
+
+    for (Index i = 0;
+         i < MIN(actual->statements_count, expected->statements_count);
+         ++i)
+    {
+        const Ast_Statement* actual_statement = &actual->statements[i];
+        const Ast_Statement* expected_statement = &expected->statements[i];
+
+        ASSERT_ENUM_VALUES_ARE_EQUAL(actual_statement->kind, expected_statement->kind);
+        ASSERT_EQUAL(actual_statement->start_location.offset_in_bytes, expected_statement->start_location.offset_in_bytes);
+
+        switch (actual_statement->kind)
+        {
+            case AST_STATEMENT_VARIABLE_DEFINITION:
+            {
+                assert_that_types_are_equal(test_context, actual_statement->variable_definition.type, expected_statement->variable_definition.type);
+                ASSERT_EQUAL(actual_statement->variable_definition.initial_value, expected_statement->variable_definition.initial_value);
+            } break;
+
+            case AST_STATEMENT_ASSIGNMENT:
+            {
+                ASSERT_EQUAL(actual_statement->assignment.lhs, expected_statement->assignment.lhs);
+                ASSERT_EQUAL(actual_statement->assignment.rhs, expected_statement->assignment.rhs);
+            } break;
+
+            case AST_STATEMENT_RETURN:
+            {
+                ASSERT_EQUAL(actual_statement->return_statement.expression, expected_statement->return_statement.expression);
+            } break;
+
+            case AST_STATEMENT_WHILE:
+            {
+                ASSERT_EQUAL(actual_statement->while_statement.condition, expected_statement->while_statement.condition);
+                assert_that_code_blocks_are_equal(test_context, &actual_statement->while_statement.body, &expected_statement->while_statement.body);
+            } break;
+
+            case AST_STATEMENT_IF:
+            {
+                ASSERT_EQUAL(actual_statement->if_statement.condition, expected_statement->if_statement.condition);
+                assert_that_code_blocks_are_equal(test_context, &actual_statement->if_statement.if_statements, &expected_statement->if_statement.if_statements);
+                assert_that_code_blocks_are_equal(test_context, &actual_statement->if_statement.else_statements, &expected_statement->if_statement.else_statements);
+            } break;
+
+            case AST_STATEMENT_CALL:
+            {
+                ASSERT_EQUAL(actual_statement->call_statement.call_expression, expected_statement->call_statement.call_expression);
+            } break;
+
+            default:
+            {
+            } break;
+        }
+    }
+}
+
+internal void
+assert_that_parsing_in_chunks_agrees_with_sequential_parsing(Test_Context* test_context, const String_View code)
+{
+    Source_File source_file = {0};
+    source_file.filename = string_view("<test-input>");
+    source_file.code = code;
+
+    struct Arena_Provider test_arena_provider = {0};
+    test_arena_provider.test_context = test_context;
+
+    Compilation_Context sequential_context = {0};
+    Compilation_Context chunks_context = {0};
+    create_compilation_context(&sequential_context, &test_arena_provider, &source_file);
+    create_compilation_context(&chunks_context, &test_arena_provider, &source_file);
+
+    Lexer sequential_lexer = {0};
+    Lexer chunks_lexer = {0};
+
+    const Bool parsed_sequentially = parse_code_in_chunks(&sequential_context, &sequential_lexer, 1);
+    const Bool parsed_in_chunks = parse_code_in_chunks(&chunks_context, &chunks_lexer, MAX_PARSER_CHUNKS_COUNT);
+
+    ASSERT_EQUAL(parsed_in_chunks, parsed_sequentially);
+    ASSERT_STRINGS_ARE_EQUAL(dump_diagnostic_messages(test_context->arena, &chunks_context, MAX_MESSAGE_LEVEL),
+                             dump_diagnostic_messages(test_context->arena, &sequential_context, MAX_MESSAGE_LEVEL));
+
+    const Ast* sequential_ast = &sequential_context.ast;
+    const Ast* chunks_ast = &chunks_context.ast;
+
+    ASSERT_EQUAL(chunks_ast->expressions_count, sequential_ast->expressions_count);
+    ASSERT_EQUAL(chunks_ast->call_arguments_count, sequential_ast->call_arguments_count);
+    ASSERT_EQUAL(chunks_ast->function_definitions_count, sequential_ast->function_definitions_count);
+
+    if (chunks_ast->expressions_count == sequential_ast->expressions_count)
+    {
+        ASSERT_TRUE(strings_are_equal(get_bytes(chunks_ast->expressions, chunks_ast->expressions_count * size_of(Ast_Expression)),
+                                      get_bytes(sequential_ast->expressions, sequential_ast->expressions_count * size_of(Ast_Expression))));
+    }
+
+    if (chunks_ast->call_arguments_count == sequential_ast->call_arguments_count)
+    {
+        ASSERT_TRUE(strings_are_equal(get_bytes(chunks_ast->call_arguments, chunks_ast->call_arguments_count * size_of(Ast_Expression_Id)),
+                                      get_bytes(sequential_ast->call_arguments, sequential_ast->call_arguments_count * size_of(Ast_Expression_Id))));
+    }
+
+    for (Index i = 0;
+         i < MIN(chunks_ast->function_definitions_count, sequential_ast->function_definitions_count);
+         ++i)
+    {
+        const Ast_Function_Definition* actual = &chunks_ast->function_definitions[i];
+        const Ast_Function_Definition* expected = &sequential_ast->function_definitions[i];
+
+        ASSERT_STRINGS_ARE_EQUAL(actual->name.token.lexeme, expected->name.token.lexeme);
+        assert_that_types_are_equal(test_context, actual->type, expected->type);
+        assert_that_code_blocks_are_equal(test_context, &actual->body, &expected->body);
+    }
+
+    destroy_lexer(&chunks_lexer);
+    destroy_lexer(&sequential_lexer);
+    destroy_compilation_context(&chunks_context);
+    destroy_compilation_context(&sequential_context);
+}
+
+internal void
+test_parsing_in_chunks(Test_Context* test_context)
+{
+    const char* snippets[] = {
+        "foo: () -> void = {}",
+
+        "foo: () -> void = {}\n"
+        "bar: (x: s32 = 1 + 2, y: * s32) -> s32 = { return x * (3 + f(1, g(2, -x), *y)); }\n"
+        "baz: () -> void = {\n"
+        "    value: mutable s32 = bar(4);\n"
+        "    if value < 2 { f(); } else { while true { value = value - 1; break; } }\n"
+        "    return;\n"
+        "}\n"
+        "qux: () -> () -> void = { return baz; }\n",
+
+        // NOTE(vlad): Parsing stops at the first function with an error, the next ones are dropped.
+        "foo: () -> void = { f(1); }\n"
+        "bar: () -> void = { x := ; }\n"
+        "baz: () -> void = { g(2); }\n",
+
+        "foo: () -> void = { f(1); }\n"
+        "bar: () -> void = { }}\n"
+        "baz: () -> void = { g(2); }\n",
+
+        "foo: () -> void = { f(1); }\n"
+        "bar: () -> void = { x := 1 $ 2; }\n"
+        "baz: () -> void = { g(2); }\n",
+
+        "foo: () -> void = { f(1); }\n"
+        "bar: () -> void = { { f(2); }\n"
+        "baz: () -> void = { g(3); }\n",
+
+        "foo: () -> void = { f(1); }\n"
+        "bar",
+    };
+
+    for (Index i = 0;
+         i < NUMBER_OF_STATIC_ARRAY_ELEMENTS(snippets);
+         ++i)
+    {
+        assert_that_parsing_in_chunks_agrees_with_sequential_parsing(test_context, string_view(snippets[i]));
+    }
+}
+
+internal void
+test_parser_chunks_start_after_function_definitions(Test_Context* test_context)
+{
+    CREATE_TEST_COMPILATION_CONTEXT_FOR_CODE("a: () -> void = { if true {} }\n"
+                                             "b: () -> void = {}\n"
+                                             "c: () -> void = { while true { { } } }\n");
+
+    Lexer lexer = {0};
+    Parser parser = {0};
+
+    create_lexer(&lexer, &context);
+    create_parser(&parser, &lexer, &context);
+
+    lex_all_tokens(&lexer, context.tokens_arena, &parser.tokens);
+
+    Index boundaries[MAX_PARSER_CHUNKS_COUNT + 1] = {0};
+    const Size chunks_count = find_parser_chunk_boundaries(&parser, MAX_PARSER_CHUNKS_COUNT, boundaries);
+
+    // NOTE(vlad): The trailing EOF token never starts a chunk.
+    const Index expected_boundaries[] = {0, 13, 22, 38};
+    ASSERT_EQUAL(chunks_count + 1, NUMBER_OF_STATIC_ARRAY_ELEMENTS(expected_boundaries));
+
+    for (Index i = 0;
+         i <= MIN(chunks_count, NUMBER_OF_STATIC_ARRAY_ELEMENTS(expected_boundaries) - 1);
+         ++i)
+    {
+        ASSERT_EQUAL(boundaries[i], expected_boundaries[i]);
+    }
+
+    ASSERT_EQUAL(find_parser_chunk_boundaries(&parser, 1, boundaries), 1);
+    ASSERT_EQUAL(boundaries[1], 38);
+
+    destroy_parser(&parser);
+    destroy_lexer(&lexer);
+    destroy_compilation_context(&context);
+}
+
+internal Bool
+compile_code(Compilation_Context* context, Lexer* lexer)
+{
+    Parser parser = {0};
+
+    create_lexer(lexer, context);
+    create_parser(&parser, lexer, context);
+
+    const Bool parsed_without_errors = parse_ast(&parser);
+    destroy_parser(&parser);
+
+    if (!parsed_without_errors || has_compilation_errors(context))
+    {
+        return false;
+    }
+
+    validate_ast(context);
+    create_lexical_scopes(context);
+
+    if (has_compilation_errors(context) || !resolve_and_validate_types(context) || has_compilation_errors(context))
+    {
+        return false;
+    }
+
+    lower_ast_to_tac(context);
+    construct_cfg_from_tac(context);
+    construct_ssa_from_cfg(context);
+
+    return !has_compilation_errors(context);
+}
+
+internal void
+test_reusing_unchanged_functions(Test_Context* test_context)
+{
+    struct Arena_Provider test_arena_provider = {0};
+    test_arena_provider.test_context = test_context;
+
+    Source_File previous_source_file = {0};
+    previous_source_file.filename = string_view("<test-input>");
+    previous_source_file.code = string_view("f: (x: s32) -> s32 = { if x > 0 { return x + 1; } return 0; }\n"
+                                            "g: () -> s32 = { return f(1); }\n"
+                                            "h: () -> s32 = { return 2; }\n");
+
+    Compilation_Context previous_context = {0};
+    Lexer previous_lexer = {0};
+    create_compilation_context(&previous_context, &test_arena_provider, &previous_source_file);
+
+    ASSERT_TRUE(compile_code(&previous_context, &previous_lexer));
+    ASSERT_EQUAL(previous_context.function_fingerprints_count, 3);
+    ASSERT_EQUAL(previous_context.tac.functions_count, 3);
+
+    {
+        // NOTE(vlad): Only the edited body is compiled again.
+        Source_File source_file = previous_source_file;
+        source_file.code = string_view("f: (x: s32) -> s32 = { if x > 0 { return x + 1; } return 0; }\n"
+                                       "g: () -> s32 = { return f(1); }\n"
+                                       "h: () -> s32 = { a := 2; return a; }\n");
+
+        Compilation_Context context = {0};
+        Lexer lexer = {0};
+        create_compilation_context(&context, &test_arena_provider, &source_file);
+        reuse_unchanged_functions_of_previous_compilation(&context, &previous_context);
+
+        ASSERT_TRUE(compile_code(&context, &lexer));
+        ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
+
+        ASSERT_EQUAL(context.ast.function_definitions_count, 3);
+        ASSERT_TRUE(context.ast.function_definitions[0].body_is_reused);
+        ASSERT_TRUE(context.ast.function_definitions[1].body_is_reused);
+        ASSERT_FALSE(context.ast.function_definitions[2].body_is_reused);
+        ASSERT_EQUAL(context.ast.function_definitions[0].body.statements_count, 0);
+
+        // NOTE(vlad): Reused functions are copied, the context doesn't depend on the previous one.
+        ASSERT_POINTERS_ARE_EQUAL(context.previous_context, NULL);
+        ASSERT_EQUAL(context.tac.functions_count, 3);
+        ASSERT_TRUE(context.tac.functions[0].is_reused);
+        ASSERT_TRUE(context.tac.functions[1].is_reused);
+        ASSERT_FALSE(context.tac.functions[2].is_reused);
+        ASSERT_POINTERS_ARE_EQUAL(context.tac.functions[2].ast_function_definition, &context.ast.function_definitions[2]);
+
+        for (Index function_index = 0;
+             function_index < 2;
+             ++function_index)
+        {
+            const Tac_Function* previous_function = &previous_context.tac.functions[function_index];
+            const Tac_Function* function = &context.tac.functions[function_index];
+
+            ASSERT_EQUAL(function->instructions_count, previous_function->instructions_count);
+            ASSERT_EQUAL(function->cfg_blocks_count, previous_function->cfg_blocks_count);
+            ASSERT_EQUAL(function->last_tac_variable_index - function->first_tac_variable_index,
+                         previous_function->last_tac_variable_index - previous_function->first_tac_variable_index);
+        }
+
+        {
+            // NOTE(vlad): 'g' calls 'f' of this compilation.
+            const Tac_Function* g = &context.tac.functions[1];
+            Bool f_is_called = false;
+
+            for (Index instruction_index = 0;
+                 instruction_index < g->instructions_count;
+                 ++instruction_index)
+            {
+                const Tac_Instruction* instruction = &g->instructions[instruction_index];
+                if (instruction->operation == TAC_CALL)
+                {
+                    ASSERT_EQUAL(instruction->first_argument.kind, TAC_OPERAND_FUNCTION_LABEL);
+                    ASSERT_EQUAL(instruction->first_argument.function_label_id.index, context.tac.functions[0].label_id.index);
+                    f_is_called = true;
+                }
+            }
+
+            ASSERT_TRUE(f_is_called);
+        }
+
+        {
+            // NOTE(vlad): Bodies reused by a reused compilation are reused again.
+            Source_File next_source_file = previous_source_file;
+            Compilation_Context next_context = {0};
+            Lexer next_lexer = {0};
+            create_compilation_context(&next_context, &test_arena_provider, &next_source_file);
+            reuse_unchanged_functions_of_previous_compilation(&next_context, &context);
+
+            ASSERT_TRUE(compile_code(&next_context, &next_lexer));
+            ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
+
+            ASSERT_TRUE(next_context.ast.function_definitions[0].body_is_reused);
+            ASSERT_TRUE(next_context.ast.function_definitions[1].body_is_reused);
+            ASSERT_FALSE(next_context.ast.function_definitions[2].body_is_reused);
+
+            ASSERT_EQUAL(next_context.tac.functions_count, 3);
+            ASSERT_EQUAL(next_context.tac.functions[0].instructions_count, previous_context.tac.functions[0].instructions_count);
+            ASSERT_EQUAL(next_context.tac.functions[1].instructions_count, previous_context.tac.functions[1].instructions_count);
+            ASSERT_EQUAL(next_context.tac.functions[2].instructions_count, previous_context.tac.functions[2].instructions_count);
+
+            destroy_lexer(&next_lexer);
+            destroy_compilation_context(&next_context);
+        }
+
+        destroy_lexer(&lexer);
+        destroy_compilation_context(&context);
+    }
+
+    {
+        // NOTE(vlad): Callers of a function whose signature changed are checked again, even
+        //             though their own text is the same.
+        Source_File source_file = previous_source_file;
+        source_file.code = string_view("f: (x: s32, y: s32) -> s32 = { return x + y; }\n"
+                                       "g: () -> s32 = { return f(1); }\n"
+                                       "h: () -> s32 = { return 2; }\n");
+
+        Compilation_Context context = {0};
+        Lexer lexer = {0};
+        create_compilation_context(&context, &test_arena_provider, &source_file);
+        reuse_unchanged_functions_of_previous_compilation(&context, &previous_context);
+
+        ASSERT_FALSE(compile_code(&context, &lexer));
+
+        ASSERT_EQUAL(context.ast.function_definitions_count, 3);
+        ASSERT_FALSE(context.ast.function_definitions[0].body_is_reused);
+        ASSERT_FALSE(context.ast.function_definitions[1].body_is_reused);
+        ASSERT_TRUE(context.ast.function_definitions[2].body_is_reused);
+
+        const String_View dumped_messages = dump_diagnostic_messages(test_context->arena, &context, MAX_MESSAGE_LEVEL);
+        const String_View expected_output = string_view("<test-input>:2:25: error: Too many arguments provided to a function call, expected 2, got 1\n"
+                                                        "  2 | g: () -> s32 = { return f(1); }\n"
+                                                        "    |                         ^");
+        ASSERT_STRINGS_ARE_EQUAL(dumped_messages, expected_output);
+
+        // NOTE(vlad): Contexts with errors are never reused.
+        Source_File next_source_file = previous_source_file;
+        Compilation_Context next_context = {0};
+        Lexer next_lexer = {0};
+        create_compilation_context(&next_context, &test_arena_provider, &next_source_file);
+        reuse_unchanged_functions_of_previous_compilation(&next_context, &context);
+
+        ASSERT_TRUE(compile_code(&next_context, &next_lexer));
+        ASSERT_EQUAL(next_context.tac.functions_count, 3);
+
+        destroy_lexer(&next_lexer);
+        destroy_compilation_context(&next_context);
+
+        destroy_lexer(&lexer);
+        destroy_compilation_context(&context);
+    }
+
+    {
+        // NOTE(vlad): Both branches return, so the previous compilation removed the block after
+        //             'if', its label is still in the copied TAC. See 'run_ssa_test' for
+        //             the comparison of whole recompilations.
+        Source_File source_file = previous_source_file;
+        source_file.code = string_view("f: (x: s32) -> s32 = { if x > 0 { return 1; } else { return 2; } }\n");
+
+        Compilation_Context first_context = {0};
+        Lexer first_lexer = {0};
+        create_compilation_context(&first_context, &test_arena_provider, &source_file);
+        ASSERT_TRUE(compile_code(&first_context, &first_lexer));
+
+        Compilation_Context context = {0};
+        Lexer lexer = {0};
+        create_compilation_context(&context, &test_arena_provider, &source_file);
+        reuse_unchanged_functions_of_previous_compilation(&context, &first_context);
+
+        ASSERT_TRUE(compile_code(&context, &lexer));
+        ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
+
+        ASSERT_TRUE(context.tac.functions[0].is_reused);
+        ASSERT_EQUAL(context.tac.functions[0].cfg_blocks_count, first_context.tac.functions[0].cfg_blocks_count);
+        ASSERT_EQUAL(context.tac.labels_count, first_context.tac.labels_count);
+
+        destroy_lexer(&lexer);
+        destroy_compilation_context(&context);
+
+        destroy_lexer(&first_lexer);
+        destroy_compilation_context(&first_context);
+    }
+
+    destroy_lexer(&previous_lexer);
+    destroy_compilation_context(&previous_context);
+}
+
 REGISTER_TESTS(
     test_function_definitions_parsing,
     test_variable_definitions_parsing,
@@ -4170,7 +4709,10 @@ REGISTER_TESTS(
     test_assignments,
     test_while_statements,
     test_call_statements,
-    test_syntax_errors
+    test_syntax_errors,
+    test_parsing_in_chunks,
+    test_parser_chunks_start_after_function_definitions,
+    test_reusing_unchanged_functions
 )
 
 #include "eon_ast.c"
@@ -4180,5 +4722,6 @@ REGISTER_TESTS(
 #include "eon_lexer.c"
 #include "eon_lexical_scopes.c"
 #include "eon_parser.c"
+#include "eon_ssa.c"
 #include "eon_tac.c"
 #include "eon_types.c"
@@ -82,6 +82,10 @@ compute_cfg_dominators(Compilation_Context* context)
          ++function_index)
     {
         Tac_Function* tac_function = &tac->functions[function_index];
+        if (tac_function->is_reused)
+        {
+            continue;
+        }
 
         // TODO(vlad): Reuse this memory?
         Cfg_Block_Id* block_ids_in_postorder = allocate_array(context->scratch_arena,
@@ -188,11 +192,42 @@ compute_cfg_dominance_frontiers(Compilation_Context* context)
 {
     Tac* tac = &context->tac;
 
+    struct Frontier_Entry
+    {
+        Cfg_Block_Id runner_id;
+        Cfg_Block_Id block_id;
+    };
+    typedef struct Frontier_Entry Frontier_Entry;
+
+    struct Frontier_Entries
+    {
+        array(Frontier_Entry, entries);
+    };
+    typedef struct Frontier_Entries Frontier_Entries;
+
     for (Index function_index = 0;
          function_index < tac->functions_count;
          ++function_index)
     {
         Tac_Function* tac_function = &tac->functions[function_index];
+        if (tac_function->is_reused)
+        {
+            continue;
+        }
+
+        Frontier_Entries frontier_entries = {0};
+
+        // NOTE(vlad): All entries for the block are collected while processing that block,
+        //             so remembering the last added block is enough to avoid duplicates.
+        Index* last_frontier_block_indices = allocate_uninitialized_array(context->scratch_arena,
+                                                                          tac_function->cfg_blocks_count,
+                                                                          Index);
+        for (Index block_index = 0;
+             block_index < tac_function->cfg_blocks_count;
+             ++block_index)
+        {
+            last_frontier_block_indices[block_index] = INVALID_CFG_BLOCK_INDEX;
+        }
 
         for (Index block_index = 0;
              block_index < tac_function->cfg_blocks_count;
@@ -219,36 +254,52 @@ compute_cfg_dominance_frontiers(Compilation_Context* context)
                     Cfg_Block* runner = get_cfg_block_by_id(tac_function, runner_id);
 
                     // NOTE(vlad): Adding 'runner' to this block's dominance frontier.
+                    if (last_frontier_block_indices[runner_id.index] != this_block_id.index)
                     {
-                        Bool should_add_this_block_to_dominance_frontier = true;
+                        last_frontier_block_indices[runner_id.index] = this_block_id.index;
 
-                        for (Index frontier_index = 0;
-                             frontier_index < runner->dominance_frontier_count;
-                             ++frontier_index)
-                        {
-                            const Cfg_Block_Id frontier_element_id = runner->dominance_frontier[frontier_index];
+                        Frontier_Entry entry = {0};
+                        entry.runner_id = runner_id;
+                        entry.block_id = this_block_id;
 
-                            if (frontier_element_id.index == this_block_id.index)
-                            {
-                                should_add_this_block_to_dominance_frontier = false;
-                                break;
-                            }
-                        }
+                        append_array(context->scratch_arena, frontier_entries.entries, Frontier_Entry, entry);
 
-                        if (should_add_this_block_to_dominance_frontier)
-                        {
-                            append_array(runner->dominance_frontier_arena,
-                                         runner->dominance_frontier,
-                                         Cfg_Block_Id,
-                                         this_block_id);
-                        }
+                        runner->dominance_frontier_count += 1;
                     }
 
                     runner_id = runner->immediate_dominator_id;
                 }
             }
         }
+
+        // NOTE(vlad): Scattering collected entries to the blocks' slices.
+        Cfg_Block_Id* dominance_frontiers = allocate_uninitialized_array(context->cfg_adjacency_arena,
+                                                                         frontier_entries.entries_count,
+                                                                         Cfg_Block_Id);
+        Size dominance_frontiers_count = 0;
+
+        for (Index block_index = 0;
+             block_index < tac_function->cfg_blocks_count;
+             ++block_index)
+        {
+            Cfg_Block* block = &tac_function->cfg_blocks[block_index];
+            block->dominance_frontier = dominance_frontiers + dominance_frontiers_count;
+            dominance_frontiers_count += block->dominance_frontier_count;
+            block->dominance_frontier_count = 0;
+        }
+
+        for (Index entry_index = 0;
+             entry_index < frontier_entries.entries_count;
+             ++entry_index)
+        {
+            const Frontier_Entry* entry = &frontier_entries.entries[entry_index];
+
+            Cfg_Block* runner = get_cfg_block_by_id(tac_function, entry->runner_id);
+            runner->dominance_frontier[runner->dominance_frontier_count++] = entry->block_id;
+        }
     }
+
+    request_arena_reset(context->arena_provider, context->scratch_arena);
 }
 
 internal void
@@ -256,11 +307,30 @@ insert_phi_nodes(Compilation_Context* context)
 {
     Tac* tac = &context->tac;
 
+    struct Phi_Node_Entry
+    {
+        Cfg_Block_Id block_id;
+        Phi_Node phi_node;
+    };
+    typedef struct Phi_Node_Entry Phi_Node_Entry;
+
+    struct Phi_Node_Entries
+    {
+        array(Phi_Node_Entry, entries);
+    };
+    typedef struct Phi_Node_Entries Phi_Node_Entries;
+
     for (Index function_index = 0;
          function_index < tac->functions_count;
          ++function_index)
     {
         Tac_Function* tac_function = &tac->functions[function_index];
+        if (tac_function->is_reused)
+        {
+            continue;
+        }
+
+        Phi_Node_Entries phi_node_entries = {0};
 
         for (Index variable_index = tac_function->first_tac_variable_index;
              variable_index < tac_function->last_tac_variable_index;
@@ -354,7 +424,12 @@ insert_phi_nodes(Compilation_Context* context)
                         phi_node.previous_variables[previous_variable_index].ssa_version = SSA_VERSION_UNSET;
                     }
 
-                    append_array(frontier_block->phi_nodes_arena, frontier_block->phi_nodes, Phi_Node, phi_node);
+                    Phi_Node_Entry entry = {0};
+                    entry.block_id = frontier_block_id;
+                    entry.phi_node = phi_node;
+
+                    append_array(context->scratch_arena, phi_node_entries.entries, Phi_Node_Entry, entry);
+                    frontier_block->phi_nodes_count += 1;
 
                     block_has_phi_node_for_this_variable[frontier_block_id.index] = true;
 
@@ -362,6 +437,32 @@ insert_phi_nodes(Compilation_Context* context)
                 }
             }
         }
+
+        // NOTE(vlad): Scattering collected phi nodes to the blocks' slices.
+        Phi_Node* phi_nodes = allocate_uninitialized_array(context->cfg_adjacency_arena,
+                                                           phi_node_entries.entries_count,
+                                                           Phi_Node);
+        Size phi_nodes_count = 0;
+
+        for (Index block_index = 0;
+             block_index < tac_function->cfg_blocks_count;
+             ++block_index)
+        {
+            Cfg_Block* block = &tac_function->cfg_blocks[block_index];
+            block->phi_nodes = phi_nodes + phi_nodes_count;
+            phi_nodes_count += block->phi_nodes_count;
+            block->phi_nodes_count = 0;
+        }
+
+        for (Index entry_index = 0;
+             entry_index < phi_node_entries.entries_count;
+             ++entry_index)
+        {
+            const Phi_Node_Entry* entry = &phi_node_entries.entries[entry_index];
+
+            Cfg_Block* block = get_cfg_block_by_id(tac_function, entry->block_id);
+            block->phi_nodes[block->phi_nodes_count++] = entry->phi_node;
+        }
     }
 
     request_arena_reset(context->arena_provider, context->scratch_arena);
@@ -377,6 +478,42 @@ build_dominator_tree(Compilation_Context* context)
          ++function_index)
     {
         Tac_Function* tac_function = &tac->functions[function_index];
+        if (tac_function->is_reused)
+        {
+            continue;
+        }
+
+        // NOTE(vlad): Counting children of every block in the dominator tree.
+        Size dominated_blocks_count = 0;
+
+        for (Index block_index = ENTRY_BLOCK_INDEX + 1;
+             block_index < tac_function->cfg_blocks_count;
+             ++block_index)
+        {
+            const Cfg_Block* block = &tac_function->cfg_blocks[block_index];
+
+            if (block->immediate_dominator_id.index != INVALID_CFG_BLOCK_INDEX)
+            {
+                Cfg_Block* immediate_dominator_block = get_cfg_block_by_id(tac_function, block->immediate_dominator_id);
+                immediate_dominator_block->dominated_block_ids_count += 1;
+                dominated_blocks_count += 1;
+            }
+        }
+
+        Cfg_Block_Id* dominated_block_ids = allocate_uninitialized_array(context->cfg_adjacency_arena,
+                                                                         dominated_blocks_count,
+                                                                         Cfg_Block_Id);
+        Size dominated_block_ids_count = 0;
+
+        for (Index block_index = 0;
+             block_index < tac_function->cfg_blocks_count;
+             ++block_index)
+        {
+            Cfg_Block* block = &tac_function->cfg_blocks[block_index];
+            block->dominated_block_ids = dominated_block_ids + dominated_block_ids_count;
+            dominated_block_ids_count += block->dominated_block_ids_count;
+            block->dominated_block_ids_count = 0;
+        }
 
         for (Index block_index = ENTRY_BLOCK_INDEX + 1;
              block_index < tac_function->cfg_blocks_count;
@@ -385,15 +522,12 @@ build_dominator_tree(Compilation_Context* context)
             Cfg_Block_Id block_id = {0};
             block_id.index = block_index;
 
-            Cfg_Block* block = get_cfg_block_by_id(tac_function, block_id);
+            const Cfg_Block* block = get_cfg_block_by_id(tac_function, block_id);
 
             if (block->immediate_dominator_id.index != INVALID_CFG_BLOCK_INDEX)
             {
                 Cfg_Block* immediate_dominator_block = get_cfg_block_by_id(tac_function, block->immediate_dominator_id);
-                append_array(immediate_dominator_block->dominated_block_ids_arena,
-                             immediate_dominator_block->dominated_block_ids,
-                             Cfg_Block_Id,
-                             block_id);
+                immediate_dominator_block->dominated_block_ids[immediate_dominator_block->dominated_block_ids_count++] = block_id;
             }
         }
     }
@@ -597,6 +731,10 @@ set_tac_variable_versions(Compilation_Context* context)
          ++function_index)
     {
         Tac_Function* tac_function = &tac->functions[function_index];
+        if (tac_function->is_reused)
+        {
+            continue;
+        }
 
         const Cfg_Block_Id entry_block_id = {0};
         set_tac_variable_versions_in_cfg_block(context, &renaming_info, tac_function, entry_block_id);
@@ -612,6 +750,10 @@ set_tac_variable_versions(Compilation_Context* context)
         variable_id.index = variable_index;
 
         Tac_Variable* variable = get_tac_variable_by_id(tac, variable_id);
+        if (variable->is_reused)
+        {
+            continue;
+        }
 
         variable->max_ssa_version = variable_info->next_version;
     }
@@ -722,6 +864,10 @@ find_unused_ssa_assignments(Compilation_Context* context)
         variable_id.index = variable_index;
 
         Tac_Variable* variable = get_tac_variable_by_id(tac, variable_id);
+        if (variable->is_reused)
+        {
+            continue;
+        }
 
         version_info->versions_count = variable->max_ssa_version + 1;
         version_info->version_infos = allocate_array(context->scratch_arena, version_info->versions_count, Version_Info);
@@ -732,6 +878,10 @@ find_unused_ssa_assignments(Compilation_Context* context)
          ++function_index)
     {
         Tac_Function* tac_function = &tac->functions[function_index];
+        if (tac_function->is_reused)
+        {
+            continue;
+        }
 
         for (Index this_block_index = 0;
              this_block_index < tac_function->cfg_blocks_count;
@@ -837,6 +987,12 @@ find_unused_ssa_assignments(Compilation_Context* context)
             continue;
         }
 
+        // NOTE(vlad): Its assignments were checked by the previous compilation.
+        if (variable->is_reused)
+        {
+            continue;
+        }
+
         Ssa_Variable_Versions_Info* info = &infos[variable_index];
         Bool variable_was_never_used = true;
         Bool variable_was_reassigned = false;
@@ -906,6 +1062,10 @@ perform_constant_folding(Compilation_Context* context)
          ++function_index)
     {
         Tac_Function* tac_function = &tac->functions[function_index];
+        if (tac_function->is_reused)
+        {
+            continue;
+        }
 
         Bool constant_was_folded = false;
         do
@@ -1128,6 +1288,10 @@ remove_unreachable_jumps(Compilation_Context* context)
          ++function_index)
     {
         Tac_Function* tac_function = &tac->functions[function_index];
+        if (tac_function->is_reused)
+        {
+            continue;
+        }
 
         for (Index this_block_index = 0;
              this_block_index < tac_function->cfg_blocks_count;
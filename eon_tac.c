@@ -1,5 +1,6 @@
 #include "eon_tac.h"
 
+#include "eon_cfg.h"
 #include "eon_compilation_context.h"
 #include "eon_lexical_scopes.h"
 #include "eon_types.h"
@@ -403,14 +404,15 @@ get_constant_kind_by_type_id(Compilation_Context* context,
 
 internal Tac_Operand
 create_tac_constant_for_number(Compilation_Context* context,
-                               const Ast_Expression* expression)
+                               const Ast_Expression_Id expression_id)
 {
+    const Ast_Expression* expression = get_ast_expression_by_id(&context->ast, expression_id);
     ASSERT(expression->kind == AST_EXPRESSION_NUMBER);
 
     const Tac_Constant_Id id = create_tac_constant(context);
 
     Tac_Constant* constant = get_tac_constant_by_id(&context->tac, id);
-    constant->kind = get_constant_kind_by_type_id(context, expression->type_id);
+    constant->kind = get_constant_kind_by_type_id(context, get_expression_type_id(context, expression_id));
 
     const Ast_Number* number = &expression->number;
 
@@ -459,8 +461,11 @@ create_tac_constant_for_number(Compilation_Context* context,
 internal Tac_Operand
 lower_expression_to_tac(Compilation_Context* context,
                         Tac_Function* tac_function,
-                        Ast_Expression* expression)
+                        const Ast_Expression_Id expression_id)
 {
+    const Ast_Expression* expression = get_ast_expression_by_id(&context->ast, expression_id);
+    const Type_Id expression_type_id = get_expression_type_id(context, expression_id);
+
     Tac_Instructions_Range instructions_range = {0};
     instructions_range.function_label_id = tac_function->label_id;
     instructions_range.start_instruction_index = tac_function->instructions_count;
@@ -476,7 +481,7 @@ lower_expression_to_tac(Compilation_Context* context,
 
         case AST_EXPRESSION_NUMBER:
         {
-            result = create_tac_constant_for_number(context, expression);
+            result = create_tac_constant_for_number(context, expression_id);
         } break;
 
         case AST_EXPRESSION_STRING_LITERAL:
@@ -615,7 +620,7 @@ lower_expression_to_tac(Compilation_Context* context,
                 } break;
             }
 
-            instruction.destination = create_tac_temporary_variable(context, expression->type_id);
+            instruction.destination = create_tac_temporary_variable(context, expression_type_id);
             instruction.first_argument = lhs;
             instruction.second_argument = rhs;
 
@@ -637,7 +642,7 @@ lower_expression_to_tac(Compilation_Context* context,
 
             Tac_Instruction instruction = {0};
             instruction.operation = TAC_LOAD_BY_ADDRESS;
-            instruction.destination = create_tac_temporary_variable(context, expression->type_id);
+            instruction.destination = create_tac_temporary_variable(context, expression_type_id);
             instruction.first_argument = operand;
 
             emit_tac_instruction(tac_function, instruction);
@@ -653,7 +658,7 @@ lower_expression_to_tac(Compilation_Context* context,
 
             Tac_Instruction instruction = {0};
             instruction.operation = TAC_GET_ADDRESS;
-            instruction.destination = create_tac_temporary_variable(context, expression->type_id);
+            instruction.destination = create_tac_temporary_variable(context, expression_type_id);
             instruction.first_argument = operand;
 
             emit_tac_instruction(tac_function, instruction);
@@ -672,11 +677,11 @@ lower_expression_to_tac(Compilation_Context* context,
                  argument_index < call->arguments_count;
                  ++argument_index)
             {
-                Ast_Expression* argument = call->arguments[argument_index];
+                const Ast_Expression_Id argument_id = get_ast_call_argument_id(&context->ast, call, argument_index);
 
                 const Tac_Operand argument_operand = lower_expression_to_tac(context,
                                                                              tac_function,
-                                                                             argument);
+                                                                             argument_id);
 
                 Tac_Instruction instruction = {0};
                 instruction.operation = TAC_SET_PARAMETER;
@@ -690,7 +695,7 @@ lower_expression_to_tac(Compilation_Context* context,
 
             {
                 const Type* called_expression_type = get_type_by_id(context,
-                                                                    call->called_expression->type_id);
+                                                                    get_expression_type_id(context, call->called_expression));
                 ASSERT(called_expression_type->kind == TYPE_FUNCTION);
 
                 const Type_Id return_type_id = called_expression_type->function_info.return_type_id;
@@ -698,7 +703,7 @@ lower_expression_to_tac(Compilation_Context* context,
 
                 if (!type_ids_are_equal(context, return_type_id, void_type_id))
                 {
-                    call_instruction.destination = create_tac_temporary_variable(context, expression->type_id);
+                    call_instruction.destination = create_tac_temporary_variable(context, expression_type_id);
                 }
             }
 
@@ -710,7 +715,7 @@ lower_expression_to_tac(Compilation_Context* context,
     }
 
     instructions_range.end_instruction_index = tac_function->instructions_count;
-    expression->tac_instructions_range = instructions_range;
+    context->tac.expression_instructions_ranges[expression_id] = instructions_range;
     return result;
 }
 
@@ -741,7 +746,7 @@ lower_statement_to_tac(Compilation_Context* context,
             {
                 instruction.first_argument = lower_expression_to_tac(context,
                                                                      tac_function,
-                                                                     &definition->initial_value);
+                                                                     definition->initial_value);
             }
 
             instruction.destination = create_tac_variable_for_symbol(context, definition->name.symbol_id);
@@ -757,11 +762,13 @@ lower_statement_to_tac(Compilation_Context* context,
         {
             Ast_Assignment* assignment = &statement->assignment;
 
-            const Tac_Operand rhs = lower_expression_to_tac(context, tac_function, &assignment->rhs);
+            const Tac_Operand rhs = lower_expression_to_tac(context, tac_function, assignment->rhs);
+
+            const Ast_Expression* lhs_expression = get_ast_expression_by_id(&context->ast, assignment->lhs);
 
-            if (assignment->lhs.kind == AST_EXPRESSION_DEREFERENCE)
+            if (lhs_expression->kind == AST_EXPRESSION_DEREFERENCE)
             {
-                const Ast_Unary_Expression* lhs_dereference = &assignment->lhs.unary_expression;
+                const Ast_Unary_Expression* lhs_dereference = &lhs_expression->unary_expression;
                 const Tac_Operand lhs_dereference_operand = lower_expression_to_tac(context, tac_function, lhs_dereference->operand);
 
                 Tac_Instruction instruction = {0};
@@ -773,7 +780,7 @@ lower_statement_to_tac(Compilation_Context* context,
             }
             else
             {
-                const Tac_Operand lhs = lower_expression_to_tac(context, tac_function, &assignment->lhs);
+                const Tac_Operand lhs = lower_expression_to_tac(context, tac_function, assignment->lhs);
 
                 Tac_Instruction instruction = {0};
                 instruction.operation = TAC_ASSIGN;
@@ -795,7 +802,7 @@ lower_statement_to_tac(Compilation_Context* context,
             {
                 instruction.first_argument = lower_expression_to_tac(context,
                                                                      tac_function,
-                                                                     &return_statement->expression);
+                                                                     return_statement->expression);
             }
 
             emit_tac_instruction(tac_function, instruction);
@@ -827,7 +834,7 @@ lower_statement_to_tac(Compilation_Context* context,
             {
                 const Tac_Operand condition_operand = lower_expression_to_tac(context,
                                                                               tac_function,
-                                                                              &while_statement->condition);
+                                                                              while_statement->condition);
 
                 Tac_Instruction condition_instruction = {0};
                 condition_instruction.operation = TAC_JUMP_IF_FALSE;
@@ -887,7 +894,7 @@ lower_statement_to_tac(Compilation_Context* context,
             {
                 const Tac_Operand condition_operand = lower_expression_to_tac(context,
                                                                               tac_function,
-                                                                              &if_statement->condition);
+                                                                              if_statement->condition);
 
                 Tac_Instruction condition_instruction = {0};
                 condition_instruction.operation = TAC_JUMP_IF_FALSE;
@@ -960,8 +967,8 @@ lower_statement_to_tac(Compilation_Context* context,
         case AST_STATEMENT_CALL:
         {
             Ast_Call_Statement* call_statement = &statement->call_statement;
-            ASSERT(call_statement->call_expression.kind == AST_EXPRESSION_CALL);
-            lower_expression_to_tac(context, tac_function, &call_statement->call_expression);
+            ASSERT(get_ast_expression_by_id(&context->ast, call_statement->call_expression)->kind == AST_EXPRESSION_CALL);
+            lower_expression_to_tac(context, tac_function, call_statement->call_expression);
         } break;
 
         case AST_STATEMENT_BREAK:
@@ -1031,6 +1038,295 @@ lower_statement_to_tac(Compilation_Context* context,
     statement->tac_instructions_range = instructions_range;
 }
 
+// NOTE(vlad): Ids of the previous compilation that are already copied into this one, indexed by
+//             the previous ids. Undefined ids are not copied yet.
+struct Reused_Tac_Ids
+{
+    const Compilation_Context* previous_context;
+
+    Type_Id* type_ids;
+    Symbol_Id* symbol_ids;
+    Tac_Constant_Id* constant_ids;
+    Tac_Function_Label_Id* function_label_ids;
+
+    // NOTE(vlad): Differences between the ids of the function that is being copied and its
+    //             previous ids.
+    Index variable_index_offset;
+    Index label_index_offset;
+    s64 source_offset;
+};
+typedef struct Reused_Tac_Ids Reused_Tac_Ids;
+
+internal Reused_Tac_Ids
+create_reused_tac_ids(Compilation_Context* context, const Compilation_Context* previous_context)
+{
+    Reused_Tac_Ids ids = {0};
+    ids.previous_context = previous_context;
+    ids.type_ids = allocate_array(context->scratch_arena, previous_context->types_count, Type_Id);
+    ids.symbol_ids = allocate_array(context->scratch_arena, previous_context->symbols_count, Symbol_Id);
+    ids.constant_ids = allocate_array(context->scratch_arena, previous_context->tac.constants_count, Tac_Constant_Id);
+    ids.function_label_ids = allocate_array(context->scratch_arena,
+                                            previous_context->tac.function_labels_count,
+                                            Tac_Function_Label_Id);
+    return ids;
+}
+
+// NOTE(vlad): Reused functions only call functions that exist in both compilations.
+internal Tac_Function_Label_Id
+copy_reused_function_label_id(Compilation_Context* context, Reused_Tac_Ids* ids, const Tac_Function_Label_Id previous_id)
+{
+    Tac_Function_Label_Id* id = &ids->function_label_ids[previous_id.index];
+
+    if (previous_id.index != INVALID_TAC_INDEX && id->index == INVALID_TAC_INDEX)
+    {
+        const Compilation_Context* previous_context = ids->previous_context;
+        const Tac_Function_Label* previous_label = &previous_context->tac.function_labels[previous_id.index];
+        const Symbol* previous_symbol = &previous_context->symbols[previous_label->symbol_id];
+
+        const Symbol_Id symbol_id = find_symbol_id(context, GLOBAL_LEXICAL_SCOPE_ID, previous_symbol->name);
+        ASSERT(symbol_id != UNDEFINED_SYMBOL_ID && symbol_id != INVALID_SYMBOL_ID);
+
+        *id = get_symbol_by_id(context, symbol_id)->tac_instruction_id.function_label_id;
+    }
+
+    return *id;
+}
+
+// NOTE(vlad): Symbols of reused functions are only referred to by their TAC variables. Their
+//             names and locations are moved to where the function is in this source.
+internal Symbol_Id
+copy_reused_symbol(Compilation_Context* context, Reused_Tac_Ids* ids, const Symbol_Id previous_symbol_id)
+{
+    Symbol_Id* symbol_id = &ids->symbol_ids[previous_symbol_id];
+
+    if (*symbol_id == UNDEFINED_SYMBOL_ID)
+    {
+        const Compilation_Context* previous_context = ids->previous_context;
+        const Symbol* previous_symbol = &previous_context->symbols[previous_symbol_id];
+
+        *symbol_id = create_symbol(context);
+
+        Symbol* symbol = get_symbol_by_id(context, *symbol_id);
+        *symbol = *previous_symbol;
+
+        symbol->name.data = context->source_file.code.data
+                            + (previous_symbol->name.data - previous_context->source_file.code.data)
+                            + ids->source_offset;
+        symbol->name_id = intern_string(context, symbol->name);
+        symbol->location.offset_in_bytes = (u32)(previous_symbol->location.offset_in_bytes + ids->source_offset);
+        symbol->type_id = copy_type_of_previous_compilation(context, previous_context, ids->type_ids, previous_symbol->type_id);
+        symbol->tac_instruction_id.function_label_id = copy_reused_function_label_id(context,
+                                                                                     ids,
+                                                                                     previous_symbol->tac_instruction_id.function_label_id);
+    }
+
+    return *symbol_id;
+}
+
+internal Tac_Variable_Id
+copy_reused_variable_id(const Reused_Tac_Ids* ids, const Tac_Variable_Id previous_id)
+{
+    Tac_Variable_Id id = previous_id;
+    id.index += ids->variable_index_offset;
+    return id;
+}
+
+internal Tac_Operand
+copy_reused_tac_operand(Compilation_Context* context, Reused_Tac_Ids* ids, const Tac_Operand previous_operand)
+{
+    Tac_Operand operand = previous_operand;
+
+    switch (previous_operand.kind)
+    {
+        case TAC_OPERAND_NONE:
+        case TAC_OPERAND_PARAMETER_INDEX:
+        {
+        } break;
+
+        case TAC_OPERAND_FUNCTION_LABEL:
+        {
+            operand.function_label_id = copy_reused_function_label_id(context, ids, previous_operand.function_label_id);
+        } break;
+
+        case TAC_OPERAND_VARIABLE:
+        {
+            operand.variable_id = copy_reused_variable_id(ids, previous_operand.variable_id);
+        } break;
+
+        case TAC_OPERAND_LABEL:
+        {
+            operand.label_id.index += ids->label_index_offset;
+        } break;
+
+        case TAC_OPERAND_CONSTANT:
+        {
+            Tac_Constant_Id* constant_id = &ids->constant_ids[previous_operand.constant_id.index];
+
+            if (constant_id->index == INVALID_TAC_INDEX)
+            {
+                *constant_id = create_tac_constant(context);
+                *get_tac_constant_by_id(&context->tac, *constant_id) = ids->previous_context->tac.constants[previous_operand.constant_id.index];
+            }
+
+            operand.constant_id = *constant_id;
+        } break;
+    }
+
+    return operand;
+}
+
+internal Cfg_Block_Id*
+copy_reused_cfg_block_ids(Compilation_Context* context, const Cfg_Block_Id* previous_block_ids, const Size count)
+{
+    if (count == 0)
+    {
+        return NULL;
+    }
+
+    Cfg_Block_Id* block_ids = allocate_uninitialized_array(context->cfg_adjacency_arena, count, Cfg_Block_Id);
+    copy_memory(as_bytes(block_ids), as_bytes(previous_block_ids), count * size_of(Cfg_Block_Id));
+    return block_ids;
+}
+
+internal void
+copy_reused_cfg_block(Compilation_Context* context, Reused_Tac_Ids* ids, Cfg_Block* block, const Cfg_Block* previous_block)
+{
+    *block = *previous_block;
+
+    block->instructions_range.function_label_id = copy_reused_function_label_id(context,
+                                                                                ids,
+                                                                                previous_block->instructions_range.function_label_id);
+
+    block->edges = copy_reused_cfg_block_ids(context, previous_block->edges, previous_block->edges_count);
+    block->predecessors = copy_reused_cfg_block_ids(context, previous_block->predecessors, previous_block->predecessors_count);
+    block->dominance_frontier = copy_reused_cfg_block_ids(context,
+                                                          previous_block->dominance_frontier,
+                                                          previous_block->dominance_frontier_count);
+    block->dominated_block_ids = copy_reused_cfg_block_ids(context,
+                                                           previous_block->dominated_block_ids,
+                                                           previous_block->dominated_block_ids_count);
+
+    if (previous_block->phi_nodes_count != 0)
+    {
+        block->phi_nodes = allocate_uninitialized_array(context->cfg_adjacency_arena, previous_block->phi_nodes_count, Phi_Node);
+    }
+
+    for (Index phi_node_index = 0;
+         phi_node_index < previous_block->phi_nodes_count;
+         ++phi_node_index)
+    {
+        const Phi_Node* previous_phi_node = &previous_block->phi_nodes[phi_node_index];
+        Phi_Node* phi_node = &block->phi_nodes[phi_node_index];
+
+        phi_node->destination = copy_reused_variable_id(ids, previous_phi_node->destination);
+        phi_node->previous_variables_count = previous_phi_node->previous_variables_count;
+        phi_node->previous_variables = allocate_uninitialized_array(context->phi_node_arguments_arena,
+                                                                    previous_phi_node->previous_variables_count,
+                                                                    Tac_Variable_Id);
+
+        for (Index argument_index = 0;
+             argument_index < previous_phi_node->previous_variables_count;
+             ++argument_index)
+        {
+            phi_node->previous_variables[argument_index] = copy_reused_variable_id(ids,
+                                                                                   previous_phi_node->previous_variables[argument_index]);
+        }
+    }
+}
+
+// NOTE(vlad): Copies everything the previous compilation produced for the function, so that
+//             this context doesn't depend on the previous one after 'lower_ast_to_tac'.
+internal void
+copy_reused_tac_function(Compilation_Context* context, Reused_Tac_Ids* ids, Tac_Function* tac_function)
+{
+    Tac* tac = &context->tac;
+    const Compilation_Context* previous_context = ids->previous_context;
+
+    const Function_Fingerprint* fingerprint = &context->function_fingerprints[tac_function->ast_function_definition->fingerprint_index];
+    const Function_Fingerprint* previous_fingerprint = &previous_context->function_fingerprints[fingerprint->previous_function_index];
+    const Tac_Function* previous_function = &previous_context->tac.functions[fingerprint->previous_function_index];
+
+    ASSERT(previous_function->ast_function_definition == &previous_context->ast.function_definitions[fingerprint->previous_function_index]);
+
+    tac_function->is_reused = true;
+    tac_function->first_tac_variable_index = tac->variables_count;
+    tac_function->first_tac_label_index = tac->labels_count;
+
+    ids->variable_index_offset = tac->variables_count - previous_function->first_tac_variable_index;
+    ids->label_index_offset = tac->labels_count - previous_function->first_tac_label_index;
+    ids->source_offset = (fingerprint->text.data - context->source_file.code.data)
+                         - (previous_fingerprint->text.data - previous_context->source_file.code.data);
+
+    for (Index variable_index = previous_function->first_tac_variable_index;
+         variable_index < previous_function->last_tac_variable_index;
+         ++variable_index)
+    {
+        const Tac_Variable* previous_variable = &previous_context->tac.variables[variable_index];
+
+        const Tac_Variable_Id variable_id = create_tac_variable(context);
+        Tac_Variable* variable = get_tac_variable_by_id(tac, variable_id);
+
+        *variable = *previous_variable;
+        variable->is_reused = true;
+        variable->type_id = copy_type_of_previous_compilation(context, previous_context, ids->type_ids, previous_variable->type_id);
+
+        if (!previous_variable->is_temporary)
+        {
+            variable->symbol_id = copy_reused_symbol(context, ids, previous_variable->symbol_id);
+        }
+    }
+
+    for (Index label_index = previous_function->first_tac_label_index;
+         label_index < previous_function->last_tac_label_index;
+         ++label_index)
+    {
+        const Tac_Label* previous_label = &previous_context->tac.labels[label_index];
+
+        const Tac_Label_Id label_id = create_tac_label(context);
+        Tac_Label* label = get_tac_label_by_id(tac, label_id);
+
+        *label = *previous_label;
+        label->instruction_id.function_label_id = copy_reused_function_label_id(context,
+                                                                                ids,
+                                                                                previous_label->instruction_id.function_label_id);
+    }
+
+    tac_function->last_tac_variable_index = tac->variables_count;
+    tac_function->last_tac_label_index = tac->labels_count;
+
+    // NOTE(vlad): Reused functions are never changed, so they don't need arenas of their own,
+    //             thousands of small arenas would only cost memory mappings.
+    tac_function->instructions = allocate_uninitialized_array(context->tac_reused_function_instructions_arena,
+                                                              previous_function->instructions_count,
+                                                              Tac_Instruction);
+    tac_function->instructions_count = previous_function->instructions_count;
+    tac_function->instructions_capacity = previous_function->instructions_count;
+
+    for (Index instruction_index = 0;
+         instruction_index < previous_function->instructions_count;
+         ++instruction_index)
+    {
+        const Tac_Instruction* previous_instruction = &previous_function->instructions[instruction_index];
+        Tac_Instruction* instruction = &tac_function->instructions[instruction_index];
+
+        *instruction = *previous_instruction;
+        instruction->destination = copy_reused_tac_operand(context, ids, previous_instruction->destination);
+        instruction->first_argument = copy_reused_tac_operand(context, ids, previous_instruction->first_argument);
+        instruction->second_argument = copy_reused_tac_operand(context, ids, previous_instruction->second_argument);
+    }
+
+    for (Index block_index = 0;
+         block_index < previous_function->cfg_blocks_count;
+         ++block_index)
+    {
+        append_array(context->cfg_blocks_arena, tac_function->cfg_blocks, Cfg_Block, (Cfg_Block){0});
+        copy_reused_cfg_block(context,
+                              ids,
+                              &tac_function->cfg_blocks[tac_function->cfg_blocks_count - 1],
+                              &previous_function->cfg_blocks[block_index]);
+    }
+}
+
 internal void
 lower_ast_to_tac(Compilation_Context* context)
 {
@@ -1052,6 +1348,12 @@ lower_ast_to_tac(Compilation_Context* context)
         ASSERT(label_id.index == INVALID_TAC_INDEX);
     }
 
+    tac->expression_instructions_ranges = allocate_array(context->tac_expression_instructions_ranges_arena,
+                                                         ast->expressions_count,
+                                                         Tac_Instructions_Range);
+    tac->expression_instructions_ranges_count = ast->expressions_count;
+    tac->expression_instructions_ranges_capacity = ast->expressions_count;
+
     // NOTE(vlad): Creating variable ids for functions.
     {
         for (Index function_index = 0;
@@ -1072,6 +1374,12 @@ lower_ast_to_tac(Compilation_Context* context)
         }
     }
 
+    Reused_Tac_Ids reused_ids = {0};
+    if (context->previous_context != NULL)
+    {
+        reused_ids = create_reused_tac_ids(context, context->previous_context);
+    }
+
     for (Index function_index = 0;
          function_index < ast->function_definitions_count;
          ++function_index)
@@ -1094,10 +1402,16 @@ lower_ast_to_tac(Compilation_Context* context)
             tac_function->label_id = function_symbol->tac_instruction_id.function_label_id;
         }
 
+        if (ast_function->body_is_reused)
+        {
+            copy_reused_tac_function(context, &reused_ids, tac_function);
+            continue;
+        }
+
         tac_function->instructions_arena = acquire_arena_from_provider(context->arena_provider,
                                                                        string_view("tac-function-instructions"),
-                                                                       GiB(1),
-                                                                       MiB(1));
+                                                                       KiB(64),
+                                                                       KiB(4));
 
         tac_function->first_tac_variable_index = tac->variables_count;
         tac_function->first_tac_label_index = tac->labels_count;
@@ -1156,6 +1470,10 @@ lower_ast_to_tac(Compilation_Context* context)
         tac_function->last_tac_variable_index = tac->variables_count;
         tac_function->last_tac_label_index = tac->labels_count;
     }
+
+    // NOTE(vlad): Everything that is reused is copied by now.
+    context->previous_context = NULL;
+    request_arena_reset(context->arena_provider, context->scratch_arena);
 }
 
 internal const Ast_Statement*
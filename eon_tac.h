@@ -82,6 +82,7 @@ struct Tac_Variable
     Index max_ssa_version;
 
     Bool is_temporary;
+    Bool is_reused; // NOTE(vlad): See 'Tac_Function.is_reused'.
     union
     {
         Symbol_Id symbol_id;
@@ -182,6 +183,10 @@ struct Tac_Function
     const Ast_Function_Definition* ast_function_definition;
     Tac_Function_Label_Id label_id;
 
+    // NOTE(vlad): Copied from the previous compilation together with its CFG and SSA, the passes
+    //             after 'lower_ast_to_tac' skip it, see 'copy_reused_tac_function'.
+    Bool is_reused;
+
     Index first_tac_variable_index;
     Index last_tac_variable_index; // NOTE(vlad): This index is not included.
 
@@ -202,6 +207,9 @@ struct Tac
     array(Tac_Constant, constants);
     array(Tac_Label, labels);
 
+    // NOTE(vlad): Indexed by 'Ast_Expression_Id', filled by 'lower_ast_to_tac'.
+    array(Tac_Instructions_Range, expression_instructions_ranges);
+
     Cfg_Block_Id* label_index_to_cfg_block_id_map;
 };
 typedef struct Tac Tac;
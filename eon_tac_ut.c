@@ -255,11 +255,11 @@ test_expression_lowering(Test_Context* test_context)
 
             ASSERT_TRUE(statement->variable_definition.has_initial_value);
 
-            const Ast_Expression* initial_expression = &statement->variable_definition.initial_value;
+            const Ast_Expression* initial_expression = AST_EXPRESSION(statement->variable_definition.initial_value);
             ASSERT_ENUM_VALUES_ARE_EQUAL(initial_expression->kind, AST_EXPRESSION_NUMBER);
 
             {
-                const Tac_Instructions_Range* instructions_range = &initial_expression->tac_instructions_range;
+                const Tac_Instructions_Range* instructions_range = &context.tac.expression_instructions_ranges[statement->variable_definition.initial_value];
                 ASSERT_EQUAL(instructions_range->function_label_id.index, tac_function->label_id.index);
                 ASSERT_EQUAL(instructions_range->start_instruction_index, 0);
 
@@ -404,11 +404,11 @@ test_expression_lowering(Test_Context* test_context)
 
                 ASSERT_TRUE(statement->variable_definition.has_initial_value);
 
-                const Ast_Expression* initial_expression = &statement->variable_definition.initial_value;
+                const Ast_Expression* initial_expression = AST_EXPRESSION(statement->variable_definition.initial_value);
                 ASSERT_ENUM_VALUES_ARE_EQUAL(initial_expression->kind, AST_EXPRESSION_NUMBER);
 
                 {
-                    const Tac_Instructions_Range* instructions_range = &initial_expression->tac_instructions_range;
+                    const Tac_Instructions_Range* instructions_range = &context.tac.expression_instructions_ranges[statement->variable_definition.initial_value];
                     ASSERT_EQUAL(instructions_range->function_label_id.index, tac_function->label_id.index);
                     ASSERT_EQUAL(instructions_range->start_instruction_index, 0);
                     ASSERT_EQUAL(instructions_range->end_instruction_index, 0);
@@ -427,11 +427,11 @@ test_expression_lowering(Test_Context* test_context)
                 }
 
                 {
-                    const Ast_Expression* lhs = &statement->assignment.lhs;
+                    const Ast_Expression* lhs = AST_EXPRESSION(statement->assignment.lhs);
                     ASSERT_ENUM_VALUES_ARE_EQUAL(lhs->kind, AST_EXPRESSION_IDENTIFIER);
 
                     {
-                        const Tac_Instructions_Range* instructions_range = &lhs->tac_instructions_range;
+                        const Tac_Instructions_Range* instructions_range = &context.tac.expression_instructions_ranges[statement->assignment.lhs];
                         ASSERT_EQUAL(instructions_range->function_label_id.index, tac_function->label_id.index);
                         ASSERT_EQUAL(instructions_range->start_instruction_index, 1);
                         ASSERT_EQUAL(instructions_range->end_instruction_index, 1);
@@ -439,11 +439,11 @@ test_expression_lowering(Test_Context* test_context)
                 }
 
                 {
-                    const Ast_Expression* lhs = &statement->assignment.rhs;
+                    const Ast_Expression* lhs = AST_EXPRESSION(statement->assignment.rhs);
                     ASSERT_ENUM_VALUES_ARE_EQUAL(lhs->kind, AST_EXPRESSION_NUMBER);
 
                     {
-                        const Tac_Instructions_Range* instructions_range = &lhs->tac_instructions_range;
+                        const Tac_Instructions_Range* instructions_range = &context.tac.expression_instructions_ranges[statement->assignment.rhs];
                         ASSERT_EQUAL(instructions_range->function_label_id.index, tac_function->label_id.index);
                         ASSERT_EQUAL(instructions_range->start_instruction_index, 1);
                         ASSERT_EQUAL(instructions_range->end_instruction_index, 1);
@@ -5,6 +5,8 @@
 
 #include <eon/string.h>
 
+#include <eon/platform/threads.h>
+
 enum
 {
     UNDEFINED_TYPE_INDEX = 0,
@@ -69,6 +71,206 @@ create_new_type_variable(Compilation_Context* context)
     return type_variable_id;
 }
 
+internal inline u64
+hash_type(const Type type)
+{
+    u64 hash = hash_u64((u64)type.kind);
+
+    switch (type.kind)
+    {
+        case TYPE_INTEGER:
+        {
+            hash = hash_u64(hash ^ (u64)type.integer_info.width_in_bits ^ ((u64)type.integer_info.is_signed << 32));
+        } break;
+
+        case TYPE_FLOAT:
+        {
+            hash = hash_u64(hash ^ (u64)type.float_info.width_in_bits);
+        } break;
+
+        case TYPE_POINTER:
+        {
+            hash = hash_u64(hash ^ (u64)type.pointer_info.points_to_type_id.index ^ ((u64)type.pointer_info.pointee_is_mutable << 32));
+        } break;
+
+        case TYPE_FUNCTION:
+        {
+            const Function_Type_Info* type_info = &type.function_info;
+
+            hash = hash_u64(hash ^ (u64)type_info->return_type_id.index);
+            for (Index i = 0;
+                 i < type_info->parameter_type_ids_count;
+                 ++i)
+            {
+                hash = hash_u64(hash ^ (u64)type_info->parameter_type_ids[i].index);
+            }
+        } break;
+
+        default:
+        {
+            UNREACHABLE();
+        } break;
+    }
+
+    return hash;
+}
+
+internal inline Bool
+interned_types_are_equal(const Type lhs, const Type rhs)
+{
+    if (lhs.kind != rhs.kind)
+    {
+        return false;
+    }
+
+    switch (lhs.kind)
+    {
+        case TYPE_INTEGER:
+        {
+            return lhs.integer_info.width_in_bits == rhs.integer_info.width_in_bits
+                && lhs.integer_info.is_signed == rhs.integer_info.is_signed;
+        } break;
+
+        case TYPE_FLOAT:
+        {
+            return lhs.float_info.width_in_bits == rhs.float_info.width_in_bits;
+        } break;
+
+        case TYPE_POINTER:
+        {
+            return lhs.pointer_info.points_to_type_id.index == rhs.pointer_info.points_to_type_id.index
+                && lhs.pointer_info.pointee_is_mutable == rhs.pointer_info.pointee_is_mutable;
+        } break;
+
+        case TYPE_FUNCTION:
+        {
+            const Function_Type_Info* lhs_info = &lhs.function_info;
+            const Function_Type_Info* rhs_info = &rhs.function_info;
+
+            if (lhs_info->return_type_id.index != rhs_info->return_type_id.index
+                || lhs_info->parameter_type_ids_count != rhs_info->parameter_type_ids_count)
+            {
+                return false;
+            }
+
+            for (Index i = 0;
+                 i < lhs_info->parameter_type_ids_count;
+                 ++i)
+            {
+                if (lhs_info->parameter_type_ids[i].index != rhs_info->parameter_type_ids[i].index)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        } break;
+
+        default:
+        {
+            UNREACHABLE();
+        } break;
+    }
+
+    return false;
+}
+
+internal inline Bool
+type_never_changes(const Type* type)
+{
+    return type->is_interned || type->kind == TYPE_VOID || type->kind == TYPE_BOOLEAN;
+}
+
+// NOTE(vlad): Replaces the type id with its root and tells whether that root can be a part
+//             of an interned type, i.e. it will never change.
+internal Bool
+resolve_interned_type_part(Compilation_Context* context, Type_Id* type_id)
+{
+    *type_id = find_root_type_id(context, *type_id);
+    return type_never_changes(get_exact_type_by_id(context, *type_id));
+}
+
+// NOTE(vlad): Creates an integer, float, pointer or function type, or returns the existing one
+//             with the same contents. Types that refer to type variables can't be interned because
+//             they change as variables are unified, so they are always created anew.
+//             Parameter type ids of a function are replaced with their roots in place, a new type
+//             keeps the array.
+internal Type_Id
+intern_type(Compilation_Context* context, const Type* type)
+{
+    Type key = {0};
+    key.kind = type->kind;
+
+    Bool can_be_interned = true;
+
+    switch (type->kind)
+    {
+        case TYPE_INTEGER:
+        {
+            key.integer_info = type->integer_info;
+        } break;
+
+        case TYPE_FLOAT:
+        {
+            key.float_info = type->float_info;
+        } break;
+
+        case TYPE_POINTER:
+        {
+            key.pointer_info = type->pointer_info;
+            can_be_interned = resolve_interned_type_part(context, &key.pointer_info.points_to_type_id);
+        } break;
+
+        case TYPE_FUNCTION:
+        {
+            key.function_info = type->function_info;
+            can_be_interned = resolve_interned_type_part(context, &key.function_info.return_type_id);
+
+            for (Index i = 0;
+                 i < key.function_info.parameter_type_ids_count;
+                 ++i)
+            {
+                can_be_interned &= resolve_interned_type_part(context, &key.function_info.parameter_type_ids[i]);
+            }
+        } break;
+
+        default:
+        {
+            UNREACHABLE();
+        } break;
+    }
+
+    if (can_be_interned)
+    {
+        Index slot_index = 0;
+        hash_map_find(context->interned_type_ids, Type, key, hash_type, interned_types_are_equal, slot_index);
+
+        if (slot_index != -1)
+        {
+            return context->interned_type_ids[slot_index];
+        }
+    }
+
+    key.is_interned = (Bool8)can_be_interned;
+
+    const Type_Id type_id = create_type(context);
+    *get_exact_type_by_id(context, type_id) = key;
+
+    if (can_be_interned)
+    {
+        hash_map_insert(context->interned_types_arena,
+                        context->interned_type_ids,
+                        Type,
+                        Type_Id,
+                        key,
+                        type_id,
+                        hash_type,
+                        interned_types_are_equal);
+    }
+
+    return type_id;
+}
+
 internal Bool variable_type_is_valid(Compilation_Context* context,
                                      const Type_Id variable_type_id,
                                      const Source_Location* variable_location);
@@ -161,13 +363,13 @@ create_builtin_types(Compilation_Context* context)
     {
         const Integer_Builtin_Type* builtin_type = &integer_builtin_types[i];
 
-        const Type_Id integer_type_id = create_type(context);
-        ASSERT(type_id_is_valid(context, integer_type_id));
+        Type integer_type = {0};
+        integer_type.kind = TYPE_INTEGER;
+        integer_type.integer_info.width_in_bits = builtin_type->width_in_bits;
+        integer_type.integer_info.is_signed = builtin_type->is_signed;
 
-        Type* integer_type = get_type_by_id(context, integer_type_id);
-        integer_type->kind = TYPE_INTEGER;
-        integer_type->integer_info.width_in_bits = builtin_type->width_in_bits;
-        integer_type->integer_info.is_signed = builtin_type->is_signed;
+        const Type_Id integer_type_id = intern_type(context, &integer_type);
+        ASSERT(type_id_is_valid(context, integer_type_id));
 
         bind_type_id_to_a_builtin_symbol(context, builtin_type->name, integer_type_id);
     }
@@ -179,12 +381,12 @@ create_builtin_types(Compilation_Context* context)
     {
         const Float_Builtin_Type* builtin_type = &float_builtin_types[i];
 
-        const Type_Id float_type_id = create_type(context);
-        ASSERT(type_id_is_valid(context, float_type_id));
+        Type float_type = {0};
+        float_type.kind = TYPE_FLOAT;
+        float_type.float_info.width_in_bits = builtin_type->width_in_bits;
 
-        Type* float_type = get_type_by_id(context, float_type_id);
-        float_type->kind = TYPE_FLOAT;
-        float_type->float_info.width_in_bits = builtin_type->width_in_bits;
+        const Type_Id float_type_id = intern_type(context, &float_type);
+        ASSERT(type_id_is_valid(context, float_type_id));
 
         bind_type_id_to_a_builtin_symbol(context, builtin_type->name, float_type_id);
     }
@@ -225,6 +427,35 @@ get_max_integer_value(const Integer_Type_Info* type_info)
     }
 }
 
+// NOTE(vlad): Expects roots with different ids. Interned ones have different contents then, but
+//             pointers are still compared by their pointees: '* mutable T' is accepted as '* T'.
+internal inline Bool
+interned_types_are_different(const Type* lhs_root_type, const Type* rhs_root_type)
+{
+    return lhs_root_type->is_interned
+        && rhs_root_type->is_interned
+        && lhs_root_type->kind != TYPE_POINTER;
+}
+
+// NOTE(vlad): Links one root under another. The caller decides the direction because a root
+//             carries the type of the whole set, so only type variables can be linked freely.
+internal void
+link_root_types(Compilation_Context* context, const Type_Id child_root_type_id, const Type_Id parent_root_type_id)
+{
+    Type* child_root_type = get_exact_type_by_id(context, child_root_type_id);
+    Type* parent_root_type = get_exact_type_by_id(context, parent_root_type_id);
+
+    ASSERT(type_is_a_root_node(child_root_type));
+    ASSERT(type_is_a_root_node(parent_root_type));
+
+    child_root_type->parent_type_id = parent_root_type_id;
+
+    if (parent_root_type->rank <= child_root_type->rank && child_root_type->rank < MAX_VALUE(u8))
+    {
+        parent_root_type->rank = (u8)(child_root_type->rank + 1);
+    }
+}
+
 // FIXME(vlad): Add Source_Location that triggered this unification.
 internal Bool
 try_to_unify_types(Compilation_Context* context,
@@ -250,15 +481,30 @@ try_to_unify_types(Compilation_Context* context,
         return true;
     }
 
+    if (lhs_root_type->kind == TYPE_VARIABLE && rhs_root_type->kind == TYPE_VARIABLE)
+    {
+        // NOTE(vlad): Union by rank, so chains of inferred variables stay shallow.
+        if (lhs_root_type->rank > rhs_root_type->rank)
+        {
+            link_root_types(context, rhs_root_type_id, lhs_root_type_id);
+        }
+        else
+        {
+            link_root_types(context, lhs_root_type_id, rhs_root_type_id);
+        }
+
+        return true;
+    }
+
     if (lhs_root_type->kind == TYPE_VARIABLE)
     {
-        lhs_root_type->parent_type_id = rhs_root_type_id;
+        link_root_types(context, lhs_root_type_id, rhs_root_type_id);
         return true;
     }
 
     if (rhs_root_type->kind == TYPE_VARIABLE)
     {
-        rhs_root_type->parent_type_id = lhs_root_type_id;
+        link_root_types(context, rhs_root_type_id, lhs_root_type_id);
         return true;
     }
 
@@ -298,17 +544,15 @@ try_to_unify_types(Compilation_Context* context,
         Type* created_type = get_type_by_id(context, unified_type_id);
         *created_type = unified_type;
 
-        // NOTE(vlad): Fetching root types again because they can be invalidated after the 'create_type()' function call.
-        lhs_root_type = get_type_by_id(context, lhs_root_type_id);
-        rhs_root_type = get_type_by_id(context, rhs_root_type_id);
-        lhs_root_type->parent_type_id = unified_type_id;
-        rhs_root_type->parent_type_id = unified_type_id;
+        link_root_types(context, lhs_root_type_id, unified_type_id);
+        link_root_types(context, rhs_root_type_id, unified_type_id);
 
         return true;
     }
     else if (lhs_root_type->kind == TYPE_NUMBER_VARIABLE || rhs_root_type->kind == TYPE_NUMBER_VARIABLE)
     {
-        const Type_Id other_type_id = lhs_root_type->kind != TYPE_NUMBER_VARIABLE ? lhs_type_id : rhs_type_id;
+        const Type_Id number_variable_type_id = lhs_root_type->kind == TYPE_NUMBER_VARIABLE ? lhs_root_type_id : rhs_root_type_id;
+        const Type_Id other_type_id           = lhs_root_type->kind != TYPE_NUMBER_VARIABLE ? lhs_root_type_id : rhs_root_type_id;
 
         Type* number_variable_type = lhs_root_type->kind == TYPE_NUMBER_VARIABLE ? lhs_root_type : rhs_root_type;
         Type* other_type           = lhs_root_type->kind != TYPE_NUMBER_VARIABLE ? lhs_root_type : rhs_root_type;
@@ -339,7 +583,7 @@ try_to_unify_types(Compilation_Context* context,
             return false;
         }
 
-        number_variable_type->parent_type_id = other_type_id;
+        link_root_types(context, number_variable_type_id, other_type_id);
         return true;
     }
 
@@ -350,6 +594,11 @@ try_to_unify_types(Compilation_Context* context,
         return false;
     }
 
+    if (interned_types_are_different(lhs_root_type, rhs_root_type))
+    {
+        return false;
+    }
+
     switch (lhs_root_type->kind)
     {
         case TYPE_UNDEFINED:
@@ -440,6 +689,11 @@ types_are_equal(Compilation_Context* context,
         return false;
     }
 
+    if (interned_types_are_different(lhs_root_type, rhs_root_type))
+    {
+        return false;
+    }
+
     switch (lhs_root_type->kind)
     {
         case TYPE_UNDEFINED:
@@ -588,20 +842,22 @@ resolve_type_by_ast_type(Compilation_Context* context,
             const Type_Id points_to_type_id = resolve_type_by_ast_type(context,
                                                                        ast_pointer_type->pointed_to);
 
-            const Type_Id pointer_type_id = create_type(context);
-
-            Type* pointer_type = get_type_by_id(context, pointer_type_id);
-            pointer_type->kind = TYPE_POINTER;
-            pointer_type->pointer_info.points_to_type_id = points_to_type_id;
-            pointer_type->pointer_info.pointee_is_mutable = ast_pointer_type->pointed_to->is_mutable;
+            Type pointer_type = {0};
+            pointer_type.kind = TYPE_POINTER;
+            pointer_type.pointer_info.points_to_type_id = points_to_type_id;
+            pointer_type.pointer_info.pointee_is_mutable = ast_pointer_type->pointed_to->is_mutable;
 
-            ast_type->type_id = pointer_type_id;
+            ast_type->type_id = intern_type(context, &pointer_type);
         } break;
 
         case AST_TYPE_FUNCTION:
         {
             Ast_Function_Type* ast_function_type = &ast_type->function;
 
+            const Index parameter_type_ids_position = arena_get_position(context->parameter_type_ids_arena);
+
+            Index parameter_type_ids_end_position = parameter_type_ids_position;
+
             Type_Id* parameter_type_ids = NULL;
 
             if (ast_function_type->parameters_count != 0)
@@ -609,6 +865,7 @@ resolve_type_by_ast_type(Compilation_Context* context,
                 parameter_type_ids = allocate_array(context->parameter_type_ids_arena,
                                                     ast_function_type->parameters_count,
                                                     Type_Id);
+                parameter_type_ids_end_position = arena_get_position(context->parameter_type_ids_arena);
 
                 for (Index parameter_index = 0;
                      parameter_index < ast_function_type->parameters_count;
@@ -626,16 +883,24 @@ resolve_type_by_ast_type(Compilation_Context* context,
             const Type_Id return_type_id = resolve_type_by_ast_type(context,
                                                                     ast_function_type->return_type);
 
-            const Type_Id function_type_id = create_type(context);
-            Type* function_type = get_type_by_id(context, function_type_id);
-            function_type->kind = TYPE_FUNCTION;
+            Type function_type = {0};
+            function_type.kind = TYPE_FUNCTION;
 
-            Function_Type_Info* type_info = &function_type->function_info;
+            Function_Type_Info* type_info = &function_type.function_info;
             type_info->parameter_type_ids = parameter_type_ids;
             type_info->parameter_type_ids_count = ast_function_type->parameters_count;
             type_info->return_type_id = return_type_id;
 
-            ast_type->type_id = function_type_id;
+            ast_type->type_id = intern_type(context, &function_type);
+
+            // NOTE(vlad): An equal function type already exists and has its own parameters, so ours
+            //             can be freed unless something else was allocated after them.
+            const Type* interned_function_type = get_exact_type_by_id(context, ast_type->type_id);
+            if (interned_function_type->function_info.parameter_type_ids != parameter_type_ids
+                && arena_get_position(context->parameter_type_ids_arena) == parameter_type_ids_end_position)
+            {
+                arena_pop_to_position(context->parameter_type_ids_arena, parameter_type_ids_position);
+            }
         } break;
 
         case AST_TYPE_OMITTED:
@@ -720,8 +985,11 @@ struct Expression_Result
 typedef struct Expression_Result Expression_Result;
 
 internal Expression_Result
-resolve_types_in_expression(Compilation_Context* context, Ast_Expression* expression)
+resolve_types_in_expression(Compilation_Context* context, const Ast_Expression_Id expression_id)
 {
+    Ast_Expression* expression = get_ast_expression_by_id(&context->ast, expression_id);
+    Type_Id* expression_type_id = &context->expression_type_ids[expression_id];
+
     Expression_Result result = {0};
 
     switch (expression->kind)
@@ -765,7 +1033,7 @@ resolve_types_in_expression(Compilation_Context* context, Ast_Expression* expres
                     error.text = string_view(error_text);
                     emit_diagnostic_message(context, &error);
 
-                    expression->type_id.index = INVALID_TYPE_INDEX;
+                    expression_type_id->index = INVALID_TYPE_INDEX;
                     result.type_id.index = INVALID_TYPE_INDEX;
                     return result;
                 }
@@ -792,7 +1060,7 @@ resolve_types_in_expression(Compilation_Context* context, Ast_Expression* expres
                 }
             }
 
-            expression->type_id = number_type_id;
+            *expression_type_id = number_type_id;
             result.type_id = number_type_id;
         } break;
 
@@ -807,7 +1075,7 @@ resolve_types_in_expression(Compilation_Context* context, Ast_Expression* expres
             Symbol* symbol = get_symbol_for_identifier(context, identifier);
             ASSERT(type_id_is_defined(symbol->type_id));
 
-            expression->type_id = symbol->type_id;
+            *expression_type_id = symbol->type_id;
             result.type_id = symbol->type_id;
             result.is_lvalue = true;
             result.is_mutable = symbol->binding_is_mutable;
@@ -858,13 +1126,9 @@ resolve_types_in_expression(Compilation_Context* context, Ast_Expression* expres
                 error.level = MESSAGE_LEVEL_ERROR;
                 error.location = expression->location;
 
-                const String_View lhs_type_string = convert_type_to_string(context->diagnostic_message_texts_arena,
-                                                                           context,
-                                                                           lhs_result.type_id);
+                const String_View lhs_type_string = convert_type_to_string(context, lhs_result.type_id);
 
-                const String_View rhs_type_string = convert_type_to_string(context->diagnostic_message_texts_arena,
-                                                                           context,
-                                                                           rhs_result.type_id);
+                const String_View rhs_type_string = convert_type_to_string(context, rhs_result.type_id);
 
                 const String error_text = format_string(context->diagnostic_message_texts_arena,
                                                         "Cannot {} expressions of different types '{}' and '{}'",
@@ -875,7 +1139,7 @@ resolve_types_in_expression(Compilation_Context* context, Ast_Expression* expres
                 error.text = string_view(error_text);
                 emit_diagnostic_message(context, &error);
 
-                expression->type_id.index = INVALID_TYPE_INDEX;
+                expression_type_id->index = INVALID_TYPE_INDEX;
                 result.type_id.index = INVALID_TYPE_INDEX;
                 return result;
             }
@@ -908,9 +1172,7 @@ resolve_types_in_expression(Compilation_Context* context, Ast_Expression* expres
                     error.level = MESSAGE_LEVEL_ERROR;
                     error.location = expression->location;
 
-                    const String_View lhs_type_string = convert_type_to_string(context->diagnostic_message_texts_arena,
-                                                                               context,
-                                                                               lhs_result.type_id);
+                    const String_View lhs_type_string = convert_type_to_string(context, lhs_result.type_id);
 
                     const String error_text = format_string(context->diagnostic_message_texts_arena,
                                                             "Cannot {} expressions of type '{}'",
@@ -920,13 +1182,13 @@ resolve_types_in_expression(Compilation_Context* context, Ast_Expression* expres
                     error.text = string_view(error_text);
                     emit_diagnostic_message(context, &error);
 
-                    expression->type_id.index = INVALID_TYPE_INDEX;
+                    expression_type_id->index = INVALID_TYPE_INDEX;
                     result.type_id.index = INVALID_TYPE_INDEX;
                     return result;
                 } break;
             }
 
-            expression->type_id = lhs_result.type_id;
+            *expression_type_id = lhs_result.type_id;
             result.type_id = lhs_result.type_id;
         } break;
 
@@ -948,13 +1210,9 @@ resolve_types_in_expression(Compilation_Context* context, Ast_Expression* expres
                 error.level = MESSAGE_LEVEL_ERROR;
                 error.location = expression->location;
 
-                const String_View lhs_type_string = convert_type_to_string(context->diagnostic_message_texts_arena,
-                                                                           context,
-                                                                           lhs_result.type_id);
+                const String_View lhs_type_string = convert_type_to_string(context, lhs_result.type_id);
 
-                const String_View rhs_type_string = convert_type_to_string(context->diagnostic_message_texts_arena,
-                                                                           context,
-                                                                           rhs_result.type_id);
+                const String_View rhs_type_string = convert_type_to_string(context, rhs_result.type_id);
 
                 const String error_text = format_string(context->diagnostic_message_texts_arena,
                                                         "Cannot compare expressions of different types '{}' and '{}'",
@@ -964,7 +1222,7 @@ resolve_types_in_expression(Compilation_Context* context, Ast_Expression* expres
                 error.text = string_view(error_text);
                 emit_diagnostic_message(context, &error);
 
-                expression->type_id.index = INVALID_TYPE_INDEX;
+                expression_type_id->index = INVALID_TYPE_INDEX;
                 result.type_id.index = INVALID_TYPE_INDEX;
                 return result;
             }
@@ -998,9 +1256,7 @@ resolve_types_in_expression(Compilation_Context* context, Ast_Expression* expres
                     error.level = MESSAGE_LEVEL_ERROR;
                     error.location = expression->location;
 
-                    const String_View lhs_type_string = convert_type_to_string(context->diagnostic_message_texts_arena,
-                                                                               context,
-                                                                               lhs_result.type_id);
+                    const String_View lhs_type_string = convert_type_to_string(context, lhs_result.type_id);
 
                     const String error_text = format_string(context->diagnostic_message_texts_arena,
                                                             "Expressions of type '{}' cannot be compared.",
@@ -1009,14 +1265,14 @@ resolve_types_in_expression(Compilation_Context* context, Ast_Expression* expres
                     error.text = string_view(error_text);
                     emit_diagnostic_message(context, &error);
 
-                    expression->type_id.index = INVALID_TYPE_INDEX;
+                    expression_type_id->index = INVALID_TYPE_INDEX;
                     result.type_id.index = INVALID_TYPE_INDEX;
                     return result;
                 } break;
             }
 
             const Type_Id boolean_type_id = get_boolean_type_id(context);
-            expression->type_id = boolean_type_id;
+            *expression_type_id = boolean_type_id;
             result.type_id = boolean_type_id;
         } break;
 
@@ -1035,7 +1291,7 @@ resolve_types_in_expression(Compilation_Context* context, Ast_Expression* expres
 
             if (type_id_is_invalid(context, expression_result.type_id))
             {
-                expression->type_id.index = INVALID_TYPE_INDEX;
+                expression_type_id->index = INVALID_TYPE_INDEX;
                 result.type_id.index = INVALID_TYPE_INDEX;
                 return result;
             }
@@ -1045,11 +1301,9 @@ resolve_types_in_expression(Compilation_Context* context, Ast_Expression* expres
             {
                 Diagnostic_Message error = {0};
                 error.level = MESSAGE_LEVEL_ERROR;
-                error.location = dereference->operand->location;
+                error.location = get_ast_expression_by_id(&context->ast, dereference->operand)->location;
 
-                const String_View expression_type_string = convert_type_to_string(context->diagnostic_message_texts_arena,
-                                                                                  context,
-                                                                                  expression_result.type_id);
+                const String_View expression_type_string = convert_type_to_string(context, expression_result.type_id);
 
                 const String error_text = format_string(context->diagnostic_message_texts_arena,
                                                         "Cannot dereference a non-pointer type '{}'",
@@ -1058,14 +1312,14 @@ resolve_types_in_expression(Compilation_Context* context, Ast_Expression* expres
                 error.text = string_view(error_text);
                 emit_diagnostic_message(context, &error);
 
-                expression->type_id.index = INVALID_TYPE_INDEX;
+                expression_type_id->index = INVALID_TYPE_INDEX;
                 result.type_id.index = INVALID_TYPE_INDEX;
                 return result;
             }
 
             const Type_Id dereferenced_type_id = expression_type->pointer_info.points_to_type_id;
 
-            expression->type_id = dereferenced_type_id;
+            *expression_type_id = dereferenced_type_id;
             result.type_id = dereferenced_type_id;
             result.is_lvalue = true;
             result.is_mutable = expression_type->pointer_info.pointee_is_mutable;
@@ -1080,22 +1334,23 @@ resolve_types_in_expression(Compilation_Context* context, Ast_Expression* expres
             {
                 Diagnostic_Message error = {0};
                 error.level = MESSAGE_LEVEL_ERROR;
-                error.location = address_of->operand->location;
+                error.location = get_ast_expression_by_id(&context->ast, address_of->operand)->location;
                 error.text = string_view("Cannot take address of a non-lvalue expression");
                 emit_diagnostic_message(context, &error);
 
-                expression->type_id.index = INVALID_TYPE_INDEX;
+                expression_type_id->index = INVALID_TYPE_INDEX;
                 result.type_id.index = INVALID_TYPE_INDEX;
                 return result;
             }
 
-            const Type_Id pointer_type_id = create_type(context);
-            Type* pointer_type = get_type_by_id(context, pointer_type_id);
-            pointer_type->kind = TYPE_POINTER;
-            pointer_type->pointer_info.points_to_type_id = points_to_result.type_id;
-            pointer_type->pointer_info.pointee_is_mutable = points_to_result.is_mutable;
+            Type pointer_type = {0};
+            pointer_type.kind = TYPE_POINTER;
+            pointer_type.pointer_info.points_to_type_id = points_to_result.type_id;
+            pointer_type.pointer_info.pointee_is_mutable = points_to_result.is_mutable;
 
-            expression->type_id = pointer_type_id;
+            const Type_Id pointer_type_id = intern_type(context, &pointer_type);
+
+            *expression_type_id = pointer_type_id;
             result.type_id = pointer_type_id;
         } break;
 
@@ -1112,11 +1367,9 @@ resolve_types_in_expression(Compilation_Context* context, Ast_Expression* expres
             {
                 Diagnostic_Message error = {0};
                 error.level = MESSAGE_LEVEL_ERROR;
-                error.location = call->called_expression->location;
+                error.location = get_ast_expression_by_id(&context->ast, call->called_expression)->location;
 
-                const String_View expression_type_string = convert_type_to_string(context->diagnostic_message_texts_arena,
-                                                                                  context,
-                                                                                  called_result.type_id);
+                const String_View expression_type_string = convert_type_to_string(context, called_result.type_id);
 
                 const String error_text = format_string(context->diagnostic_message_texts_arena,
                                                         "Expression of type '{}' is not callable",
@@ -1125,7 +1378,7 @@ resolve_types_in_expression(Compilation_Context* context, Ast_Expression* expres
                 error.text = string_view(error_text);
                 emit_diagnostic_message(context, &error);
 
-                expression->type_id.index = INVALID_TYPE_INDEX;
+                expression_type_id->index = INVALID_TYPE_INDEX;
                 result.type_id.index = INVALID_TYPE_INDEX;
                 return result;
             }
@@ -1136,7 +1389,7 @@ resolve_types_in_expression(Compilation_Context* context, Ast_Expression* expres
             {
                 Diagnostic_Message error = {0};
                 error.level = MESSAGE_LEVEL_ERROR;
-                error.location = call->called_expression->location;
+                error.location = get_ast_expression_by_id(&context->ast, call->called_expression)->location;
 
                 const String error_text = format_string(context->diagnostic_message_texts_arena,
                                                         "Too many arguments provided to a function call, expected {}, got {}",
@@ -1146,7 +1399,7 @@ resolve_types_in_expression(Compilation_Context* context, Ast_Expression* expres
                 error.text = string_view(error_text);
                 emit_diagnostic_message(context, &error);
 
-                expression->type_id.index = INVALID_TYPE_INDEX;
+                expression_type_id->index = INVALID_TYPE_INDEX;
                 result.type_id.index = INVALID_TYPE_INDEX;
                 return result;
             }
@@ -1162,9 +1415,10 @@ resolve_types_in_expression(Compilation_Context* context, Ast_Expression* expres
                  parameter_index < call->arguments_count;
                  ++parameter_index)
             {
-                Ast_Expression* parameter = call->arguments[parameter_index];
+                const Ast_Expression_Id parameter_id = get_ast_call_argument_id(&context->ast, call, parameter_index);
+                const Ast_Expression* parameter = get_ast_expression_by_id(&context->ast, parameter_id);
 
-                const Expression_Result parameter_result = resolve_types_in_expression(context, parameter);
+                const Expression_Result parameter_result = resolve_types_in_expression(context, parameter_id);
                 const Type_Id expected_type_id = parameter_type_ids[parameter_index];
 
                 if (!try_to_unify_types(context, expected_type_id, parameter_result.type_id))
@@ -1173,12 +1427,8 @@ resolve_types_in_expression(Compilation_Context* context, Ast_Expression* expres
                     error.level = MESSAGE_LEVEL_ERROR;
                     error.location = parameter->location;
 
-                    const String_View actual_type_string = convert_type_to_string(context->diagnostic_message_texts_arena,
-                                                                                  context,
-                                                                                  parameter_result.type_id);
-                    const String_View expected_type_string = convert_type_to_string(context->diagnostic_message_texts_arena,
-                                                                                    context,
-                                                                                    expected_type_id);
+                    const String_View actual_type_string = convert_type_to_string(context, parameter_result.type_id);
+                    const String_View expected_type_string = convert_type_to_string(context, expected_type_id);
 
                     const String error_text = format_string(context->diagnostic_message_texts_arena,
                                                             "Passing expression of type '{}' to parameter of type '{}'",
@@ -1188,18 +1438,18 @@ resolve_types_in_expression(Compilation_Context* context, Ast_Expression* expres
                     error.text = string_view(error_text);
                     emit_diagnostic_message(context, &error);
 
-                    expression->type_id.index = INVALID_TYPE_INDEX;
+                    expression_type_id->index = INVALID_TYPE_INDEX;
                     result.type_id.index = INVALID_TYPE_INDEX;
                     return result;
                 }
             }
 
-            expression->type_id = return_type_id;
+            *expression_type_id = return_type_id;
             result.type_id = return_type_id;
         } break;
     }
 
-    ASSERT(type_id_is_defined(expression->type_id));
+    ASSERT(type_id_is_defined(*expression_type_id));
     ASSERT(type_id_is_defined(result.type_id));
     return result;
 }
@@ -1231,20 +1481,17 @@ resolve_types_in_code_block(Compilation_Context* context,
                 if (definition->has_initial_value)
                 {
                     const Expression_Result initial_value = resolve_types_in_expression(context,
-                                                                                        &definition->initial_value);
+                                                                                        definition->initial_value);
 
                     if (!try_to_unify_types(context, variable_symbol->type_id, initial_value.type_id))
                     {
                         Diagnostic_Message error = {0};
                         error.level = MESSAGE_LEVEL_ERROR;
-                        error.location = definition->initial_value.location;
+                        error.location = get_ast_expression_by_id(&context->ast, definition->initial_value)->location;
 
-                        const String_View expected_type_string = convert_type_to_string(context->diagnostic_message_texts_arena,
-                                                                                        context,
+                        const String_View expected_type_string = convert_type_to_string(context,
                                                                                         variable_symbol->type_id);
-                        const String_View actual_type_string = convert_type_to_string(context->diagnostic_message_texts_arena,
-                                                                                      context,
-                                                                                      initial_value.type_id);
+                        const String_View actual_type_string = convert_type_to_string(context, initial_value.type_id);
 
                         const String error_text = format_string(context->diagnostic_message_texts_arena,
                                                                 "Cannot initialise variable of type '{}' with expression of type '{}'",
@@ -1269,21 +1516,17 @@ resolve_types_in_code_block(Compilation_Context* context,
             {
                 Ast_Assignment* assignment = &statement->assignment;
 
-                const Expression_Result lhs = resolve_types_in_expression(context, &assignment->lhs);
-                const Expression_Result rhs = resolve_types_in_expression(context, &assignment->rhs);
+                const Expression_Result lhs = resolve_types_in_expression(context, assignment->lhs);
+                const Expression_Result rhs = resolve_types_in_expression(context, assignment->rhs);
 
                 if (!try_to_unify_types(context, lhs.type_id, rhs.type_id))
                 {
                     Diagnostic_Message error = {0};
                     error.level = MESSAGE_LEVEL_ERROR;
-                    error.location = assignment->rhs.location;
+                    error.location = get_ast_expression_by_id(&context->ast, assignment->rhs)->location;
 
-                    const String_View expected_type_string = convert_type_to_string(context->diagnostic_message_texts_arena,
-                                                                                    context,
-                                                                                    lhs.type_id);
-                    const String_View actual_type_string = convert_type_to_string(context->diagnostic_message_texts_arena,
-                                                                                  context,
-                                                                                  rhs.type_id);
+                    const String_View expected_type_string = convert_type_to_string(context, lhs.type_id);
+                    const String_View actual_type_string = convert_type_to_string(context, rhs.type_id);
 
                     const String error_text = format_string(context->diagnostic_message_texts_arena,
                                                             "Type mismatch: expected '{}', got '{}'",
@@ -1299,7 +1542,7 @@ resolve_types_in_code_block(Compilation_Context* context,
                 {
                     Diagnostic_Message error = {0};
                     error.level = MESSAGE_LEVEL_ERROR;
-                    error.location = assignment->lhs.location;
+                    error.location = get_ast_expression_by_id(&context->ast, assignment->lhs)->location;
                     error.text = string_view("lvalue is required as a LHS of assignment");
                     emit_diagnostic_message(context, &error);
                     return false;
@@ -1309,7 +1552,7 @@ resolve_types_in_code_block(Compilation_Context* context,
                 {
                     Diagnostic_Message error = {0};
                     error.level = MESSAGE_LEVEL_ERROR;
-                    error.location = assignment->lhs.location;
+                    error.location = get_ast_expression_by_id(&context->ast, assignment->lhs)->location;
                     error.text = string_view("Read-only location is not assignable");
                     emit_diagnostic_message(context, &error);
                     return false;
@@ -1327,7 +1570,7 @@ resolve_types_in_code_block(Compilation_Context* context,
                 }
                 else
                 {
-                    return_result = resolve_types_in_expression(context, &return_statement->expression);
+                    return_result = resolve_types_in_expression(context, return_statement->expression);
                 }
 
                 if (type_id_is_valid(context, return_result.type_id))
@@ -1343,15 +1586,12 @@ resolve_types_in_code_block(Compilation_Context* context,
                         }
                         else
                         {
-                            error.location = return_statement->expression.location;
+                            error.location = get_ast_expression_by_id(&context->ast, return_statement->expression)->location;
                         }
 
-                        const String_View expected_type_string = convert_type_to_string(context->diagnostic_message_texts_arena,
-                                                                                        context,
+                        const String_View expected_type_string = convert_type_to_string(context,
                                                                                         expected_return_type_id);
-                        const String_View actual_type_string = convert_type_to_string(context->diagnostic_message_texts_arena,
-                                                                                      context,
-                                                                                      return_result.type_id);
+                        const String_View actual_type_string = convert_type_to_string(context, return_result.type_id);
 
                         const String error_text = format_string(context->diagnostic_message_texts_arena,
                                                                 "Return type mismatch: expected '{}', got '{}'",
@@ -1382,9 +1622,9 @@ resolve_types_in_code_block(Compilation_Context* context,
                 Ast_While_Statement* while_statement = &statement->while_statement;
 
                 {
-                    Ast_Expression* condition = &while_statement->condition;
+                    const Ast_Expression* condition = get_ast_expression_by_id(&context->ast, while_statement->condition);
 
-                    const Expression_Result condition_result = resolve_types_in_expression(context, condition);
+                    const Expression_Result condition_result = resolve_types_in_expression(context, while_statement->condition);
                     const Type_Id boolean_type_id = get_boolean_type_id(context);
 
                     if (!try_to_unify_types(context, condition_result.type_id, boolean_type_id))
@@ -1394,11 +1634,8 @@ resolve_types_in_code_block(Compilation_Context* context,
 
                         error.location = condition->location;
 
-                        const String_View expected_type_string = convert_type_to_string(context->diagnostic_message_texts_arena,
-                                                                                        context,
-                                                                                        boolean_type_id);
-                        const String_View actual_type_string = convert_type_to_string(context->diagnostic_message_texts_arena,
-                                                                                      context,
+                        const String_View expected_type_string = convert_type_to_string(context, boolean_type_id);
+                        const String_View actual_type_string = convert_type_to_string(context,
                                                                                       condition_result.type_id);
 
                         const String error_text = format_string(context->diagnostic_message_texts_arena,
@@ -1432,8 +1669,8 @@ resolve_types_in_code_block(Compilation_Context* context,
                 Ast_If_Statement* if_statement = &statement->if_statement;
 
                 {
-                    Ast_Expression* condition = &if_statement->condition;
-                    const Expression_Result condition_result = resolve_types_in_expression(context, condition);
+                    const Ast_Expression* condition = get_ast_expression_by_id(&context->ast, if_statement->condition);
+                    const Expression_Result condition_result = resolve_types_in_expression(context, if_statement->condition);
                     const Type_Id boolean_type_id = get_boolean_type_id(context);
 
                     if (!try_to_unify_types(context, condition_result.type_id, boolean_type_id))
@@ -1443,11 +1680,8 @@ resolve_types_in_code_block(Compilation_Context* context,
 
                         error.location = condition->location;
 
-                        const String_View expected_type_string = convert_type_to_string(context->diagnostic_message_texts_arena,
-                                                                                        context,
-                                                                                        boolean_type_id);
-                        const String_View actual_type_string = convert_type_to_string(context->diagnostic_message_texts_arena,
-                                                                                      context,
+                        const String_View expected_type_string = convert_type_to_string(context, boolean_type_id);
+                        const String_View actual_type_string = convert_type_to_string(context,
                                                                                       condition_result.type_id);
 
                         const String error_text = format_string(context->diagnostic_message_texts_arena,
@@ -1496,7 +1730,7 @@ resolve_types_in_code_block(Compilation_Context* context,
             {
                 Ast_Call_Statement* call_statement = &statement->call_statement;
 
-                const Expression_Result return_result = resolve_types_in_expression(context, &call_statement->call_expression);
+                const Expression_Result return_result = resolve_types_in_expression(context, call_statement->call_expression);
                 ASSERT(type_id_is_defined(return_result.type_id));
 
                 if (type_id_is_invalid(context, return_result.type_id))
@@ -1522,169 +1756,729 @@ resolve_types_in_code_block(Compilation_Context* context,
 }
 
 internal Bool
-resolve_and_validate_types(Compilation_Context* context)
+resolve_types_in_function_definition(Compilation_Context* context, Ast_Function_Definition* function_definition)
 {
-    create_builtin_types(context);
+    ASSERT(function_definition->type->kind == AST_TYPE_FUNCTION);
+    ASSERT(type_id_is_defined(function_definition->type->type_id));
 
-    Ast* ast = &context->ast;
+    const Type_Id expected_return_type_id = function_definition->type->function.return_type->type_id;
 
-    // NOTE(vlad): Resolving global symbols' types.
+    Ast_Code_Block* body = &function_definition->body;
+    if (!resolve_types_in_code_block(context, body, expected_return_type_id))
     {
-        for (Index function_definition_index = 0;
-             function_definition_index < context->ast.function_definitions_count;
-             ++function_definition_index)
-        {
-            Ast_Function_Definition* function_definition = &context->ast.function_definitions[function_definition_index];
-
-            ASSERT(function_definition->type->kind == AST_TYPE_FUNCTION);
-
-            const Type_Id function_type_id = resolve_type_by_ast_type(context, function_definition->type);
-
-            function_definition->type->type_id = function_type_id;
-            bind_type_id_to_a_symbol(context, function_definition->name.symbol_id, function_type_id);
-        }
+        return false;
     }
 
-    for (Index function_definition_index = 0;
-         function_definition_index < ast->function_definitions_count;
-         ++function_definition_index)
+    if (type_id_is_invalid(context, body->return_type_id))
     {
-        Ast_Function_Definition* function_definition = &ast->function_definitions[function_definition_index];
-
-        ASSERT(function_definition->type->kind == AST_TYPE_FUNCTION);
-        ASSERT(type_id_is_defined(function_definition->type->type_id));
+        return false;
+    }
 
-        const Type_Id expected_return_type_id = function_definition->type->function.return_type->type_id;
+    const Type_Id void_type_id = get_void_type_id(context);
 
-        Ast_Code_Block* body = &function_definition->body;
-        if (!resolve_types_in_code_block(context, body, expected_return_type_id))
-        {
-            return false;
-        }
+    /* NOTE(vlad): Logic is based on these rules:
+     *
+     *     | expected | body               | every path returns | result                        |
+     *     |----------+--------------------+--------------------+-------------------------------|
+     *     | void     | undefined          | -                  | ok                            |
+     *     | void     | void               | -                  | ok                            |
+     *     | void     | non-void           | -                  | mismatch                      |
+     *     |----------+--------------------+--------------------+-------------------------------|
+     *     | non-void | undefined          | -                  | non-void should have a return |
+     *     | non-void | void               | -                  | mismatch                      |
+     *     | non-void | same non-void      | true               | ok                            |
+     *     | non-void | same non-void      | false              | non-void should have a return |
+     *     | non-void | different non-void | -                  | mismatch                      |
+     **/
+
+    // FIXME(vlad): Remove code duplication in diagnostic messages emitting.
+
+    if (types_are_equal(context, expected_return_type_id, void_type_id))
+    {
+        // NOTE(vlad): Expected return type is void.
 
-        if (type_id_is_invalid(context, body->return_type_id))
+        if (type_id_is_undefined(body->return_type_id))
         {
-            return false;
+            body->return_type_id = void_type_id;
+            body->every_path_returns = true;
         }
-
-        const Type_Id void_type_id = get_void_type_id(context);
-
-        /* NOTE(vlad): Logic is based on these rules:
-         *
-         *     | expected | body               | every path returns | result                        |
-         *     |----------+--------------------+--------------------+-------------------------------|
-         *     | void     | undefined          | -                  | ok                            |
-         *     | void     | void               | -                  | ok                            |
-         *     | void     | non-void           | -                  | mismatch                      |
-         *     |----------+--------------------+--------------------+-------------------------------|
-         *     | non-void | undefined          | -                  | non-void should have a return |
-         *     | non-void | void               | -                  | mismatch                      |
-         *     | non-void | same non-void      | true               | ok                            |
-         *     | non-void | same non-void      | false              | non-void should have a return |
-         *     | non-void | different non-void | -                  | mismatch                      |
-         **/
-
-        // FIXME(vlad): Remove code duplication in diagnostic messages emitting.
-
-        if (types_are_equal(context, expected_return_type_id, void_type_id))
+        else if (!try_to_unify_types(context, body->return_type_id, void_type_id))
         {
-            // NOTE(vlad): Expected return type is void.
-
-            if (type_id_is_undefined(body->return_type_id))
-            {
-                body->return_type_id = void_type_id;
-                body->every_path_returns = true;
-            }
-            else if (!try_to_unify_types(context, body->return_type_id, void_type_id))
-            {
-                Diagnostic_Message error = {0};
-                error.level = MESSAGE_LEVEL_ERROR;
-                error.location = body->end_location;
+            Diagnostic_Message error = {0};
+            error.level = MESSAGE_LEVEL_ERROR;
+            error.location = body->end_location;
 
-                const String_View expected_type_string = convert_type_to_string(context->diagnostic_message_texts_arena,
-                                                                                context,
-                                                                                expected_return_type_id);
-                const String_View actual_type_string = convert_type_to_string(context->diagnostic_message_texts_arena,
-                                                                              context,
-                                                                              body->return_type_id);
+            const String_View expected_type_string = convert_type_to_string(context, expected_return_type_id);
+            const String_View actual_type_string = convert_type_to_string(context, body->return_type_id);
 
-                const String error_text = format_string(context->diagnostic_message_texts_arena,
-                                                        "Return type mismatch: expected '{}', got '{}'",
-                                                        expected_type_string,
-                                                        actual_type_string);
+            const String error_text = format_string(context->diagnostic_message_texts_arena,
+                                                    "Return type mismatch: expected '{}', got '{}'",
+                                                    expected_type_string,
+                                                    actual_type_string);
 
-                error.text = string_view(error_text);
-                emit_diagnostic_message(context, &error);
-                return false;
-            }
-            else
-            {
-                body->every_path_returns = true;
-            }
+            error.text = string_view(error_text);
+            emit_diagnostic_message(context, &error);
+            return false;
         }
         else
         {
-            // NOTE(vlad): Expected return type is non-void.
+            body->every_path_returns = true;
+        }
+    }
+    else
+    {
+        // NOTE(vlad): Expected return type is non-void.
 
-            if (type_id_is_undefined(body->return_type_id))
-            {
-                Diagnostic_Message error = {0};
-                error.level = MESSAGE_LEVEL_ERROR;
-                error.location = body->end_location;
-                error.text = string_view("Non-void function does not return a value in all control paths");
+        if (type_id_is_undefined(body->return_type_id))
+        {
+            Diagnostic_Message error = {0};
+            error.level = MESSAGE_LEVEL_ERROR;
+            error.location = body->end_location;
+            error.text = string_view("Non-void function does not return a value in all control paths");
 
-                emit_diagnostic_message(context, &error);
-                return false;
-            }
+            emit_diagnostic_message(context, &error);
+            return false;
+        }
 
-            if (!try_to_unify_types(context, expected_return_type_id, body->return_type_id))
-            {
-                Diagnostic_Message error = {0};
-                error.level = MESSAGE_LEVEL_ERROR;
-                error.location = body->end_location;
+        if (!try_to_unify_types(context, expected_return_type_id, body->return_type_id))
+        {
+            Diagnostic_Message error = {0};
+            error.level = MESSAGE_LEVEL_ERROR;
+            error.location = body->end_location;
 
-                const String_View expected_type_string = convert_type_to_string(context->diagnostic_message_texts_arena,
-                                                                                context,
-                                                                                expected_return_type_id);
-                const String_View actual_type_string = convert_type_to_string(context->diagnostic_message_texts_arena,
-                                                                              context,
-                                                                              body->return_type_id);
+            const String_View expected_type_string = convert_type_to_string(context, expected_return_type_id);
+            const String_View actual_type_string = convert_type_to_string(context, body->return_type_id);
 
-                const String error_text = format_string(context->diagnostic_message_texts_arena,
-                                                        "Return type mismatch: expected '{}', got '{}'",
-                                                        expected_type_string,
-                                                        actual_type_string);
+            const String error_text = format_string(context->diagnostic_message_texts_arena,
+                                                    "Return type mismatch: expected '{}', got '{}'",
+                                                    expected_type_string,
+                                                    actual_type_string);
 
-                error.text = string_view(error_text);
-                emit_diagnostic_message(context, &error);
-                return false;
-            }
+            error.text = string_view(error_text);
+            emit_diagnostic_message(context, &error);
+            return false;
+        }
 
-            if (!body->every_path_returns)
-            {
-                Diagnostic_Message error = {0};
-                error.level = MESSAGE_LEVEL_ERROR;
-                error.location = body->end_location;
-                error.text = string_view("Non-void function does not return a value in all control paths");
+        if (!body->every_path_returns)
+        {
+            Diagnostic_Message error = {0};
+            error.level = MESSAGE_LEVEL_ERROR;
+            error.location = body->end_location;
+            error.text = string_view("Non-void function does not return a value in all control paths");
 
-                emit_diagnostic_message(context, &error);
-                return false;
-            }
+            emit_diagnostic_message(context, &error);
+            return false;
         }
     }
 
     return true;
 }
 
-internal String_View
-convert_type_to_string(Arena* arena,
-                       Compilation_Context* context,
-                       const Type_Id type_id)
+struct Type_Checker_Batch
 {
-    // FIXME(vlad): Remove unnecessary allocations and copies.
+    // NOTE(vlad): A copy of the context with its own copies of the types and the interned types
+    //             and its own diagnostics. Types created here get ids after the global ones and are
+    //             relocated when the batch is appended, everything else it writes (types of local
+    //             symbols and expressions, types in the AST) belongs to its functions only.
+    Compilation_Context context;
 
-    const Type_Id root_type_id = find_root_type_id(context, type_id);
-    const Type* type = get_type_by_id(context, root_type_id);
+    Index first_function_definition_index;
+    Index end_function_definition_index;
+
+    // NOTE(vlad): 'end_function_definition_index' if every function is valid.
+    Index failed_function_definition_index;
+
+    Size first_type_index;
+    Type_Id* relocated_type_ids;
+
+    Thread thread;
+    Bool thread_started;
+};
+typedef struct Type_Checker_Batch Type_Checker_Batch;
+
+internal void
+resolve_types_in_batch(void* batch_pointer)
+{
+    Type_Checker_Batch* batch = batch_pointer;
+    Compilation_Context* context = &batch->context;
+
+    batch->failed_function_definition_index = batch->end_function_definition_index;
+
+    for (Index function_definition_index = batch->first_function_definition_index;
+         function_definition_index < batch->end_function_definition_index;
+         ++function_definition_index)
+    {
+        Ast_Function_Definition* function_definition = &context->ast.function_definitions[function_definition_index];
+
+        // NOTE(vlad): It was checked by the previous compilation, only its signature is needed here.
+        if (function_definition->body_is_reused)
+        {
+            continue;
+        }
+
+        if (!resolve_types_in_function_definition(context, function_definition))
+        {
+            batch->failed_function_definition_index = function_definition_index;
+            return;
+        }
+    }
+}
+
+// NOTE(vlad): A batch would unify its own copy of a type variable from a signature, so such
+//             signatures are checked sequentially.
+internal Bool
+signature_types_are_fully_resolved(const Compilation_Context* context)
+{
+    for (Index type_index = 0;
+         type_index < context->types_count;
+         ++type_index)
+    {
+        const Type* type = &context->types[type_index];
+        if (type->kind == TYPE_VARIABLE || type->kind == TYPE_NUMBER_VARIABLE)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+internal void
+copy_types_to_batch(Arena* arena, const Compilation_Context* context, Compilation_Context* batch_context)
+{
+    batch_context->types = allocate_uninitialized_array(arena, context->types_count, Type);
+    batch_context->types_count = context->types_count;
+    batch_context->types_capacity = context->types_count;
+    copy_memory(as_bytes(batch_context->types), as_bytes(context->types), context->types_count * size_of(Type));
+
+    const Size capacity = context->interned_type_ids_capacity;
+
+    batch_context->interned_type_ids = allocate_uninitialized_array(arena, capacity, Type_Id);
+    batch_context->interned_type_ids_keys = allocate_uninitialized_array(arena, capacity, Type);
+    batch_context->interned_type_ids_controls = allocate_uninitialized_array(arena, capacity, u8);
+    batch_context->interned_type_ids_count = context->interned_type_ids_count;
+    batch_context->interned_type_ids_capacity = capacity;
+
+    copy_memory(as_bytes(batch_context->interned_type_ids), as_bytes(context->interned_type_ids), capacity * size_of(Type_Id));
+    copy_memory(as_bytes(batch_context->interned_type_ids_keys), as_bytes(context->interned_type_ids_keys), capacity * size_of(Type));
+    copy_memory(as_bytes(batch_context->interned_type_ids_controls), as_bytes(context->interned_type_ids_controls), capacity * size_of(u8));
+
+    // NOTE(vlad): Type strings are only needed for diagnostics, the batch builds its own.
+    batch_context->type_strings = NULL;
+    batch_context->type_strings_keys = NULL;
+    batch_context->type_strings_controls = NULL;
+    batch_context->type_strings_count = 0;
+    batch_context->type_strings_capacity = 0;
+}
+
+// NOTE(vlad): Without a batch the type id is cleared, see 'append_type_checker_batch'.
+internal inline void
+relocate_batch_type_id(const Type_Checker_Batch* batch, Type_Id* type_id)
+{
+    if (batch == NULL)
+    {
+        type_id->index = UNDEFINED_TYPE_INDEX;
+    }
+    else if (type_id->index >= batch->first_type_index)
+    {
+        *type_id = batch->relocated_type_ids[type_id->index - batch->first_type_index];
+    }
+}
+
+internal void
+relocate_batch_type_ids_in_type(const Type_Checker_Batch* batch, Type* type)
+{
+    relocate_batch_type_id(batch, &type->parent_type_id);
+
+    if (type->kind == TYPE_POINTER)
+    {
+        relocate_batch_type_id(batch, &type->pointer_info.points_to_type_id);
+    }
+    else if (type->kind == TYPE_FUNCTION)
+    {
+        for (Index i = 0;
+             i < type->function_info.parameter_type_ids_count;
+             ++i)
+        {
+            relocate_batch_type_id(batch, &type->function_info.parameter_type_ids[i]);
+        }
+
+        relocate_batch_type_id(batch, &type->function_info.return_type_id);
+    }
+}
+
+// NOTE(vlad): Types are appended in creation order, so the parts of an interned type are already
+//             relocated when it's looked up in the global table. Other types may refer to types
+//             created after them (e.g. a unified variable), so they are relocated afterwards.
+internal void
+append_batch_types(Compilation_Context* context, Type_Checker_Batch* batch)
+{
+    const Compilation_Context* batch_context = &batch->context;
+
+    const Size batch_types_count = batch_context->types_count - batch->first_type_index;
+    const Index first_appended_type_index = context->types_count;
+
+    batch->relocated_type_ids = allocate_array(batch->context.scratch_arena, batch_types_count, Type_Id);
+
+    for (Index i = 0;
+         i < batch_types_count;
+         ++i)
+    {
+        Type* type = &batch_context->types[batch->first_type_index + i];
+
+        if (type->is_interned)
+        {
+            relocate_batch_type_ids_in_type(batch, type);
+
+            Index slot_index = 0;
+            hash_map_find(context->interned_type_ids, Type, *type, hash_type, interned_types_are_equal, slot_index);
+
+            if (slot_index != -1)
+            {
+                batch->relocated_type_ids[i] = context->interned_type_ids[slot_index];
+                continue;
+            }
+        }
+
+        const Type_Id type_id = create_type(context);
+        *get_exact_type_by_id(context, type_id) = *type;
+        batch->relocated_type_ids[i] = type_id;
+
+        if (type->is_interned)
+        {
+            hash_map_insert(context->interned_types_arena,
+                            context->interned_type_ids,
+                            Type,
+                            Type_Id,
+                            *type,
+                            type_id,
+                            hash_type,
+                            interned_types_are_equal);
+        }
+    }
+
+    for (Index type_index = first_appended_type_index;
+         type_index < context->types_count;
+         ++type_index)
+    {
+        Type* type = &context->types[type_index];
+
+        if (!type->is_interned)
+        {
+            relocate_batch_type_ids_in_type(batch, type);
+        }
+    }
+
+    // NOTE(vlad): Batch types may be linked under the batch copies of the global roots, which
+    //             bumps the ranks of those copies. Every batch only adds its own subtrees, so
+    //             the largest rank bounds the height of the merged tree, see 'find_root_type_id'.
+    for (Index type_index = 0;
+         type_index < batch->first_type_index;
+         ++type_index)
+    {
+        Type* type = &context->types[type_index];
+        const Type* batch_type = &batch_context->types[type_index];
+
+        type->rank = (u8)MAX(type->rank, batch_type->rank);
+    }
+}
+
+internal void
+relocate_batch_type_ids_in_expression(Compilation_Context* context,
+                                      const Type_Checker_Batch* batch,
+                                      const Ast_Expression_Id expression_id)
+{
+    if (expression_id == INVALID_AST_EXPRESSION_ID)
+    {
+        return;
+    }
+
+    relocate_batch_type_id(batch, &context->expression_type_ids[expression_id]);
+
+    const Ast_Expression* expression = get_ast_expression_by_id(&context->ast, expression_id);
+
+    switch (expression->kind)
+    {
+        case AST_EXPRESSION_ADD:
+        case AST_EXPRESSION_SUBTRACT:
+        case AST_EXPRESSION_MULTIPLY:
+        case AST_EXPRESSION_DIVIDE:
+        case AST_EXPRESSION_EQUAL:
+        case AST_EXPRESSION_NOT_EQUAL:
+        case AST_EXPRESSION_LESS:
+        case AST_EXPRESSION_LESS_OR_EQUAL:
+        case AST_EXPRESSION_GREATER:
+        case AST_EXPRESSION_GREATER_OR_EQUAL:
+        {
+            relocate_batch_type_ids_in_expression(context, batch, expression->binary_expression.lhs);
+            relocate_batch_type_ids_in_expression(context, batch, expression->binary_expression.rhs);
+        } break;
+
+        case AST_EXPRESSION_NEGATE:
+        case AST_EXPRESSION_DEREFERENCE:
+        case AST_EXPRESSION_ADDRESS_OF:
+        {
+            relocate_batch_type_ids_in_expression(context, batch, expression->unary_expression.operand);
+        } break;
+
+        case AST_EXPRESSION_CALL:
+        {
+            const Ast_Call* call = &expression->call;
+
+            relocate_batch_type_ids_in_expression(context, batch, call->called_expression);
+
+            for (Index argument_index = 0;
+                 argument_index < call->arguments_count;
+                 ++argument_index)
+            {
+                relocate_batch_type_ids_in_expression(context,
+                                                      batch,
+                                                      get_ast_call_argument_id(&context->ast, call, argument_index));
+            }
+        } break;
+
+        default:
+        {
+        } break;
+    }
+}
+
+internal void
+relocate_batch_type_ids_in_ast_type(Compilation_Context* context, const Type_Checker_Batch* batch, Ast_Type* type)
+{
+    if (type == NULL)
+    {
+        return;
+    }
+
+    relocate_batch_type_id(batch, &type->type_id);
+
+    if (type->kind == AST_TYPE_POINTER)
+    {
+        relocate_batch_type_ids_in_ast_type(context, batch, type->pointer.pointed_to);
+    }
+    else if (type->kind == AST_TYPE_FUNCTION)
+    {
+        for (Index i = 0;
+             i < type->function.parameters_count;
+             ++i)
+        {
+            Ast_Function_Parameter* parameter = &type->function.parameters[i];
+
+            relocate_batch_type_ids_in_ast_type(context, batch, parameter->type);
+            relocate_batch_type_id(batch, &get_symbol_by_id(context, parameter->name.symbol_id)->type_id);
+        }
+
+        relocate_batch_type_ids_in_ast_type(context, batch, type->function.return_type);
+    }
+}
+
+internal void
+relocate_batch_type_ids_in_code_block(Compilation_Context* context,
+                                      const Type_Checker_Batch* batch,
+                                      Ast_Code_Block* code_block)
+{
+    relocate_batch_type_id(batch, &code_block->return_type_id);
+
+    for (Index i = 0;
+         i < code_block->statements_count;
+         ++i)
+    {
+        Ast_Statement* statement = &code_block->statements[i];
+
+        switch (statement->kind)
+        {
+            case AST_STATEMENT_VARIABLE_DEFINITION:
+            {
+                Ast_Variable_Definition* definition = &statement->variable_definition;
+
+                relocate_batch_type_id(batch, &get_symbol_for_identifier(context, &definition->name)->type_id);
+                relocate_batch_type_ids_in_ast_type(context, batch, definition->type);
+
+                if (definition->has_initial_value)
+                {
+                    relocate_batch_type_ids_in_expression(context, batch, definition->initial_value);
+                }
+            } break;
+
+            case AST_STATEMENT_ASSIGNMENT:
+            {
+                relocate_batch_type_ids_in_expression(context, batch, statement->assignment.lhs);
+                relocate_batch_type_ids_in_expression(context, batch, statement->assignment.rhs);
+            } break;
+
+            case AST_STATEMENT_RETURN:
+            {
+                if (!statement->return_statement.is_empty)
+                {
+                    relocate_batch_type_ids_in_expression(context, batch, statement->return_statement.expression);
+                }
+            } break;
+
+            case AST_STATEMENT_WHILE:
+            {
+                relocate_batch_type_ids_in_expression(context, batch, statement->while_statement.condition);
+                relocate_batch_type_ids_in_code_block(context, batch, &statement->while_statement.body);
+            } break;
+
+            case AST_STATEMENT_IF:
+            {
+                relocate_batch_type_ids_in_expression(context, batch, statement->if_statement.condition);
+                relocate_batch_type_ids_in_code_block(context, batch, &statement->if_statement.if_statements);
+                relocate_batch_type_ids_in_code_block(context, batch, &statement->if_statement.else_statements);
+            } break;
+
+            case AST_STATEMENT_CALL:
+            {
+                relocate_batch_type_ids_in_expression(context, batch, statement->call_statement.call_expression);
+            } break;
+
+            case AST_STATEMENT_BREAK:
+            case AST_STATEMENT_CONTINUE:
+            {
+            } break;
+
+            case AST_STATEMENT_UNDEFINED:
+            {
+                UNREACHABLE();
+            } break;
+        }
+    }
+}
+
+internal void
+relocate_batch_type_ids_in_function_definitions(Compilation_Context* context,
+                                                const Type_Checker_Batch* batch,
+                                                const Index first_function_definition_index,
+                                                const Index end_function_definition_index)
+{
+    for (Index function_definition_index = first_function_definition_index;
+         function_definition_index < end_function_definition_index;
+         ++function_definition_index)
+    {
+        Ast_Function_Definition* function_definition = &context->ast.function_definitions[function_definition_index];
+
+        if (!function_definition->body_is_reused)
+        {
+            relocate_batch_type_ids_in_code_block(context, batch, &function_definition->body);
+        }
+    }
+}
+
+// NOTE(vlad): Batches are appended in source order and the sequential checker stops at the first
+//             invalid function, so the types and diagnostics of the functions after it are dropped.
+internal Bool
+append_type_checker_batch(Compilation_Context* context, Type_Checker_Batch* batch)
+{
+    append_batch_types(context, batch);
+
+    const Index end_function_definition_index = MIN(batch->failed_function_definition_index + 1,
+                                                    batch->end_function_definition_index);
+
+    relocate_batch_type_ids_in_function_definitions(context,
+                                                    batch,
+                                                    batch->first_function_definition_index,
+                                                    end_function_definition_index);
+    relocate_batch_type_ids_in_function_definitions(context,
+                                                    NULL,
+                                                    end_function_definition_index,
+                                                    batch->end_function_definition_index);
+
+    for (Index i = 0;
+         i < batch->context.diagnostic_messages_count;
+         ++i)
+    {
+        emit_diagnostic_message(context, &batch->context.diagnostic_messages[i]);
+    }
+
+    return batch->failed_function_definition_index == batch->end_function_definition_index;
+}
+
+internal Bool
+resolve_types_in_function_bodies(Compilation_Context* context, const Size batches_count)
+{
+    Ast* ast = &context->ast;
+
+    if (batches_count == 1 || !signature_types_are_fully_resolved(context))
+    {
+        for (Index function_definition_index = 0;
+             function_definition_index < ast->function_definitions_count;
+             ++function_definition_index)
+        {
+            Ast_Function_Definition* function_definition = &ast->function_definitions[function_definition_index];
+
+            // NOTE(vlad): It was checked by the previous compilation, only its signature is needed here.
+            if (function_definition->body_is_reused)
+            {
+                continue;
+            }
+
+            if (!resolve_types_in_function_definition(context, function_definition))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // NOTE(vlad): Like parser chunks, every batch gets arenas of its own. Parameter types and
+    //             diagnostic texts stay in them until the context is destroyed, the rest is copied out.
+    Type_Checker_Batch* batches = allocate_array(context->scratch_arena, batches_count, Type_Checker_Batch);
+    Arena** temporary_arenas = allocate_array(context->scratch_arena, batches_count, Arena*);
+
+    for (Index batch_index = 0;
+         batch_index < batches_count;
+         ++batch_index)
+    {
+        Type_Checker_Batch* batch = &batches[batch_index];
+
+        // NOTE(vlad): Names outlive the arenas, so they are kept next to 'worker_arenas'.
+        const String_View batch_arena_name = string_view(format_string(context->ast_arena, "type-checker-batch-{}", batch_index));
+        const String_View temporary_arena_name = string_view(format_string(context->ast_arena, "type-checker-batch-{}-types", batch_index));
+        const String_View scratch_arena_name = string_view(format_string(context->ast_arena, "type-checker-batch-{}-scratch", batch_index));
+
+        Arena* batch_arena = acquire_worker_arena_from_provider(context->arena_provider, batch_arena_name, MiB(16), KiB(64));
+        append_array(context->ast_arena, context->worker_arenas, Arena*, batch_arena);
+
+        temporary_arenas[batch_index] = acquire_worker_arena_from_provider(context->arena_provider, temporary_arena_name, MiB(64), KiB(64));
+
+        batch->context = *context;
+        batch->context.diagnostic_messages = NULL;
+        batch->context.diagnostic_messages_count = 0;
+        batch->context.diagnostic_messages_capacity = 0;
+
+        batch->context.parameter_type_ids_arena = batch_arena;
+        batch->context.diagnostic_message_texts_arena = batch_arena;
+        batch->context.types_arena = temporary_arenas[batch_index];
+        batch->context.interned_types_arena = temporary_arenas[batch_index];
+        batch->context.type_strings_arena = temporary_arenas[batch_index];
+        batch->context.diagnostic_messages_arena = temporary_arenas[batch_index];
+        batch->context.scratch_arena = acquire_worker_arena_from_provider(context->arena_provider, scratch_arena_name, MiB(16), KiB(64));
+
+        copy_types_to_batch(temporary_arenas[batch_index], context, &batch->context);
+
+        batch->first_function_definition_index = ast->function_definitions_count * batch_index / batches_count;
+        batch->end_function_definition_index = ast->function_definitions_count * (batch_index + 1) / batches_count;
+        batch->first_type_index = context->types_count;
+    }
+
+    // NOTE(vlad): The first batch is checked on the calling thread, which also takes over
+    //             the batches whose threads failed to start.
+    for (Index batch_index = 1;
+         batch_index < batches_count;
+         ++batch_index)
+    {
+        batches[batch_index].thread_started = platform_start_thread(&batches[batch_index].thread,
+                                                                    resolve_types_in_batch,
+                                                                    &batches[batch_index]);
+    }
+
+    for (Index batch_index = 0;
+         batch_index < batches_count;
+         ++batch_index)
+    {
+        if (batches[batch_index].thread_started)
+        {
+            platform_join_thread(&batches[batch_index].thread);
+        }
+        else
+        {
+            resolve_types_in_batch(&batches[batch_index]);
+        }
+    }
+
+    Bool types_are_valid = true;
+
+    for (Index batch_index = 0;
+         batch_index < batches_count;
+         ++batch_index)
+    {
+        Type_Checker_Batch* batch = &batches[batch_index];
+
+        if (types_are_valid)
+        {
+            types_are_valid = append_type_checker_batch(context, batch);
+        }
+        else
+        {
+            relocate_batch_type_ids_in_function_definitions(context,
+                                                            NULL,
+                                                            batch->first_function_definition_index,
+                                                            batch->end_function_definition_index);
+        }
+    }
+
+    for (Index batch_index = 0;
+         batch_index < batches_count;
+         ++batch_index)
+    {
+        release_arena_to_provider(context->arena_provider, batches[batch_index].context.scratch_arena);
+        release_arena_to_provider(context->arena_provider, temporary_arenas[batch_index]);
+    }
+
+    return types_are_valid;
+}
+
+internal Bool
+resolve_and_validate_types_in_batches(Compilation_Context* context, const Size batches_count)
+{
+    ASSERT(batches_count > 0);
+
+    create_builtin_types(context);
+
+    Ast* ast = &context->ast;
+
+    context->expression_type_ids = allocate_array(context->expression_type_ids_arena, ast->expressions_count, Type_Id);
+    context->expression_type_ids_count = ast->expressions_count;
+    context->expression_type_ids_capacity = ast->expressions_count;
+
+    // NOTE(vlad): Resolving global symbols' types.
+    {
+        for (Index function_definition_index = 0;
+             function_definition_index < context->ast.function_definitions_count;
+             ++function_definition_index)
+        {
+            Ast_Function_Definition* function_definition = &context->ast.function_definitions[function_definition_index];
+
+            ASSERT(function_definition->type->kind == AST_TYPE_FUNCTION);
+
+            const Type_Id function_type_id = resolve_type_by_ast_type(context, function_definition->type);
+
+            function_definition->type->type_id = function_type_id;
+            bind_type_id_to_a_symbol(context, function_definition->name.symbol_id, function_type_id);
+        }
+    }
+
+    return resolve_types_in_function_bodies(context, batches_count);
+}
+
+internal Bool
+resolve_and_validate_types(Compilation_Context* context)
+{
+    const Size batches_count = MIN(MIN(platform_get_number_of_processors(),
+                                       context->ast.function_definitions_count / MIN_FUNCTIONS_PER_TYPE_CHECKER_BATCH),
+                                   MAX_TYPE_CHECKER_BATCHES_COUNT);
+
+    return resolve_and_validate_types_in_batches(context, MAX(batches_count, 1));
+}
+
+internal inline u64
+hash_type_id(const Type_Id type_id)
+{
+    return hash_u64((u64)type_id.index);
+}
+
+internal inline Bool
+type_id_indices_are_equal(const Type_Id lhs, const Type_Id rhs)
+{
+    return lhs.index == rhs.index;
+}
+
+internal String_View
+build_type_string(Arena* arena, Compilation_Context* context, const Type* type)
+{
+    // FIXME(vlad): Remove unnecessary allocations and copies.
 
     String_Builder builder = {0};
     create_string_builder(&builder, arena);
@@ -1867,7 +2661,7 @@ convert_type_to_string(Arena* arena,
                 append_string(&builder, string_view("mutable "));
             }
 
-            const String_View points_to_type = convert_type_to_string(arena, context, type_info->points_to_type_id);
+            const String_View points_to_type = convert_type_to_string(context, type_info->points_to_type_id);
             append_string(&builder, points_to_type);
         } break;
 
@@ -1894,17 +2688,13 @@ convert_type_to_string(Arena* arena,
                      ++i)
                 {
                     const Type_Id parameter_type_id = type_info->parameter_type_ids[i];
-                    parameter_types[i] = convert_type_to_string(arena,
-                                                                context,
-                                                                parameter_type_id);
+                    parameter_types[i] = convert_type_to_string(context, parameter_type_id);
 
                     total_result_length += parameter_types[i].length;
                 }
             }
 
-            const String_View result_type = convert_type_to_string(arena,
-                                                                   context,
-                                                                   type_info->return_type_id);
+            const String_View result_type = convert_type_to_string(context, type_info->return_type_id);
             total_result_length += result_type.length;
 
             result.data = allocate_uninitialized_array(arena, total_result_length, char);
@@ -1946,3 +2736,216 @@ convert_type_to_string(Arena* arena,
 
     return string_builder_to_string(&builder);
 }
+
+internal void
+collect_changeable_root_type_ids(Compilation_Context* context, Type_String* type_string, const Type_Id type_id)
+{
+    const Type_Id root_type_id = find_root_type_id(context, type_id);
+    const Type* type = get_exact_type_by_id(context, root_type_id);
+
+    if (type_never_changes(type))
+    {
+        return;
+    }
+
+    append_array(context->type_strings_arena, type_string->changeable_root_type_ids, Type_Id, root_type_id);
+
+    if (type->kind == TYPE_POINTER)
+    {
+        collect_changeable_root_type_ids(context, type_string, type->pointer_info.points_to_type_id);
+    }
+    else if (type->kind == TYPE_FUNCTION)
+    {
+        for (Index parameter_index = 0;
+             parameter_index < type->function_info.parameter_type_ids_count;
+             ++parameter_index)
+        {
+            collect_changeable_root_type_ids(context, type_string, type->function_info.parameter_type_ids[parameter_index]);
+        }
+
+        collect_changeable_root_type_ids(context, type_string, type->function_info.return_type_id);
+    }
+}
+
+internal Bool
+type_string_is_stale(Compilation_Context* context, const Type_String* type_string)
+{
+    for (Index root_index = 0;
+         root_index < type_string->changeable_root_type_ids_count;
+         ++root_index)
+    {
+        const Type_Id root_type_id = type_string->changeable_root_type_ids[root_index];
+
+        if (find_root_type_id(context, root_type_id).index != root_type_id.index)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// NOTE(vlad): Diagnostics print the same few types over and over, so strings are built once
+//             per root type and live as long as the context. Unifying a type variable only makes
+//             the strings of the types that contain it stale.
+internal String_View
+convert_type_to_string(Compilation_Context* context, const Type_Id type_id)
+{
+    const Type_Id root_type_id = find_root_type_id(context, type_id);
+    const Type* type = get_type_by_id(context, root_type_id);
+
+    Index slot_index = 0;
+    hash_map_find(context->type_strings, Type_Id, root_type_id, hash_type_id, type_id_indices_are_equal, slot_index);
+
+    if (slot_index != -1 && !type_string_is_stale(context, &context->type_strings[slot_index]))
+    {
+        return context->type_strings[slot_index].string;
+    }
+
+    Type_String type_string = {0};
+    type_string.string = build_type_string(context->type_strings_arena, context, type);
+    collect_changeable_root_type_ids(context, &type_string, root_type_id);
+
+    hash_map_insert(context->type_strings_arena,
+                    context->type_strings,
+                    Type_Id,
+                    Type_String,
+                    root_type_id,
+                    type_string,
+                    hash_type_id,
+                    type_id_indices_are_equal);
+
+    return type_string.string;
+}
+
+// NOTE(vlad): Creates the same type in this context for a type of the previous compilation, see
+//             'copy_reused_tac_function'. 'copied_type_ids' is indexed by the previous type ids
+//             and remembers the roots that are already copied.
+internal Type_Id
+copy_type_of_previous_compilation(Compilation_Context* context,
+                                  const Compilation_Context* previous_context,
+                                  Type_Id* copied_type_ids,
+                                  const Type_Id previous_type_id)
+{
+    // NOTE(vlad): The previous context is not changed, so its paths are not halved.
+    Index root_index = previous_type_id.index;
+    while (!type_is_a_root_node(&previous_context->types[root_index]))
+    {
+        root_index = previous_context->types[root_index].parent_type_id.index;
+    }
+
+    if (root_index == UNDEFINED_TYPE_INDEX || root_index == INVALID_TYPE_INDEX)
+    {
+        return (Type_Id) { root_index };
+    }
+
+    if (type_id_is_defined(copied_type_ids[root_index]))
+    {
+        return copied_type_ids[root_index];
+    }
+
+    const Type* previous_type = &previous_context->types[root_index];
+    Type_Id type_id = {0};
+
+    switch (previous_type->kind)
+    {
+        case TYPE_UNDEFINED:
+        case TYPE_INVALID:
+        {
+            UNREACHABLE();
+        } break;
+
+        case TYPE_VOID:
+        {
+            type_id = get_void_type_id(context);
+        } break;
+
+        case TYPE_BOOLEAN:
+        {
+            type_id = get_boolean_type_id(context);
+        } break;
+
+        case TYPE_VARIABLE:
+        {
+            type_id = create_new_type_variable(context);
+        } break;
+
+        case TYPE_NUMBER_VARIABLE:
+        {
+            type_id = create_type(context);
+
+            Type* type = get_exact_type_by_id(context, type_id);
+            type->kind = TYPE_NUMBER_VARIABLE;
+            type->number_constraints = previous_type->number_constraints;
+        } break;
+
+        case TYPE_INTEGER:
+        {
+            Type type = {0};
+            type.kind = TYPE_INTEGER;
+            type.integer_info = previous_type->integer_info;
+
+            type_id = intern_type(context, &type);
+        } break;
+
+        case TYPE_FLOAT:
+        {
+            Type type = {0};
+            type.kind = TYPE_FLOAT;
+            type.float_info = previous_type->float_info;
+
+            type_id = intern_type(context, &type);
+        } break;
+
+        case TYPE_POINTER:
+        {
+            Type type = {0};
+            type.kind = TYPE_POINTER;
+            type.pointer_info.pointee_is_mutable = previous_type->pointer_info.pointee_is_mutable;
+            type.pointer_info.points_to_type_id = copy_type_of_previous_compilation(context,
+                                                                                   previous_context,
+                                                                                   copied_type_ids,
+                                                                                   previous_type->pointer_info.points_to_type_id);
+
+            type_id = intern_type(context, &type);
+        } break;
+
+        case TYPE_FUNCTION:
+        {
+            const Function_Type_Info* previous_type_info = &previous_type->function_info;
+
+            Type type = {0};
+            type.kind = TYPE_FUNCTION;
+
+            Function_Type_Info* type_info = &type.function_info;
+            type_info->parameter_type_ids_count = previous_type_info->parameter_type_ids_count;
+
+            if (previous_type_info->parameter_type_ids_count != 0)
+            {
+                type_info->parameter_type_ids = allocate_array(context->parameter_type_ids_arena,
+                                                               previous_type_info->parameter_type_ids_count,
+                                                               Type_Id);
+            }
+
+            for (Index i = 0;
+                 i < previous_type_info->parameter_type_ids_count;
+                 ++i)
+            {
+                type_info->parameter_type_ids[i] = copy_type_of_previous_compilation(context,
+                                                                                     previous_context,
+                                                                                     copied_type_ids,
+                                                                                     previous_type_info->parameter_type_ids[i]);
+            }
+
+            type_info->return_type_id = copy_type_of_previous_compilation(context,
+                                                                          previous_context,
+                                                                          copied_type_ids,
+                                                                          previous_type_info->return_type_id);
+
+            type_id = intern_type(context, &type);
+        } break;
+    }
+
+    copied_type_ids[root_index] = type_id;
+    return type_id;
+}
@@ -5,6 +5,10 @@
 
 #include "eon_compilation_context.h"
 
+// NOTE(vlad): Files with fewer functions are checked on the calling thread, starting threads isn't worth it.
+#define MIN_FUNCTIONS_PER_TYPE_CHECKER_BATCH 256
+#define MAX_TYPE_CHECKER_BATCHES_COUNT 64
+
 enum Type_Kind
 {
     TYPE_UNDEFINED = 0,
@@ -80,6 +84,15 @@ typedef struct Number_Constraints Number_Constraints;
 struct Type
 {
     Type_Kind kind;
+
+    // NOTE(vlad): Upper bound on the height of the tree under this root, see 'link_root_types'.
+    //             It fits into the padding after 'kind', so types don't get any bigger.
+    u8 rank;
+
+    // NOTE(vlad): Interned types are never unified with anything else, so equal interned
+    //             types have equal ids, see 'intern_type'.
+    Bool8 is_interned;
+
     Type_Id parent_type_id;
 
     union
@@ -94,6 +107,17 @@ struct Type
 };
 typedef struct Type Type;
 
+// NOTE(vlad): A string is stale once one of the roots it was built from is not a root anymore,
+//             see 'convert_type_to_string'.
+struct Type_String
+{
+    String_View string;
+
+    // NOTE(vlad): Roots of the type and its parts that can still be unified.
+    array(Type_Id, changeable_root_type_ids);
+};
+typedef struct Type_String Type_String;
+
 maybe_unused internal inline Bool type_id_is_defined(const Type_Id type_id);
 maybe_unused internal inline Bool type_id_is_undefined(const Type_Id type_id);
 
@@ -101,8 +125,18 @@ maybe_unused internal inline Bool type_id_is_valid(Compilation_Context* context,
 maybe_unused internal inline Bool type_id_is_invalid(Compilation_Context* context, const Type_Id type_id);
 
 maybe_unused internal Bool resolve_and_validate_types(Compilation_Context* context);
-maybe_unused internal String_View convert_type_to_string(Arena* arena,
-                                                         Compilation_Context* context,
-                                                         const Type_Id type_id);
+maybe_unused internal Bool resolve_and_validate_types_in_batches(Compilation_Context* context, const Size batches_count);
+maybe_unused internal String_View convert_type_to_string(Compilation_Context* context, const Type_Id type_id);
+maybe_unused internal Type_Id copy_type_of_previous_compilation(Compilation_Context* context,
+                                                                const Compilation_Context* previous_context,
+                                                                Type_Id* copied_type_ids,
+                                                                const Type_Id previous_type_id);
 
 maybe_unused internal inline Type_Id get_void_type_id(Compilation_Context* context);
+maybe_unused internal inline Type_Id get_boolean_type_id(Compilation_Context* context);
+
+maybe_unused internal Type_Id create_new_type_variable(Compilation_Context* context);
+maybe_unused internal Type_Id intern_type(Compilation_Context* context, const Type* type);
+maybe_unused internal Bool try_to_unify_types(Compilation_Context* context,
+                                              const Type_Id lhs_type_id,
+                                              const Type_Id rhs_type_id);
@@ -92,8 +92,8 @@ test_builtin_types_resolving(Test_Context* test_context)
 
             ASSERT_TRUE(variable_definition->has_initial_value);
 
-            const Ast_Expression* initial_value = &variable_definition->initial_value;
-            ASSERT_TYPE_STRINGS_ARE_EQUAL(initial_value->type_id, "s32");
+            const Ast_Expression* initial_value = AST_EXPRESSION(variable_definition->initial_value);
+            ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, variable_definition->initial_value), "s32");
             ASSERT_ENUM_VALUES_ARE_EQUAL(initial_value->kind, AST_EXPRESSION_IDENTIFIER);
 
             const Ast_Identifier* identifier = &initial_value->identifier;
@@ -208,8 +208,8 @@ test_builtin_types_resolving(Test_Context* test_context)
 
             ASSERT_TRUE(variable_definition->has_initial_value);
 
-            const Ast_Expression* initial_value = &variable_definition->initial_value;
-            ASSERT_TYPE_STRINGS_ARE_EQUAL(initial_value->type_id, "s32");
+            const Ast_Expression* initial_value = AST_EXPRESSION(variable_definition->initial_value);
+            ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, variable_definition->initial_value), "s32");
             ASSERT_ENUM_VALUES_ARE_EQUAL(initial_value->kind, AST_EXPRESSION_IDENTIFIER);
 
             const Ast_Identifier* identifier = &initial_value->identifier;
@@ -514,10 +514,10 @@ test_comparisons(Test_Context* test_context)
             ASSERT_ENUM_VALUES_ARE_EQUAL(type->kind, AST_TYPE_OMITTED);
             ASSERT_TYPE_STRINGS_ARE_EQUAL(type->type_id, "bool");
 
-            const Ast_Expression* initial_value = &variable_definition->initial_value;
+            const Ast_Expression* initial_value = AST_EXPRESSION(variable_definition->initial_value);
             ASSERT_ENUM_VALUES_ARE_EQUAL(initial_value->kind, AST_EXPRESSION_EQUAL);
-            ASSERT_TYPE_IS_VALID(initial_value->type_id);
-            ASSERT_TYPE_STRINGS_ARE_EQUAL(initial_value->type_id, "bool");
+            ASSERT_TYPE_IS_VALID(get_expression_type_id(&context, variable_definition->initial_value));
+            ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, variable_definition->initial_value), "bool");
         }
 
         destroy_parser(&parser);
@@ -614,10 +614,10 @@ test_comparisons(Test_Context* test_context)
             ASSERT_ENUM_VALUES_ARE_EQUAL(type->kind, AST_TYPE_OMITTED);
             ASSERT_TYPE_STRINGS_ARE_EQUAL(type->type_id, "bool");
 
-            const Ast_Expression* initial_value = &variable_definition->initial_value;
+            const Ast_Expression* initial_value = AST_EXPRESSION(variable_definition->initial_value);
             ASSERT_ENUM_VALUES_ARE_EQUAL(initial_value->kind, AST_EXPRESSION_NOT_EQUAL);
-            ASSERT_TYPE_IS_VALID(initial_value->type_id);
-            ASSERT_TYPE_STRINGS_ARE_EQUAL(initial_value->type_id, "bool");
+            ASSERT_TYPE_IS_VALID(get_expression_type_id(&context, variable_definition->initial_value));
+            ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, variable_definition->initial_value), "bool");
         }
 
         destroy_parser(&parser);
@@ -714,10 +714,10 @@ test_comparisons(Test_Context* test_context)
             ASSERT_ENUM_VALUES_ARE_EQUAL(type->kind, AST_TYPE_OMITTED);
             ASSERT_TYPE_STRINGS_ARE_EQUAL(type->type_id, "bool");
 
-            const Ast_Expression* initial_value = &variable_definition->initial_value;
+            const Ast_Expression* initial_value = AST_EXPRESSION(variable_definition->initial_value);
             ASSERT_ENUM_VALUES_ARE_EQUAL(initial_value->kind, AST_EXPRESSION_LESS);
-            ASSERT_TYPE_IS_VALID(initial_value->type_id);
-            ASSERT_TYPE_STRINGS_ARE_EQUAL(initial_value->type_id, "bool");
+            ASSERT_TYPE_IS_VALID(get_expression_type_id(&context, variable_definition->initial_value));
+            ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, variable_definition->initial_value), "bool");
         }
 
         destroy_parser(&parser);
@@ -814,10 +814,10 @@ test_comparisons(Test_Context* test_context)
             ASSERT_ENUM_VALUES_ARE_EQUAL(type->kind, AST_TYPE_OMITTED);
             ASSERT_TYPE_STRINGS_ARE_EQUAL(type->type_id, "bool");
 
-            const Ast_Expression* initial_value = &variable_definition->initial_value;
+            const Ast_Expression* initial_value = AST_EXPRESSION(variable_definition->initial_value);
             ASSERT_ENUM_VALUES_ARE_EQUAL(initial_value->kind, AST_EXPRESSION_LESS_OR_EQUAL);
-            ASSERT_TYPE_IS_VALID(initial_value->type_id);
-            ASSERT_TYPE_STRINGS_ARE_EQUAL(initial_value->type_id, "bool");
+            ASSERT_TYPE_IS_VALID(get_expression_type_id(&context, variable_definition->initial_value));
+            ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, variable_definition->initial_value), "bool");
         }
 
         destroy_parser(&parser);
@@ -914,10 +914,10 @@ test_comparisons(Test_Context* test_context)
             ASSERT_ENUM_VALUES_ARE_EQUAL(type->kind, AST_TYPE_OMITTED);
             ASSERT_TYPE_STRINGS_ARE_EQUAL(type->type_id, "bool");
 
-            const Ast_Expression* initial_value = &variable_definition->initial_value;
+            const Ast_Expression* initial_value = AST_EXPRESSION(variable_definition->initial_value);
             ASSERT_ENUM_VALUES_ARE_EQUAL(initial_value->kind, AST_EXPRESSION_GREATER);
-            ASSERT_TYPE_IS_VALID(initial_value->type_id);
-            ASSERT_TYPE_STRINGS_ARE_EQUAL(initial_value->type_id, "bool");
+            ASSERT_TYPE_IS_VALID(get_expression_type_id(&context, variable_definition->initial_value));
+            ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, variable_definition->initial_value), "bool");
         }
 
         destroy_parser(&parser);
@@ -1014,10 +1014,10 @@ test_comparisons(Test_Context* test_context)
             ASSERT_ENUM_VALUES_ARE_EQUAL(type->kind, AST_TYPE_OMITTED);
             ASSERT_TYPE_STRINGS_ARE_EQUAL(type->type_id, "bool");
 
-            const Ast_Expression* initial_value = &variable_definition->initial_value;
+            const Ast_Expression* initial_value = AST_EXPRESSION(variable_definition->initial_value);
             ASSERT_ENUM_VALUES_ARE_EQUAL(initial_value->kind, AST_EXPRESSION_GREATER_OR_EQUAL);
-            ASSERT_TYPE_IS_VALID(initial_value->type_id);
-            ASSERT_TYPE_STRINGS_ARE_EQUAL(initial_value->type_id, "bool");
+            ASSERT_TYPE_IS_VALID(get_expression_type_id(&context, variable_definition->initial_value));
+            ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, variable_definition->initial_value), "bool");
         }
 
         destroy_parser(&parser);
@@ -1112,7 +1112,7 @@ test_if_statements(Test_Context* test_context)
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_IF);
             const Ast_If_Statement* if_statement = &statement->if_statement;
 
-            ASSERT_TYPE_STRINGS_ARE_EQUAL(if_statement->condition.type_id, "bool");
+            ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, if_statement->condition), "bool");
 
             ASSERT_FALSE(if_statement->if_statements.every_path_returns);
             ASSERT_FALSE(if_statement->else_statements.every_path_returns);
@@ -1218,7 +1218,7 @@ test_if_statements(Test_Context* test_context)
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_IF);
             const Ast_If_Statement* if_statement = &statement->if_statement;
 
-            ASSERT_TYPE_STRINGS_ARE_EQUAL(if_statement->condition.type_id, "bool");
+            ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, if_statement->condition), "bool");
 
             ASSERT_TRUE(if_statement->if_statements.every_path_returns);
             ASSERT_TRUE(if_statement->else_statements.every_path_returns);
@@ -1323,7 +1323,7 @@ test_if_statements(Test_Context* test_context)
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_IF);
             const Ast_If_Statement* if_statement = &statement->if_statement;
 
-            ASSERT_TYPE_STRINGS_ARE_EQUAL(if_statement->condition.type_id, "bool");
+            ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, if_statement->condition), "bool");
 
             ASSERT_TRUE(if_statement->if_statements.every_path_returns);
             ASSERT_FALSE(if_statement->else_statements.every_path_returns);
@@ -1340,10 +1340,10 @@ test_if_statements(Test_Context* test_context)
 
             ASSERT_FALSE(return_statement->is_empty);
 
-            const Ast_Expression* returned_expression = &return_statement->expression;
+            const Ast_Expression* returned_expression = AST_EXPRESSION(return_statement->expression);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(returned_expression->kind, AST_EXPRESSION_IDENTIFIER);
-            ASSERT_TYPE_STRINGS_ARE_EQUAL(returned_expression->type_id, "s32");
+            ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, return_statement->expression), "s32");
 
             const Ast_Identifier* identifier = &returned_expression->identifier;
 
@@ -1447,7 +1447,7 @@ test_while_statements(Test_Context* test_context)
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_WHILE);
             const Ast_While_Statement* while_statement = &statement->while_statement;
 
-            ASSERT_TYPE_STRINGS_ARE_EQUAL(while_statement->condition.type_id, "bool");
+            ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, while_statement->condition), "bool");
 
             ASSERT_FALSE(while_statement->body.every_path_returns);
             ASSERT_FALSE(type_id_is_valid(&context, while_statement->body.return_type_id));
@@ -1546,7 +1546,7 @@ test_while_statements(Test_Context* test_context)
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_WHILE);
             const Ast_While_Statement* while_statement = &statement->while_statement;
 
-            ASSERT_TYPE_STRINGS_ARE_EQUAL(while_statement->condition.type_id, "bool");
+            ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, while_statement->condition), "bool");
 
             ASSERT_TRUE(while_statement->body.every_path_returns);
             ASSERT_TYPE_STRINGS_ARE_EQUAL(while_statement->body.return_type_id, "s32");
@@ -1647,7 +1647,7 @@ test_while_statements(Test_Context* test_context)
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_WHILE);
             const Ast_While_Statement* while_statement = &statement->while_statement;
 
-            ASSERT_TYPE_STRINGS_ARE_EQUAL(while_statement->condition.type_id, "bool");
+            ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, while_statement->condition), "bool");
 
             ASSERT_TRUE(while_statement->body.every_path_returns);
             ASSERT_TYPE_STRINGS_ARE_EQUAL(while_statement->body.return_type_id, "s32");
@@ -1748,7 +1748,7 @@ test_while_statements(Test_Context* test_context)
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_WHILE);
             const Ast_While_Statement* while_statement = &statement->while_statement;
 
-            ASSERT_TYPE_STRINGS_ARE_EQUAL(while_statement->condition.type_id, "bool");
+            ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, while_statement->condition), "bool");
 
             ASSERT_TRUE(while_statement->body.every_path_returns);
             ASSERT_TYPE_STRINGS_ARE_EQUAL(while_statement->body.return_type_id, "s32");
@@ -1852,8 +1852,8 @@ test_assignments(Test_Context* test_context)
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_ASSIGNMENT);
             const Ast_Assignment* assignment = &statement->assignment;
 
-            ASSERT_TYPE_STRINGS_ARE_EQUAL(assignment->lhs.type_id, "s32");
-            ASSERT_TYPE_STRINGS_ARE_EQUAL(assignment->rhs.type_id, "s32");
+            ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, assignment->lhs), "s32");
+            ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, assignment->rhs), "s32");
         }
 
         destroy_parser(&parser);
@@ -1948,8 +1948,8 @@ test_assignments(Test_Context* test_context)
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_ASSIGNMENT);
             const Ast_Assignment* assignment = &statement->assignment;
 
-            ASSERT_TYPE_STRINGS_ARE_EQUAL(assignment->lhs.type_id, "s32");
-            ASSERT_TYPE_STRINGS_ARE_EQUAL(assignment->rhs.type_id, "s32");
+            ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, assignment->lhs), "s32");
+            ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, assignment->rhs), "s32");
         }
 
         destroy_parser(&parser);
@@ -2037,7 +2037,7 @@ test_assignments(Test_Context* test_context)
             ASSERT_TYPE_STRINGS_ARE_EQUAL(variable_symbol->type_id, "s32");
 
             ASSERT_TRUE(definition->has_initial_value);
-            ASSERT_TYPE_STRINGS_ARE_EQUAL(definition->initial_value.type_id, "s32");
+            ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, definition->initial_value), "s32");
         }
 
         {
@@ -2055,7 +2055,7 @@ test_assignments(Test_Context* test_context)
             ASSERT_TYPE_STRINGS_ARE_EQUAL(variable_symbol->type_id, "s32");
 
             ASSERT_TRUE(definition->has_initial_value);
-            ASSERT_TYPE_STRINGS_ARE_EQUAL(definition->initial_value.type_id, "s32");
+            ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, definition->initial_value), "s32");
         }
 
         destroy_parser(&parser);
@@ -2157,14 +2157,14 @@ test_pointers_to_mutable_binding(Test_Context* test_context)
 
             ASSERT_TRUE(definition->has_initial_value);
 
-            const Ast_Expression* initial_value = &definition->initial_value;
-            ASSERT_TYPE_STRINGS_ARE_EQUAL(initial_value->type_id, "* mutable s32");
+            const Ast_Expression* initial_value = AST_EXPRESSION(definition->initial_value);
+            ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, definition->initial_value), "* mutable s32");
             ASSERT_ENUM_VALUES_ARE_EQUAL(initial_value->kind, AST_EXPRESSION_ADDRESS_OF);
 
             const Ast_Unary_Expression* address_of = &initial_value->unary_expression;
-            ASSERT_ENUM_VALUES_ARE_EQUAL(address_of->operand->kind, AST_EXPRESSION_IDENTIFIER);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(address_of->operand)->kind, AST_EXPRESSION_IDENTIFIER);
 
-            const Ast_Identifier* identifier = &address_of->operand->identifier;
+            const Ast_Identifier* identifier = &AST_EXPRESSION(address_of->operand)->identifier;
             const Symbol* identifier_symbol = get_symbol_for_identifier(&context, identifier);
             ASSERT_TYPE_STRINGS_ARE_EQUAL(identifier_symbol->type_id, "s32");
 
@@ -2182,8 +2182,8 @@ test_pointers_to_mutable_binding(Test_Context* test_context)
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_ASSIGNMENT);
             const Ast_Assignment* assignment = &statement->assignment;
 
-            ASSERT_TYPE_STRINGS_ARE_EQUAL(assignment->lhs.type_id, "s32");
-            ASSERT_TYPE_STRINGS_ARE_EQUAL(assignment->rhs.type_id, "s32");
+            ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, assignment->lhs), "s32");
+            ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, assignment->rhs), "s32");
         }
 
         destroy_parser(&parser);
@@ -2326,25 +2326,25 @@ test_pointers_to_mutable_binding(Test_Context* test_context)
                 ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_CALL);
 
                 const Ast_Call_Statement* call_statement = &statement->call_statement;
-                const Ast_Expression* call_expression = &call_statement->call_expression;
+                const Ast_Expression* call_expression = AST_EXPRESSION(call_statement->call_expression);
                 ASSERT_ENUM_VALUES_ARE_EQUAL(call_expression->kind, AST_EXPRESSION_CALL);
-                ASSERT_TYPE_STRINGS_ARE_EQUAL(call_expression->type_id, "void");
+                ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, call_statement->call_expression), "void");
 
                 const Ast_Call* call = &call_expression->call;
 
-                const Ast_Expression* called_expression = call->called_expression;
+                const Ast_Expression* called_expression = AST_EXPRESSION(call->called_expression);
                 ASSERT_ENUM_VALUES_ARE_EQUAL(called_expression->kind, AST_EXPRESSION_IDENTIFIER);
-                ASSERT_TYPE_STRINGS_ARE_EQUAL(called_expression->type_id, "(* mutable s32) -> void");
+                ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, call->called_expression), "(* mutable s32) -> void");
 
                 ASSERT_EQUAL(call->arguments_count, 1);
-                const Ast_Expression* call_parameter = call->arguments[0];
+                const Ast_Expression* call_parameter = AST_CALL_ARGUMENT(call, 0);
                 ASSERT_ENUM_VALUES_ARE_EQUAL(call_parameter->kind, AST_EXPRESSION_ADDRESS_OF);
 
-                const Ast_Expression* address_of_operand = call_parameter->unary_expression.operand;
+                const Ast_Expression* address_of_operand = AST_EXPRESSION(call_parameter->unary_expression.operand);
                 ASSERT_ENUM_VALUES_ARE_EQUAL(address_of_operand->kind, AST_EXPRESSION_IDENTIFIER);
-                ASSERT_TYPE_STRINGS_ARE_EQUAL(address_of_operand->type_id, "s32");
+                ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, call_parameter->unary_expression.operand), "s32");
 
-                ASSERT_TYPE_STRINGS_ARE_EQUAL(call_parameter->type_id, "* mutable s32");
+                ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, get_ast_call_argument_id(&context.ast, call, 0)), "* mutable s32");
             }
         }
 
@@ -2489,25 +2489,25 @@ test_pointers_to_mutable_binding(Test_Context* test_context)
                 ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_CALL);
 
                 const Ast_Call_Statement* call_statement = &statement->call_statement;
-                const Ast_Expression* call_expression = &call_statement->call_expression;
+                const Ast_Expression* call_expression = AST_EXPRESSION(call_statement->call_expression);
                 ASSERT_ENUM_VALUES_ARE_EQUAL(call_expression->kind, AST_EXPRESSION_CALL);
-                ASSERT_TYPE_STRINGS_ARE_EQUAL(call_expression->type_id, "void");
+                ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, call_statement->call_expression), "void");
 
                 const Ast_Call* call = &call_expression->call;
 
-                const Ast_Expression* called_expression = call->called_expression;
+                const Ast_Expression* called_expression = AST_EXPRESSION(call->called_expression);
                 ASSERT_ENUM_VALUES_ARE_EQUAL(called_expression->kind, AST_EXPRESSION_IDENTIFIER);
-                ASSERT_TYPE_STRINGS_ARE_EQUAL(called_expression->type_id, "(* s32) -> void");
+                ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, call->called_expression), "(* s32) -> void");
 
                 ASSERT_EQUAL(call->arguments_count, 1);
-                const Ast_Expression* call_parameter = call->arguments[0];
+                const Ast_Expression* call_parameter = AST_CALL_ARGUMENT(call, 0);
                 ASSERT_ENUM_VALUES_ARE_EQUAL(call_parameter->kind, AST_EXPRESSION_ADDRESS_OF);
 
-                const Ast_Expression* address_of_operand = call_parameter->unary_expression.operand;
+                const Ast_Expression* address_of_operand = AST_EXPRESSION(call_parameter->unary_expression.operand);
                 ASSERT_ENUM_VALUES_ARE_EQUAL(address_of_operand->kind, AST_EXPRESSION_IDENTIFIER);
-                ASSERT_TYPE_STRINGS_ARE_EQUAL(address_of_operand->type_id, "s32");
+                ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, call_parameter->unary_expression.operand), "s32");
 
-                ASSERT_TYPE_STRINGS_ARE_EQUAL(call_parameter->type_id, "* mutable s32");
+                ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, get_ast_call_argument_id(&context.ast, call, 0)), "* mutable s32");
             }
         }
 
@@ -2604,20 +2604,20 @@ test_calls(Test_Context* test_context)
 
             ASSERT_FALSE(return_statement->is_empty);
 
-            const Ast_Expression* returned_expression = &return_statement->expression;
+            const Ast_Expression* returned_expression = AST_EXPRESSION(return_statement->expression);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(returned_expression->kind, AST_EXPRESSION_CALL);
-            ASSERT_TYPE_STRINGS_ARE_EQUAL(returned_expression->type_id, "s32");
+            ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, return_statement->expression), "s32");
 
-            const Ast_Expression* called_expression = returned_expression->call.called_expression;
+            const Ast_Expression* called_expression = AST_EXPRESSION(returned_expression->call.called_expression);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(called_expression->kind, AST_EXPRESSION_DEREFERENCE);
-            ASSERT_TYPE_STRINGS_ARE_EQUAL(called_expression->type_id, "() -> s32");
+            ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, returned_expression->call.called_expression), "() -> s32");
 
-            const Ast_Expression* dereferenced_expression = called_expression->unary_expression.operand;
+            const Ast_Expression* dereferenced_expression = AST_EXPRESSION(called_expression->unary_expression.operand);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(dereferenced_expression->kind, AST_EXPRESSION_IDENTIFIER);
-            ASSERT_TYPE_STRINGS_ARE_EQUAL(dereferenced_expression->type_id, "* () -> s32");
+            ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, called_expression->unary_expression.operand), "* () -> s32");
 
             const Symbol* identifier_symbol = get_symbol_for_identifier(&context, &dereferenced_expression->identifier);
             ASSERT_TYPE_STRINGS_ARE_EQUAL(identifier_symbol->type_id, "* () -> s32");
@@ -2724,20 +2724,20 @@ test_calls(Test_Context* test_context)
 
             ASSERT_FALSE(return_statement->is_empty);
 
-            const Ast_Expression* returned_expression = &return_statement->expression;
+            const Ast_Expression* returned_expression = AST_EXPRESSION(return_statement->expression);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(returned_expression->kind, AST_EXPRESSION_CALL);
-            ASSERT_TYPE_STRINGS_ARE_EQUAL(returned_expression->type_id, "s32");
+            ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, return_statement->expression), "s32");
 
-            const Ast_Expression* called_expression = returned_expression->call.called_expression;
+            const Ast_Expression* called_expression = AST_EXPRESSION(returned_expression->call.called_expression);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(called_expression->kind, AST_EXPRESSION_DEREFERENCE);
-            ASSERT_TYPE_STRINGS_ARE_EQUAL(called_expression->type_id, "(s32) -> s32");
+            ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, returned_expression->call.called_expression), "(s32) -> s32");
 
-            const Ast_Expression* dereferenced_expression = called_expression->unary_expression.operand;
+            const Ast_Expression* dereferenced_expression = AST_EXPRESSION(called_expression->unary_expression.operand);
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(dereferenced_expression->kind, AST_EXPRESSION_IDENTIFIER);
-            ASSERT_TYPE_STRINGS_ARE_EQUAL(dereferenced_expression->type_id, "* (s32) -> s32");
+            ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, called_expression->unary_expression.operand), "* (s32) -> s32");
 
             const Symbol* identifier_symbol = get_symbol_for_identifier(&context, &dereferenced_expression->identifier);
             ASSERT_TYPE_STRINGS_ARE_EQUAL(identifier_symbol->type_id, "* (s32) -> s32");
@@ -2822,15 +2822,15 @@ test_calls(Test_Context* test_context)
 
                 ASSERT_FALSE(return_statement->is_empty);
 
-                const Ast_Expression* returned_expression = &return_statement->expression;
+                const Ast_Expression* returned_expression = AST_EXPRESSION(return_statement->expression);
 
                 ASSERT_ENUM_VALUES_ARE_EQUAL(returned_expression->kind, AST_EXPRESSION_CALL);
-                ASSERT_TYPE_STRINGS_ARE_EQUAL(returned_expression->type_id, "void");
+                ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, return_statement->expression), "void");
 
-                const Ast_Expression* called_expression = returned_expression->call.called_expression;
+                const Ast_Expression* called_expression = AST_EXPRESSION(returned_expression->call.called_expression);
 
                 ASSERT_ENUM_VALUES_ARE_EQUAL(called_expression->kind, AST_EXPRESSION_IDENTIFIER);
-                ASSERT_TYPE_STRINGS_ARE_EQUAL(called_expression->type_id, "() -> void");
+                ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, returned_expression->call.called_expression), "() -> void");
 
                 const Ast_Identifier* identifier = &called_expression->identifier;
 
@@ -2965,15 +2965,15 @@ test_calls(Test_Context* test_context)
                 ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_CALL);
                 const Ast_Call_Statement* call_statement = &statement->call_statement;
 
-                const Ast_Expression* call_expression = &call_statement->call_expression;
+                const Ast_Expression* call_expression = AST_EXPRESSION(call_statement->call_expression);
 
                 ASSERT_ENUM_VALUES_ARE_EQUAL(call_expression->kind, AST_EXPRESSION_CALL);
-                ASSERT_TYPE_STRINGS_ARE_EQUAL(call_expression->type_id, "void");
+                ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, call_statement->call_expression), "void");
 
-                const Ast_Expression* called_expression = call_expression->call.called_expression;
+                const Ast_Expression* called_expression = AST_EXPRESSION(call_expression->call.called_expression);
 
                 ASSERT_ENUM_VALUES_ARE_EQUAL(called_expression->kind, AST_EXPRESSION_IDENTIFIER);
-                ASSERT_TYPE_STRINGS_ARE_EQUAL(called_expression->type_id, "() -> void");
+                ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, call_expression->call.called_expression), "() -> void");
 
                 const Ast_Identifier* identifier = &called_expression->identifier;
 
@@ -3111,35 +3111,35 @@ test_calls(Test_Context* test_context)
 
             ASSERT_TRUE(variable_definition->has_initial_value);
 
-            const Ast_Expression* initial_value = &variable_definition->initial_value;
+            const Ast_Expression* initial_value = AST_EXPRESSION(variable_definition->initial_value);
             ASSERT_ENUM_VALUES_ARE_EQUAL(initial_value->kind, AST_EXPRESSION_ADDRESS_OF);
-            ASSERT_TYPE_STRINGS_ARE_EQUAL(initial_value->type_id, "* () -> void");
+            ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, variable_definition->initial_value), "* () -> void");
 
             const Ast_Unary_Expression* address_of = &initial_value->unary_expression;
-            ASSERT_ENUM_VALUES_ARE_EQUAL(address_of->operand->kind, AST_EXPRESSION_IDENTIFIER);
-            ASSERT_TYPE_STRINGS_ARE_EQUAL(address_of->operand->type_id, "() -> void");
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(address_of->operand)->kind, AST_EXPRESSION_IDENTIFIER);
+            ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, address_of->operand), "() -> void");
         }
 
         {
             const Ast_Statement* statement = &body->statements[1];
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_CALL);
-            const Ast_Expression* call_expression = &statement->call_statement.call_expression;
+            const Ast_Expression* call_expression = AST_EXPRESSION(statement->call_statement.call_expression);
 
-            ASSERT_TYPE_STRINGS_ARE_EQUAL(call_expression->type_id, "void");
+            ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, statement->call_statement.call_expression), "void");
 
             ASSERT_ENUM_VALUES_ARE_EQUAL(call_expression->kind, AST_EXPRESSION_CALL);
             const Ast_Call* call = &call_expression->call;
 
             ASSERT_EQUAL(call->arguments_count, 0);
 
-            const Ast_Expression* called_expression = call->called_expression;
+            const Ast_Expression* called_expression = AST_EXPRESSION(call->called_expression);
             ASSERT_ENUM_VALUES_ARE_EQUAL(called_expression->kind, AST_EXPRESSION_DEREFERENCE);
-            ASSERT_TYPE_STRINGS_ARE_EQUAL(called_expression->type_id, "() -> void");
+            ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, call->called_expression), "() -> void");
 
             const Ast_Unary_Expression* dereference = &called_expression->unary_expression;
-            ASSERT_ENUM_VALUES_ARE_EQUAL(dereference->operand->kind, AST_EXPRESSION_IDENTIFIER);
-            ASSERT_TYPE_STRINGS_ARE_EQUAL(dereference->operand->type_id, "* () -> void");
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(dereference->operand)->kind, AST_EXPRESSION_IDENTIFIER);
+            ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, dereference->operand), "* () -> void");
         }
 
         destroy_parser(&parser);
@@ -3221,10 +3221,10 @@ test_signed_integers(Test_Context* test_context)
 
                 ASSERT_FALSE(return_statement->is_empty);
 
-                const Ast_Expression* returned_expression = &return_statement->expression;
+                const Ast_Expression* returned_expression = AST_EXPRESSION(return_statement->expression);
 
                 ASSERT_ENUM_VALUES_ARE_EQUAL(returned_expression->kind, AST_EXPRESSION_NUMBER);
-                ASSERT_TYPE_STRINGS_ARE_EQUAL(returned_expression->type_id, "s8");
+                ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, return_statement->expression), "s8");
             }
 
             destroy_parser(&parser);
@@ -3300,10 +3300,10 @@ test_signed_integers(Test_Context* test_context)
 
                 ASSERT_FALSE(return_statement->is_empty);
 
-                const Ast_Expression* returned_expression = &return_statement->expression;
+                const Ast_Expression* returned_expression = AST_EXPRESSION(return_statement->expression);
 
                 ASSERT_ENUM_VALUES_ARE_EQUAL(returned_expression->kind, AST_EXPRESSION_NUMBER);
-                ASSERT_TYPE_STRINGS_ARE_EQUAL(returned_expression->type_id, "s16");
+                ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, return_statement->expression), "s16");
             }
 
             destroy_parser(&parser);
@@ -3379,10 +3379,10 @@ test_signed_integers(Test_Context* test_context)
 
                 ASSERT_FALSE(return_statement->is_empty);
 
-                const Ast_Expression* returned_expression = &return_statement->expression;
+                const Ast_Expression* returned_expression = AST_EXPRESSION(return_statement->expression);
 
                 ASSERT_ENUM_VALUES_ARE_EQUAL(returned_expression->kind, AST_EXPRESSION_NUMBER);
-                ASSERT_TYPE_STRINGS_ARE_EQUAL(returned_expression->type_id, "s32");
+                ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, return_statement->expression), "s32");
             }
 
             destroy_parser(&parser);
@@ -3458,10 +3458,10 @@ test_signed_integers(Test_Context* test_context)
 
                 ASSERT_FALSE(return_statement->is_empty);
 
-                const Ast_Expression* returned_expression = &return_statement->expression;
+                const Ast_Expression* returned_expression = AST_EXPRESSION(return_statement->expression);
 
                 ASSERT_ENUM_VALUES_ARE_EQUAL(returned_expression->kind, AST_EXPRESSION_NUMBER);
-                ASSERT_TYPE_STRINGS_ARE_EQUAL(returned_expression->type_id, "s64");
+                ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, return_statement->expression), "s64");
             }
 
             destroy_parser(&parser);
@@ -3544,10 +3544,10 @@ test_unsigned_integers(Test_Context* test_context)
 
                 ASSERT_FALSE(return_statement->is_empty);
 
-                const Ast_Expression* returned_expression = &return_statement->expression;
+                const Ast_Expression* returned_expression = AST_EXPRESSION(return_statement->expression);
 
                 ASSERT_ENUM_VALUES_ARE_EQUAL(returned_expression->kind, AST_EXPRESSION_NUMBER);
-                ASSERT_TYPE_STRINGS_ARE_EQUAL(returned_expression->type_id, "u8");
+                ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, return_statement->expression), "u8");
             }
 
             destroy_parser(&parser);
@@ -3623,10 +3623,10 @@ test_unsigned_integers(Test_Context* test_context)
 
                 ASSERT_FALSE(return_statement->is_empty);
 
-                const Ast_Expression* returned_expression = &return_statement->expression;
+                const Ast_Expression* returned_expression = AST_EXPRESSION(return_statement->expression);
 
                 ASSERT_ENUM_VALUES_ARE_EQUAL(returned_expression->kind, AST_EXPRESSION_NUMBER);
-                ASSERT_TYPE_STRINGS_ARE_EQUAL(returned_expression->type_id, "u16");
+                ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, return_statement->expression), "u16");
             }
 
             destroy_parser(&parser);
@@ -3702,10 +3702,10 @@ test_unsigned_integers(Test_Context* test_context)
 
                 ASSERT_FALSE(return_statement->is_empty);
 
-                const Ast_Expression* returned_expression = &return_statement->expression;
+                const Ast_Expression* returned_expression = AST_EXPRESSION(return_statement->expression);
 
                 ASSERT_ENUM_VALUES_ARE_EQUAL(returned_expression->kind, AST_EXPRESSION_NUMBER);
-                ASSERT_TYPE_STRINGS_ARE_EQUAL(returned_expression->type_id, "u32");
+                ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, return_statement->expression), "u32");
             }
 
             destroy_parser(&parser);
@@ -3781,10 +3781,10 @@ test_unsigned_integers(Test_Context* test_context)
 
                 ASSERT_FALSE(return_statement->is_empty);
 
-                const Ast_Expression* returned_expression = &return_statement->expression;
+                const Ast_Expression* returned_expression = AST_EXPRESSION(return_statement->expression);
 
                 ASSERT_ENUM_VALUES_ARE_EQUAL(returned_expression->kind, AST_EXPRESSION_NUMBER);
-                ASSERT_TYPE_STRINGS_ARE_EQUAL(returned_expression->type_id, "s64");
+                ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, return_statement->expression), "s64");
             }
 
             destroy_parser(&parser);
@@ -3867,10 +3867,10 @@ test_floats(Test_Context* test_context)
 
                 ASSERT_FALSE(return_statement->is_empty);
 
-                const Ast_Expression* returned_expression = &return_statement->expression;
+                const Ast_Expression* returned_expression = AST_EXPRESSION(return_statement->expression);
 
                 ASSERT_ENUM_VALUES_ARE_EQUAL(returned_expression->kind, AST_EXPRESSION_NUMBER);
-                ASSERT_TYPE_STRINGS_ARE_EQUAL(returned_expression->type_id, "f32");
+                ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, return_statement->expression), "f32");
             }
 
             destroy_parser(&parser);
@@ -3946,10 +3946,10 @@ test_floats(Test_Context* test_context)
 
                 ASSERT_FALSE(return_statement->is_empty);
 
-                const Ast_Expression* returned_expression = &return_statement->expression;
+                const Ast_Expression* returned_expression = AST_EXPRESSION(return_statement->expression);
 
                 ASSERT_ENUM_VALUES_ARE_EQUAL(returned_expression->kind, AST_EXPRESSION_NUMBER);
-                ASSERT_TYPE_STRINGS_ARE_EQUAL(returned_expression->type_id, "f64");
+                ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, return_statement->expression), "f64");
             }
 
             destroy_parser(&parser);
@@ -4028,10 +4028,10 @@ test_floats(Test_Context* test_context)
 
                 ASSERT_FALSE(return_statement->is_empty);
 
-                const Ast_Expression* returned_expression = &return_statement->expression;
+                const Ast_Expression* returned_expression = AST_EXPRESSION(return_statement->expression);
 
                 ASSERT_ENUM_VALUES_ARE_EQUAL(returned_expression->kind, AST_EXPRESSION_NUMBER);
-                ASSERT_TYPE_STRINGS_ARE_EQUAL(returned_expression->type_id, "f32");
+                ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, return_statement->expression), "f32");
             }
 
             destroy_parser(&parser);
@@ -4107,10 +4107,10 @@ test_floats(Test_Context* test_context)
 
                 ASSERT_FALSE(return_statement->is_empty);
 
-                const Ast_Expression* returned_expression = &return_statement->expression;
+                const Ast_Expression* returned_expression = AST_EXPRESSION(return_statement->expression);
 
                 ASSERT_ENUM_VALUES_ARE_EQUAL(returned_expression->kind, AST_EXPRESSION_NUMBER);
-                ASSERT_TYPE_STRINGS_ARE_EQUAL(returned_expression->type_id, "f64");
+                ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, return_statement->expression), "f64");
             }
 
             destroy_parser(&parser);
@@ -4191,8 +4191,8 @@ test_floats(Test_Context* test_context)
 
                 ASSERT_TRUE(definition->has_initial_value);
 
-                const Ast_Expression* initial_value = &definition->initial_value;
-                ASSERT_TYPE_STRINGS_ARE_EQUAL(initial_value->type_id, "f64");
+                const Ast_Expression* initial_value = AST_EXPRESSION(definition->initial_value);
+                ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, definition->initial_value), "f64");
                 ASSERT_ENUM_VALUES_ARE_EQUAL(initial_value->kind, AST_EXPRESSION_NUMBER);
 
                 const Ast_Type* ast_type = definition->type;
@@ -4212,8 +4212,8 @@ test_floats(Test_Context* test_context)
 
                 ASSERT_TRUE(definition->has_initial_value);
 
-                const Ast_Expression* initial_value = &definition->initial_value;
-                ASSERT_TYPE_STRINGS_ARE_EQUAL(initial_value->type_id, "f64");
+                const Ast_Expression* initial_value = AST_EXPRESSION(definition->initial_value);
+                ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, definition->initial_value), "f64");
                 ASSERT_ENUM_VALUES_ARE_EQUAL(initial_value->kind, AST_EXPRESSION_NUMBER);
 
                 const Ast_Type* ast_type = definition->type;
@@ -4231,8 +4231,8 @@ test_floats(Test_Context* test_context)
                 ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_ASSIGNMENT);
                 const Ast_Assignment* assignment = &statement->assignment;
 
-                ASSERT_TYPE_STRINGS_ARE_EQUAL(assignment->lhs.type_id, "f64");
-                ASSERT_TYPE_STRINGS_ARE_EQUAL(assignment->rhs.type_id, "f64");
+                ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, assignment->lhs), "f64");
+                ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, assignment->rhs), "f64");
             }
 
             destroy_parser(&parser);
@@ -4365,10 +4365,10 @@ test_number_types_inference_in_arithmetic_expressions(Test_Context* test_context
             ASSERT_ENUM_VALUES_ARE_EQUAL(statement->kind, AST_STATEMENT_ASSIGNMENT);
             const Ast_Assignment* assignment = &statement->assignment;
 
-            ASSERT_TYPE_STRINGS_ARE_EQUAL(assignment->lhs.type_id, test_info.expected_type);
-            ASSERT_TYPE_STRINGS_ARE_EQUAL(assignment->rhs.type_id, test_info.expected_type);
+            ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, assignment->lhs), test_info.expected_type);
+            ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, assignment->rhs), test_info.expected_type);
 
-            const Ast_Expression* rhs = &assignment->rhs;
+            const Ast_Expression* rhs = AST_EXPRESSION(assignment->rhs);
             switch (rhs->kind)
             {
                 case AST_EXPRESSION_ADD:
@@ -4385,11 +4385,11 @@ test_number_types_inference_in_arithmetic_expressions(Test_Context* test_context
             }
 
             const Ast_Binary_Expression* binary_expression = &rhs->binary_expression;
-            ASSERT_ENUM_VALUES_ARE_EQUAL(binary_expression->lhs->kind, AST_EXPRESSION_NUMBER);
-            ASSERT_TYPE_STRINGS_ARE_EQUAL(binary_expression->lhs->type_id, test_info.expected_type);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(binary_expression->lhs)->kind, AST_EXPRESSION_NUMBER);
+            ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, binary_expression->lhs), test_info.expected_type);
 
-            ASSERT_ENUM_VALUES_ARE_EQUAL(binary_expression->rhs->kind, AST_EXPRESSION_NUMBER);
-            ASSERT_TYPE_STRINGS_ARE_EQUAL(binary_expression->rhs->type_id, test_info.expected_type);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(binary_expression->rhs)->kind, AST_EXPRESSION_NUMBER);
+            ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, binary_expression->rhs), test_info.expected_type);
         }
 
         destroy_parser(&parser);
@@ -4498,7 +4498,7 @@ test_number_types_inference_in_arithmetic_expressions(Test_Context* test_context
 
             ASSERT_FALSE(return_statement->is_empty);
 
-            const Ast_Expression* returned_expression = &return_statement->expression;
+            const Ast_Expression* returned_expression = AST_EXPRESSION(return_statement->expression);
 
             switch (returned_expression->kind)
             {
@@ -4516,11 +4516,11 @@ test_number_types_inference_in_arithmetic_expressions(Test_Context* test_context
             }
 
             const Ast_Binary_Expression* binary_expression = &returned_expression->binary_expression;
-            ASSERT_ENUM_VALUES_ARE_EQUAL(binary_expression->lhs->kind, AST_EXPRESSION_NUMBER);
-            ASSERT_TYPE_STRINGS_ARE_EQUAL(binary_expression->lhs->type_id, test_info.expected_type);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(binary_expression->lhs)->kind, AST_EXPRESSION_NUMBER);
+            ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, binary_expression->lhs), test_info.expected_type);
 
-            ASSERT_ENUM_VALUES_ARE_EQUAL(binary_expression->rhs->kind, AST_EXPRESSION_NUMBER);
-            ASSERT_TYPE_STRINGS_ARE_EQUAL(binary_expression->rhs->type_id, test_info.expected_type);
+            ASSERT_ENUM_VALUES_ARE_EQUAL(AST_EXPRESSION(binary_expression->rhs)->kind, AST_EXPRESSION_NUMBER);
+            ASSERT_TYPE_STRINGS_ARE_EQUAL(get_expression_type_id(&context, binary_expression->rhs), test_info.expected_type);
         }
 
         destroy_parser(&parser);
@@ -5917,6 +5917,323 @@ test_mutability_mismatches(Test_Context* test_context)
     }
 }
 
+internal void
+test_long_chains_of_type_variables(Test_Context* test_context)
+{
+    CREATE_TEST_COMPILATION_CONTEXT_FOR_CODE("foo: () -> void = {\n"
+                                             "}\n");
+
+    Lexer lexer = {0};
+    Parser parser = {0};
+
+    create_lexer(&lexer, &context);
+    create_parser(&parser, &lexer, &context);
+
+    ASSERT_TRUE(parse_ast(&parser));
+    create_lexical_scopes(&context);
+    ASSERT_TRUE(resolve_and_validate_types(&context));
+
+    // NOTE(vlad): Deep enough to overflow the stack with a recursive 'find_root_type_id'.
+    const Size number_of_variables = 1000000;
+    const Type_Id first_variable_type_id = create_new_type_variable(&context);
+
+    {
+        Type_Id previous_variable_type_id = first_variable_type_id;
+
+        for (Index i = 1;
+             i < number_of_variables;
+             ++i)
+        {
+            const Type_Id variable_type_id = create_new_type_variable(&context);
+            ASSERT_TRUE(try_to_unify_types(&context, previous_variable_type_id, variable_type_id));
+            previous_variable_type_id = variable_type_id;
+        }
+
+        const Type_Id root_type_id = find_root_type_id(&context, first_variable_type_id);
+        ASSERT_EQUAL(root_type_id.index, find_root_type_id(&context, previous_variable_type_id).index);
+        ASSERT_TRUE(get_exact_type_by_id(&context, root_type_id)->rank <= 1);
+
+        ASSERT_TRUE(try_to_unify_types(&context, previous_variable_type_id, get_boolean_type_id(&context)));
+        ASSERT_EQUAL(get_type_by_id(&context, first_variable_type_id)->kind, TYPE_BOOLEAN);
+    }
+
+    {
+        const Type_Id last_variable_type_id = create_new_type_variable(&context);
+
+        // NOTE(vlad): The degenerate chain a union without ranks builds: every variable is linked under the next one.
+        for (Index i = 0;
+             i < number_of_variables;
+             ++i)
+        {
+            const Type_Id variable_type_id = create_new_type_variable(&context);
+            get_exact_type_by_id(&context, variable_type_id)->parent_type_id = (Type_Id) { variable_type_id.index - 1 };
+        }
+
+        const Type_Id first_chained_type_id = (Type_Id) { context.types_count - 1 };
+        ASSERT_EQUAL(find_root_type_id(&context, first_chained_type_id).index, last_variable_type_id.index);
+
+        // NOTE(vlad): Path halving links every other node to its grandparent.
+        ASSERT_EQUAL(get_exact_type_by_id(&context, first_chained_type_id)->parent_type_id.index,
+                     first_chained_type_id.index - 2);
+    }
+
+    destroy_parser(&parser);
+    destroy_lexer(&lexer);
+    destroy_compilation_context(&context);
+}
+
+internal void
+test_structural_types_interning(Test_Context* test_context)
+{
+    CREATE_TEST_COMPILATION_CONTEXT_FOR_CODE("foo: (parameter: * s32) -> * s32 = {\n"
+                                             "    value: s32 = 0;\n"
+                                             "    pointer: * s32 = value&;\n"
+                                             "    return pointer;\n"
+                                             "}\n"
+                                             "bar: (parameter: * s32) -> * s32 = {\n"
+                                             "    return foo(parameter);\n"
+                                             "}\n"
+                                             "baz: (parameter: * mutable s32) -> * s32 = {\n"
+                                             "    return bar(parameter);\n"
+                                             "}\n");
+
+    Lexer lexer = {0};
+    Parser parser = {0};
+
+    create_lexer(&lexer, &context);
+    create_parser(&parser, &lexer, &context);
+
+    ASSERT_TRUE(parse_ast(&parser));
+    create_lexical_scopes(&context);
+    ASSERT_TRUE(resolve_and_validate_types(&context));
+    ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
+
+    const Symbol* foo = get_symbol_by_id(&context, find_symbol_id(&context, GLOBAL_LEXICAL_SCOPE_ID, string_view("foo")));
+    const Symbol* bar = get_symbol_by_id(&context, find_symbol_id(&context, GLOBAL_LEXICAL_SCOPE_ID, string_view("bar")));
+    const Symbol* baz = get_symbol_by_id(&context, find_symbol_id(&context, GLOBAL_LEXICAL_SCOPE_ID, string_view("baz")));
+
+    ASSERT_EQUAL(foo->type_id.index, bar->type_id.index);
+    ASSERT_NOT_EQUAL(foo->type_id.index, baz->type_id.index);
+
+    const Type* foo_type = get_exact_type_by_id(&context, foo->type_id);
+    const Type* baz_type = get_exact_type_by_id(&context, baz->type_id);
+
+    ASSERT_TRUE(foo_type->is_interned);
+    ASSERT_EQUAL(foo_type->function_info.return_type_id.index, foo_type->function_info.parameter_type_ids[0].index);
+    ASSERT_EQUAL(foo_type->function_info.return_type_id.index, baz_type->function_info.return_type_id.index);
+    ASSERT_NOT_EQUAL(foo_type->function_info.parameter_type_ids[0].index,
+                     baz_type->function_info.parameter_type_ids[0].index);
+
+    // NOTE(vlad): Pointers to type variables are not interned.
+    {
+        Type pointer_type = {0};
+        pointer_type.kind = TYPE_POINTER;
+        pointer_type.pointer_info.points_to_type_id = create_new_type_variable(&context);
+
+        const Type_Id first_pointer_type_id = intern_type(&context, &pointer_type);
+        const Type_Id second_pointer_type_id = intern_type(&context, &pointer_type);
+
+        ASSERT_NOT_EQUAL(first_pointer_type_id.index, second_pointer_type_id.index);
+        ASSERT_FALSE(get_exact_type_by_id(&context, first_pointer_type_id)->is_interned);
+    }
+
+    destroy_parser(&parser);
+    destroy_lexer(&lexer);
+    destroy_compilation_context(&context);
+}
+
+internal void
+test_type_strings_cache(Test_Context* test_context)
+{
+    CREATE_TEST_COMPILATION_CONTEXT_FOR_CODE("foo: (parameter: * s32, value: bool) -> * s32 = {\n"
+                                             "    return parameter;\n"
+                                             "}\n");
+
+    Lexer lexer = {0};
+    Parser parser = {0};
+
+    create_lexer(&lexer, &context);
+    create_parser(&parser, &lexer, &context);
+
+    ASSERT_TRUE(parse_ast(&parser));
+    create_lexical_scopes(&context);
+    ASSERT_TRUE(resolve_and_validate_types(&context));
+    ASSERT_THAT_THERE_ARE_NO_DIAGNOSTIC_MESSAGES();
+
+    const Symbol* foo = get_symbol_by_id(&context, find_symbol_id(&context, GLOBAL_LEXICAL_SCOPE_ID, string_view("foo")));
+
+    const String_View first_string = convert_type_to_string(&context, foo->type_id);
+    const String_View second_string = convert_type_to_string(&context, foo->type_id);
+
+    ASSERT_STRINGS_ARE_EQUAL(first_string, "(* s32, bool) -> * s32");
+    ASSERT_TRUE(first_string.data == second_string.data);
+
+    // NOTE(vlad): Strings of types that refer to type variables follow unification.
+    {
+        const Type_Id variable_type_id = create_new_type_variable(&context);
+
+        Type pointer_type = {0};
+        pointer_type.kind = TYPE_POINTER;
+        pointer_type.pointer_info.points_to_type_id = variable_type_id;
+
+        const Type_Id pointer_type_id = intern_type(&context, &pointer_type);
+
+        const Type_Id other_variable_type_id = create_new_type_variable(&context);
+        pointer_type.pointer_info.points_to_type_id = other_variable_type_id;
+        const Type_Id other_pointer_type_id = intern_type(&context, &pointer_type);
+        const String_View other_pointer_string = convert_type_to_string(&context, other_pointer_type_id);
+
+        ASSERT_STRINGS_ARE_EQUAL(convert_type_to_string(&context, pointer_type_id), "* _");
+        ASSERT_TRUE(try_to_unify_types(&context, variable_type_id, get_boolean_type_id(&context)));
+        ASSERT_STRINGS_ARE_EQUAL(convert_type_to_string(&context, pointer_type_id), "* bool");
+        ASSERT_TRUE(convert_type_to_string(&context, foo->type_id).data == first_string.data);
+
+        // NOTE(vlad): Types that don't contain the unified variable keep their strings.
+        ASSERT_TRUE(convert_type_to_string(&context, other_pointer_type_id).data == other_pointer_string.data);
+    }
+
+    destroy_parser(&parser);
+    destroy_lexer(&lexer);
+    destroy_compilation_context(&context);
+}
+
+internal String_View
+dump_types_resolved_in_batches(Test_Context* test_context, const C_String code, const Size batches_count)
+{
+    CREATE_TEST_COMPILATION_CONTEXT_FOR_CODE(code);
+
+    Lexer lexer = {0};
+    Parser parser = {0};
+
+    create_lexer(&lexer, &context);
+    create_parser(&parser, &lexer, &context);
+
+    parse_ast(&parser);
+    create_lexical_scopes(&context);
+
+    const Bool types_are_valid = resolve_and_validate_types_in_batches(&context, batches_count);
+
+    String_Builder builder = {0};
+    create_string_builder(&builder, test_context->arena);
+
+    append_string(&builder, types_are_valid ? string_view("valid\n") : string_view("invalid\n"));
+    append_string(&builder, dump_diagnostic_messages(test_context->arena, &context, MAX_MESSAGE_LEVEL));
+    append_string(&builder, string_view("\n"));
+
+    for (Index expression_id = 1;
+         expression_id < context.expression_type_ids_count;
+         ++expression_id)
+    {
+        const Type_Id type_id = context.expression_type_ids[expression_id];
+
+        if (type_id_is_defined(type_id) && type_id_is_valid(&context, type_id))
+        {
+            append_string(&builder, convert_type_to_string(&context, type_id));
+        }
+
+        append_string(&builder, string_view("\n"));
+    }
+
+    // NOTE(vlad): Union by rank must hold after merging the batches, sequential checking never
+    //             reports anything here.
+    for (Index type_index = 0;
+         type_index < context.types_count;
+         ++type_index)
+    {
+        const Type* type = &context.types[type_index];
+        if (type_id_is_undefined(type->parent_type_id))
+        {
+            continue;
+        }
+
+        const Type* parent_type = &context.types[type->parent_type_id.index];
+        if (parent_type->rank <= type->rank)
+        {
+            append_string(&builder, string_view(format_string(test_context->arena,
+                                                              "rank of a type is not below the rank of its parent: {} >= {}\n",
+                                                              type->rank,
+                                                              parent_type->rank)));
+        }
+    }
+
+    destroy_parser(&parser);
+    destroy_lexer(&lexer);
+    destroy_compilation_context(&context);
+
+    return string_builder_to_string(&builder);
+}
+
+internal void
+test_type_checking_in_batches(Test_Context* test_context)
+{
+    const C_String valid_code = "first: (parameter: * s32) -> s32 =\n"
+                                "{\n"
+                                "    a: mutable _ = parameter*;\n"
+                                "    b := 10;\n"
+                                "    while a > 0\n"
+                                "    {\n"
+                                "        a = a - b;\n"
+                                "    }\n"
+                                "    return a;\n"
+                                "}\n"
+                                "second: (parameter: s32) -> * s32 =\n"
+                                "{\n"
+                                "    a: mutable _ = parameter;\n"
+                                "    ptr: * mutable _ = a&;\n"
+                                "    ptr* = first(ptr) + 1;\n"
+                                "    return ptr;\n"
+                                "}\n"
+                                "third: () -> f64 =\n"
+                                "{\n"
+                                "    a := 2.0;\n"
+                                "    if 1 != 2\n"
+                                "    {\n"
+                                "        return a;\n"
+                                "    }\n"
+                                "    return 1.0;\n"
+                                "}\n"
+                                "fourth: (parameter: s32) -> void =\n"
+                                "{\n"
+                                "    ptr := second(parameter);\n"
+                                "    first_ptr := first&;\n"
+                                "    b: s8 = 10;\n"
+                                "    c := (first_ptr*)(ptr) + parameter;\n"
+                                "}\n"
+                                "fifth: () -> f64 =\n"
+                                "{\n"
+                                "    fourth(1);\n"
+                                "    return third() * 2;\n"
+                                "}\n";
+
+    ASSERT_STRINGS_ARE_EQUAL(dump_types_resolved_in_batches(test_context, valid_code, 3),
+                             dump_types_resolved_in_batches(test_context, valid_code, 1));
+    ASSERT_STRINGS_ARE_EQUAL(dump_types_resolved_in_batches(test_context, valid_code, 5),
+                             dump_types_resolved_in_batches(test_context, valid_code, 1));
+
+    // NOTE(vlad): Only the first invalid function is reported, like in the sequential mode.
+    const C_String invalid_code = "first: () -> s32 =\n"
+                                  "{\n"
+                                  "    return 1;\n"
+                                  "}\n"
+                                  "second: () -> s32 =\n"
+                                  "{\n"
+                                  "    a: * s32 = first();\n"
+                                  "    return 1;\n"
+                                  "}\n"
+                                  "third: () -> s32 =\n"
+                                  "{\n"
+                                  "    return 1.0;\n"
+                                  "}\n"
+                                  "fourth: () -> s32 =\n"
+                                  "{\n"
+                                  "    return first();\n"
+                                  "}\n";
+
+    const String_View sequential_dump = dump_types_resolved_in_batches(test_context, invalid_code, 1);
+    ASSERT_STRINGS_ARE_EQUAL(dump_types_resolved_in_batches(test_context, invalid_code, 2), sequential_dump);
+    ASSERT_STRINGS_ARE_EQUAL(dump_types_resolved_in_batches(test_context, invalid_code, 4), sequential_dump);
+}
+
 REGISTER_TESTS(
     test_builtin_types_resolving,
     test_pointers,
@@ -5934,7 +6251,11 @@ REGISTER_TESTS(
     test_type_mismatches,
     test_number_type_mismatches,
     test_lvalue_mismatches,
-    test_mutability_mismatches
+    test_mutability_mismatches,
+    test_long_chains_of_type_variables,
+    test_structural_types_interning,
+    test_type_strings_cache,
+    test_type_checking_in_batches
 )
 
 #include "eon_ast.c"
@@ -19,6 +19,28 @@ acquire_arena_from_provider(struct Arena_Provider* provider,
     return provider->test_context->arena;
 }
 
+internal inline Arena*
+acquire_arena_with_flags_from_provider(struct Arena_Provider* provider,
+                                       const String_View arena_name,
+                                       const Size number_of_bytes_to_reserve,
+                                       const Size number_of_bytes_to_commit,
+                                       const Arena_Flags arena_flags)
+{
+    UNUSED(arena_name, number_of_bytes_to_reserve, number_of_bytes_to_commit, arena_flags);
+    return provider->test_context->arena;
+}
+
+// NOTE(vlad): Arenas aren't thread-safe, so worker threads can't share the test arena.
+internal inline Arena*
+acquire_worker_arena_from_provider(struct Arena_Provider* provider,
+                                   const String_View arena_name,
+                                   const Size number_of_bytes_to_reserve,
+                                   const Size number_of_bytes_to_commit)
+{
+    UNUSED(provider);
+    return INTERNAL_create_arena(arena_name, number_of_bytes_to_reserve, number_of_bytes_to_commit, ARENA_FLAG_NONE);
+}
+
 internal inline void
 request_arena_reset(struct Arena_Provider* provider, Arena* arena)
 {
@@ -28,7 +50,10 @@ request_arena_reset(struct Arena_Provider* provider, Arena* arena)
 internal inline void
 release_arena_to_provider(struct Arena_Provider* provider, Arena* arena)
 {
-    UNUSED(provider, arena);
+    if (arena != provider->test_context->arena)
+    {
+        destroy_arena(arena);
+    }
 }
 
 #define CREATE_TEST_COMPILATION_CONTEXT_FOR_CODE(source_code)           \
@@ -70,11 +95,16 @@ release_arena_to_provider(struct Arena_Provider* provider, Arena* arena)
     do                                                                  \
     {                                                                   \
         ASSERT_TYPE_IS_VALID(type_id);                                  \
-        ASSERT_STRINGS_ARE_EQUAL(convert_type_to_string(test_context->arena, \
-                                                        &context,       \
-                                                        type_id),       \
+        ASSERT_STRINGS_ARE_EQUAL(convert_type_to_string(&context, type_id), \
                                  expected);                             \
     }                                                                   \
     while (0)
 
+// NOTE(vlad): AST nodes refer to expressions by ids, these look them up in the test context.
+#define AST_EXPRESSION(expression_id)                                   \
+    get_ast_expression_by_id(&context.ast, (expression_id))
+
+#define AST_CALL_ARGUMENT(call, argument_index)                         \
+    AST_EXPRESSION(get_ast_call_argument_id(&context.ast, (call), (argument_index)))
+
 // FIXME(vlad): Implement 'ASSERT_DIAGNOSTIC_MESSAGES_ARE_EQUAL("<diagnostic-messages>")'.
@@ -1,3 +1,4 @@
+#include <eon/arena_provider.h>
 #include <eon/common.h>
 #include <eon/diff.h>
 #include <eon/memory.h>
@@ -33,12 +34,6 @@
 #    define END_TIMER(name, message)
 #endif
 
-struct Arena_Provider
-{
-    s32 dummy_field;
-};
-typedef struct Arena_Provider Arena_Provider;
-
 internal inline void
 print_usage(void)
 {
@@ -53,6 +48,11 @@ internal Bool compare_outputs_and_optionally_canonize(Arena* scratch_arena,
                                                       const String_View output,
                                                       const Bool canonize_output);
 
+internal Bool compare_with_recompilation_reusing_functions(Arena* ssa_string_arena,
+                                                           Arena_Provider* arena_provider,
+                                                           Compilation_Context* previous_context,
+                                                           const String_View expected_ssa_string);
+
 int
 main(const int argc, const char* argv[])
 {
@@ -90,6 +90,8 @@ main(const int argc, const char* argv[])
     Arena* ssa_string_arena = create_arena("ssa-string", GiB(1), MiB(1));
 
     Arena_Provider arena_provider = {0};
+    create_arena_provider(&arena_provider);
+
     Compilation_Context context = {0};
 
     const Timestamp test_start_timestamp = platform_get_current_monotonic_timestamp();
@@ -104,6 +106,7 @@ main(const int argc, const char* argv[])
         if (result.status != READ_FILE_SUCCESS)
         {
             println("Error: failed to read file {}", main_filename);
+            destroy_arena_provider(&arena_provider);
             destroy_arena(ssa_string_arena);
             destroy_arena(source_code_arena);
             return EXIT_FAILURE;
@@ -208,6 +211,13 @@ main(const int argc, const char* argv[])
         test_failed = !success;
 
         END_TIMER(comparing_plain_ssa, "Plain SSA processed");
+
+        START_TIMER(recompilation);
+        if (!compare_with_recompilation_reusing_functions(ssa_string_arena, &arena_provider, &context, plain_ssa_string))
+        {
+            test_failed = true;
+        }
+        END_TIMER(recompilation, "Recompilation with reused functions compared");
     }
 
     START_TIMER(unused_ssa_assignments);
@@ -299,33 +309,15 @@ cleanup:
     destroy_parser(&parser);
     destroy_lexer(&lexer);
 
-    destroy_arena(ssa_string_arena);
-
-    return test_failed ? EXIT_FAILURE : EXIT_SUCCESS;
-}
+#if ENABLE_TIMER
+    println("Arena provider: {} hits, {} misses", arena_provider.hits_count, arena_provider.misses_count);
+#endif
 
-internal Arena*
-acquire_arena_from_provider(Arena_Provider* provider,
-                            const String_View arena_name,
-                            const Size number_of_bytes_to_reserve,
-                            const Size number_of_bytes_to_commit)
-{
-    UNUSED(provider);
-    return create_arena(arena_name, number_of_bytes_to_reserve, number_of_bytes_to_commit);
-}
+    destroy_arena_provider(&arena_provider);
 
-internal void
-request_arena_reset(Arena_Provider* provider, Arena* arena)
-{
-    UNUSED(provider);
-    arena_clear(arena);
-}
+    destroy_arena(ssa_string_arena);
 
-internal void
-release_arena_to_provider(Arena_Provider* provider, Arena* arena)
-{
-    UNUSED(provider);
-    destroy_arena(arena);
+    return test_failed ? EXIT_FAILURE : EXIT_SUCCESS;
 }
 
 // FIXME(vlad): Use 'tac_function->first_tac_variable_index' instead.
@@ -919,6 +911,77 @@ compare_outputs_and_optionally_canonize(Arena* scratch_arena,
     }
 }
 
+// NOTE(vlad): Compiling the same file again reuses every function of the previous compilation,
+//             which must give the same SSA and diagnostics as compiling it from scratch.
+internal Bool
+compare_with_recompilation_reusing_functions(Arena* ssa_string_arena,
+                                             Arena_Provider* arena_provider,
+                                             Compilation_Context* previous_context,
+                                             const String_View expected_ssa_string)
+{
+    Compilation_Context context = {0};
+    Lexer lexer = {0};
+    Parser parser = {0};
+
+    create_compilation_context(&context, arena_provider, &previous_context->source_file);
+    reuse_unchanged_functions_of_previous_compilation(&context, previous_context);
+
+    create_lexer(&lexer, &context);
+    create_parser(&parser, &lexer, &context);
+
+    Bool compiled_without_errors = parse_ast(&parser) && !has_compilation_errors(&context);
+
+    if (compiled_without_errors)
+    {
+        validate_ast(&context);
+        create_lexical_scopes(&context);
+        compiled_without_errors = !has_compilation_errors(&context)
+                                  && resolve_and_validate_types(&context)
+                                  && !has_compilation_errors(&context);
+    }
+
+    Bool outputs_are_equal = false;
+
+    if (compiled_without_errors)
+    {
+        lower_ast_to_tac(&context);
+        construct_cfg_from_tac(&context);
+        construct_ssa_from_cfg(&context);
+
+        const String_View ssa_string = convert_ssa_to_string(ssa_string_arena, &context);
+        const String_View diagnostic_messages = dump_diagnostic_messages(context.scratch_arena, &context, MAX_MESSAGE_LEVEL);
+        const String_View expected_diagnostic_messages = dump_diagnostic_messages(context.scratch_arena,
+                                                                                  previous_context,
+                                                                                  MAX_MESSAGE_LEVEL);
+
+        if (!strings_are_equal(ssa_string, expected_ssa_string))
+        {
+            const Diff diff = calculate_line_diff(context.scratch_arena, expected_ssa_string, ssa_string);
+            println("Recompilation: SSA differs:\n\n{}", line_diff_to_string(context.scratch_arena, &diff));
+        }
+        else if (!strings_are_equal(diagnostic_messages, expected_diagnostic_messages))
+        {
+            const Diff diff = calculate_line_diff(context.scratch_arena, expected_diagnostic_messages, diagnostic_messages);
+            println("Recompilation: diagnostics differ:\n\n{}", line_diff_to_string(context.scratch_arena, &diff));
+        }
+        else
+        {
+            outputs_are_equal = true;
+        }
+    }
+    else
+    {
+        println("Recompilation: failed to compile {}", context.source_file.filename);
+    }
+
+    destroy_compilation_context(&context);
+    destroy_parser(&parser);
+    destroy_lexer(&lexer);
+
+    return outputs_are_equal;
+}
+
+#include <eon/arena_provider.c>
 #include <eon/diff.c>
 #include <eon/io.c>
 #include <eon/memory.c>